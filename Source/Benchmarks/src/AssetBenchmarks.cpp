@@ -0,0 +1,104 @@
+#include "AssetBenchmarks.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "fastgltf/core.hpp"
+#include "Sengine/Core/PngEncoder.h"
+#include "stb_image/stb_image.h"
+
+namespace Benchmarks
+{
+	namespace
+	{
+		//Small random steps between neighbouring pixels, so the decoder's inflate and unfiltering both have work to do.
+		std::vector<uint8_t> CreatePng(uint32_t width, uint32_t height)
+		{
+			std::mt19937 random(42);
+			std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+			for (size_t index = 0; index < pixels.size(); index++)
+			{
+				const uint8_t left = index % (width * 4) >= 4 ? pixels[index - 4] : 0;
+				pixels[index] = static_cast<uint8_t>(left + random() % 8);
+			}
+
+			return Sengine::EncodePng(pixels.data(), width, height);
+		}
+
+		std::string EncodeBase64(const std::vector<uint8_t>& bytes)
+		{
+			constexpr const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+			std::string encoded;
+			for (size_t index = 0; index < bytes.size(); index += 3)
+			{
+				const uint32_t remaining = static_cast<uint32_t>(std::min<size_t>(3, bytes.size() - index));
+				uint32_t group = 0;
+				for (uint32_t byte = 0; byte < 3; byte++)
+				{
+					group = (group << 8) | (byte < remaining ? bytes[index + byte] : 0);
+				}
+				for (uint32_t character = 0; character < 4; character++)
+				{
+					encoded.push_back(character <= remaining ? alphabet[(group >> (18 - character * 6)) & 63] : '=');
+				}
+			}
+			return encoded;
+		}
+
+		//A glTF with one triangle list mesh whose buffer is embedded as base64, so parsing covers both the JSON and the buffer.
+		std::string CreateGltf(uint32_t triangleCount)
+		{
+			std::mt19937 random(42);
+			std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+			const uint32_t vertexCount = triangleCount * 3;
+			std::vector<uint8_t> buffer(vertexCount * sizeof(float) * 3);
+			for (size_t offset = 0; offset < buffer.size(); offset += sizeof(float))
+			{
+				const float value = distribution(random);
+				std::memcpy(buffer.data() + offset, &value, sizeof(float));
+			}
+
+			const std::string byteLength = std::to_string(buffer.size());
+			return R"({"asset":{"version":"2.0"},"scene":0,"scenes":[{"nodes":[0]}],"nodes":[{"mesh":0}],)"
+				R"("meshes":[{"primitives":[{"attributes":{"POSITION":0}}]}],)"
+				R"("accessors":[{"bufferView":0,"componentType":5126,"count":)" + std::to_string(vertexCount) + R"(,"type":"VEC3","min":[-1,-1,-1],"max":[1,1,1]}],)"
+				R"("bufferViews":[{"buffer":0,"byteLength":)" + byteLength + R"(}],)"
+				R"("buffers":[{"byteLength":)" + byteLength + R"(,"uri":"data:application/octet-stream;base64,)" + EncodeBase64(buffer) + R"("}]})";
+		}
+	}
+
+	void RunAssetBenchmarks(BenchmarkRunner& runner)
+	{
+		{
+			constexpr uint32_t size = 512;
+			const std::vector<uint8_t> png = CreatePng(size, size);
+			runner.Run("PNG decode (stb_image, per pixel)", size * size, [&]()
+				{
+					int width = 0;
+					int height = 0;
+					int channels = 0;
+					stbi_uc* pixels = stbi_load_from_memory(png.data(), static_cast<int>(png.size()), &width, &height, &channels, 4);
+					KeepAlive(pixels[0]);
+					stbi_image_free(pixels);
+				});
+		}
+
+		{
+			constexpr uint32_t triangleCount = 10000;
+			const std::string gltf = CreateGltf(triangleCount);
+			fastgltf::Parser parser;
+			runner.Run("glTF parse (fastgltf, per triangle)", triangleCount, [&]()
+				{
+					auto data = fastgltf::GltfDataBuffer::FromBytes(reinterpret_cast<const std::byte*>(gltf.data()), gltf.size());
+					auto asset = parser.loadGltfJson(data.get(), {});
+					KeepAlive(asset.error());
+				});
+		}
+	}
+}//namespace Benchmarks
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Benchmarks
+{
+	//Image and glTF decoding from memory, so disk speed stays out of the numbers.
+	void RunAssetBenchmarks(BenchmarkRunner& runner);
+}//namespace Benchmarks
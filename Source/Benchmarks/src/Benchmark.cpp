@@ -0,0 +1,93 @@
+#include "Benchmark.h"
+
+#include <fstream>
+#include <unordered_map>
+
+namespace Benchmarks
+{
+	void BenchmarkRunner::PrintSpeedup(const BenchmarkResult* baseline, const BenchmarkResult* result)
+	{
+		if (!baseline || !result) return;
+
+		std::cout << std::left << std::setw(40) << ("  " + result->Name + " speedup") << std::right << std::setw(12) << std::fixed << std::setprecision(2)
+			<< baseline->NanosecondsPerItem / result->NanosecondsPerItem << " x\n";
+	}
+
+	bool BenchmarkRunner::WriteJson(const std::filesystem::path& path) const
+	{
+		std::ofstream file(path);
+		if (!file.is_open())
+		{
+			std::cout << "[Benchmarks] Error: Failed to write " << path.string() << "\n";
+			return false;
+		}
+
+		file << "[\n";
+		for (size_t index = 0; index < m_Results.size(); index++)
+		{
+			const BenchmarkResult& result = m_Results[index];
+			file << "  {\"name\": \"" << result.Name << "\", \"ns_per_item\": " << std::setprecision(6) << result.NanosecondsPerItem << "}"
+				<< (index + 1 < m_Results.size() ? "," : "") << "\n";
+		}
+		file << "]\n";
+
+		return true;
+	}
+
+	bool BenchmarkRunner::CompareWithBaseline(const std::filesystem::path& path, double threshold) const
+	{
+		std::ifstream file(path);
+		if (!file.is_open())
+		{
+			std::cout << "[Benchmarks] Error: Failed to read " << path.string() << "\n";
+			return false;
+		}
+
+		//Only reads the layout WriteJson writes, a result per line.
+		std::unordered_map<std::string, double> baseline;
+		std::string line;
+		while (std::getline(file, line))
+		{
+			const std::string nameKey = "\"name\": \"";
+			const std::string timeKey = "\"ns_per_item\": ";
+			const size_t name = line.find(nameKey);
+			const size_t time = line.find(timeKey);
+			if (name == std::string::npos || time == std::string::npos) continue;
+
+			const size_t nameStart = name + nameKey.size();
+			baseline[line.substr(nameStart, line.find('"', nameStart) - nameStart)] = std::stod(line.substr(time + timeKey.size()));
+		}
+
+		std::cout << "\nAgainst " << path.string() << ", failing above +" << std::fixed << std::setprecision(1) << threshold * 100.0 << "%\n";
+
+		bool isPassing = true;
+		for (const BenchmarkResult& result : m_Results)
+		{
+			const auto entry = baseline.find(result.Name);
+			if (entry == baseline.end())
+			{
+				std::cout << std::left << std::setw(40) << result.Name << std::right << std::setw(12) << "new" << "\n";
+				continue;
+			}
+
+			const double change = result.NanosecondsPerItem / entry->second - 1.0;
+			const bool isRegression = change > threshold;
+			isPassing = isPassing && !isRegression;
+
+			std::cout << std::left << std::setw(40) << result.Name << std::right << std::setw(11) << std::showpos << std::fixed << std::setprecision(1)
+				<< change * 100.0 << std::noshowpos << "%" << (isRegression ? "  REGRESSION" : "") << "\n";
+			baseline.erase(entry);
+		}
+
+		//A filtered run leaves out most of the baseline on purpose.
+		if (m_Filter.empty())
+		{
+			for (const auto& [name, nanoseconds] : baseline)
+			{
+				std::cout << std::left << std::setw(40) << name << std::right << std::setw(12) << "missing" << "\n";
+			}
+		}
+
+		return isPassing;
+	}
+}//namespace Benchmarks
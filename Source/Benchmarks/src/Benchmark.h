@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Benchmarks
+{
+	struct BenchmarkResult
+	{
+		std::string Name;
+		double NanosecondsPerItem = 0.0;
+	};
+
+	//Times a function that processes itemCount items per call. Runs it for a few rounds of at least MinimumRoundSeconds
+	//and keeps the fastest, which is the least disturbed by the rest of the machine.
+	class BenchmarkRunner
+	{
+	public:
+		static constexpr double MinimumRoundSeconds = 0.05;
+		static constexpr int RoundCount = 7;
+
+		//Only benchmarks whose name contains the filter run, an empty filter runs everything.
+		explicit BenchmarkRunner(std::string filter = "")
+			: m_Filter(std::move(filter))
+		{
+		}
+
+		//Returns null if the benchmark was filtered out.
+		template<typename Function>
+		const BenchmarkResult* Run(const std::string& name, size_t itemCount, Function&& function)
+		{
+			using Clock = std::chrono::steady_clock;
+
+			if (!m_Filter.empty() && name.find(m_Filter) == std::string::npos) return nullptr;
+
+			function();
+
+			double best = 0.0;
+			for (int round = 0; round < RoundCount; round++)
+			{
+				size_t calls = 0;
+				const Clock::time_point start = Clock::now();
+				double seconds = 0.0;
+				do
+				{
+					function();
+					calls++;
+					seconds = std::chrono::duration<double>(Clock::now() - start).count();
+				} while (seconds < MinimumRoundSeconds);
+
+				const double nanoseconds = seconds * 1e9 / static_cast<double>(calls * itemCount);
+				best = round == 0 ? nanoseconds : std::min(best, nanoseconds);
+			}
+
+			m_Results.push_back({ name, best });
+			std::cout << std::left << std::setw(40) << name << std::right << std::setw(12) << std::fixed << std::setprecision(3) << best << " ns/item\n";
+			return &m_Results.back();
+		}
+
+		//Prints how many times faster the second result is than the first, if both ran.
+		static void PrintSpeedup(const BenchmarkResult* baseline, const BenchmarkResult* result);
+
+		//One result per line, {"name": ..., "ns_per_item": ...}, so baselines diff cleanly.
+		[[nodiscard]] bool WriteJson(const std::filesystem::path& path) const;
+		//Prints every result against the same benchmark in the baseline. Returns false if any is slower by more
+		//than the threshold, e.g. 0.05 for 5%. Benchmarks missing from either side are reported but do not fail.
+		[[nodiscard]] bool CompareWithBaseline(const std::filesystem::path& path, double threshold) const;
+
+		[[nodiscard]] const std::deque<BenchmarkResult>& GetResults() const { return m_Results; }
+
+	private:
+		std::string m_Filter;
+		//A deque so the results handed out stay where they are as more are added.
+		std::deque<BenchmarkResult> m_Results;
+	};
+
+	//Keeps the optimiser from removing work whose result is never used. The value's address escapes and memory is
+	//treated as read, so every byte of it has to be computed, not just the ones something else reads.
+	template<typename T>
+	void KeepAlive(const T& value)
+	{
+#ifdef _MSC_VER
+		static const volatile void* volatile address;
+		address = &value;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "g"(&value) : "memory");
+#endif
+	}
+}//namespace Benchmarks
@@ -0,0 +1,176 @@
+#include "CoreBenchmarks.h"
+
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <thread>
+
+#include "Sengine/Audio/Mixer.h"
+#include "Sengine/Core/JobSystem.h"
+#include "Sengine/Net/InProcessTransport.h"
+#include "Sengine/Net/ReplicationClient.h"
+#include "Sengine/Net/ReplicationServer.h"
+#include "Sengine/Scene/Scene.h"
+
+namespace Benchmarks
+{
+	void RunCoreBenchmarks(BenchmarkRunner& runner)
+	{
+		using namespace Sengine;
+
+		//Small jobs through the queue and back, which is mostly the cost of the queue itself.
+		{
+			constexpr uint32_t jobCount = 10000;
+			JobSystem::Init();
+
+			std::atomic<uint32_t> completed = 0;
+			runner.Run("Job system submit and complete", jobCount, [&]()
+				{
+					completed = 0;
+					for (uint32_t job = 0; job < jobCount; job++)
+					{
+						JobSystem::Submit([&completed]() { completed.fetch_add(1, std::memory_order_relaxed); });
+					}
+
+					while (completed.load(std::memory_order_relaxed) < jobCount)
+					{
+						std::this_thread::yield();
+					}
+				});
+
+			JobSystem::Destroy();
+		}
+
+		//A flat scene where every entity has a transform and half have sprites, walked the way the renderer walks it.
+		{
+			constexpr uint32_t entityCount = 10000;
+			std::mt19937 random(42);
+			std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+
+			Scene scene;
+			entt::registry& registry = scene.GetRegistry();
+			for (uint32_t index = 0; index < entityCount; index++)
+			{
+				const entt::entity entity = scene.CreateEntity();
+				registry.get<TransformComponent>(entity).Translation = { distribution(random), distribution(random), distribution(random) };
+				if (index % 2 == 0)
+				{
+					registry.emplace<SpriteComponent>(entity);
+				}
+			}
+
+			runner.Run("ECS transform view", entityCount, [&]()
+				{
+					glm::vec3 sum(0.0f);
+					for (const auto [entity, transform] : registry.view<TransformComponent>().each())
+					{
+						sum += transform.Translation;
+					}
+					KeepAlive(sum);
+				});
+
+			runner.Run("ECS transform and sprite view", entityCount / 2, [&]()
+				{
+					glm::vec4 sum(0.0f);
+					for (const auto [entity, transform, sprite] : registry.view<TransformComponent, SpriteComponent>().each())
+					{
+						sum += transform.GetTransform()[3] * sprite.Colour;
+					}
+					KeepAlive(sum);
+				});
+		}
+
+		//A full server with a quarter of its entities moving every snapshot, more changes than the bandwidth budget lets
+		//through. Times the server's snapshots together with every client decoding and applying its own.
+		{
+			constexpr uint32_t entityCount = 1000;
+			constexpr uint32_t clientCount = 64;
+
+			const std::vector<Net::ReplicatedComponent> components = { Net::CreateTransformReplication(), Net::CreateSpriteReplication() };
+			Net::ReplicationSettings settings;
+			const float interval = 1.0f / static_cast<float>(settings.SendRate);
+
+			Net::InProcessNetwork network;
+			const std::unique_ptr<Net::Transport> serverTransport = network.CreateTransport();
+			Scene serverScene;
+			Net::ReplicationServer server(serverScene, *serverTransport, components, settings);
+
+			std::vector<entt::entity> entities;
+			for (uint32_t index = 0; index < entityCount; index++)
+			{
+				const entt::entity entity = serverScene.CreateEntity();
+				serverScene.GetRegistry().emplace<SpriteComponent>(entity);
+				server.Replicate(entity);
+				entities.push_back(entity);
+			}
+
+			std::vector<std::unique_ptr<Scene>> clientScenes;
+			std::vector<std::unique_ptr<Net::Transport>> clientTransports;
+			std::vector<std::unique_ptr<Net::ReplicationClient>> clients;
+			for (uint32_t index = 0; index < clientCount; index++)
+			{
+				clientScenes.push_back(std::make_unique<Scene>());
+				clientTransports.push_back(network.CreateTransport());
+				clients.push_back(std::make_unique<Net::ReplicationClient>(*clientScenes.back(), *clientTransports.back(), serverTransport->GetAddress(), components));
+			}
+
+			uint32_t tick = 0;
+			const auto update = [&]()
+			{
+				entt::registry& registry = serverScene.GetRegistry();
+				for (uint32_t index = tick % 4; index < entityCount; index += 4)
+				{
+					registry.get<TransformComponent>(entities[index]).Translation.x += 0.1f;
+				}
+				tick++;
+
+				server.Update(interval);
+				for (const std::unique_ptr<Net::ReplicationClient>& client : clients)
+				{
+					client->Update(interval);
+				}
+			};
+
+			//Connected, with the initial state sent, before anything is timed.
+			for (uint32_t round = 0; round < 120; round++)
+			{
+				update();
+			}
+
+			runner.Run("Replication snapshot per client", clientCount, update);
+		}
+
+		//A crowd of looping sound effects at different pitches, so every real voice takes the resampling path, with
+		//most of them past the real voice limit. Per voice and block of 512 frames at 48 kHz, about 10.7 ms of audio.
+		{
+			constexpr uint32_t voiceCount = 256;
+			constexpr uint32_t blockFrames = 512;
+
+			std::vector<float> samples(44100);
+			for (size_t index = 0; index < samples.size(); index++)
+			{
+				samples[index] = 0.5f * std::sin(static_cast<float>(index) * 0.0627f);
+			}
+			const std::shared_ptr<AudioClip> clip = AudioClip::Create(std::move(samples), 1, 44100);
+
+			Mixer mixer(48000, 64);
+			for (uint32_t index = 0; index < voiceCount; index++)
+			{
+				VoiceSettings settings;
+				settings.Volume = 0.05f;
+				settings.Pan = static_cast<float>(index % 21) / 10.0f - 1.0f;
+				settings.Pitch = 0.5f + static_cast<float>(index) * 0.005f;
+				settings.IsLooping = true;
+				settings.Priority = static_cast<int32_t>(index % 4);
+				mixer.Play(index + 1, clip, settings);
+			}
+
+			std::vector<float> left(blockFrames);
+			std::vector<float> right(blockFrames);
+			runner.Run("Audio mix per voice", voiceCount, [&]()
+				{
+					mixer.Mix(left.data(), right.data(), blockFrames);
+				});
+		}
+	}
+}//namespace Benchmarks
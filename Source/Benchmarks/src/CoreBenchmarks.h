@@ -0,0 +1,9 @@
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Benchmarks
+{
+	//The job system and ECS iteration over a scene.
+	void RunCoreBenchmarks(BenchmarkRunner& runner);
+}//namespace Benchmarks
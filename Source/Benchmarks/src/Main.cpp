@@ -0,0 +1,69 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "AssetBenchmarks.h"
+#include "Benchmark.h"
+#include "CoreBenchmarks.h"
+#include "MathBenchmarks.h"
+#include "RendererBenchmarks.h"
+
+//Micro-benchmarks of engine hot paths on this machine. Build in Release, timings are per processed item.
+//
+//  --filter <text>       Only run benchmarks whose name contains the text
+//  --json <path>         Write the results, e.g. to record a baseline
+//  --baseline <path>     Compare against results written by --json earlier and fail on regressions
+//  --threshold <percent> How much slower than the baseline counts as a regression, 5 by default
+//
+//Baselines only mean something on the machine and build they were recorded with, so keep one per machine.
+int main(int argc, char** argv)
+{
+	std::string filter;
+	std::string jsonPath;
+	std::string baselinePath;
+	double threshold = 5.0;
+
+	for (int index = 1; index < argc; index++)
+	{
+		const bool hasValue = index + 1 < argc;
+		if (std::strcmp(argv[index], "--filter") == 0 && hasValue) filter = argv[++index];
+		else if (std::strcmp(argv[index], "--json") == 0 && hasValue) jsonPath = argv[++index];
+		else if (std::strcmp(argv[index], "--baseline") == 0 && hasValue) baselinePath = argv[++index];
+		else if (std::strcmp(argv[index], "--threshold") == 0 && hasValue) threshold = std::atof(argv[++index]);
+		else
+		{
+			std::cout << "Usage: Benchmarks [--filter <text>] [--json <path>] [--baseline <path>] [--threshold <percent>]\n";
+			return 1;
+		}
+	}
+
+	Benchmarks::BenchmarkRunner runner(filter);
+
+	std::cout << "Math\n";
+	Benchmarks::RunMathBenchmarks(runner);
+
+	std::cout << "\nRenderer\n";
+	Benchmarks::RunRendererBenchmarks(runner);
+
+	std::cout << "\nCore\n";
+	Benchmarks::RunCoreBenchmarks(runner);
+
+	std::cout << "\nAssets\n";
+	Benchmarks::RunAssetBenchmarks(runner);
+
+	if (!jsonPath.empty() && !runner.WriteJson(jsonPath))
+	{
+		return 1;
+	}
+
+	if (!baselinePath.empty())
+	{
+		if (!runner.CompareWithBaseline(baselinePath, threshold / 100.0))
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,157 @@
+#include "MathBenchmarks.h"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "Sengine/Math/SoAMath.h"
+
+namespace Benchmarks
+{
+	namespace
+	{
+		//Enough to leave the caches warm but still be more than a handful of iterations.
+		constexpr size_t ItemCount = 4096;
+		constexpr size_t LaneBlockCount = ItemCount / Sengine::Math::LaneCount;
+	}
+
+	void RunMathBenchmarks(BenchmarkRunner& runner)
+	{
+		using namespace Sengine::Math;
+
+#if GLM_CONFIG_SIMD == GLM_ENABLE
+		std::cout << "GLM intrinsics: on\n";
+#else
+		std::cout << "GLM intrinsics: off, generate with --glm-simd to enable them\n";
+#endif
+
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+		std::vector<glm::vec3> points(ItemCount);
+		std::vector<glm::vec3> velocities(ItemCount);
+		for (size_t index = 0; index < ItemCount; index++)
+		{
+			points[index] = { distribution(random), distribution(random), distribution(random) };
+			velocities[index] = { distribution(random), distribution(random), distribution(random) };
+		}
+
+		std::vector<Vec3x8> pointBlocks(LaneBlockCount);
+		std::vector<Vec3x8> velocityBlocks(LaneBlockCount);
+		for (size_t block = 0; block < LaneBlockCount; block++)
+		{
+			pointBlocks[block] = Vec3x8::Load(&points[block * LaneCount]);
+			velocityBlocks[block] = Vec3x8::Load(&velocities[block * LaneCount]);
+		}
+
+		const glm::mat4 transform = glm::rotate(glm::translate(glm::mat4(1.0f), { 1.0f, 2.0f, 3.0f }), 0.7f, { 0.0f, 1.0f, 0.0f });
+		constexpr float deltaTime = 1.0f / 60.0f;
+
+		//Particles, positions moved by their velocities.
+		{
+			std::vector<glm::vec3> scalarPoints = points;
+			const BenchmarkResult* scalar = runner.Run("Integrate vec3 (scalar)", ItemCount, [&]()
+				{
+					for (size_t index = 0; index < ItemCount; index++)
+					{
+						scalarPoints[index] += velocities[index] * deltaTime;
+					}
+					KeepAlive(scalarPoints[0]);
+				});
+
+			std::vector<Vec3x8> blocks = pointBlocks;
+			const BenchmarkResult* soa = runner.Run("Integrate Vec3x8 (SoA)", ItemCount, [&]()
+				{
+					for (size_t block = 0; block < LaneBlockCount; block++)
+					{
+						blocks[block] = MultiplyAdd(blocks[block], velocityBlocks[block], deltaTime);
+					}
+					KeepAlive(blocks[0]);
+				});
+			BenchmarkRunner::PrintSpeedup(scalar, soa);
+		}
+
+		//Culling, points moved into world space.
+		{
+			std::vector<glm::vec3> scalarOut(ItemCount);
+			const BenchmarkResult* scalar = runner.Run("Transform points (scalar)", ItemCount, [&]()
+				{
+					for (size_t index = 0; index < ItemCount; index++)
+					{
+						scalarOut[index] = glm::vec3(transform * glm::vec4(points[index], 1.0f));
+					}
+					KeepAlive(scalarOut[0]);
+				});
+
+			std::vector<Vec3x8> blockOut(LaneBlockCount);
+			const BenchmarkResult* soa = runner.Run("Transform points (SoA)", ItemCount, [&]()
+				{
+					for (size_t block = 0; block < LaneBlockCount; block++)
+					{
+						blockOut[block] = TransformPoints(transform, pointBlocks[block]);
+					}
+					KeepAlive(blockOut[0]);
+				});
+			BenchmarkRunner::PrintSpeedup(scalar, soa);
+		}
+
+		//Hierarchies, a parent transform applied to its children.
+		{
+			std::vector<glm::mat4> locals(ItemCount);
+			for (size_t index = 0; index < ItemCount; index++)
+			{
+				locals[index] = glm::translate(glm::mat4(1.0f), points[index]);
+			}
+
+			std::vector<glm::mat4> worlds(ItemCount);
+			const BenchmarkResult* scalar = runner.Run("Mat4 multiply (scalar)", ItemCount, [&]()
+				{
+					for (size_t index = 0; index < ItemCount; index++)
+					{
+						worlds[index] = transform * locals[index];
+					}
+					KeepAlive(worlds[0]);
+				});
+
+			const BenchmarkResult* batch = runner.Run("Mat4 multiply (batch)", ItemCount, [&]()
+				{
+					MultiplyBatch(transform, locals.data(), worlds.data(), ItemCount);
+					KeepAlive(worlds[0]);
+				});
+			BenchmarkRunner::PrintSpeedup(scalar, batch);
+		}
+
+		//Animation, blending between two poses.
+		{
+			std::vector<glm::quat> from(ItemCount);
+			std::vector<glm::quat> to(ItemCount);
+			std::vector<float> t(ItemCount);
+			for (size_t index = 0; index < ItemCount; index++)
+			{
+				from[index] = glm::normalize(glm::quat(distribution(random), distribution(random), distribution(random), distribution(random)));
+				to[index] = glm::normalize(glm::quat(distribution(random), distribution(random), distribution(random), distribution(random)));
+				t[index] = unit(random);
+			}
+
+			std::vector<glm::quat> blended(ItemCount);
+			const BenchmarkResult* scalar = runner.Run("Quaternion slerp (glm)", ItemCount, [&]()
+				{
+					for (size_t index = 0; index < ItemCount; index++)
+					{
+						blended[index] = glm::slerp(from[index], to[index], t[index]);
+					}
+					KeepAlive(blended[0]);
+				});
+
+			const BenchmarkResult* batch = runner.Run("Quaternion slerp (batch)", ItemCount, [&]()
+				{
+					SlerpBatch(from.data(), to.data(), t.data(), blended.data(), ItemCount);
+					KeepAlive(blended[0]);
+				});
+			BenchmarkRunner::PrintSpeedup(scalar, batch);
+		}
+	}
+}//namespace Benchmarks
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Benchmarks
+{
+	//Scalar glm against the engine's SoA and batched maths.
+	void RunMathBenchmarks(BenchmarkRunner& runner);
+}//namespace Benchmarks
@@ -0,0 +1,108 @@
+#include "RendererBenchmarks.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "Sengine/Render/2D/LightGrid2D.h"
+#include "Sengine/Render/2D/QuadBatch.h"
+#include "Sengine/Render/2D/SpriteAnimator.h"
+#include "Sengine/Render/RenderCommandQueue.h"
+
+namespace Benchmarks
+{
+	void RunRendererBenchmarks(BenchmarkRunner& runner)
+	{
+		using namespace Sengine;
+
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+		//A full batch of quads spread over a few textures, as a sprite heavy scene submits them.
+		{
+			constexpr uint32_t textureCount = 4;
+			std::vector<glm::mat4> transforms(Renderer2D::QuadBatch::MaxQuads);
+			for (glm::mat4& transform : transforms)
+			{
+				transform = glm::rotate(glm::translate(glm::mat4(1.0f), { distribution(random) * 10.0f, distribution(random) * 10.0f, 0.0f }), distribution(random), { 0.0f, 0.0f, 1.0f });
+			}
+
+			Renderer2D::QuadBatch batch;
+			batch.SetReservedTextures(1, 2);
+			runner.Run("Quad batch fill", transforms.size(), [&]()
+				{
+					batch.Clear();
+					for (uint32_t quad = 0; quad < transforms.size(); quad++)
+					{
+						const bool isAdded = batch.Add(transforms[quad], 3 + quad % textureCount, 2, { 0.0f, 0.0f, 1.0f, 1.0f }, glm::vec4(1.0f), static_cast<int>(quad));
+						KeepAlive(isAdded);
+					}
+				});
+		}
+
+		//A scene's worth of draws submitted in arbitrary order and sorted into draw order.
+		{
+			constexpr uint32_t commandCount = 100000;
+			std::vector<uint64_t> keys(commandCount);
+			for (uint64_t& key : keys)
+			{
+				const RenderLayer layer = distribution(random) > 0.8f ? RenderLayer::Transparent : RenderLayer::Opaque;
+				key = RenderCommandQueue::MakeKey(layer, (distribution(random) + 1.0f) * 500.0f, static_cast<uint32_t>(random() % 256));
+			}
+
+			RenderCommandQueue queue;
+			runner.Run("Command queue submit and sort", commandCount, [&]()
+				{
+					queue.Clear();
+					for (uint32_t index = 0; index < commandCount; index++)
+					{
+						queue.Submit(keys[index], index);
+					}
+					queue.Sort();
+					KeepAlive(queue.GetCommands().front());
+				});
+		}
+
+		//Lights binned into the tiles of a 1080p target.
+		{
+			constexpr uint32_t lightCount = 512;
+			std::vector<Renderer2D::PointLight2D> lights(lightCount);
+			for (Renderer2D::PointLight2D& light : lights)
+			{
+				light.Position = { distribution(random) * 16.0f, distribution(random) * 9.0f, 1.0f };
+				light.Radius = 0.5f + (distribution(random) + 1.0f);
+			}
+
+			const glm::mat4 viewProjection = glm::ortho(-16.0f, 16.0f, -9.0f, 9.0f);
+			Renderer2D::LightGrid2D grid;
+			runner.Run("Light grid build (1080p)", lightCount, [&]()
+				{
+					grid.Build(lights, viewProjection, 1920, 1080);
+					KeepAlive(grid.GetTiles().front());
+				});
+		}
+
+		//Flipbook playback of many sprites at different speeds.
+		{
+			constexpr uint32_t animationCount = 10000;
+			const auto atlas = std::make_shared<Renderer2D::SpriteAtlas>();
+			atlas->AddGrid(8, 8);
+
+			Renderer2D::SpriteAnimator animator(atlas);
+			const uint32_t looping = animator.AddClip({ { 0, 1, 2, 3, 4, 5, 6, 7 }, 12.0f, true });
+			const uint32_t once = animator.AddClip({ { 8, 9, 10, 11 }, 24.0f, false });
+			for (uint32_t index = 0; index < animationCount; index++)
+			{
+				static_cast<void>(animator.Create(index % 4 == 0 ? once : looping, 0.5f + (distribution(random) + 1.0f), 0.0f));
+			}
+
+			runner.Run("Sprite animator update", animationCount, [&]()
+				{
+					animator.Update(1.0f / 60.0f);
+					KeepAlive(animator.GetFrame(0));
+				});
+		}
+	}
+}//namespace Benchmarks
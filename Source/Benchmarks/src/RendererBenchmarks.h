@@ -0,0 +1,9 @@
+#pragma once
+
+#include "Benchmark.h"
+
+namespace Benchmarks
+{
+	//The CPU side of the renderers: the quad batch, command sorting, 2D light binning and sprite animation.
+	void RunRendererBenchmarks(BenchmarkRunner& runner);
+}//namespace Benchmarks
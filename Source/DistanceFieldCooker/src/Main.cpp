@@ -0,0 +1,46 @@
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include "Sengine/Spatial/DistanceField.h"
+#include "Sengine/Spatial/DistanceFieldBuilder.h"
+
+//Cooks the static geometry of a glTF scene into a distance field the engine maps at runtime.
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		std::cout << "Usage: " << argv[0] << " <input.gltf> <output.sdf> [voxelSize]\n";
+		return 1;
+	}
+
+	const std::filesystem::path input = argv[1];
+	const std::filesystem::path output = argv[2];
+	const float voxelSize = argc > 3 ? std::stof(argv[3]) : 0.1f;
+
+	const auto start = std::chrono::steady_clock::now();
+
+	Sengine::DistanceFieldBuilder builder;
+	if (!builder.AddGltf(input) || !builder.Build(voxelSize, output))
+	{
+		return 1;
+	}
+
+	const float seconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+
+	Sengine::DistanceField field;
+	if (!field.Load(output))
+	{
+		return 1;
+	}
+
+	const Sengine::DistanceFieldHeader& header = *field.GetHeader();
+	const uint32_t cellCount = header.CellCount.x * header.CellCount.y * header.CellCount.z;
+	std::cout << "Triangles: " << builder.GetTriangleCount() << "\n";
+	std::cout << "Cells: " << header.CellCount.x << "x" << header.CellCount.y << "x" << header.CellCount.z
+		<< ", " << header.BrickCount << " of " << cellCount << " hold bricks\n";
+	std::cout << "Size: " << std::filesystem::file_size(output) / 1024 << " KiB, cooked in " << seconds << "s\n";
+
+	return 0;
+}
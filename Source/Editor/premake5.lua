@@ -18,6 +18,10 @@ project "Sengine Editor"
 		"src",
 		"%{IncludeDir.SENGINE}",
         "%{IncludeDir.THIRDPARTY}",
+        "%{IncludeDir.GLAD}",
+        "%{IncludeDir.IMGUI}",
+        "%{IncludeDir.ENTT}",
+        "%{IncludeDir.GLM}",
 	}
 
 	links
@@ -38,6 +42,20 @@ project "Sengine Editor"
 			"{COPYDIR} %[Resources] %[%{cfg.targetdir}/Resources]"
 		}
 
+	filter "system:linux"
+		links
+		{
+			"GL",
+			"X11",
+			"pthread",
+			"dl",
+		}
+
+		postbuildcommands 
+		{
+			"{COPYDIR} %[Resources] %[%{cfg.targetdir}/Resources]"
+		}
+
 	filter "configurations:Debug"
         defines
         {
@@ -0,0 +1,305 @@
+#include "ThumbnailCache.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#include "Sengine/Core/JobSystem.h"
+
+#include "stb_image/stb_image.h"
+
+namespace SengineEditor
+{
+	namespace
+	{
+		constexpr uint32_t ThumbnailCacheMagic = 0x48544553; //"SETH"
+		constexpr size_t ThumbnailByteSize = ThumbnailCache::ThumbnailSize * ThumbnailCache::ThumbnailSize * 4;
+
+		uint64_t HashBytes(const std::vector<uint8_t>& bytes)
+		{
+			//FNV-1a, good enough to key a local cache.
+			uint64_t hash = 14695981039346656037ull;
+			for (const uint8_t byte : bytes)
+			{
+				hash ^= byte;
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		bool ReadFile(const std::filesystem::path& path, std::vector<uint8_t>& bytes)
+		{
+			std::ifstream file(path, std::ios::binary);
+			if (!file.is_open()) return false;
+
+			bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+			return true;
+		}
+
+		bool ReadCachedThumbnail(const std::filesystem::path& path, std::vector<uint8_t>& pixels)
+		{
+			std::ifstream file(path, std::ios::binary);
+			if (!file.is_open()) return false;
+
+			uint32_t magic = 0;
+			file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+			if (magic != ThumbnailCacheMagic) return false;
+
+			pixels.resize(ThumbnailByteSize);
+			file.read(reinterpret_cast<char*>(pixels.data()), static_cast<std::streamsize>(pixels.size()));
+			return file.gcount() == static_cast<std::streamsize>(pixels.size());
+		}
+
+		void WriteCachedThumbnail(const std::filesystem::path& path, const std::vector<uint8_t>& pixels)
+		{
+			std::error_code error;
+			std::filesystem::create_directories(path.parent_path(), error);
+
+			//Write to a temporary file first so a concurrent reader never sees half a thumbnail.
+			std::filesystem::path temporaryPath = path;
+			temporaryPath += ".tmp";
+			{
+				std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+				if (!file.is_open()) return;
+
+				file.write(reinterpret_cast<const char*>(&ThumbnailCacheMagic), sizeof(ThumbnailCacheMagic));
+				file.write(reinterpret_cast<const char*>(pixels.data()), static_cast<std::streamsize>(pixels.size()));
+			}
+			std::filesystem::rename(temporaryPath, path, error);
+		}
+
+		//Box filters the source image down so it fits the thumbnail, centred on a transparent background.
+		void Downscale(const uint8_t* source, int sourceWidth, int sourceHeight, std::vector<uint8_t>& pixels)
+		{
+			constexpr int size = static_cast<int>(ThumbnailCache::ThumbnailSize);
+
+			const float scale = std::min(1.0f, std::min(static_cast<float>(size) / sourceWidth, static_cast<float>(size) / sourceHeight));
+			const int width = std::max(1, static_cast<int>(sourceWidth * scale));
+			const int height = std::max(1, static_cast<int>(sourceHeight * scale));
+			const int offsetX = (size - width) / 2;
+			const int offsetY = (size - height) / 2;
+
+			pixels.assign(ThumbnailByteSize, 0);
+
+			for (int y = 0; y < height; y++)
+			{
+				const int sourceY0 = y * sourceHeight / height;
+				const int sourceY1 = std::max(sourceY0 + 1, (y + 1) * sourceHeight / height);
+
+				for (int x = 0; x < width; x++)
+				{
+					const int sourceX0 = x * sourceWidth / width;
+					const int sourceX1 = std::max(sourceX0 + 1, (x + 1) * sourceWidth / width);
+
+					std::array<uint32_t, 4> sum = {};
+					for (int sy = sourceY0; sy < sourceY1; sy++)
+					{
+						const uint8_t* row = source + (static_cast<size_t>(sy) * sourceWidth + sourceX0) * 4;
+						for (int sx = sourceX0; sx < sourceX1; sx++, row += 4)
+						{
+							sum[0] += row[0];
+							sum[1] += row[1];
+							sum[2] += row[2];
+							sum[3] += row[3];
+						}
+					}
+
+					const uint32_t count = static_cast<uint32_t>((sourceX1 - sourceX0) * (sourceY1 - sourceY0));
+					uint8_t* destination = pixels.data() + (static_cast<size_t>(y + offsetY) * size + (x + offsetX)) * 4;
+					for (int channel = 0; channel < 4; channel++)
+					{
+						destination[channel] = static_cast<uint8_t>(sum[channel] / count);
+					}
+				}
+			}
+		}
+	}
+
+	ThumbnailCache::ThumbnailCache(std::filesystem::path cacheDirectory)
+		: m_CacheDirectory(std::move(cacheDirectory)),
+		m_Atlas(std::make_unique<Sengine::Texture2D>(AtlasSize, AtlasSize)),
+		m_SlotOwners(SlotCount),
+		m_SharedState(std::make_shared<SharedState>())
+	{
+		m_FreeSlots.reserve(SlotCount);
+		for (uint32_t slot = SlotCount; slot > 0; slot--)
+		{
+			m_FreeSlots.push_back(slot - 1);
+		}
+	}
+
+	bool ThumbnailCache::Get(const std::filesystem::path& path, ThumbnailRegion& region)
+	{
+		std::string key = path.generic_string();
+
+		const auto it = m_Thumbnails.find(key);
+		if (it == m_Thumbnails.end())
+		{
+			Thumbnail thumbnail;
+			thumbnail.LastUsedFrame = m_FrameIndex;
+			m_Thumbnails.emplace(key, thumbnail);
+			m_Requests.push_back(std::move(key));
+			return false;
+		}
+
+		Thumbnail& thumbnail = it->second;
+		thumbnail.LastUsedFrame = m_FrameIndex;
+
+		if (thumbnail.State != ThumbnailState::Resident) return false;
+
+		region = GetSlotRegion(thumbnail.Slot);
+		return true;
+	}
+
+	void ThumbnailCache::Update()
+	{
+		m_FrameIndex++;
+
+		//Dispatch requests, dropping the ones that scrolled out of view before a job picked them up.
+		while (m_JobsInFlight < MaxJobsInFlight && !m_Requests.empty())
+		{
+			std::string key = std::move(m_Requests.front());
+			m_Requests.pop_front();
+
+			const auto it = m_Thumbnails.find(key);
+			if (it == m_Thumbnails.end() || it->second.State != ThumbnailState::Requested) continue;
+
+			if (it->second.LastUsedFrame + 2 < m_FrameIndex)
+			{
+				m_Thumbnails.erase(it);
+				continue;
+			}
+
+			it->second.State = ThumbnailState::Loading;
+			m_JobsInFlight++;
+
+			Sengine::JobSystem::Submit([sharedState = m_SharedState, cacheDirectory = m_CacheDirectory, key = std::move(key)]()
+				{
+					DecodedThumbnail decoded;
+					GenerateThumbnail(key, cacheDirectory, decoded.Pixels);
+					decoded.Key = key;
+
+					std::lock_guard<std::mutex> lock(sharedState->Mutex);
+					sharedState->Completed.push_back(std::move(decoded));
+				});
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_SharedState->Mutex);
+			m_JobsInFlight -= static_cast<uint32_t>(m_SharedState->Completed.size());
+			std::move(m_SharedState->Completed.begin(), m_SharedState->Completed.end(), std::back_inserter(m_PendingUploads));
+			m_SharedState->Completed.clear();
+		}
+
+		//Uploads are spread over frames so a burst of finished jobs never causes a hitch.
+		for (uint32_t uploads = 0; uploads < MaxUploadsPerFrame && !m_PendingUploads.empty();)
+		{
+			DecodedThumbnail& decoded = m_PendingUploads.front();
+
+			const auto it = m_Thumbnails.find(decoded.Key);
+			if (it == m_Thumbnails.end())
+			{
+				m_PendingUploads.pop_front();
+				continue;
+			}
+
+			if (decoded.Pixels.empty())
+			{
+				it->second.State = ThumbnailState::Failed;
+				m_PendingUploads.pop_front();
+				continue;
+			}
+
+			uint32_t slot = 0;
+			if (!AllocateSlot(slot)) break;
+
+			const uint32_t x = (slot % SlotsPerRow) * ThumbnailSize;
+			const uint32_t y = (slot / SlotsPerRow) * ThumbnailSize;
+			m_Atlas->SetData(x, y, ThumbnailSize, ThumbnailSize, decoded.Pixels.data());
+
+			it->second.State = ThumbnailState::Resident;
+			it->second.Slot = slot;
+			m_SlotOwners[slot] = std::move(decoded.Key);
+
+			m_PendingUploads.pop_front();
+			uploads++;
+		}
+	}
+
+	bool ThumbnailCache::IsSupportedImage(const std::filesystem::path& path)
+	{
+		std::string extension = path.extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+
+		return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga"
+			|| extension == ".bmp" || extension == ".psd" || extension == ".gif" || extension == ".hdr";
+	}
+
+	void ThumbnailCache::GenerateThumbnail(const std::filesystem::path& path, const std::filesystem::path& cacheDirectory, std::vector<uint8_t>& pixels)
+	{
+		std::vector<uint8_t> bytes;
+		if (!ReadFile(path, bytes) || bytes.empty()) return;
+
+		char hashName[32];
+		std::snprintf(hashName, sizeof(hashName), "%016llx.thumb", static_cast<unsigned long long>(HashBytes(bytes)));
+		const std::filesystem::path cachePath = cacheDirectory / hashName;
+
+		if (ReadCachedThumbnail(cachePath, pixels)) return;
+
+		int width = 0, height = 0, channels = 0;
+		stbi_uc* source = stbi_load_from_memory(bytes.data(), static_cast<int>(bytes.size()), &width, &height, &channels, 4);
+		if (!source)
+		{
+			pixels.clear();
+			return;
+		}
+
+		Downscale(source, width, height, pixels);
+		stbi_image_free(source);
+
+		WriteCachedThumbnail(cachePath, pixels);
+	}
+
+	bool ThumbnailCache::AllocateSlot(uint32_t& slot)
+	{
+		if (!m_FreeSlots.empty())
+		{
+			slot = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+			return true;
+		}
+
+		//Evict the least recently used thumbnail, unless everything in the atlas is still on screen.
+		uint64_t oldestFrame = m_FrameIndex;
+		for (uint32_t i = 0; i < SlotCount; i++)
+		{
+			const Thumbnail& thumbnail = m_Thumbnails.at(m_SlotOwners[i]);
+			if (thumbnail.LastUsedFrame < oldestFrame)
+			{
+				oldestFrame = thumbnail.LastUsedFrame;
+				slot = i;
+			}
+		}
+
+		if (oldestFrame + 1 >= m_FrameIndex) return false;
+
+		m_Thumbnails.erase(m_SlotOwners[slot]);
+		m_SlotOwners[slot].clear();
+		return true;
+	}
+
+	ThumbnailRegion ThumbnailCache::GetSlotRegion(uint32_t slot) const
+	{
+		constexpr float slotSize = static_cast<float>(ThumbnailSize) / static_cast<float>(AtlasSize);
+
+		ThumbnailRegion region;
+		region.U0 = static_cast<float>(slot % SlotsPerRow) * slotSize;
+		region.V0 = static_cast<float>(slot / SlotsPerRow) * slotSize;
+		region.U1 = region.U0 + slotSize;
+		region.V1 = region.V0 + slotSize;
+		return region;
+	}
+}//namespace SengineEditor
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Sengine/Render/Texture.h"
+
+namespace SengineEditor
+{
+	//Normalised atlas coordinates of a resident thumbnail.
+	struct ThumbnailRegion
+	{
+		float U0 = 0.0f, V0 = 0.0f;
+		float U1 = 1.0f, V1 = 1.0f;
+	};
+
+	//Generates image thumbnails on the job system and packs them into a single atlas texture.
+	//Decoded thumbnails are written to disk keyed by a hash of the file contents, so an asset is only decoded once
+	//no matter how often it is browsed, renamed or moved.
+	class ThumbnailCache
+	{
+	public:
+		static constexpr uint32_t ThumbnailSize = 64;
+		static constexpr uint32_t AtlasSize = 2048;
+		static constexpr uint32_t SlotsPerRow = AtlasSize / ThumbnailSize;
+		static constexpr uint32_t SlotCount = SlotsPerRow * SlotsPerRow;
+
+		//How many decode jobs may be in flight, and how many finished thumbnails are uploaded each frame.
+		static constexpr uint32_t MaxJobsInFlight = 32;
+		static constexpr uint32_t MaxUploadsPerFrame = 32;
+
+		explicit ThumbnailCache(std::filesystem::path cacheDirectory);
+		~ThumbnailCache() = default;
+
+		//Returns true and fills the region if the thumbnail is resident. Otherwise the thumbnail is requested and false is returned.
+		[[nodiscard]] bool Get(const std::filesystem::path& path, ThumbnailRegion& region);
+
+		//Dispatches queued requests and uploads finished thumbnails. Call once per frame on the main thread.
+		void Update();
+
+		[[nodiscard]] uint32_t GetAtlasRendererID() const { return m_Atlas->GetRendererID(); }
+
+		[[nodiscard]] static bool IsSupportedImage(const std::filesystem::path& path);
+
+	private:
+		enum class ThumbnailState : uint8_t
+		{
+			Requested,
+			Loading,
+			Resident,
+			Failed,
+		};
+
+		struct Thumbnail
+		{
+			ThumbnailState State = ThumbnailState::Requested;
+			uint32_t Slot = 0;
+			uint64_t LastUsedFrame = 0;
+		};
+
+		struct DecodedThumbnail
+		{
+			std::string Key;
+			std::vector<uint8_t> Pixels; //Empty if the decode failed
+		};
+
+		//Shared with the jobs so results can be dropped safely if the cache is destroyed first.
+		struct SharedState
+		{
+			std::mutex Mutex;
+			std::vector<DecodedThumbnail> Completed;
+		};
+
+		static void GenerateThumbnail(const std::filesystem::path& path, const std::filesystem::path& cacheDirectory, std::vector<uint8_t>& pixels);
+
+		[[nodiscard]] bool AllocateSlot(uint32_t& slot);
+		[[nodiscard]] ThumbnailRegion GetSlotRegion(uint32_t slot) const;
+
+	private:
+		std::filesystem::path m_CacheDirectory;
+		std::unique_ptr<Sengine::Texture2D> m_Atlas;
+
+		std::unordered_map<std::string, Thumbnail> m_Thumbnails;
+		std::deque<std::string> m_Requests;
+		std::deque<DecodedThumbnail> m_PendingUploads;
+		std::vector<std::string> m_SlotOwners;
+		std::vector<uint32_t> m_FreeSlots;
+
+		std::shared_ptr<SharedState> m_SharedState;
+		uint32_t m_JobsInFlight = 0;
+		uint64_t m_FrameIndex = 0;
+	};
+}//namespace SengineEditor
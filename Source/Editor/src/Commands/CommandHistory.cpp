@@ -0,0 +1,188 @@
+#include "CommandHistory.h"
+
+namespace SengineEditor
+{
+	namespace
+	{
+		void WriteVarint(size_t value, std::vector<uint8_t>& output)
+		{
+			while (value >= 0x80)
+			{
+				output.push_back(static_cast<uint8_t>(value | 0x80));
+				value >>= 7;
+			}
+			output.push_back(static_cast<uint8_t>(value));
+		}
+
+		size_t ReadVarint(const std::vector<uint8_t>& input, size_t& offset)
+		{
+			size_t value = 0;
+			for (uint32_t shift = 0; offset < input.size(); shift += 7)
+			{
+				const uint8_t byte = input[offset++];
+				value |= static_cast<size_t>(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0) break;
+			}
+			return value;
+		}
+	}
+
+	CommandHistory::CommandHistory(size_t memoryBudget)
+		: m_MemoryBudget(memoryBudget)
+	{
+	}
+
+	void CommandHistory::SetContext(Sengine::Scene* scene)
+	{
+		m_Scene = scene;
+		m_Entries.clear();
+		m_Cursor = 0;
+		m_MemoryUsage = 0;
+		m_IsLastEntrySealed = true;
+	}
+
+	bool CommandHistory::Undo()
+	{
+		if (!m_Scene) return false;
+
+		//Entries whose entity has since been destroyed, or whose component was changed outside the history, are skipped
+		//rather than blocking the rest of the history.
+		while (m_Cursor > 0)
+		{
+			const Entry& entry = m_Entries[--m_Cursor];
+			if (entry.Apply(m_Scene->GetRegistry(), entry.Entity, entry.Delta, entry.AfterHash))
+			{
+				m_IsLastEntrySealed = true;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool CommandHistory::Redo()
+	{
+		if (!m_Scene) return false;
+
+		while (m_Cursor < m_Entries.size())
+		{
+			const Entry& entry = m_Entries[m_Cursor++];
+			if (entry.Apply(m_Scene->GetRegistry(), entry.Entity, entry.Delta, entry.BeforeHash))
+			{
+				m_IsLastEntrySealed = true;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void CommandHistory::Push(Entry entry, const uint8_t* xorBytes, size_t size, bool isMergeable)
+	{
+		//Anything that could be redone is invalidated by a new edit.
+		while (m_Entries.size() > m_Cursor)
+		{
+			m_MemoryUsage -= GetEntrySize(m_Entries.back());
+			m_Entries.pop_back();
+		}
+
+		const bool canMerge = isMergeable && !m_IsLastEntrySealed && !m_Entries.empty()
+			&& m_Entries.back().Entity == entry.Entity && m_Entries.back().ComponentType == entry.ComponentType;
+
+		m_IsLastEntrySealed = !isMergeable;
+
+		if (canMerge)
+		{
+			//(A ^ B) ^ (B ^ C) = A ^ C, so folding a new edit in is just XORing the deltas together.
+			Entry& last = m_Entries.back();
+			std::vector<uint8_t> merged(xorBytes, xorBytes + size);
+			DecodeInto(last.Delta, merged.data(), size);
+
+			m_MemoryUsage -= GetEntrySize(last);
+			last.AfterHash = entry.AfterHash;
+			last.Delta.clear();
+			Encode(merged.data(), size, last.Delta);
+			last.Delta.shrink_to_fit();
+
+			//The drag ended where it started, there is nothing left to undo.
+			if (last.Delta.empty())
+			{
+				m_Entries.pop_back();
+				m_IsLastEntrySealed = true;
+			}
+			else
+			{
+				m_MemoryUsage += GetEntrySize(last);
+			}
+
+			m_Cursor = m_Entries.size();
+			TrimToBudget();
+			return;
+		}
+
+		Encode(xorBytes, size, entry.Delta);
+		if (entry.Delta.empty()) return;
+
+		entry.Delta.shrink_to_fit();
+		m_MemoryUsage += GetEntrySize(entry);
+		m_Entries.push_back(std::move(entry));
+		m_Cursor = m_Entries.size();
+
+		TrimToBudget();
+	}
+
+	void CommandHistory::TrimToBudget()
+	{
+		//The oldest edits are dropped first. The newest entry is always kept.
+		while (m_MemoryUsage > m_MemoryBudget && m_Entries.size() > 1)
+		{
+			m_MemoryUsage -= GetEntrySize(m_Entries.front());
+			m_Entries.pop_front();
+			m_Cursor--;
+		}
+	}
+
+	void CommandHistory::Encode(const uint8_t* xorBytes, size_t size, std::vector<uint8_t>& encoded)
+	{
+		//Runs of [zero byte count][literal count][literal bytes]. Trailing zero bytes are not written.
+		size_t offset = 0;
+		while (offset < size)
+		{
+			const size_t zeroStart = offset;
+			while (offset < size && xorBytes[offset] == 0) offset++;
+			if (offset == size) break;
+
+			const size_t literalStart = offset;
+			while (offset < size && xorBytes[offset] != 0) offset++;
+
+			WriteVarint(literalStart - zeroStart, encoded);
+			WriteVarint(offset - literalStart, encoded);
+			encoded.insert(encoded.end(), xorBytes + literalStart, xorBytes + offset);
+		}
+	}
+
+	uint64_t CommandHistory::HashBytes(const uint8_t* bytes, size_t size)
+	{
+		//FNV-1a. Only compared against hashes of the same component type, so it needs no more than that.
+		uint64_t hash = 14695981039346656037ull;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash = (hash ^ bytes[i]) * 1099511628211ull;
+		}
+		return hash;
+	}
+
+	void CommandHistory::DecodeInto(const std::vector<uint8_t>& encoded, uint8_t* bytes, size_t size)
+	{
+		size_t position = 0;
+		size_t offset = 0;
+		while (offset < encoded.size())
+		{
+			position += ReadVarint(encoded, offset);
+			const size_t literalCount = ReadVarint(encoded, offset);
+
+			for (size_t i = 0; i < literalCount && position < size && offset < encoded.size(); i++)
+			{
+				bytes[position++] ^= encoded[offset++];
+			}
+		}
+	}
+}//namespace SengineEditor
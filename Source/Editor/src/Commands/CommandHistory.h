@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <type_traits>
+#include <vector>
+
+#include "Sengine/Scene/Scene.h"
+
+namespace SengineEditor
+{
+	//Undo/redo history of component edits.
+	//An edit is stored as the XOR of the component bytes before and after, run length encoded. Unchanged bytes XOR to zero,
+	//so a typical edit costs a handful of bytes, and applying the same delta again toggles between the two states.
+	//A delta only means something against the state it was recorded from, so each entry also keeps a hash of the state
+	//on either side and is skipped if the component has since been changed outside the history, e.g. by a script.
+	//Only trivially copyable components can be recorded, structural changes (create/destroy/re-parent) are not tracked.
+	class CommandHistory
+	{
+	public:
+		static constexpr size_t DefaultMemoryBudget = 8 * 1024 * 1024;
+
+		explicit CommandHistory(size_t memoryBudget = DefaultMemoryBudget);
+
+		//Clears the history, entries are only valid for the scene they were recorded in.
+		void SetContext(Sengine::Scene* scene);
+
+		//Records a change to a component. Mergeable edits to the same component of the same entity fold into the last entry
+		//until SealLastEntry is called, which is how a whole drag ends up as a single undo step.
+		template<typename Component>
+		void Record(entt::entity entity, const Component& before, const Component& after, bool isMergeable);
+
+		//Ends the current merge, the next edit starts a new entry.
+		void SealLastEntry() { m_IsLastEntrySealed = true; }
+
+		bool Undo();
+		bool Redo();
+
+		[[nodiscard]] bool GetCanUndo() const { return m_Cursor > 0; }
+		[[nodiscard]] bool GetCanRedo() const { return m_Cursor < m_Entries.size(); }
+
+		[[nodiscard]] size_t GetMemoryUsage() const { return m_MemoryUsage; }
+		[[nodiscard]] size_t GetEntryCount() const { return m_Entries.size(); }
+
+	private:
+		//XORs a decoded delta into the component. Returns false, changing nothing, if the entity or component no longer
+		//exists or the component's bytes no longer hash to the expected state.
+		using ApplyFunction = bool(*)(entt::registry& registry, entt::entity entity, const std::vector<uint8_t>& delta, uint64_t expectedHash);
+
+		struct Entry
+		{
+			entt::entity Entity = entt::null;
+			entt::id_type ComponentType = 0;
+			ApplyFunction Apply = nullptr;
+			std::vector<uint8_t> Delta; //Run length encoded XOR of the component bytes
+			uint64_t BeforeHash = 0; //What redo expects to find
+			uint64_t AfterHash = 0; //What undo expects to find
+		};
+
+		template<typename Component>
+		static bool ApplyDelta(entt::registry& registry, entt::entity entity, const std::vector<uint8_t>& delta, uint64_t expectedHash);
+
+		void Push(Entry entry, const uint8_t* xorBytes, size_t size, bool isMergeable);
+		void TrimToBudget();
+
+		[[nodiscard]] static size_t GetEntrySize(const Entry& entry) { return sizeof(Entry) + entry.Delta.capacity(); }
+
+		static void Encode(const uint8_t* xorBytes, size_t size, std::vector<uint8_t>& encoded);
+		static void DecodeInto(const std::vector<uint8_t>& encoded, uint8_t* bytes, size_t size);
+		[[nodiscard]] static uint64_t HashBytes(const uint8_t* bytes, size_t size);
+
+	private:
+		Sengine::Scene* m_Scene = nullptr;
+
+		std::deque<Entry> m_Entries;
+		size_t m_Cursor = 0; //Entries before the cursor can be undone, entries from it onwards redone
+		size_t m_MemoryBudget = 0;
+		size_t m_MemoryUsage = 0;
+		bool m_IsLastEntrySealed = true;
+	};
+
+	template<typename Component>
+	void CommandHistory::Record(entt::entity entity, const Component& before, const Component& after, bool isMergeable)
+	{
+		static_assert(std::is_trivially_copyable_v<Component>, "Only trivially copyable components can be recorded as byte deltas");
+
+		uint8_t xorBytes[sizeof(Component)];
+		const uint8_t* beforeBytes = reinterpret_cast<const uint8_t*>(&before);
+		const uint8_t* afterBytes = reinterpret_cast<const uint8_t*>(&after);
+		for (size_t i = 0; i < sizeof(Component); i++)
+		{
+			xorBytes[i] = static_cast<uint8_t>(beforeBytes[i] ^ afterBytes[i]);
+		}
+
+		Entry entry;
+		entry.Entity = entity;
+		entry.ComponentType = entt::type_hash<Component>::value();
+		entry.Apply = &CommandHistory::ApplyDelta<Component>;
+		entry.BeforeHash = HashBytes(beforeBytes, sizeof(Component));
+		entry.AfterHash = HashBytes(afterBytes, sizeof(Component));
+
+		Push(std::move(entry), xorBytes, sizeof(Component), isMergeable);
+	}
+
+	template<typename Component>
+	bool CommandHistory::ApplyDelta(entt::registry& registry, entt::entity entity, const std::vector<uint8_t>& delta, uint64_t expectedHash)
+	{
+		if (!registry.valid(entity) || !registry.all_of<Component>(entity)) return false;
+
+		//XORed into anything else, the delta would turn the component into garbage.
+		const Component& current = registry.get<Component>(entity);
+		if (HashBytes(reinterpret_cast<const uint8_t*>(&current), sizeof(Component)) != expectedHash) return false;
+
+		registry.patch<Component>(entity, [&delta](Component& component)
+			{
+				uint8_t bytes[sizeof(Component)];
+				std::memcpy(bytes, &component, sizeof(Component));
+				DecodeInto(delta, bytes, sizeof(Component));
+				std::memcpy(&component, bytes, sizeof(Component));
+			});
+		return true;
+	}
+}//namespace SengineEditor
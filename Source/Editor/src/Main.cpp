@@ -2,6 +2,14 @@
 #include "Sengine/Sengine.h"
 #include "Sengine/Render/Renderer.h"
 
+#include "Commands/CommandHistory.h"
+#include "Panels/AssetBrowserPanel.h"
+#include "Panels/InspectorPanel.h"
+#include "Panels/SceneHierarchyPanel.h"
+#include "Panels/ViewportPanel.h"
+
+#include "imgui/imgui.h"
+
 namespace SengineEditor
 {
 	using namespace Sengine;
@@ -16,11 +24,23 @@ namespace SengineEditor
 		[[nodiscard]] virtual bool OnEarlyInit() override;
 		[[nodiscard]] virtual bool OnInit() override;
 		virtual void OnTick() override;
+		virtual void OnImGuiRender() override;
 		virtual void OnDestroy() override;
 		virtual void OnLateDestroy() override;
 
+	private:
+		void DrawMenuBar();
+
 	private:
 		WindowDescription m_WindowDescription;
+
+		std::unique_ptr<Scene> m_Scene;
+		CommandHistory m_CommandHistory;
+
+		std::unique_ptr<AssetBrowserPanel> m_AssetBrowserPanel;
+		std::unique_ptr<SceneHierarchyPanel> m_SceneHierarchyPanel;
+		InspectorPanel m_InspectorPanel;
+		std::unique_ptr<ViewportPanel> m_ViewportPanel;
 	};
 
 	WindowDescription& Editor::GetWindowDescription()
@@ -37,6 +57,18 @@ namespace SengineEditor
 	}
 	bool Editor::OnInit()
 	{
+		m_Scene = std::make_unique<Scene>();
+
+		m_AssetBrowserPanel = std::make_unique<AssetBrowserPanel>("Resources", "Cache/Thumbnails");
+
+		m_SceneHierarchyPanel = std::make_unique<SceneHierarchyPanel>();
+		m_SceneHierarchyPanel->SetContext(m_Scene.get());
+		m_CommandHistory.SetContext(m_Scene.get());
+		m_InspectorPanel.SetContext(m_Scene.get(), &m_CommandHistory);
+
+		m_ViewportPanel = std::make_unique<ViewportPanel>();
+		m_ViewportPanel->SetContext(m_Scene.get());
+
 		return true;
 	}
 	void Editor::OnTick()
@@ -44,14 +76,65 @@ namespace SengineEditor
 		glClear(GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
 		glClearColor(0.25f, 0.6f, 0.75f, 1.0f);
 
-		Renderer::BeginRender2D({});
+		m_ViewportPanel->OnRender();
+	}
+	void Editor::OnImGuiRender()
+	{
+		DrawMenuBar();
+
+		ImGui::DockSpaceOverViewport(ImGui::GetMainViewport(), ImGuiDockNodeFlags_PassthruCentralNode);
+
+		m_AssetBrowserPanel->OnImGuiRender();
+		m_SceneHierarchyPanel->OnImGuiRender();
+		m_ViewportPanel->OnImGuiRender();
+
+		entt::entity pickedEntity = entt::null;
+		if (m_ViewportPanel->GetPickedEntity(pickedEntity))
+		{
+			m_SceneHierarchyPanel->SetSelectedEntity(m_Scene->GetRegistry().valid(pickedEntity) ? pickedEntity : entt::null);
+		}
+
+		m_InspectorPanel.OnImGuiRender(m_SceneHierarchyPanel->GetSelectedEntity());
+	}
+	void Editor::DrawMenuBar()
+	{
+		//A focused text field handles its own undo, the shortcuts would otherwise undo scene edits behind it.
+		const ImGuiIO& io = ImGui::GetIO();
+		if (io.KeyCtrl && !io.WantTextInput)
+		{
+			if (ImGui::IsKeyPressed(ImGuiKey_Z, false)) m_CommandHistory.Undo();
+			if (ImGui::IsKeyPressed(ImGuiKey_Y, false)) m_CommandHistory.Redo();
+		}
+
+		if (!ImGui::BeginMainMenuBar()) return;
+
+		if (ImGui::BeginMenu("Edit"))
+		{
+			if (ImGui::MenuItem("Undo", "Ctrl+Z", false, m_CommandHistory.GetCanUndo())) m_CommandHistory.Undo();
+			if (ImGui::MenuItem("Redo", "Ctrl+Y", false, m_CommandHistory.GetCanRedo())) m_CommandHistory.Redo();
+
+			ImGui::Separator();
+			ImGui::TextDisabled("History: %zu entries, %.1f KB", m_CommandHistory.GetEntryCount(), m_CommandHistory.GetMemoryUsage() / 1024.0f);
+
+			ImGui::EndMenu();
+		}
+
+		if (ImGui::BeginMenu("Render"))
+		{
+			//Replay it with FrameReplay to time the renderer on its own.
+			if (ImGui::MenuItem("Capture Frame")) Renderer::CaptureFrame("Frame.secapture");
 
-		Renderer::Draw2D();
+			ImGui::EndMenu();
+		}
 
-		Renderer::EndRender2D();
+		ImGui::EndMainMenuBar();
 	}
 	void Editor::OnDestroy()
 	{
+		m_AssetBrowserPanel.reset();
+		m_SceneHierarchyPanel.reset();
+		m_ViewportPanel.reset();
+		m_Scene.reset();
 	}
 	void Editor::OnLateDestroy()
 	{
@@ -0,0 +1,229 @@
+#include "AssetBrowserPanel.h"
+
+#include <algorithm>
+#include <cctype>
+
+#include "Sengine/Core/JobSystem.h"
+
+#include "imgui/imgui.h"
+
+namespace SengineEditor
+{
+	namespace
+	{
+		std::string ToLower(std::string value)
+		{
+			std::transform(value.begin(), value.end(), value.begin(), [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+			return value;
+		}
+	}
+
+	AssetBrowserPanel::AssetBrowserPanel(std::filesystem::path rootDirectory, std::filesystem::path cacheDirectory)
+		: m_RootDirectory(std::move(rootDirectory)),
+		m_ThumbnailCache(std::move(cacheDirectory)),
+		m_Listing(std::make_shared<DirectoryListing>())
+	{
+		NavigateTo(m_RootDirectory);
+	}
+
+	void AssetBrowserPanel::OnImGuiRender()
+	{
+		if (m_IsListing)
+		{
+			std::lock_guard<std::mutex> lock(m_Listing->Mutex);
+			if (m_Listing->IsReady && m_Listing->Generation == m_ListingGeneration)
+			{
+				m_Entries = std::move(m_Listing->Entries);
+				m_Listing->Entries.clear();
+				m_Listing->IsReady = false;
+				m_IsListing = false;
+
+				RebuildFilter();
+			}
+		}
+
+		m_ThumbnailCache.Update();
+
+		ImGui::Begin("Asset Browser");
+
+		DrawToolbar();
+		ImGui::Separator();
+		DrawGrid();
+
+		ImGui::End();
+	}
+
+	void AssetBrowserPanel::NavigateTo(const std::filesystem::path& directory)
+	{
+		m_CurrentDirectory = directory;
+		m_Entries.clear();
+		m_VisibleEntries.clear();
+		m_IsListing = true;
+
+		//Listing a large folder takes longer than a frame, so it is done on a worker.
+		//Only the most recent request is kept if the user navigates again before it finishes.
+		const uint64_t generation = ++m_ListingGeneration;
+		Sengine::JobSystem::Submit([listing = m_Listing, directory, generation]()
+			{
+				std::vector<AssetEntry> entries;
+
+				std::error_code error;
+				for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+				{
+					AssetEntry entry;
+					entry.Path = it->path();
+					entry.Name = entry.Path.filename().string();
+					entry.IsDirectory = it->is_directory(error);
+					entries.push_back(std::move(entry));
+				}
+
+				std::sort(entries.begin(), entries.end(), [](const AssetEntry& a, const AssetEntry& b)
+					{
+						if (a.IsDirectory != b.IsDirectory) return a.IsDirectory;
+						return ToLower(a.Name) < ToLower(b.Name);
+					});
+
+				std::lock_guard<std::mutex> lock(listing->Mutex);
+				if (generation > listing->Generation)
+				{
+					listing->Generation = generation;
+					listing->Entries = std::move(entries);
+					listing->IsReady = true;
+				}
+			});
+	}
+
+	void AssetBrowserPanel::RebuildFilter()
+	{
+		m_VisibleEntries.clear();
+		m_VisibleEntries.reserve(m_Entries.size());
+
+		const std::string filter = ToLower(m_Filter);
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_Entries.size()); i++)
+		{
+			if (filter.empty() || ToLower(m_Entries[i].Name).find(filter) != std::string::npos)
+			{
+				m_VisibleEntries.push_back(i);
+			}
+		}
+	}
+
+	void AssetBrowserPanel::DrawToolbar()
+	{
+		ImGui::BeginDisabled(m_CurrentDirectory == m_RootDirectory);
+		if (ImGui::Button("Back"))
+		{
+			NavigateTo(m_CurrentDirectory.parent_path());
+		}
+		ImGui::EndDisabled();
+
+		ImGui::SameLine();
+		if (ImGui::Button("Refresh"))
+		{
+			NavigateTo(m_CurrentDirectory);
+		}
+
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(200.0f);
+		if (ImGui::InputTextWithHint("##Filter", "Filter", m_Filter, sizeof(m_Filter)))
+		{
+			RebuildFilter();
+		}
+
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(120.0f);
+		ImGui::SliderFloat("##CellSize", &m_CellSize, 48.0f, 160.0f, "%.0f px");
+
+		ImGui::SameLine();
+		const std::string relativePath = std::filesystem::relative(m_CurrentDirectory, m_RootDirectory.parent_path()).generic_string();
+		ImGui::TextDisabled("%s (%zu items)", relativePath.c_str(), m_VisibleEntries.size());
+	}
+
+	void AssetBrowserPanel::DrawGrid()
+	{
+		ImGui::BeginChild("AssetGrid");
+
+		if (m_IsListing)
+		{
+			ImGui::TextDisabled("Loading...");
+			ImGui::EndChild();
+			return;
+		}
+
+		const ImGuiStyle& style = ImGui::GetStyle();
+		const float cellWidth = m_CellSize + style.ItemSpacing.x;
+		const float rowHeight = m_CellSize + ImGui::GetTextLineHeight() + style.ItemSpacing.y * 2.0f;
+
+		const int columns = std::max(1, static_cast<int>(ImGui::GetContentRegionAvail().x / cellWidth));
+		const int rows = (static_cast<int>(m_VisibleEntries.size()) + columns - 1) / columns;
+
+		const ImTextureID atlas = reinterpret_cast<ImTextureID>(static_cast<uintptr_t>(m_ThumbnailCache.GetAtlasRendererID()));
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+		std::filesystem::path openedDirectory;
+
+		//Rows are a fixed height so the clipper can skip everything that is off screen without laying it out.
+		ImGuiListClipper clipper;
+		clipper.Begin(rows, rowHeight);
+		while (clipper.Step())
+		{
+			for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+			{
+				const ImVec2 rowStart = ImGui::GetCursorScreenPos();
+
+				for (int column = 0; column < columns; column++)
+				{
+					const size_t visibleIndex = static_cast<size_t>(row) * columns + column;
+					if (visibleIndex >= m_VisibleEntries.size()) break;
+
+					const AssetEntry& entry = m_Entries[m_VisibleEntries[visibleIndex]];
+					const ImVec2 cellStart(rowStart.x + column * cellWidth, rowStart.y);
+
+					ImGui::PushID(static_cast<int>(m_VisibleEntries[visibleIndex]));
+					ImGui::SetCursorScreenPos(cellStart);
+
+					ThumbnailRegion region;
+					if (!entry.IsDirectory && ThumbnailCache::IsSupportedImage(entry.Path) && m_ThumbnailCache.Get(entry.Path, region))
+					{
+						const ImVec2 imageSize(m_CellSize - style.FramePadding.x * 2.0f, m_CellSize - style.FramePadding.y * 2.0f);
+						ImGui::ImageButton("##Thumbnail", atlas, imageSize,
+							ImVec2(region.U0, region.V0), ImVec2(region.U1, region.V1));
+					}
+					else
+					{
+						ImGui::Button(entry.IsDirectory ? "Folder" : entry.Path.extension().string().c_str(), ImVec2(m_CellSize, m_CellSize));
+					}
+
+					if (entry.IsDirectory && ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
+					{
+						openedDirectory = entry.Path;
+					}
+
+					if (ImGui::IsItemHovered())
+					{
+						ImGui::SetTooltip("%s", entry.Name.c_str());
+					}
+
+					//The label is clipped to the cell rather than laid out, which keeps the grid columns fixed.
+					const ImVec2 labelStart(cellStart.x, cellStart.y + m_CellSize + style.ItemSpacing.y);
+					const ImVec4 labelClip(labelStart.x, labelStart.y, labelStart.x + m_CellSize, labelStart.y + ImGui::GetTextLineHeight());
+					drawList->AddText(ImGui::GetFont(), ImGui::GetFontSize(), labelStart, ImGui::GetColorU32(ImGuiCol_Text),
+						entry.Name.c_str(), entry.Name.c_str() + entry.Name.size(), 0.0f, &labelClip);
+
+					ImGui::PopID();
+				}
+
+				ImGui::SetCursorScreenPos(rowStart);
+				ImGui::Dummy(ImVec2(columns * cellWidth, rowHeight - style.ItemSpacing.y));
+			}
+		}
+		clipper.End();
+
+		ImGui::EndChild();
+
+		if (!openedDirectory.empty())
+		{
+			NavigateTo(openedDirectory);
+		}
+	}
+}//namespace SengineEditor
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Assets/ThumbnailCache.h"
+
+namespace SengineEditor
+{
+	//Grid view of an asset directory. Only the rows that are on screen are laid out, and directory listings
+	//and thumbnails are produced on the job system, so the cost per frame does not grow with the folder size.
+	class AssetBrowserPanel
+	{
+	public:
+		AssetBrowserPanel(std::filesystem::path rootDirectory, std::filesystem::path cacheDirectory);
+
+		void OnImGuiRender();
+
+	private:
+		struct AssetEntry
+		{
+			std::filesystem::path Path;
+			std::string Name;
+			bool IsDirectory = false;
+		};
+
+		//Written by the listing job and picked up by the panel on the main thread.
+		struct DirectoryListing
+		{
+			std::mutex Mutex;
+			uint64_t Generation = 0;
+			bool IsReady = false;
+			std::vector<AssetEntry> Entries;
+		};
+
+		void NavigateTo(const std::filesystem::path& directory);
+		void RebuildFilter();
+
+		void DrawToolbar();
+		void DrawGrid();
+
+	private:
+		std::filesystem::path m_RootDirectory;
+		std::filesystem::path m_CurrentDirectory;
+
+		ThumbnailCache m_ThumbnailCache;
+
+		std::shared_ptr<DirectoryListing> m_Listing;
+		uint64_t m_ListingGeneration = 0;
+		bool m_IsListing = false;
+
+		std::vector<AssetEntry> m_Entries;
+		std::vector<uint32_t> m_VisibleEntries; //Indices into m_Entries that pass the filter
+		char m_Filter[128] = {};
+
+		float m_CellSize = 96.0f;
+	};
+}//namespace SengineEditor
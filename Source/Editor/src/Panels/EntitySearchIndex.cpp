@@ -0,0 +1,205 @@
+#include "EntitySearchIndex.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace SengineEditor
+{
+	namespace
+	{
+		//How many names are compared between checks for a newer query.
+		constexpr size_t SearchCancelInterval = 65536;
+
+		std::string ToLower(std::string value)
+		{
+			std::transform(value.begin(), value.end(), value.begin(), [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+			return value;
+		}
+	}
+
+	EntitySearchIndex::EntitySearchIndex()
+		: m_Worker(&EntitySearchIndex::WorkerLoop, this)
+	{
+	}
+
+	EntitySearchIndex::~EntitySearchIndex()
+	{
+		SetScene(nullptr);
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_IsRunning = false;
+		}
+		m_Condition.notify_one();
+
+		m_Worker.join();
+	}
+
+	void EntitySearchIndex::SetScene(Sengine::Scene* scene)
+	{
+		if (m_Scene)
+		{
+			entt::registry& registry = m_Scene->GetRegistry();
+			registry.on_construct<Sengine::TagComponent>().disconnect(this);
+			registry.on_update<Sengine::TagComponent>().disconnect(this);
+			registry.on_destroy<Sengine::TagComponent>().disconnect(this);
+		}
+
+		m_Scene = scene;
+		m_PendingChanges.clear();
+		m_SeedCursor = 0;
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Inbox.clear();
+			m_ClearIndex = true;
+		}
+		m_Condition.notify_one();
+
+		if (!m_Scene) return;
+
+		entt::registry& registry = m_Scene->GetRegistry();
+		registry.on_construct<Sengine::TagComponent>().connect<&EntitySearchIndex::OnTagChanged>(*this);
+		registry.on_update<Sengine::TagComponent>().connect<&EntitySearchIndex::OnTagChanged>(*this);
+		registry.on_destroy<Sengine::TagComponent>().connect<&EntitySearchIndex::OnTagDestroyed>(*this);
+
+		m_SeedCursor = registry.storage<Sengine::TagComponent>().size();
+	}
+
+	void EntitySearchIndex::Update()
+	{
+		if (m_Scene && m_SeedCursor > 0)
+		{
+			//Seeding walks the packed storage backwards. Removals swap the last element into the hole,
+			//so an entity can only move to an index that is still ahead of the cursor or was already seeded.
+			auto& tags = m_Scene->GetRegistry().storage<Sengine::TagComponent>();
+			m_SeedCursor = std::min(m_SeedCursor, tags.size());
+
+			for (uint32_t seeded = 0; seeded < SeedEntitiesPerFrame && m_SeedCursor > 0; seeded++)
+			{
+				m_SeedCursor--;
+				const entt::entity entity = tags.data()[m_SeedCursor];
+				m_PendingChanges.push_back({ entity, tags.get(entity).Name, false });
+			}
+		}
+
+		if (!m_PendingChanges.empty())
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				std::move(m_PendingChanges.begin(), m_PendingChanges.end(), std::back_inserter(m_Inbox));
+			}
+			m_PendingChanges.clear();
+			m_Condition.notify_one();
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (m_PublishVersion != m_SeenPublishVersion)
+		{
+			m_Results.swap(m_PublishedResults);
+			m_ResultsGeneration = m_PublishedGeneration;
+			m_SeenPublishVersion = m_PublishVersion;
+		}
+	}
+
+	void EntitySearchIndex::SetQuery(const std::string& query)
+	{
+		std::string lowered = ToLower(query);
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (lowered == m_Query) return;
+
+			m_Query = std::move(lowered);
+			m_InboxQueryGeneration = ++m_QueryGeneration;
+		}
+		m_Condition.notify_one();
+	}
+
+	void EntitySearchIndex::OnTagChanged(entt::registry& registry, entt::entity entity)
+	{
+		m_PendingChanges.push_back({ entity, registry.get<Sengine::TagComponent>(entity).Name, false });
+	}
+
+	void EntitySearchIndex::OnTagDestroyed(entt::registry& /*registry*/, entt::entity entity)
+	{
+		m_PendingChanges.push_back({ entity, {}, true });
+	}
+
+	void EntitySearchIndex::WorkerLoop()
+	{
+		uint64_t searchedGeneration = 0;
+
+		while (true)
+		{
+			std::vector<NameChange> changes;
+			std::string query;
+			uint64_t generation = 0;
+			bool clearIndex = false;
+
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_Condition.wait(lock, [&]
+					{
+						return !m_IsRunning || m_ClearIndex || !m_Inbox.empty() || m_InboxQueryGeneration != searchedGeneration;
+					});
+
+				if (!m_IsRunning) return;
+
+				changes.swap(m_Inbox);
+				query = m_Query;
+				generation = m_InboxQueryGeneration;
+				clearIndex = m_ClearIndex;
+				m_ClearIndex = false;
+			}
+
+			if (clearIndex)
+			{
+				m_Names.clear();
+			}
+
+			for (NameChange& change : changes)
+			{
+				if (change.IsRemoved)
+				{
+					m_Names.erase(change.Entity);
+				}
+				else
+				{
+					m_Names[change.Entity] = ToLower(std::move(change.Name));
+				}
+			}
+
+			std::vector<entt::entity> results;
+			if (!query.empty() && !Search(query, generation, results)) continue;
+
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_PublishedResults = std::move(results);
+			m_PublishedGeneration = generation;
+			m_PublishVersion++;
+			searchedGeneration = generation;
+		}
+	}
+
+	bool EntitySearchIndex::Search(const std::string& query, uint64_t generation, std::vector<entt::entity>& results)
+	{
+		size_t compared = 0;
+		for (const auto& [entity, name] : m_Names)
+		{
+			if (name.find(query) != std::string::npos)
+			{
+				results.push_back(entity);
+			}
+
+			if (++compared % SearchCancelInterval == 0)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				if (m_InboxQueryGeneration != generation) return false;
+			}
+		}
+
+		//Hash map order is arbitrary, sort so results don't reshuffle between searches.
+		std::sort(results.begin(), results.end());
+		return true;
+	}
+}//namespace SengineEditor
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Sengine/Scene/Scene.h"
+
+namespace SengineEditor
+{
+	//Name index of a scene that is searched on a background thread.
+	//The main thread only copies names that changed, and existing entities are fed in a slice per frame,
+	//so opening a scene with millions of entities never stalls the editor.
+	class EntitySearchIndex
+	{
+	public:
+		//How many existing entities are handed to the index each frame while it is being seeded.
+		static constexpr uint32_t SeedEntitiesPerFrame = 16384;
+
+		EntitySearchIndex();
+		~EntitySearchIndex();
+
+		EntitySearchIndex(const EntitySearchIndex&) = delete;
+		EntitySearchIndex& operator=(const EntitySearchIndex&) = delete;
+
+		void SetScene(Sengine::Scene* scene);
+
+		//Feeds changes to the worker and picks up finished results. Call once per frame on the main thread.
+		void Update();
+
+		void SetQuery(const std::string& query);
+
+		//Matches for the current query. May contain entities destroyed since the search ran.
+		[[nodiscard]] const std::vector<entt::entity>& GetResults() const { return m_Results; }
+		[[nodiscard]] bool GetIsSearching() const { return m_ResultsGeneration != m_QueryGeneration; }
+
+	private:
+		struct NameChange
+		{
+			entt::entity Entity = entt::null;
+			std::string Name;
+			bool IsRemoved = false;
+		};
+
+		void OnTagChanged(entt::registry& registry, entt::entity entity);
+		void OnTagDestroyed(entt::registry& registry, entt::entity entity);
+
+		void WorkerLoop();
+		//Returns false if a newer query arrived while searching.
+		[[nodiscard]] bool Search(const std::string& query, uint64_t generation, std::vector<entt::entity>& results);
+
+	private:
+		Sengine::Scene* m_Scene = nullptr;
+		size_t m_SeedCursor = 0;
+
+		//Main thread state
+		std::vector<NameChange> m_PendingChanges;
+		std::vector<entt::entity> m_Results;
+		uint64_t m_QueryGeneration = 0;
+		uint64_t m_ResultsGeneration = 0;
+		uint64_t m_SeenPublishVersion = 0;
+
+		//Shared with the worker, guarded by m_Mutex
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		std::vector<NameChange> m_Inbox;
+		std::string m_Query;
+		uint64_t m_InboxQueryGeneration = 0;
+		bool m_ClearIndex = false;
+		std::vector<entt::entity> m_PublishedResults;
+		uint64_t m_PublishedGeneration = 0;
+		uint64_t m_PublishVersion = 0;
+		bool m_IsRunning = true;
+
+		//Worker thread state
+		std::unordered_map<entt::entity, std::string> m_Names;
+
+		std::thread m_Worker;
+	};
+}//namespace SengineEditor
@@ -0,0 +1,109 @@
+#include "InspectorPanel.h"
+
+#include <cstring>
+
+#include "imgui/imgui.h"
+
+namespace SengineEditor
+{
+	using namespace Sengine;
+
+	void InspectorPanel::OnImGuiRender(entt::entity selectedEntity)
+	{
+		ImGui::Begin("Inspector");
+
+		if (m_Scene && m_Scene->GetRegistry().valid(selectedEntity))
+		{
+			DrawTag(selectedEntity);
+			DrawTransform(selectedEntity);
+			DrawSprite(selectedEntity);
+			DrawRelationship(selectedEntity);
+		}
+
+		ImGui::End();
+	}
+
+	void InspectorPanel::DrawTag(entt::entity entity)
+	{
+		const TagComponent* tag = m_Scene->GetRegistry().try_get<TagComponent>(entity);
+		if (!tag) return;
+
+		char buffer[256] = {};
+		std::strncpy(buffer, tag->Name.c_str(), sizeof(buffer) - 1);
+
+		ImGui::SetNextItemWidth(-1.0f);
+		if (ImGui::InputText("##Name", buffer, sizeof(buffer)))
+		{
+			//Renames go through the scene so the search index picks them up.
+			m_Scene->SetName(entity, buffer);
+		}
+	}
+
+	void InspectorPanel::DrawTransform(entt::entity entity)
+	{
+		TransformComponent* transform = m_Scene->GetRegistry().try_get<TransformComponent>(entity);
+		if (!transform) return;
+
+		if (!ImGui::CollapsingHeader("Transform", ImGuiTreeNodeFlags_DefaultOpen)) return;
+
+		const TransformComponent before = *transform;
+		bool isChanged = false;
+
+		//Every frame of a drag is recorded as mergeable, releasing the widget seals it into one undo step.
+		isChanged |= ImGui::DragFloat3("Translation", &transform->Translation.x, 0.1f);
+		if (ImGui::IsItemDeactivatedAfterEdit()) m_History->SealLastEntry();
+
+		glm::vec3 rotation = glm::degrees(transform->Rotation);
+		if (ImGui::DragFloat3("Rotation", &rotation.x, 1.0f))
+		{
+			transform->Rotation = glm::radians(rotation);
+			isChanged = true;
+		}
+		if (ImGui::IsItemDeactivatedAfterEdit()) m_History->SealLastEntry();
+
+		isChanged |= ImGui::DragFloat3("Scale", &transform->Scale.x, 0.1f);
+		if (ImGui::IsItemDeactivatedAfterEdit()) m_History->SealLastEntry();
+
+		if (isChanged)
+		{
+			m_History->Record(entity, before, *transform, true);
+		}
+	}
+
+	void InspectorPanel::DrawSprite(entt::entity entity)
+	{
+		entt::registry& registry = m_Scene->GetRegistry();
+
+		SpriteComponent* sprite = registry.try_get<SpriteComponent>(entity);
+		if (!sprite)
+		{
+			if (ImGui::Button("Add Sprite"))
+			{
+				registry.emplace<SpriteComponent>(entity);
+			}
+			return;
+		}
+
+		if (!ImGui::CollapsingHeader("Sprite", ImGuiTreeNodeFlags_DefaultOpen)) return;
+
+		const SpriteComponent before = *sprite;
+		if (ImGui::ColorEdit4("Colour", &sprite->Colour.x))
+		{
+			m_History->Record(entity, before, *sprite, true);
+		}
+		if (ImGui::IsItemDeactivatedAfterEdit()) m_History->SealLastEntry();
+	}
+
+	void InspectorPanel::DrawRelationship(entt::entity entity)
+	{
+		const entt::registry& registry = m_Scene->GetRegistry();
+		const RelationshipComponent* relationship = registry.try_get<RelationshipComponent>(entity);
+		if (!relationship) return;
+
+		if (!ImGui::CollapsingHeader("Hierarchy")) return;
+
+		const char* parentName = relationship->Parent != entt::null ? registry.get<TagComponent>(relationship->Parent).Name.c_str() : "None";
+		ImGui::Text("Parent: %s", parentName);
+		ImGui::Text("Children: %u", relationship->ChildCount);
+	}
+}//namespace SengineEditor
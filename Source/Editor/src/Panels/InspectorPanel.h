@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Commands/CommandHistory.h"
+
+namespace SengineEditor
+{
+	//Shows the components of the selected entity. Only the selection is read, so the cost is independent of the scene size.
+	class InspectorPanel
+	{
+	public:
+		InspectorPanel() = default;
+
+		void SetContext(Sengine::Scene* scene, CommandHistory* history)
+		{
+			m_Scene = scene;
+			m_History = history;
+		}
+		void OnImGuiRender(entt::entity selectedEntity);
+
+	private:
+		void DrawTag(entt::entity entity);
+		void DrawTransform(entt::entity entity);
+		void DrawSprite(entt::entity entity);
+		void DrawRelationship(entt::entity entity);
+
+	private:
+		Sengine::Scene* m_Scene = nullptr;
+		CommandHistory* m_History = nullptr;
+	};
+}//namespace SengineEditor
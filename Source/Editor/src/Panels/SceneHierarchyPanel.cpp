@@ -0,0 +1,271 @@
+#include "SceneHierarchyPanel.h"
+
+#include <algorithm>
+
+#include "imgui/imgui.h"
+
+namespace SengineEditor
+{
+	using namespace Sengine;
+
+	void SceneHierarchyPanel::SetContext(Scene* scene)
+	{
+		m_Scene = scene;
+		m_SelectedEntity = entt::null;
+		m_ExpandedEntities.clear();
+		m_IsSegmentsDirty = true;
+
+		m_SearchIndex.SetScene(scene);
+	}
+
+	void SceneHierarchyPanel::OnImGuiRender()
+	{
+		ImGui::Begin("Scene Hierarchy");
+
+		if (!m_Scene)
+		{
+			ImGui::End();
+			return;
+		}
+
+		m_SearchIndex.Update();
+
+		ImGui::SetNextItemWidth(-1.0f);
+		if (ImGui::InputTextWithHint("##Search", "Search", m_Search, sizeof(m_Search)))
+		{
+			m_SearchIndex.SetQuery(m_Search);
+		}
+
+		ImGui::BeginChild("Entities");
+
+		if (m_Search[0] != '\0')
+		{
+			DrawSearchResults();
+		}
+		else
+		{
+			DrawHierarchy();
+		}
+
+		if (ImGui::BeginPopupContextWindow("HierarchyContext", ImGuiPopupFlags_MouseButtonRight | ImGuiPopupFlags_NoOpenOverItems))
+		{
+			if (ImGui::MenuItem("Create Entity"))
+			{
+				m_CreateRoot = true;
+			}
+			ImGui::EndPopup();
+		}
+
+		ImGui::EndChild();
+		ImGui::End();
+
+		if (m_EntityToDestroy != entt::null)
+		{
+			m_Scene->DestroyEntity(m_EntityToDestroy);
+			m_EntityToDestroy = entt::null;
+
+			if (!m_Scene->GetRegistry().valid(m_SelectedEntity))
+			{
+				m_SelectedEntity = entt::null;
+			}
+		}
+
+		if (m_CreateChildOf != entt::null)
+		{
+			m_SelectedEntity = m_Scene->CreateEntity("Entity", m_CreateChildOf);
+			m_ExpandedEntities.insert(m_CreateChildOf);
+			m_IsSegmentsDirty = true;
+			m_CreateChildOf = entt::null;
+		}
+
+		if (m_CreateRoot)
+		{
+			m_SelectedEntity = m_Scene->CreateEntity();
+			m_CreateRoot = false;
+		}
+	}
+
+	void SceneHierarchyPanel::RebuildSegments()
+	{
+		const entt::registry& registry = m_Scene->GetRegistry();
+		const auto& roots = m_Scene->GetRoots();
+
+		//Forget destroyed entities so the set only ever holds what the user actually has open.
+		for (auto it = m_ExpandedEntities.begin(); it != m_ExpandedEntities.end();)
+		{
+			it = registry.valid(*it) ? std::next(it) : m_ExpandedEntities.erase(it);
+		}
+
+		m_Segments.clear();
+		for (const entt::entity entity : m_ExpandedEntities)
+		{
+			if (!roots.contains(entity)) continue;
+
+			ExpandedSegment segment;
+			segment.RootIndex = roots.index(entity);
+			CollectExpandedChildren(entity, 1, segment.Rows);
+
+			if (!segment.Rows.empty())
+			{
+				m_Segments.push_back(std::move(segment));
+			}
+		}
+
+		std::sort(m_Segments.begin(), m_Segments.end(), [](const ExpandedSegment& a, const ExpandedSegment& b) { return a.RootIndex < b.RootIndex; });
+
+		size_t childRows = 0;
+		for (ExpandedSegment& segment : m_Segments)
+		{
+			segment.FirstRow = segment.RootIndex + childRows;
+			childRows += segment.Rows.size();
+		}
+
+		m_RowCount = roots.size() + childRows;
+		m_BuiltHierarchyVersion = m_Scene->GetHierarchyVersion();
+		m_IsSegmentsDirty = false;
+	}
+
+	void SceneHierarchyPanel::CollectExpandedChildren(entt::entity parent, uint32_t depth, std::vector<Row>& rows) const
+	{
+		const entt::registry& registry = m_Scene->GetRegistry();
+
+		for (entt::entity child = registry.get<RelationshipComponent>(parent).FirstChild; child != entt::null;
+			child = registry.get<RelationshipComponent>(child).NextSibling)
+		{
+			rows.push_back({ child, depth });
+
+			if (m_ExpandedEntities.count(child))
+			{
+				CollectExpandedChildren(child, depth + 1, rows);
+			}
+		}
+	}
+
+	SceneHierarchyPanel::Row SceneHierarchyPanel::GetRow(size_t row) const
+	{
+		const auto& roots = m_Scene->GetRoots();
+
+		const auto segment = std::upper_bound(m_Segments.begin(), m_Segments.end(), row,
+			[](size_t value, const ExpandedSegment& other) { return value < other.FirstRow; });
+
+		if (segment == m_Segments.begin())
+		{
+			return { roots.data()[row], 0 };
+		}
+
+		const ExpandedSegment& previous = *std::prev(segment);
+		const size_t offset = row - previous.FirstRow;
+
+		if (offset == 0)
+		{
+			return { roots.data()[previous.RootIndex], 0 };
+		}
+		if (offset <= previous.Rows.size())
+		{
+			return previous.Rows[offset - 1];
+		}
+		return { roots.data()[previous.RootIndex + offset - previous.Rows.size()], 0 };
+	}
+
+	void SceneHierarchyPanel::DrawHierarchy()
+	{
+		if (m_IsSegmentsDirty || m_BuiltHierarchyVersion != m_Scene->GetHierarchyVersion())
+		{
+			RebuildSegments();
+		}
+
+		ImGuiListClipper clipper;
+		clipper.Begin(static_cast<int>(m_RowCount));
+		while (clipper.Step())
+		{
+			for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+			{
+				DrawRow(GetRow(static_cast<size_t>(row)));
+			}
+		}
+		clipper.End();
+	}
+
+	void SceneHierarchyPanel::DrawSearchResults()
+	{
+		const entt::registry& registry = m_Scene->GetRegistry();
+		const std::vector<entt::entity>& results = m_SearchIndex.GetResults();
+
+		if (m_SearchIndex.GetIsSearching())
+		{
+			ImGui::TextDisabled("Searching...");
+		}
+
+		ImGuiListClipper clipper;
+		clipper.Begin(static_cast<int>(results.size()));
+		while (clipper.Step())
+		{
+			for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+			{
+				if (!registry.valid(results[i]))
+				{
+					//Keep the row so the clipper's fixed row height stays correct.
+					ImGui::TextDisabled("(destroyed)");
+					continue;
+				}
+
+				DrawRow({ results[i], 0 });
+			}
+		}
+		clipper.End();
+	}
+
+	void SceneHierarchyPanel::DrawRow(const Row& row)
+	{
+		const entt::registry& registry = m_Scene->GetRegistry();
+		const TagComponent& tag = registry.get<TagComponent>(row.Entity);
+		const RelationshipComponent& relationship = registry.get<RelationshipComponent>(row.Entity);
+
+		ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick
+			| ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+
+		if (relationship.ChildCount == 0) flags |= ImGuiTreeNodeFlags_Leaf;
+		if (row.Entity == m_SelectedEntity) flags |= ImGuiTreeNodeFlags_Selected;
+
+		//Rows are flat, so the tree depth is drawn as indentation rather than with a tree push.
+		const float indent = static_cast<float>(row.Depth) * ImGui::GetStyle().IndentSpacing;
+		if (indent > 0.0f) ImGui::Indent(indent);
+
+		const bool isExpanded = m_ExpandedEntities.count(row.Entity) > 0;
+		ImGui::SetNextItemOpen(isExpanded);
+		const bool isOpen = ImGui::TreeNodeEx(reinterpret_cast<void*>(static_cast<uintptr_t>(entt::to_integral(row.Entity))), flags, "%s", tag.Name.c_str());
+
+		if (indent > 0.0f) ImGui::Unindent(indent);
+
+		if (ImGui::IsItemClicked() && !ImGui::IsItemToggledOpen())
+		{
+			m_SelectedEntity = row.Entity;
+		}
+
+		if (isOpen != isExpanded && relationship.ChildCount > 0)
+		{
+			if (isOpen)
+			{
+				m_ExpandedEntities.insert(row.Entity);
+			}
+			else
+			{
+				m_ExpandedEntities.erase(row.Entity);
+			}
+			m_IsSegmentsDirty = true;
+		}
+
+		if (ImGui::BeginPopupContextItem())
+		{
+			if (ImGui::MenuItem("Create Child"))
+			{
+				m_CreateChildOf = row.Entity;
+			}
+			if (ImGui::MenuItem("Delete"))
+			{
+				m_EntityToDestroy = row.Entity;
+			}
+			ImGui::EndPopup();
+		}
+	}
+}//namespace SengineEditor
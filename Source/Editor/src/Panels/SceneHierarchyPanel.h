@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <unordered_set>
+#include <vector>
+
+#include "Panels/EntitySearchIndex.h"
+
+namespace SengineEditor
+{
+	//Outliner for a scene. Roots are read straight out of their packed storage, so only the rows on screen are touched.
+	//Children are only walked for expanded entities, and filtering is handed to an EntitySearchIndex.
+	class SceneHierarchyPanel
+	{
+	public:
+		SceneHierarchyPanel() = default;
+
+		void SetContext(Sengine::Scene* scene);
+		void OnImGuiRender();
+
+		[[nodiscard]] entt::entity GetSelectedEntity() const { return m_SelectedEntity; }
+		void SetSelectedEntity(entt::entity entity) { m_SelectedEntity = entity; }
+
+	private:
+		struct Row
+		{
+			entt::entity Entity = entt::null;
+			uint32_t Depth = 0;
+		};
+
+		//The visible descendants of one expanded root, spliced into the flat list after that root.
+		struct ExpandedSegment
+		{
+			size_t RootIndex = 0;
+			size_t FirstRow = 0;
+			std::vector<Row> Rows;
+		};
+
+		void RebuildSegments();
+		void CollectExpandedChildren(entt::entity parent, uint32_t depth, std::vector<Row>& rows) const;
+		[[nodiscard]] Row GetRow(size_t row) const;
+
+		void DrawHierarchy();
+		void DrawSearchResults();
+		void DrawRow(const Row& row);
+
+	private:
+		Sengine::Scene* m_Scene = nullptr;
+		entt::entity m_SelectedEntity = entt::null;
+
+		std::unordered_set<entt::entity> m_ExpandedEntities;
+		std::vector<ExpandedSegment> m_Segments;
+		size_t m_RowCount = 0;
+		uint64_t m_BuiltHierarchyVersion = (std::numeric_limits<uint64_t>::max)();
+		bool m_IsSegmentsDirty = true;
+
+		//Structural edits requested while drawing, applied once the list is no longer being iterated.
+		entt::entity m_EntityToDestroy = entt::null;
+		entt::entity m_CreateChildOf = entt::null;
+		bool m_CreateRoot = false;
+
+		EntitySearchIndex m_SearchIndex;
+		char m_Search[128] = {};
+	};
+}//namespace SengineEditor
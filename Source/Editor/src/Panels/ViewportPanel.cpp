@@ -0,0 +1,125 @@
+#include "ViewportPanel.h"
+
+#include "Sengine/Render/Renderer.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+#include "imgui/imgui.h"
+
+namespace SengineEditor
+{
+	using namespace Sengine;
+
+	ViewportPanel::ViewportPanel()
+	{
+		//Depth is transient and lives in the frame graph, only what outlives the frame is kept here.
+		FramebufferSpecification specification;
+		specification.Attachments = { FramebufferTextureFormat::RGBA8, FramebufferTextureFormat::RedInteger };
+		m_Framebuffer = std::make_unique<Framebuffer>(specification);
+	}
+
+	void ViewportPanel::OnRender()
+	{
+		if (!m_Scene || m_ViewportSize.x < 1.0f || m_ViewportSize.y < 1.0f) return;
+
+		m_Framebuffer->Resize(static_cast<uint32_t>(m_ViewportSize.x), static_cast<uint32_t>(m_ViewportSize.y));
+
+		const FramebufferSpecification& specification = m_Framebuffer->GetSpecification();
+		RenderView view;
+		view.Width = specification.Width;
+		view.Height = specification.Height;
+		view.ColourTexture = m_Framebuffer->GetColorAttachmentRendererID();
+		view.EntityIDTexture = m_Framebuffer->GetColorAttachmentRendererID(EntityIDAttachment);
+
+		const float aspectRatio = m_ViewportSize.x / m_ViewportSize.y;
+		Camera2D camera;
+		camera.ViewProjection = glm::ortho(-aspectRatio * m_Zoom, aspectRatio * m_Zoom, -m_Zoom, m_Zoom);
+
+		Renderer::BeginRender2D(camera, view);
+
+		const auto sprites = m_Scene->GetRegistry().view<TransformComponent, SpriteComponent>();
+		for (const auto [entity, transform, sprite] : sprites.each())
+		{
+			//Only the slot is written, with the version the ID could go negative and read back as no entity.
+			Renderer::Draw2D(transform.GetTransform(), sprite.Colour, static_cast<int>(entt::to_entity(entity)));
+		}
+
+		Renderer::EndRender2D();
+
+		if (m_HasPendingPick)
+		{
+			//The read back is queued behind the passes writing the entity IDs, so it sees this frame.
+			RenderGraph& graph = Renderer::GetFrameGraph();
+			const RenderGraphResource entityIDs = graph.Find("EntityID");
+			graph.AddPass("EntityPick", [entityIDs](RenderGraphBuilder& builder)
+				{
+					builder.Read(entityIDs);
+					builder.SetHasSideEffects();
+				},
+				[this, pick = m_PendingPick](const RenderGraph&)
+				{
+					//With dynamic resolution the IDs were rendered to the scaled down corner of the attachment.
+					const float scale = Renderer::GetRenderScale();
+					m_EntityPicker.RequestPick(*m_Framebuffer, EntityIDAttachment, static_cast<int>(static_cast<float>(pick.x) * scale), static_cast<int>(static_cast<float>(pick.y) * scale));
+				});
+
+			m_HasPendingPick = false;
+		}
+	}
+
+	void ViewportPanel::OnImGuiRender()
+	{
+		ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0.0f, 0.0f));
+		ImGui::Begin("Viewport");
+
+		//While a dock splitter or the window edge is dragged the old image is stretched, and the framebuffer only takes
+		//the new size once this panel stops changing size, so a drag does not allocate a render target for every pixel moved.
+		//Holding the mouse anywhere else leaves the size alone, so it does not keep the viewport from resizing.
+		const ImVec2 size = ImGui::GetContentRegionAvail();
+		const bool isResizing = ImGui::IsMouseDown(ImGuiMouseButton_Left) && (size.x != m_AvailableSize.x || size.y != m_AvailableSize.y);
+		m_AvailableSize = { size.x, size.y };
+		if (!isResizing || m_Framebuffer->GetRendererID() == 0)
+		{
+			m_ViewportSize = { size.x, size.y };
+		}
+
+		const FramebufferSpecification& specification = m_Framebuffer->GetSpecification();
+		if (m_Framebuffer->GetRendererID() != 0)
+		{
+			const ImTextureID texture = reinterpret_cast<ImTextureID>(static_cast<uintptr_t>(m_Framebuffer->GetColorAttachmentRendererID()));
+			ImGui::Image(texture, size, ImVec2(0.0f, 1.0f), ImVec2(1.0f, 0.0f));
+
+			if (ImGui::IsItemHovered() && ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+			{
+				//The framebuffer may still be the size of the last frame, so the cursor is mapped into its pixels.
+				const ImVec2 imageMin = ImGui::GetItemRectMin();
+				const ImVec2 mouse = ImGui::GetMousePos();
+				const int x = static_cast<int>((mouse.x - imageMin.x) / size.x * specification.Width);
+				const int y = static_cast<int>((1.0f - (mouse.y - imageMin.y) / size.y) * specification.Height);
+
+				m_PendingPick = { x, y };
+				m_HasPendingPick = true;
+			}
+		}
+
+		ImGui::End();
+		ImGui::PopStyleVar();
+	}
+
+	bool ViewportPanel::GetPickedEntity(entt::entity& entity)
+	{
+		int entityID = -1;
+		if (!m_EntityPicker.PollResult(entityID)) return false;
+
+		if (entityID < 0 || !m_Scene)
+		{
+			entity = entt::null;
+			return true;
+		}
+
+		//The version is whatever the slot holds now, the registry check in the caller drops slots freed since the pick.
+		const entt::registry& registry = m_Scene->GetRegistry();
+		const auto slot = static_cast<entt::entt_traits<entt::entity>::entity_type>(entityID);
+		entity = entt::entt_traits<entt::entity>::construct(slot, registry.current(static_cast<entt::entity>(slot)));
+		return true;
+	}
+}//namespace SengineEditor
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+
+#include "Sengine/Render/EntityPicker.h"
+#include "Sengine/Render/Framebuffer.h"
+#include "Sengine/Scene/Scene.h"
+
+namespace SengineEditor
+{
+	//Renders the scene into an off screen framebuffer and shows it as an ImGui image.
+	//Clicking the image picks the entity under the cursor through the entity ID attachment.
+	class ViewportPanel
+	{
+	public:
+		static constexpr uint32_t EntityIDAttachment = 1;
+
+		ViewportPanel();
+
+		void SetContext(Sengine::Scene* scene) { m_Scene = scene; }
+
+		//Adds the passes rendering the scene into the viewport framebuffer to the frame graph.
+		void OnRender();
+		void OnImGuiRender();
+
+		//Returns true once for every pick that has resolved. The entity is null if empty space was clicked.
+		[[nodiscard]] bool GetPickedEntity(entt::entity& entity);
+
+	private:
+		Sengine::Scene* m_Scene = nullptr;
+
+		std::unique_ptr<Sengine::Framebuffer> m_Framebuffer;
+		Sengine::EntityPicker m_EntityPicker;
+		glm::ivec2 m_PendingPick = { 0, 0 };
+		bool m_HasPendingPick = false;
+
+		glm::vec2 m_ViewportSize = { 0.0f, 0.0f };
+		//The panel's content size last frame, to tell when it is being resized.
+		glm::vec2 m_AvailableSize = { 0.0f, 0.0f };
+		float m_Zoom = 5.0f;
+	};
+}//namespace SengineEditor
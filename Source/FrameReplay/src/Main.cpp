@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "glad/glad.h"
+
+#include "Sengine/Applicatiom/HeadlessContext.h"
+#include "Sengine/Render/3D/Mesh.h"
+#include "Sengine/Render/FrameCapture.h"
+#include "Sengine/Render/Renderer.h"
+#include "Sengine/Render/Texture.h"
+
+namespace
+{
+	struct Options
+	{
+		std::string CapturePath;
+		std::string JsonPath;
+		uint32_t FrameCount = 300;
+		uint32_t WarmupFrameCount = 10;
+	};
+
+	//The GPU resources a capture draws with, created once and reused by every replayed frame.
+	struct ReplayResources
+	{
+		std::vector<std::unique_ptr<Sengine::Texture2D>> Textures;
+		std::vector<std::unique_ptr<Sengine::Renderer3D::Mesh>> Meshes;
+		//A colour and an entity ID target per view. Views that rendered to the window get a texture too, a headless context has no window.
+		std::vector<uint32_t> TargetTextures;
+	};
+
+	struct Statistics
+	{
+		double Minimum = 0.0;
+		double Median = 0.0;
+		double Mean = 0.0;
+		double Maximum = 0.0;
+	};
+
+	[[nodiscard]] bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		for (int index = 1; index < argc; index++)
+		{
+			const bool hasValue = index + 1 < argc;
+			if (std::strcmp(argv[index], "--frames") == 0 && hasValue) options.FrameCount = std::max(std::atoi(argv[++index]), 1);
+			else if (std::strcmp(argv[index], "--warmup") == 0 && hasValue) options.WarmupFrameCount = std::max(std::atoi(argv[++index]), 0);
+			else if (std::strcmp(argv[index], "--json") == 0 && hasValue) options.JsonPath = argv[++index];
+			else if (argv[index][0] != '-' && options.CapturePath.empty()) options.CapturePath = argv[index];
+			else return false;
+		}
+		return !options.CapturePath.empty();
+	}
+
+	uint32_t CreateTarget(uint32_t format, uint32_t width, uint32_t height)
+	{
+		uint32_t texture = 0;
+		glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+		glTextureStorage2D(texture, 1, format, static_cast<GLsizei>(width), static_cast<GLsizei>(height));
+		return texture;
+	}
+
+	//Points the captured views at the replay's own textures and targets.
+	void CreateResources(Sengine::CapturedFrame& frame, ReplayResources& resources)
+	{
+		for (const Sengine::CapturedTexture& texture : frame.Textures)
+		{
+			resources.Textures.push_back(std::make_unique<Sengine::Texture2D>(texture.Width, texture.Height, texture.Pixels.data()));
+		}
+		for (const Sengine::CapturedMesh& mesh : frame.Meshes)
+		{
+			resources.Meshes.push_back(std::make_unique<Sengine::Renderer3D::Mesh>(mesh.Positions, mesh.Normals, mesh.Indices));
+		}
+
+		for (Sengine::CapturedView& view : frame.Views)
+		{
+			Sengine::RenderView& target = view.Target;
+			target.ColourTexture = CreateTarget(GL_RGBA8, target.Width, target.Height);
+			resources.TargetTextures.push_back(target.ColourTexture);
+
+			if (target.EntityIDTexture != 0)
+			{
+				target.EntityIDTexture = CreateTarget(GL_R32I, target.Width, target.Height);
+				resources.TargetTextures.push_back(target.EntityIDTexture);
+			}
+		}
+	}
+
+	void SubmitFrame(const Sengine::CapturedFrame& frame, const ReplayResources& resources)
+	{
+		Sengine::Renderer::BeginFrame(frame.Width, frame.Height);
+
+		for (const Sengine::CapturedView& view : frame.Views)
+		{
+			if (view.Is3D)
+			{
+				Sengine::Renderer::BeginRender3D({ view.View, view.Projection }, view.Target);
+				for (const Sengine::CapturedMeshDraw& draw : view.Meshes)
+				{
+					Sengine::Renderer::Draw3D(*resources.Meshes[draw.Mesh], draw.Transform, draw.Colour, draw.EntityID);
+				}
+				Sengine::Renderer::EndRender3D();
+				continue;
+			}
+
+			Sengine::Renderer::BeginRender2D({ view.ViewProjection }, view.Target);
+			for (const Sengine::CapturedQuad& quad : view.Quads)
+			{
+				if (quad.NormalMap >= 0)
+				{
+					Sengine::Renderer::Draw2D(quad.Transform, *resources.Textures[quad.Texture], *resources.Textures[quad.NormalMap], quad.Region, quad.Colour, quad.EntityID);
+				}
+				else if (quad.Texture >= 0)
+				{
+					Sengine::Renderer::Draw2D(quad.Transform, *resources.Textures[quad.Texture], quad.Region, quad.Colour, quad.EntityID);
+				}
+				else
+				{
+					Sengine::Renderer::Draw2D(quad.Transform, quad.Colour, quad.EntityID);
+				}
+			}
+			for (const Sengine::Renderer2D::PointLight2D& light : view.Lights)
+			{
+				Sengine::Renderer::DrawLight2D(light);
+			}
+			Sengine::Renderer::EndRender2D();
+		}
+
+		Sengine::Renderer::EndFrame();
+	}
+
+	Statistics GetStatistics(std::vector<double> values)
+	{
+		std::sort(values.begin(), values.end());
+		return { values.front(), values[values.size() / 2], std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size()), values.back() };
+	}
+
+	void PrintStatistics(const char* name, const Statistics& statistics)
+	{
+		std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(3) << std::setw(10) << statistics.Minimum
+			<< std::setw(10) << statistics.Median << std::setw(10) << statistics.Mean << std::setw(10) << statistics.Maximum << "\n";
+	}
+
+	void WriteJsonEntry(std::ostream& stream, const char* name, const Statistics& statistics, bool isLast)
+	{
+		stream << "  {\"name\": \"" << name << "\", \"min_ms\": " << statistics.Minimum << ", \"median_ms\": " << statistics.Median
+			<< ", \"mean_ms\": " << statistics.Mean << ", \"max_ms\": " << statistics.Maximum << "}" << (isLast ? "" : ",") << "\n";
+	}
+}
+
+//Submits a frame captured with Renderer::CaptureFrame over and over without the application that produced it, so
+//renderer changes can be compared on a fixed workload. Every frame is waited on before the next starts.
+//  Submit   CPU time from BeginFrame to the return of EndFrame: building, sorting and issuing the frame
+//  Frame    Submit plus waiting for the GPU to finish it
+//  GPU      Time the GPU spent on the frame graph, from timestamp queries
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		std::cout << "Usage: FrameReplay <capture> [--frames <count>] [--warmup <count>] [--json <path>]\n";
+		return 1;
+	}
+
+	Sengine::CapturedFrame frame;
+	if (!frame.Load(options.CapturePath)) return 1;
+
+	Sengine::HeadlessContext context;
+	if (!context.Create()) return 1;
+
+	std::cout << "Replaying " << options.CapturePath << " on " << context.GetRendererName() << "\n";
+	std::cout << frame.Views.size() << " views, " << frame.Textures.size() << " textures, " << frame.Meshes.size() << " meshes\n\n";
+
+	Sengine::Renderer::Init();
+	Sengine::Renderer::GetSettings() = frame.Settings;
+
+	std::vector<double> submitMilliseconds;
+	std::vector<double> frameMilliseconds;
+	std::vector<double> gpuMilliseconds;
+	{
+		ReplayResources resources;
+		CreateResources(frame, resources);
+
+		using Clock = std::chrono::steady_clock;
+		for (uint32_t index = 0; index < options.WarmupFrameCount + options.FrameCount; index++)
+		{
+			const Clock::time_point start = Clock::now();
+			SubmitFrame(frame, resources);
+			const Clock::time_point submitted = Clock::now();
+			glFinish();
+			const Clock::time_point finished = Clock::now();
+
+			if (index < options.WarmupFrameCount) continue;
+
+			submitMilliseconds.push_back(std::chrono::duration<double, std::milli>(submitted - start).count());
+			frameMilliseconds.push_back(std::chrono::duration<double, std::milli>(finished - start).count());
+			//Timer results land a few frames late, which does not matter when every frame is the same.
+			gpuMilliseconds.push_back(Sengine::Renderer::GetGpuFrameMilliseconds());
+		}
+
+		glDeleteTextures(static_cast<GLsizei>(resources.TargetTextures.size()), resources.TargetTextures.data());
+	}
+
+	Sengine::Renderer::Destroy();
+	context.Destroy();
+
+	const Statistics submit = GetStatistics(submitMilliseconds);
+	const Statistics total = GetStatistics(frameMilliseconds);
+	const Statistics gpu = GetStatistics(gpuMilliseconds);
+
+	std::cout << std::left << std::setw(16) << "ms" << std::right << std::setw(10) << "min" << std::setw(10) << "median" << std::setw(10) << "mean" << std::setw(10) << "max" << "\n";
+	PrintStatistics("Submit", submit);
+	PrintStatistics("Frame", total);
+	PrintStatistics("GPU", gpu);
+
+	if (!options.JsonPath.empty())
+	{
+		std::ofstream file(options.JsonPath);
+		if (!file.is_open())
+		{
+			std::cout << "[Frame Replay] Error: Failed to write " << options.JsonPath << "\n";
+			return 1;
+		}
+
+		file << "[\n" << std::setprecision(6);
+		WriteJsonEntry(file, "Submit", submit, false);
+		WriteJsonEntry(file, "Frame", total, false);
+		WriteJsonEntry(file, "GPU", gpu, true);
+		file << "]\n";
+	}
+
+	return 0;
+}
@@ -0,0 +1,62 @@
+project "RenderRegression"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+	staticruntime "on"
+
+	targetdir ("../../bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("../../bin-int/" .. outputdir .. "/%{prj.name}")
+
+	--Run from this directory, or pass --references, so the tool finds the checked in images.
+	debugdir "."
+
+	files
+	{
+		"src/**.h",
+		"src/**.cpp",
+	}
+
+	includedirs
+	{
+		"src",
+		"%{IncludeDir.SENGINE}",
+        "%{IncludeDir.THIRDPARTY}",
+        "%{IncludeDir.GLAD}",
+        "%{IncludeDir.GLM}",
+	}
+
+	links
+	{
+		"Sengine"	
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+
+		defines
+		{
+			"SE_PLATFORM_WINDOWS",
+		}
+
+	filter "system:linux"
+		links
+		{
+			"pthread",
+			"dl",
+		}
+
+	filter "configurations:Debug"
+        defines
+        {
+            "SE_DEBUG"
+        }
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+        defines
+        {
+            "SE_RELEASE"
+        }
+		runtime "Release"
+        optimize "on"
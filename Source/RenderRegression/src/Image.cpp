@@ -0,0 +1,95 @@
+#include "Image.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "glm/glm.hpp"
+#include "Sengine/Core/PngEncoder.h"
+#include "stb_image/stb_image.h"
+
+namespace RenderRegression
+{
+	namespace
+	{
+		float SrgbToLinear(uint8_t value)
+		{
+			const float colour = static_cast<float>(value) / 255.0f;
+			return colour <= 0.04045f ? colour / 12.92f : std::pow((colour + 0.055f) / 1.055f, 2.4f);
+		}
+
+		float LabCurve(float value)
+		{
+			return value > 0.008856f ? std::cbrt(value) : 7.787f * value + 16.0f / 116.0f;
+		}
+
+		//Alpha is left out, the renders are opaque.
+		glm::vec3 ToLab(const uint8_t* pixel)
+		{
+			const glm::vec3 linear = { SrgbToLinear(pixel[0]), SrgbToLinear(pixel[1]), SrgbToLinear(pixel[2]) };
+
+			//sRGB to XYZ, relative to the D65 white point.
+			const float x = LabCurve((0.4124f * linear.r + 0.3576f * linear.g + 0.1805f * linear.b) / 0.95047f);
+			const float y = LabCurve(0.2126f * linear.r + 0.7152f * linear.g + 0.0722f * linear.b);
+			const float z = LabCurve((0.0193f * linear.r + 0.1192f * linear.g + 0.9505f * linear.b) / 1.08883f);
+
+			return { 116.0f * y - 16.0f, 500.0f * (x - y), 200.0f * (y - z) };
+		}
+	}
+
+	bool LoadPng(const std::filesystem::path& path, Image& image)
+	{
+		int width = 0;
+		int height = 0;
+		int channels = 0;
+		stbi_uc* pixels = stbi_load(path.string().c_str(), &width, &height, &channels, 4);
+		if (!pixels) return false;
+
+		image.Width = static_cast<uint32_t>(width);
+		image.Height = static_cast<uint32_t>(height);
+		image.Pixels.assign(pixels, pixels + static_cast<size_t>(width) * height * 4);
+		stbi_image_free(pixels);
+
+		return true;
+	}
+
+	bool SavePng(const std::filesystem::path& path, const Image& image)
+	{
+		return Sengine::WritePng(path, image.Pixels.data(), image.Width, image.Height);
+	}
+
+	ImageDifference CompareImages(const Image& reference, const Image& image, float deltaETolerance)
+	{
+		ImageDifference difference;
+		difference.DifferenceImage = reference;
+
+		const size_t pixelCount = static_cast<size_t>(reference.Width) * reference.Height;
+		size_t differentCount = 0;
+		for (size_t pixel = 0; pixel < pixelCount; pixel++)
+		{
+			const uint8_t* expected = reference.Pixels.data() + pixel * 4;
+			const uint8_t* actual = image.Pixels.data() + pixel * 4;
+
+			const float deltaE = glm::length(ToLab(expected) - ToLab(actual));
+			difference.MaxDeltaE = std::max(difference.MaxDeltaE, deltaE);
+
+			uint8_t* output = difference.DifferenceImage.Pixels.data() + pixel * 4;
+			if (deltaE > deltaETolerance)
+			{
+				differentCount++;
+				output[0] = 255;
+				output[1] = 0;
+				output[2] = 0;
+			}
+			else
+			{
+				output[0] /= 4;
+				output[1] /= 4;
+				output[2] /= 4;
+			}
+			output[3] = 255;
+		}
+
+		difference.DifferentFraction = pixelCount > 0 ? static_cast<float>(differentCount) / static_cast<float>(pixelCount) : 0.0f;
+		return difference;
+	}
+}//namespace RenderRegression
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace RenderRegression
+{
+	//Tightly packed RGBA8 pixels, top row first.
+	struct Image
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		std::vector<uint8_t> Pixels;
+	};
+
+	struct ImageDifference
+	{
+		//Largest CIE76 colour difference of any pixel, around 2.3 is the smallest people notice side by side.
+		float MaxDeltaE = 0.0f;
+		//Share of pixels whose difference is above the tolerance, from zero to one.
+		float DifferentFraction = 0.0f;
+		//The reference dimmed, with the pixels above the tolerance in red.
+		Image DifferenceImage;
+	};
+
+	[[nodiscard]] bool LoadPng(const std::filesystem::path& path, Image& image);
+	//Compressed just enough to keep flat coloured renders small in the repository.
+	[[nodiscard]] bool SavePng(const std::filesystem::path& path, const Image& image);
+
+	//Compares in CIELAB so the tolerance follows what is visible, small shifts in dark or saturated colours count
+	//for less than the same shift in greys. The images have to be the same size.
+	[[nodiscard]] ImageDifference CompareImages(const Image& reference, const Image& image, float deltaETolerance);
+}//namespace RenderRegression
@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "glad/glad.h"
+
+#include "Sengine/Applicatiom/HeadlessContext.h"
+#include "Sengine/Render/Renderer.h"
+
+#include "Image.h"
+#include "Scenes.h"
+
+namespace
+{
+	struct Options
+	{
+		std::filesystem::path ReferenceDirectory = "References";
+		std::filesystem::path OutputDirectory = "Output";
+		std::string Filter;
+		std::string JsonPath;
+		bool IsUpdating = false;
+		uint32_t FrameCount = 60;
+		float DeltaETolerance = 3.0f;
+		//Percent of pixels allowed above the tolerance, which leaves room for a few edge pixels to land differently.
+		float MaxDifferentPercent = 0.1f;
+	};
+
+	struct SceneResult
+	{
+		std::string Name;
+		double MedianMilliseconds = 0.0;
+		float GpuMilliseconds = 0.0f;
+	};
+
+	constexpr uint32_t Width = 320;
+	constexpr uint32_t Height = 180;
+
+	[[nodiscard]] bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		for (int index = 1; index < argc; index++)
+		{
+			const bool hasValue = index + 1 < argc;
+			if (std::strcmp(argv[index], "--update") == 0) options.IsUpdating = true;
+			else if (std::strcmp(argv[index], "--references") == 0 && hasValue) options.ReferenceDirectory = argv[++index];
+			else if (std::strcmp(argv[index], "--output") == 0 && hasValue) options.OutputDirectory = argv[++index];
+			else if (std::strcmp(argv[index], "--filter") == 0 && hasValue) options.Filter = argv[++index];
+			else if (std::strcmp(argv[index], "--json") == 0 && hasValue) options.JsonPath = argv[++index];
+			else if (std::strcmp(argv[index], "--frames") == 0 && hasValue) options.FrameCount = std::max(std::atoi(argv[++index]), 1);
+			else if (std::strcmp(argv[index], "--tolerance") == 0 && hasValue) options.DeltaETolerance = static_cast<float>(std::atof(argv[++index]));
+			else if (std::strcmp(argv[index], "--max-different") == 0 && hasValue) options.MaxDifferentPercent = static_cast<float>(std::atof(argv[++index]));
+			else return false;
+		}
+		return true;
+	}
+
+	//Reads the view back top row first, the way images are stored.
+	RenderRegression::Image ReadTexture(uint32_t texture)
+	{
+		RenderRegression::Image image;
+		image.Width = Width;
+		image.Height = Height;
+		image.Pixels.resize(static_cast<size_t>(Width) * Height * 4);
+
+		std::vector<uint8_t> rows(image.Pixels.size());
+		glGetTextureImage(texture, 0, GL_RGBA, GL_UNSIGNED_BYTE, static_cast<GLsizei>(rows.size()), rows.data());
+
+		const size_t stride = static_cast<size_t>(Width) * 4;
+		for (uint32_t y = 0; y < Height; y++)
+		{
+			std::memcpy(image.Pixels.data() + y * stride, rows.data() + (Height - 1 - y) * stride, stride);
+		}
+		return image;
+	}
+
+	//Renders the scene for the given number of frames, each waited on so the timings include the rasteriser.
+	SceneResult RenderScene(RenderRegression::RegressionScene& scene, const Sengine::RenderView& view, uint32_t frameCount)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		Sengine::RendererSettings& settings = Sengine::Renderer::GetSettings();
+		settings = Sengine::RendererSettings();
+		scene.Configure(settings);
+
+		std::vector<double> milliseconds;
+		for (uint32_t frame = 0; frame < frameCount; frame++)
+		{
+			const Clock::time_point start = Clock::now();
+
+			Sengine::Renderer::BeginFrame(Width, Height);
+			scene.Submit(view);
+			Sengine::Renderer::EndFrame();
+			glFinish();
+
+			milliseconds.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+		}
+
+		std::sort(milliseconds.begin(), milliseconds.end());
+		return { scene.GetName(), milliseconds[milliseconds.size() / 2], Sengine::Renderer::GetGpuFrameMilliseconds() };
+	}
+
+	[[nodiscard]] bool WriteJson(const std::string& path, const std::vector<SceneResult>& results)
+	{
+		std::ofstream file(path);
+		if (!file.is_open())
+		{
+			std::cout << "[Render Regression] Error: Failed to write " << path << "\n";
+			return false;
+		}
+
+		file << "[\n";
+		for (size_t index = 0; index < results.size(); index++)
+		{
+			file << "  {\"name\": \"" << results[index].Name << "\", \"ms_per_frame\": " << std::setprecision(6) << results[index].MedianMilliseconds
+				<< ", \"gpu_ms\": " << results[index].GpuMilliseconds << "}" << (index + 1 < results.size() ? "," : "") << "\n";
+		}
+		file << "]\n";
+
+		return true;
+	}
+}
+
+//Renders canned scenes through the Renderer without a window and compares them against reference images.
+//References are recorded with --update on Mesa's llvmpipe, so the same images come out on any machine with or
+//without a GPU. Differences are measured in CIELAB, a scene fails if more than --max-different percent of its pixels
+//are further than --tolerance from the reference. Failing scenes leave their render and a difference image in --output.
+//Frame times are the median over --frames frames, including the wait for the rasteriser.
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		std::cout << "Usage: RenderRegression [--update] [--references <dir>] [--output <dir>] [--filter <text>] [--json <path>]\n"
+			"                        [--frames <count>] [--tolerance <delta E>] [--max-different <percent>]\n";
+		return 1;
+	}
+
+	Sengine::HeadlessContext context;
+	if (!context.Create()) return 1;
+
+	const std::string rendererName = context.GetRendererName();
+	std::cout << "Rendering with " << rendererName << "\n";
+	if (rendererName.find("llvmpipe") == std::string::npos)
+	{
+		std::cout << "[Render Regression] Warning: References are recorded on llvmpipe, other renderers will differ. Set GALLIUM_DRIVER=llvmpipe.\n";
+	}
+
+	Sengine::Renderer::Init();
+
+	uint32_t colourTexture = 0;
+	glCreateTextures(GL_TEXTURE_2D, 1, &colourTexture);
+	glTextureStorage2D(colourTexture, 1, GL_RGBA8, Width, Height);
+
+	Sengine::RenderView view;
+	view.Width = Width;
+	view.Height = Height;
+	view.ColourTexture = colourTexture;
+
+	std::filesystem::create_directories(options.OutputDirectory);
+	if (options.IsUpdating) std::filesystem::create_directories(options.ReferenceDirectory);
+
+	std::cout << std::left << std::setw(16) << "Scene" << std::right << std::setw(12) << "ms/frame" << std::setw(12) << "GPU ms"
+		<< std::setw(12) << "max dE" << std::setw(12) << "different" << "\n";
+
+	bool isPassing = true;
+	std::vector<SceneResult> results;
+	{
+		//Scenes own textures and meshes, so they go before the renderer and the context.
+		const std::vector<std::unique_ptr<RenderRegression::RegressionScene>> scenes = RenderRegression::CreateScenes();
+		for (const std::unique_ptr<RenderRegression::RegressionScene>& scene : scenes)
+		{
+			const std::string name = scene->GetName();
+			if (!options.Filter.empty() && name.find(options.Filter) == std::string::npos) continue;
+
+			results.push_back(RenderScene(*scene, view, options.FrameCount));
+			const RenderRegression::Image image = ReadTexture(colourTexture);
+
+			std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(3)
+				<< std::setw(12) << results.back().MedianMilliseconds << std::setw(12) << results.back().GpuMilliseconds;
+
+			const std::filesystem::path referencePath = options.ReferenceDirectory / (name + ".png");
+			if (options.IsUpdating)
+			{
+				isPassing = RenderRegression::SavePng(referencePath, image) && isPassing;
+				std::cout << "  updated\n";
+				continue;
+			}
+
+			RenderRegression::Image reference;
+			if (!RenderRegression::LoadPng(referencePath, reference))
+			{
+				isPassing = false;
+				std::cout << "  no reference at " << referencePath.string() << "\n";
+				(void)RenderRegression::SavePng(options.OutputDirectory / (name + ".png"), image);
+				continue;
+			}
+			if (reference.Width != image.Width || reference.Height != image.Height)
+			{
+				isPassing = false;
+				std::cout << "  reference is " << reference.Width << "x" << reference.Height << "\n";
+				continue;
+			}
+
+			const RenderRegression::ImageDifference difference = RenderRegression::CompareImages(reference, image, options.DeltaETolerance);
+			const float differentPercent = difference.DifferentFraction * 100.0f;
+			const bool isMatching = differentPercent <= options.MaxDifferentPercent;
+			isPassing = isPassing && isMatching;
+
+			std::cout << std::setw(12) << std::setprecision(2) << difference.MaxDeltaE << std::setw(11) << differentPercent << "%" << (isMatching ? "" : "  FAILED") << "\n";
+
+			if (!isMatching)
+			{
+				(void)RenderRegression::SavePng(options.OutputDirectory / (name + ".png"), image);
+				(void)RenderRegression::SavePng(options.OutputDirectory / (name + ".difference.png"), difference.DifferenceImage);
+			}
+		}
+	}
+
+	glDeleteTextures(1, &colourTexture);
+	Sengine::Renderer::Destroy();
+	context.Destroy();
+
+	if (!options.JsonPath.empty() && !WriteJson(options.JsonPath, results))
+	{
+		return 1;
+	}
+
+	return isPassing ? 0 : 1;
+}
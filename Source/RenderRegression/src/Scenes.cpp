@@ -0,0 +1,261 @@
+#include "Scenes.h"
+
+#include <cmath>
+#include <cstdint>
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "Sengine/Render/2D/LightGrid2D.h"
+#include "Sengine/Render/3D/Mesh.h"
+#include "Sengine/Render/Renderer.h"
+#include "Sengine/Render/Texture.h"
+
+namespace RenderRegression
+{
+	namespace
+	{
+		glm::mat4 GetQuadTransform(const glm::vec3& position, const glm::vec2& size, float rotation = 0.0f)
+		{
+			return glm::scale(glm::rotate(glm::translate(glm::mat4(1.0f), position), rotation, { 0.0f, 0.0f, 1.0f }), { size.x, size.y, 1.0f });
+		}
+
+		//Looks at the z = 0 plane with the height of the view 10 units.
+		Sengine::Camera2D GetCamera2D(const Sengine::RenderView& view)
+		{
+			const float aspect = static_cast<float>(view.Width) / static_cast<float>(view.Height);
+			return { glm::ortho(-5.0f * aspect, 5.0f * aspect, -5.0f, 5.0f, -10.0f, 10.0f) };
+		}
+
+		std::unique_ptr<Sengine::Texture2D> CreateCheckerTexture(uint32_t size, uint32_t cellSize)
+		{
+			std::vector<uint32_t> pixels(size * size);
+			for (uint32_t y = 0; y < size; y++)
+			{
+				for (uint32_t x = 0; x < size; x++)
+				{
+					const bool isLight = ((x / cellSize) + (y / cellSize)) % 2 == 0;
+					//Every other dark cell is cut out, which exercises the alpha discard.
+					const bool isHole = !isLight && ((x / cellSize) % 4 == 1);
+					pixels[y * size + x] = isHole ? 0x00000000 : isLight ? 0xFFF0F0F0 : 0xFF404080;
+				}
+			}
+			return std::make_unique<Sengine::Texture2D>(size, size, pixels.data());
+		}
+
+		//Rounded bumps, so lights show the shape of each cell.
+		std::unique_ptr<Sengine::Texture2D> CreateBumpNormalMap(uint32_t size, uint32_t cellSize)
+		{
+			std::vector<uint32_t> pixels(size * size);
+			for (uint32_t y = 0; y < size; y++)
+			{
+				for (uint32_t x = 0; x < size; x++)
+				{
+					const glm::vec2 cell = (glm::vec2(x % cellSize, y % cellSize) + 0.5f) / static_cast<float>(cellSize) * 2.0f - 1.0f;
+					const glm::vec3 normal = glm::normalize(glm::vec3(cell * 0.8f, 1.0f));
+					const glm::uvec3 encoded = glm::uvec3((normal * 0.5f + 0.5f) * 255.0f + 0.5f);
+					pixels[y * size + x] = 0xFF000000 | (encoded.z << 16) | (encoded.y << 8) | encoded.x;
+				}
+			}
+			return std::make_unique<Sengine::Texture2D>(size, size, pixels.data());
+		}
+
+		std::unique_ptr<Sengine::Renderer3D::Mesh> CreateCube()
+		{
+			std::vector<glm::vec3> positions;
+			std::vector<glm::vec3> normals;
+			std::vector<uint32_t> indices;
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+				for (const float side : { -1.0f, 1.0f })
+				{
+					glm::vec3 normal(0.0f);
+					normal[axis] = side;
+					glm::vec3 u(0.0f);
+					u[(axis + 1) % 3] = 1.0f;
+					const glm::vec3 v = glm::cross(normal, u);
+
+					const uint32_t first = static_cast<uint32_t>(positions.size());
+					for (const glm::vec2 corner : { glm::vec2(-1.0f, -1.0f), glm::vec2(1.0f, -1.0f), glm::vec2(1.0f, 1.0f), glm::vec2(-1.0f, 1.0f) })
+					{
+						positions.push_back((normal + u * corner.x + v * corner.y) * 0.5f);
+						normals.push_back(normal);
+					}
+					indices.insert(indices.end(), { first, first + 1, first + 2, first, first + 2, first + 3 });
+				}
+			}
+
+			return std::make_unique<Sengine::Renderer3D::Mesh>(positions, normals, indices);
+		}
+
+		//Opaque and transparent quads, solid and textured, overlapping in depth. Covers batching, sorting and alpha cut outs.
+		class SpritesScene : public RegressionScene
+		{
+		public:
+			SpritesScene()
+				: m_Checker(CreateCheckerTexture(64, 8))
+			{
+			}
+
+			const char* GetName() const override { return "Sprites"; }
+
+			void Configure(Sengine::RendererSettings& settings) override
+			{
+				settings.PostProcess.Bloom = false;
+				settings.PostProcess.FXAA = false;
+			}
+
+			void Submit(const Sengine::RenderView& view) override
+			{
+				Sengine::Renderer::BeginRender2D(GetCamera2D(view), view);
+
+				for (int y = 0; y < 8; y++)
+				{
+					for (int x = 0; x < 14; x++)
+					{
+						const glm::vec4 colour = { x / 13.0f, y / 7.0f, 1.0f - x / 13.0f, 1.0f };
+						Sengine::Renderer::Draw2D(GetQuadTransform({ -8.45f + x * 1.3f, -4.55f + y * 1.3f, 0.0f }, { 1.1f, 1.1f }), colour);
+					}
+				}
+
+				Sengine::Renderer::Draw2D(GetQuadTransform({ -3.0f, 0.0f, 1.0f }, { 5.0f, 5.0f }, 0.3f), *m_Checker, { 0.0f, 0.0f, 1.0f, 1.0f });
+				Sengine::Renderer::Draw2D(GetQuadTransform({ 3.5f, 1.0f, 1.0f }, { 3.0f, 6.0f }), *m_Checker, { 0.25f, 0.0f, 0.75f, 1.0f }, { 1.0f, 0.8f, 0.6f, 1.0f });
+
+				//Transparent quads blend back to front whatever order they are submitted in.
+				Sengine::Renderer::Draw2D(GetQuadTransform({ 1.0f, -1.0f, 3.0f }, { 4.0f, 4.0f }), { 1.0f, 0.2f, 0.2f, 0.5f });
+				Sengine::Renderer::Draw2D(GetQuadTransform({ 0.0f, 0.0f, 2.0f }, { 4.0f, 4.0f }), { 0.2f, 1.0f, 0.2f, 0.5f });
+				Sengine::Renderer::Draw2D(GetQuadTransform({ -1.0f, 1.0f, 4.0f }, { 4.0f, 4.0f }), { 0.2f, 0.2f, 1.0f, 0.5f });
+
+				Sengine::Renderer::EndRender2D();
+			}
+
+		private:
+			std::unique_ptr<Sengine::Texture2D> m_Checker;
+		};
+
+		//Normal mapped sprites under point lights of different colours and ranges, binned by the light grid.
+		class LightsScene : public RegressionScene
+		{
+		public:
+			LightsScene()
+				: m_Albedo(CreateCheckerTexture(64, 16)), m_NormalMap(CreateBumpNormalMap(64, 16))
+			{
+			}
+
+			const char* GetName() const override { return "Lights2D"; }
+
+			void Configure(Sengine::RendererSettings& settings) override
+			{
+				settings.PostProcess.Bloom = false;
+				settings.PostProcess.FXAA = false;
+			}
+
+			void Submit(const Sengine::RenderView& view) override
+			{
+				Sengine::RenderView litView = view;
+				litView.AmbientLight = { 0.05f, 0.05f, 0.08f };
+				Sengine::Renderer::BeginRender2D(GetCamera2D(view), litView);
+
+				for (int y = 0; y < 3; y++)
+				{
+					for (int x = 0; x < 5; x++)
+					{
+						Sengine::Renderer::Draw2D(GetQuadTransform({ -7.0f + x * 3.5f, -3.3f + y * 3.3f, 0.0f }, { 3.2f, 3.0f }, 0.1f * (x - y)), *m_Albedo, *m_NormalMap, { 0.0f, 0.0f, 1.0f, 1.0f });
+					}
+				}
+
+				Sengine::Renderer::DrawLight2D({ { -4.0f, 1.0f, 1.5f }, 6.0f, { 1.0f, 0.6f, 0.3f }, 1.5f });
+				Sengine::Renderer::DrawLight2D({ { 3.0f, -2.0f, 1.0f }, 5.0f, { 0.3f, 0.5f, 1.0f }, 2.0f });
+				Sengine::Renderer::DrawLight2D({ { 6.0f, 3.0f, 2.0f }, 4.0f, { 0.4f, 1.0f, 0.4f }, 1.0f });
+
+				Sengine::Renderer::EndRender2D();
+			}
+
+		private:
+			std::unique_ptr<Sengine::Texture2D> m_Albedo;
+			std::unique_ptr<Sengine::Texture2D> m_NormalMap;
+		};
+
+		//Lit cubes in perspective, drawn front to back after a depth prepass.
+		class MeshesScene : public RegressionScene
+		{
+		public:
+			MeshesScene()
+				: m_Cube(CreateCube())
+			{
+			}
+
+			const char* GetName() const override { return "Meshes"; }
+
+			void Configure(Sengine::RendererSettings& settings) override
+			{
+				settings.DepthPrepass = true;
+				settings.PostProcess.Bloom = false;
+			}
+
+			void Submit(const Sengine::RenderView& view) override
+			{
+				Sengine::Camera3D camera;
+				camera.View = glm::lookAt(glm::vec3(6.0f, 5.0f, 9.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+				camera.Projection = glm::perspective(glm::radians(50.0f), static_cast<float>(view.Width) / static_cast<float>(view.Height), 0.1f, 100.0f);
+
+				Sengine::Renderer::BeginRender3D(camera, view);
+
+				Sengine::Renderer::Draw3D(*m_Cube, glm::scale(glm::translate(glm::mat4(1.0f), { 0.0f, -0.5f, 0.0f }), { 12.0f, 0.2f, 12.0f }), { 0.6f, 0.6f, 0.6f, 1.0f });
+				for (int z = -2; z <= 2; z++)
+				{
+					for (int x = -2; x <= 2; x++)
+					{
+						const glm::mat4 transform = glm::rotate(glm::translate(glm::mat4(1.0f), { x * 2.0f, 0.5f, z * 2.0f }), 0.4f * (x + z), { 0.0f, 1.0f, 0.0f });
+						Sengine::Renderer::Draw3D(*m_Cube, transform, { 0.5f + x * 0.1f, 0.5f, 0.5f - z * 0.1f, 1.0f });
+					}
+				}
+
+				Sengine::Renderer::EndRender3D();
+			}
+
+		private:
+			std::unique_ptr<Sengine::Renderer3D::Mesh> m_Cube;
+		};
+
+		//HDR colours through bloom, ACES tonemapping and FXAA on thin rotated edges.
+		class PostProcessScene : public RegressionScene
+		{
+		public:
+			const char* GetName() const override { return "PostProcess"; }
+
+			void Configure(Sengine::RendererSettings& settings) override
+			{
+				settings.PostProcess.Tonemapping = Sengine::Tonemapper::ACES;
+				settings.PostProcess.Exposure = 1.2f;
+				settings.PostProcess.BloomIntensity = 0.2f;
+			}
+
+			void Submit(const Sengine::RenderView& view) override
+			{
+				Sengine::RenderView darkView = view;
+				darkView.ClearColour = { 0.02f, 0.02f, 0.03f, 1.0f };
+				Sengine::Renderer::BeginRender2D(GetCamera2D(view), darkView);
+
+				Sengine::Renderer::Draw2D(GetQuadTransform({ -4.0f, 0.0f, 0.0f }, { 1.5f, 1.5f }), { 8.0f, 3.0f, 1.0f, 1.0f });
+				Sengine::Renderer::Draw2D(GetQuadTransform({ 0.0f, 2.0f, 0.0f }, { 0.5f, 0.5f }), { 1.0f, 4.0f, 10.0f, 1.0f });
+				for (int line = 0; line < 12; line++)
+				{
+					Sengine::Renderer::Draw2D(GetQuadTransform({ 3.0f, -2.0f + line * 0.4f, 0.0f }, { 5.0f, 0.06f }, 0.2f + line * 0.05f), { 0.9f, 0.9f, 0.9f, 1.0f });
+				}
+
+				Sengine::Renderer::EndRender2D();
+			}
+		};
+	}
+
+	std::vector<std::unique_ptr<RegressionScene>> CreateScenes()
+	{
+		std::vector<std::unique_ptr<RegressionScene>> scenes;
+		scenes.push_back(std::make_unique<SpritesScene>());
+		scenes.push_back(std::make_unique<LightsScene>());
+		scenes.push_back(std::make_unique<MeshesScene>());
+		scenes.push_back(std::make_unique<PostProcessScene>());
+		return scenes;
+	}
+}//namespace RenderRegression
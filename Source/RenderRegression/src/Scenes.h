@@ -0,0 +1,28 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+namespace Sengine
+{
+	struct RendererSettings;
+	struct RenderView;
+}
+
+namespace RenderRegression
+{
+	//A fixed scene that renders the same image every frame. Resources are created with the scene, so a context has to be current.
+	class RegressionScene
+	{
+	public:
+		virtual ~RegressionScene() = default;
+
+		[[nodiscard]] virtual const char* GetName() const = 0;
+		//Changes the settings the scene is rendered with, which start from the defaults with dynamic resolution off.
+		virtual void Configure(Sengine::RendererSettings& /*settings*/) {}
+		//Submits the scene's views between Renderer::BeginFrame and EndFrame.
+		virtual void Submit(const Sengine::RenderView& view) = 0;
+	};
+
+	[[nodiscard]] std::vector<std::unique_ptr<RegressionScene>> CreateScenes();
+}//namespace RenderRegression
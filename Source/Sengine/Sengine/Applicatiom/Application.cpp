@@ -1,9 +1,34 @@
 ﻿#include "Application.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include "Window.h"
 
+#include "Audio/Audio.h"
+#include "Core/Determinism.h"
+#include "Core/JobSystem.h"
+#include "Core/Profiler.h"
+#include "Core/StateHasher.h"
+#include "ImGui/ImGuiLayer.h"
+#include "Render/Renderer.h"
+
 namespace Sengine
 {
+	namespace
+	{
+		FrameJobDescription CreateMainThreadJob(const char* name, FrameStage stage, FrameJobFunction function, std::vector<FrameJobID> dependencies = {})
+		{
+			FrameJobDescription description;
+			description.Name = name;
+			description.Stage = stage;
+			description.Function = std::move(function);
+			description.Dependencies = std::move(dependencies);
+			description.IsMainThread = true;
+			return description;
+		}
+	}
+
 	void Application::CreateApplication(const std::shared_ptr<ISengineApp>& app)
 	{
 		m_ClientApp = app;
@@ -17,40 +42,167 @@ namespace Sengine
 
 	bool Application::Init()
 	{
+		SE_PROFILE_BEGIN_SESSION("Profile.json");
+
 		if (!m_ClientApp->OnEarlyInit()) return false;
 
+		m_Settings = m_ClientApp->GetApplicationSettings();
+		m_Settings.FixedTickRate = (std::max)(m_Settings.FixedTickRate, 1u);
+		Determinism::Init(m_Settings.Determinism);
+
 		m_Window = std::make_shared<Window>();
 
 		if (!m_Window->Create(m_ClientApp->GetWindowDescription())) return false;
 
+		Renderer::Init();
+
+		if (!ImGuiLayer::Init(*m_Window)) return false;
+
+		JobSystem::Init();
+		JobSystem::SetIsSerial(m_Settings.Determinism.Enabled && m_Settings.Determinism.SerialJobs);
+
+		//After the job system, streams decode on it.
+		if (m_Settings.Audio.Enabled && !Audio::Init(m_Settings.Audio)) return false;
+
 		if (!m_ClientApp->OnInit()) return false;
 
+		AddFrameJobs();
+		m_ClientApp->OnAddFrameJobs(m_Scheduler);
+
 		return true;
 	}
 
+	void Application::AddFrameJobs()
+	{
+		//Runs what a frame always has, in the same order, split across the stages.
+		m_Scheduler.AddJob(CreateMainThreadJob("Poll Events", FrameStage::Input, [this](const FrameContext&)
+			{
+				m_Window->PollEvents();
+
+				if (m_Window->GetIsKeyDown(Swindow::KeyCode::Escape))
+				{
+					m_Window->SetIsRunning(false);
+				}
+			}));
+
+		m_Scheduler.AddJob(CreateMainThreadJob("Client Fixed Tick", FrameStage::FixedUpdate, [this](const FrameContext& context)
+			{
+				m_ClientApp->OnFixedTick(context.FixedTimestep);
+			}));
+
+		const FrameJobID beginFrame = m_Scheduler.AddJob(CreateMainThreadJob("Begin Frame", FrameStage::Update, [this](const FrameContext&)
+			{
+				Renderer::BeginFrame(static_cast<uint32_t>(m_Window->GetWidth()), static_cast<uint32_t>(m_Window->GetHeight()));
+				ImGuiLayer::Begin();
+			}));
+
+		m_Scheduler.AddJob(CreateMainThreadJob("Client Tick", FrameStage::Update, [this](const FrameContext&)
+			{
+				m_ClientApp->OnTick();
+			}, { beginFrame }));
+
+		m_Scheduler.AddJob(CreateMainThreadJob("Client ImGui Render", FrameStage::LateUpdate, [this](const FrameContext&)
+			{
+				m_ClientApp->OnImGuiRender();
+			}));
+
+		m_Scheduler.AddJob(CreateMainThreadJob("End Frame", FrameStage::Render, [](const FrameContext&)
+			{
+				ImGuiLayer::End();
+				Renderer::EndFrame();
+			}));
+
+		m_Scheduler.AddJob(CreateMainThreadJob("Swap Buffers", FrameStage::Present, [this](const FrameContext&)
+			{
+				m_Window->SwapBuffers();
+			}));
+	}
+
 	void Application::Tick()
 	{
+		using Clock = std::chrono::steady_clock;
+
+		FrameContext context;
+		context.FixedTimestep = 1.0f / static_cast<float>(m_Settings.FixedTickRate);
+		const Clock::duration tickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(context.FixedTimestep));
+		Clock::time_point nextTick = Clock::now();
+		Clock::time_point lastFrame = nextTick;
+
 		while (m_Window->GetIsRunning())
 		{
-			m_Window->PollEvents();
+			SE_PROFILE_SCOPE("Frame");
+
+			//Deterministic runs step once per frame, so neither how many ticks a frame holds nor its delta time
+			//depends on the clock.
+			const Clock::time_point frameStart = Clock::now();
+			context.DeltaTime = Determinism::GetIsEnabled() ? context.FixedTimestep : std::chrono::duration<float>(frameStart - lastFrame).count();
+			lastFrame = frameStart;
+
+			m_Scheduler.RunStage(FrameStage::Input, context);
+			m_Scheduler.RunStage(FrameStage::PreUpdate, context);
 
-			if (m_Window->GetIsKeyDown(Swindow::KeyCode::Escape))
+			if (Determinism::GetIsEnabled())
 			{
-				m_Window->SetIsRunning(false);
-			}	
+				FixedTick(context);
+			}
+			else
+			{
+				const Clock::time_point now = Clock::now();
+				uint32_t tickCount = 0;
+				while (nextTick <= now && tickCount < MaxFixedTicksPerFrame)
+				{
+					FixedTick(context);
+					nextTick += tickDuration;
+					tickCount++;
+				}
+				if (nextTick <= now) nextTick = now + tickDuration;
+			}
+
+			m_Scheduler.RunStage(FrameStage::Update, context);
+			m_Scheduler.RunStage(FrameStage::LateUpdate, context);
+			m_Scheduler.RunStage(FrameStage::Extract, context);
+			m_Scheduler.RunStage(FrameStage::Render, context);
+			m_Scheduler.RunStage(FrameStage::Present, context);
+
+			context.FrameIndex++;
+		}
+
+		//Pipelined jobs of the last frame.
+		m_Scheduler.WaitForIdle();
+	}
+
+	void Application::FixedTick(const FrameContext& context)
+	{
+		SE_PROFILE_FUNCTION();
 
-			m_ClientApp->OnTick();
+		m_Scheduler.RunStage(FrameStage::FixedUpdate, context);
 
-			m_Window->SwapBuffers();
+		if (Determinism::GetIsEnabled())
+		{
+			StateHasher hasher;
+			m_ClientApp->OnHashState(hasher);
+			Determinism::RecordTick(m_FixedTickCount, hasher.GetHash());
 		}
+		m_FixedTickCount++;
 	}
 
-	void Application::Destroy() const
+	void Application::Destroy()
 	{
+		//Workers may still reference client data, so they finish before the client is torn down.
+		Audio::Destroy();
+		JobSystem::Destroy();
+
 		m_ClientApp->OnDestroy();
 
+		ImGuiLayer::Destroy();
+		Renderer::Destroy();
+
 		m_Window->Destroy();
 
 		m_ClientApp->OnLateDestroy();
+
+		Determinism::Destroy();
+
+		SE_PROFILE_END_SESSION();
 	}
 }
@@ -1,4 +1,7 @@
 ﻿#pragma once
+#include <cstdint>
+
+#include "FrameScheduler.h"
 #include "ISengineApp.h"
 
 namespace Sengine
@@ -16,11 +19,20 @@ namespace Sengine
 
 	private:
 		[[nodiscard]] bool Init();
+		void AddFrameJobs();
 		void Tick();
-		void Destroy() const;
+		void FixedTick(const FrameContext& context);
+		void Destroy();
 	private:
+		//Fixed ticks run per frame at most, the rest of a long frame is dropped.
+		static constexpr uint32_t MaxFixedTicksPerFrame = 4;
+
 		std::shared_ptr<ISengineApp> m_ClientApp;
 		std::shared_ptr<Window> m_Window;
+		FrameScheduler m_Scheduler;
+
+		ApplicationSettings m_Settings;
+		uint64_t m_FixedTickCount = 0;
 	};
 }
 
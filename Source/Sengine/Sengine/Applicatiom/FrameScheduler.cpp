@@ -0,0 +1,206 @@
+#include "FrameScheduler.h"
+
+#include "Core/JobSystem.h"
+#include "Core/Profiler.h"
+#include "Utils/Assert.h"
+
+namespace Sengine
+{
+	const char* GetFrameStageName(FrameStage stage)
+	{
+		switch (stage)
+		{
+		case FrameStage::Input: return "Input";
+		case FrameStage::PreUpdate: return "Pre Update";
+		case FrameStage::FixedUpdate: return "Fixed Update";
+		case FrameStage::Update: return "Update";
+		case FrameStage::LateUpdate: return "Late Update";
+		case FrameStage::Extract: return "Extract";
+		case FrameStage::Render: return "Render";
+		case FrameStage::Present: return "Present";
+		}
+		return "Unknown";
+	}
+
+	FrameJobID FrameScheduler::AddJob(FrameJobDescription description)
+	{
+		std::unique_lock lock(m_Mutex);
+		SE_Assert(m_IsRunning, "[Frame Scheduler] Error: Jobs cannot be added while a stage runs");
+		SE_Assert(!description.Function, "[Frame Scheduler] Error: A job needs a function");
+		SE_Assert(description.IsPipelined && (description.IsMainThread || (description.Stage != FrameStage::Extract && description.Stage != FrameStage::Render)),
+			"[Frame Scheduler] Error: Only Extract and Render worker jobs can be pipelined");
+
+		//Pipelined jobs still running read the job they run, and the dependents of those change below.
+		m_Condition.wait(lock, [this]()
+			{
+				for (const StageState& state : m_Stages)
+				{
+					if (state.RunningJobs > 0) return false;
+				}
+				return true;
+			});
+
+		const FrameJobID id = static_cast<FrameJobID>(m_Jobs.size());
+		FrameJob job;
+		for (const FrameJobID dependency : description.Dependencies)
+		{
+			SE_Assert(dependency >= id, "[Frame Scheduler] Error: A job depends on one that has not been added");
+
+			FrameJob& dependencyJob = m_Jobs[dependency];
+			SE_Assert(dependencyJob.Description.Stage > description.Stage, "[Frame Scheduler] Error: A job depends on one of a later stage");
+			SE_Assert(dependencyJob.Description.Stage < description.Stage && dependencyJob.Description.IsPipelined,
+				"[Frame Scheduler] Error: A job depends on a pipelined job of an earlier stage");
+
+			//Earlier stages have finished by the time this one starts.
+			if (dependencyJob.Description.Stage == description.Stage)
+			{
+				dependencyJob.Dependents.push_back(id);
+				job.DependencyCount++;
+			}
+		}
+
+		m_Stages[static_cast<size_t>(description.Stage)].Jobs.push_back(id);
+		job.Description = std::move(description);
+		m_Jobs.push_back(std::move(job));
+
+		return id;
+	}
+
+	void FrameScheduler::RunStage(FrameStage stage, const FrameContext& context)
+	{
+		SE_PROFILE_SCOPE(GetFrameStageName(stage));
+
+		StageState& state = m_Stages[static_cast<size_t>(stage)];
+		std::vector<FrameJobID> readyJobs;
+		{
+			std::unique_lock lock(m_Mutex);
+
+			//The last frame's pipelined jobs read the context and whatever the stage's jobs write.
+			m_Condition.wait(lock, [&state]() { return state.RunningJobs == 0; });
+			if (state.Jobs.empty()) return;
+
+			m_IsRunning = true;
+			state.Context = context;
+			state.RunningJobs = static_cast<uint32_t>(state.Jobs.size());
+			state.WaitedJobs = 0;
+
+			for (const FrameJobID id : state.Jobs)
+			{
+				FrameJob& job = m_Jobs[id];
+				job.PendingDependencies = job.DependencyCount;
+				if (!job.Description.IsPipelined)
+				{
+					state.WaitedJobs++;
+				}
+			}
+			for (const FrameJobID id : state.Jobs)
+			{
+				if (m_Jobs[id].PendingDependencies > 0) continue;
+
+				if (m_Jobs[id].Description.IsMainThread)
+				{
+					m_MainThreadJobs.push_back(id);
+				}
+				else
+				{
+					readyJobs.push_back(id);
+				}
+			}
+		}
+		Submit(readyJobs);
+
+		std::unique_lock lock(m_Mutex);
+		while (true)
+		{
+			if (!m_MainThreadJobs.empty())
+			{
+				const FrameJobID id = m_MainThreadJobs.front();
+				m_MainThreadJobs.pop_front();
+
+				lock.unlock();
+				Execute(id);
+				lock.lock();
+				continue;
+			}
+
+			if (state.WaitedJobs == 0) break;
+
+			m_Condition.wait(lock);
+		}
+		m_IsRunning = false;
+	}
+
+	void FrameScheduler::WaitForIdle()
+	{
+		std::unique_lock lock(m_Mutex);
+		m_Condition.wait(lock, [this]()
+			{
+				for (const StageState& state : m_Stages)
+				{
+					if (state.RunningJobs > 0) return false;
+				}
+				return true;
+			});
+	}
+
+	void FrameScheduler::Execute(FrameJobID id)
+	{
+		const FrameJob& job = m_Jobs[id];
+		{
+			SE_PROFILE_SCOPE(job.Description.Name);
+			job.Description.Function(m_Stages[static_cast<size_t>(job.Description.Stage)].Context);
+		}
+
+		std::vector<FrameJobID> readyJobs;
+		{
+			//Notified under the lock, the scheduler may be gone as soon as WaitForIdle sees the last job finish.
+			std::lock_guard lock(m_Mutex);
+			Release(id, readyJobs);
+			m_Condition.notify_all();
+		}
+
+		Submit(readyJobs);
+	}
+
+	void FrameScheduler::Release(FrameJobID id, std::vector<FrameJobID>& readyJobs)
+	{
+		const FrameJob& job = m_Jobs[id];
+		for (const FrameJobID dependent : job.Dependents)
+		{
+			FrameJob& dependentJob = m_Jobs[dependent];
+			if (--dependentJob.PendingDependencies > 0) continue;
+
+			if (dependentJob.Description.IsMainThread)
+			{
+				m_MainThreadJobs.push_back(dependent);
+			}
+			else
+			{
+				readyJobs.push_back(dependent);
+			}
+		}
+
+		StageState& state = m_Stages[static_cast<size_t>(job.Description.Stage)];
+		state.RunningJobs--;
+		if (!job.Description.IsPipelined)
+		{
+			state.WaitedJobs--;
+		}
+	}
+
+	void FrameScheduler::Submit(const std::vector<FrameJobID>& readyJobs)
+	{
+		for (const FrameJobID id : readyJobs)
+		{
+			//Without workers, e.g. before the job system starts, worker jobs run where they become ready.
+			if (JobSystem::GetThreadCount() == 0)
+			{
+				Execute(id);
+			}
+			else
+			{
+				JobSystem::Submit([this, id]() { Execute(id); });
+			}
+		}
+	}
+}//namespace Sengine
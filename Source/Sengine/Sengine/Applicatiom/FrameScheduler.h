@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace Sengine
+{
+	//The stages of a frame, run in this order. FixedUpdate runs once per fixed tick, any number of times per frame.
+	enum class FrameStage : uint8_t
+	{
+		Input,
+		PreUpdate,
+		FixedUpdate,
+		Update,
+		LateUpdate,
+		//Copies what rendering needs out of the simulation, so rendering can go on while the next frame updates it.
+		Extract,
+		Render,
+		Present,
+	};
+
+	constexpr size_t FrameStageCount = 8;
+
+	[[nodiscard]] const char* GetFrameStageName(FrameStage stage);
+
+	struct FrameContext
+	{
+		uint64_t FrameIndex = 0;
+		//Seconds between the start of the last frame and this one.
+		float DeltaTime = 0.0f;
+		//Seconds a fixed tick steps.
+		float FixedTimestep = 0.0f;
+	};
+
+	using FrameJobID = uint32_t;
+	using FrameJobFunction = std::function<void(const FrameContext&)>;
+
+	struct FrameJobDescription
+	{
+		//Shown in profiles. Has to outlive the scheduler, e.g. a literal.
+		const char* Name = "Frame Job";
+		FrameStage Stage = FrameStage::Update;
+		FrameJobFunction Function;
+		//Jobs of the same stage that finish before this one starts. Jobs of earlier stages always have.
+		std::vector<FrameJobID> Dependencies;
+		//Anything touching OpenGL, the window or ImGui runs on the main thread. Main thread jobs run in the order they
+		//become ready.
+		bool IsMainThread = false;
+		//Extract and Render worker jobs only. The stage does not wait for them, they finish alongside Present and the
+		//next frame's stages up to their own, which waits for them before running them again. What they read has to be
+		//double buffered, e.g. by FrameIndex, and jobs of later stages cannot depend on them.
+		bool IsPipelined = false;
+	};
+
+	//Runs a frame as stages of jobs. Within a stage the jobs form a graph by their dependencies and run on the job
+	//system as soon as what they depend on is done, main thread jobs on the thread calling RunStage. A stage returns
+	//once all of its jobs have finished, apart from pipelined ones. Jobs are added between frames.
+	class FrameScheduler
+	{
+	public:
+		FrameJobID AddJob(FrameJobDescription description);
+
+		void RunStage(FrameStage stage, const FrameContext& context);
+		//Waits for pipelined jobs still running from the last frame.
+		void WaitForIdle();
+
+	private:
+		struct FrameJob
+		{
+			FrameJobDescription Description;
+			//Same stage ones only.
+			std::vector<FrameJobID> Dependents;
+			uint32_t DependencyCount = 0;
+			uint32_t PendingDependencies = 0;
+		};
+
+		struct StageState
+		{
+			std::vector<FrameJobID> Jobs;
+			//A copy that outlives RunStage for pipelined jobs.
+			FrameContext Context;
+			//Jobs of the last run that have not finished, and the ones of those the stage waits for.
+			uint32_t RunningJobs = 0;
+			uint32_t WaitedJobs = 0;
+		};
+
+		void Execute(FrameJobID id);
+		//Queues main thread jobs and returns the worker ones, to be submitted once the lock is released.
+		void Release(FrameJobID id, std::vector<FrameJobID>& readyJobs);
+		void Submit(const std::vector<FrameJobID>& readyJobs);
+
+	private:
+		std::vector<FrameJob> m_Jobs;
+		std::array<StageState, FrameStageCount> m_Stages;
+
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		std::deque<FrameJobID> m_MainThreadJobs;
+		bool m_IsRunning = false;
+	};
+}//namespace Sengine
@@ -0,0 +1,134 @@
+#include "HeadlessContext.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#ifdef SE_PLATFORM_WINDOWS
+#include "Window.h"
+#else
+#include "glad/glad.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+namespace Sengine
+{
+	namespace
+	{
+		void SetDefaultEnvironment(const char* name, const char* value)
+		{
+			if (std::getenv(name)) return;
+
+#ifdef SE_PLATFORM_WINDOWS
+			_putenv_s(name, value);
+#else
+			setenv(name, value, 0);
+#endif
+		}
+
+#ifndef SE_PLATFORM_WINDOWS
+		void* LoadProcAddress(const char* name)
+		{
+			return reinterpret_cast<void*>(eglGetProcAddress(name));
+		}
+#endif
+	}
+
+	HeadlessContext::~HeadlessContext()
+	{
+		Destroy();
+	}
+
+#ifdef SE_PLATFORM_WINDOWS
+	bool HeadlessContext::Create()
+	{
+		SetDefaultEnvironment("MESA_GL_VERSION_OVERRIDE", "4.6");
+		SetDefaultEnvironment("MESA_GLSL_VERSION_OVERRIDE", "460");
+
+		WindowDescription description;
+		description.Title = "Sengine";
+		description.Width = 64;
+		description.Height = 64;
+
+		m_Window = std::make_shared<Window>();
+		if (!m_Window->Create(description))
+		{
+			std::cout << "[Headless Context] Error: Failed to create an OpenGL context\n";
+			m_Window = nullptr;
+			return false;
+		}
+
+		return true;
+	}
+
+	void HeadlessContext::Destroy()
+	{
+		if (!m_Window) return;
+
+		m_Window->Destroy();
+		m_Window = nullptr;
+	}
+#else
+	bool HeadlessContext::Create()
+	{
+		SetDefaultEnvironment("MESA_GL_VERSION_OVERRIDE", "4.6");
+		SetDefaultEnvironment("MESA_GLSL_VERSION_OVERRIDE", "460");
+
+		//Surfaceless needs neither a window nor a display server, just something to render into textures with.
+		const auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+		EGLDisplay display = getPlatformDisplay ? getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr) : EGL_NO_DISPLAY;
+		if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr))
+		{
+			std::cout << "[Headless Context] Error: Failed to open a surfaceless EGL display, is Mesa installed?\n";
+			return false;
+		}
+		m_Display = display;
+
+		const EGLint attributes[] =
+		{
+			EGL_CONTEXT_MAJOR_VERSION, 4,
+			EGL_CONTEXT_MINOR_VERSION, 6,
+			EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+			EGL_NONE,
+		};
+
+		eglBindAPI(EGL_OPENGL_API);
+		EGLContext context = eglCreateContext(display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, attributes);
+		if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+		{
+			std::cout << "[Headless Context] Error: Failed to create an OpenGL 4.6 core context\n";
+			Destroy();
+			return false;
+		}
+		m_Context = context;
+
+		if (!gladLoadGLLoader(&LoadProcAddress))
+		{
+			std::cout << "[Headless Context] Error: Failed to load OpenGL\n";
+			Destroy();
+			return false;
+		}
+
+		return true;
+	}
+
+	void HeadlessContext::Destroy()
+	{
+		if (!m_Display) return;
+
+		eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		if (m_Context) eglDestroyContext(m_Display, m_Context);
+		eglTerminate(m_Display);
+
+		m_Context = nullptr;
+		m_Display = nullptr;
+	}
+#endif
+
+	std::string HeadlessContext::GetRendererName() const
+	{
+		const GLubyte* name = glGetString(GL_RENDERER);
+		return name ? reinterpret_cast<const char*>(name) : "";
+	}
+}//namespace Sengine
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+namespace Sengine
+{
+	class Window;
+}
+
+namespace Sengine
+{
+	//An OpenGL 4.6 core context to render into textures with, and glad loaded for it, for tools that run without a window.
+	//On Linux it comes from EGL without a display server, on Windows from a small window.
+	//Mesa's llvmpipe only advertises 4.5, so the version Mesa reports is raised unless it is already set in the environment;
+	//the engine's shaders use nothing past 4.5.
+	class HeadlessContext
+	{
+	public:
+		HeadlessContext() = default;
+		~HeadlessContext();
+
+		HeadlessContext(const HeadlessContext&) = delete;
+		HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+		[[nodiscard]] bool Create();
+		void Destroy();
+
+		//The GL_RENDERER string, e.g. to check the images come from llvmpipe.
+		[[nodiscard]] std::string GetRendererName() const;
+
+	private:
+#ifdef SE_PLATFORM_WINDOWS
+		std::shared_ptr<Window> m_Window;
+#else
+		void* m_Display = nullptr;
+		void* m_Context = nullptr;
+#endif
+	};
+}//namespace Sengine
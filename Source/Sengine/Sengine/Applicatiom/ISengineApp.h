@@ -1,22 +1,49 @@
 #pragma once
+#include <cstdint>
 #include <memory>
 
+#include "../Audio/Audio.h"
+#include "../Core/Determinism.h"
+
 namespace Sengine
 {
 	struct WindowDescription;
+	class FrameScheduler;
+	class StateHasher;
 }
 
 namespace Sengine
 {
+	struct ApplicationSettings
+	{
+		//Rate OnFixedTick is called at. Frames run as many ticks as the time since the last one covers, up to a few,
+		//so a slow frame drops simulation time instead of falling further behind.
+		uint32_t FixedTickRate = 60;
+		DeterminismSettings Determinism;
+		AudioSettings Audio;
+	};
+
 	class ISengineApp
 	{
 	public:
 		virtual ~ISengineApp() = default;
 
 		[[nodiscard]] virtual WindowDescription& GetWindowDescription() = 0;
+		//Read once, after OnEarlyInit.
+		[[nodiscard]] virtual ApplicationSettings GetApplicationSettings() const { return {}; }
 		virtual bool OnEarlyInit() = 0;
 		virtual bool OnInit() = 0;
+		//Called once after OnInit to add jobs to the frame's stages. The callbacks below are the engine's own main
+		//thread jobs: OnFixedTick in FixedUpdate, OnTick in Update and OnImGuiRender in LateUpdate.
+		virtual void OnAddFrameJobs(FrameScheduler& /*scheduler*/) {}
+		//Called at the fixed tick rate before the frame's OnTick, any number of times per frame. Simulation that has to
+		//give the same results on every run, e.g. physics and gameplay, steps here.
+		virtual void OnFixedTick(float /*timestep*/) {}
+		//Called after each fixed tick in determinism mode. Add everything the simulation owns, in the same order every tick.
+		virtual void OnHashState(StateHasher& /*hasher*/) {}
 		virtual void OnTick() = 0;
+		//Called after OnTick, between the ImGui begin and end of the frame.
+		virtual void OnImGuiRender() {}
 		virtual void OnDestroy() = 0;
 		virtual void OnLateDestroy() = 0;
 	};
@@ -5,9 +5,20 @@ namespace Sengine
 	std::shared_ptr<Window> Window::Create(const WindowDescription& description)
 	{
 		m_NativeWindow = Swindow::Window::Create(description);
+		if (!m_NativeWindow)
+		{
+			std::cout << "[Window] Error: Failed to create " << description.Title << "\n";
+			return nullptr;
+		}
 
 		m_NativeWindow->CreateContext(1, 0, true);
 
+		m_LoaderWindow = m_NativeWindow.get();
+		const int loaded = gladLoadGLLoader(&Window::LoadProcAddress);
+		m_LoaderWindow = nullptr;
+
+		if (!loaded) return nullptr;
+
 		return std::make_shared<Window>();
 	}
 
@@ -35,4 +46,9 @@ namespace Sengine
 	{
 		m_NativeWindow->SwapBuffers();
 	}
+
+	void* Window::LoadProcAddress(const char* name)
+	{
+		return m_LoaderWindow->GetProcAddress(name);
+	}
 }
@@ -1,6 +1,8 @@
 ﻿#pragma once
 #include <future>
 
+//Glad has to be included before Swindow as it pulls in the platform OpenGL header.
+#include "glad/glad.h"
 #include "swindow/Swindow.h"
 
 namespace Sengine
@@ -23,7 +25,17 @@ namespace Sengine
 		void SwapBuffers() const;
 
 		[[nodiscard]] bool GetIsKeyDown(Swindow::KeyCode code) const { return m_NativeWindow->GetIsKeyDown(code); }
+
+		[[nodiscard]] int GetWidth() const { return m_NativeWindow->GetWindowDescription().Width; }
+		[[nodiscard]] int GetHeight() const { return m_NativeWindow->GetWindowDescription().Height; }
+
+		[[nodiscard]] const std::shared_ptr<Swindow::Window>& GetNativeWindow() const { return m_NativeWindow; }
 	private:
+		static void* LoadProcAddress(const char* name);
+	private:
+		//The window used to resolve OpenGL functions while glad is loading.
+		inline static Swindow::Window* m_LoaderWindow = nullptr;
+
 		std::shared_ptr<Swindow::Window> m_NativeWindow;
 	};
 }
@@ -0,0 +1,277 @@
+#include "Audio.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "AudioDevice.h"
+#include "Core/Profiler.h"
+
+namespace Sengine
+{
+	namespace
+	{
+		struct AudioCommand
+		{
+			enum class CommandType : uint8_t
+			{
+				PlayClip,
+				PlayStream,
+				Stop,
+				SetSettings,
+				SetMasterVolume,
+			};
+
+			CommandType Type = CommandType::Stop;
+			VoiceID Voice = 0;
+			std::shared_ptr<AudioClip> Clip;
+			std::shared_ptr<AudioStream> Stream;
+			VoiceSettings Settings;
+			float Volume = 1.0f;
+		};
+	}
+
+	struct Audio::AudioData
+	{
+		AudioSettings Settings;
+		std::unique_ptr<AudioDevice> Device;
+		Sengine::Mixer Mixer;
+
+		std::thread Thread;
+		std::atomic<bool> IsRunning = false;
+
+		//Guards everything below, the mixer itself is only touched by its thread.
+		std::mutex Mutex;
+		std::vector<AudioCommand> Commands;
+		//What the mixer thread took from Commands for the block it is mixing, until Voices includes their effect.
+		std::vector<std::pair<AudioCommand::CommandType, VoiceID>> TakenCommands;
+		//Sorted, as of the last block. Voices still in Commands or TakenCommands are playing too.
+		std::vector<VoiceID> Voices;
+		AudioStatistics Statistics;
+		VoiceID NextVoice = 1;
+
+		AudioData(const AudioSettings& settings)
+			: Settings(settings), Mixer(settings.SampleRate, settings.MaxRealVoices)
+		{
+		}
+	};
+
+	bool Audio::Init(const AudioSettings& settings)
+	{
+		m_Data = new AudioData(settings);
+
+		if (!settings.UseNullDevice)
+		{
+			m_Data->Device = CreatePlatformAudioDevice(settings.SampleRate, settings.BlockFrames);
+			if (!m_Data->Device)
+			{
+				std::cout << "[Audio] Warning: No audio output device, falling back to the null device\n";
+			}
+		}
+		if (!m_Data->Device)
+		{
+			m_Data->Device = std::make_unique<NullAudioDevice>(settings.SampleRate);
+		}
+
+		m_Data->IsRunning = true;
+		m_Data->Thread = std::thread(MixerLoop);
+
+		return true;
+	}
+
+	void Audio::Destroy()
+	{
+		if (!m_Data) return;
+
+		m_Data->IsRunning = false;
+		if (m_Data->Thread.joinable())
+		{
+			m_Data->Thread.join();
+		}
+
+		delete m_Data;
+		m_Data = nullptr;
+	}
+
+	VoiceID Audio::Play(std::shared_ptr<AudioClip> clip, const VoiceSettings& settings)
+	{
+		if (!m_Data || !clip) return 0;
+
+		std::lock_guard lock(m_Data->Mutex);
+		AudioCommand& command = m_Data->Commands.emplace_back();
+		command.Type = AudioCommand::CommandType::PlayClip;
+		command.Voice = m_Data->NextVoice++;
+		command.Clip = std::move(clip);
+		command.Settings = settings;
+		return command.Voice;
+	}
+
+	VoiceID Audio::Play(std::shared_ptr<AudioStream> stream, const VoiceSettings& settings)
+	{
+		if (!m_Data || !stream) return 0;
+
+		std::lock_guard lock(m_Data->Mutex);
+		AudioCommand& command = m_Data->Commands.emplace_back();
+		command.Type = AudioCommand::CommandType::PlayStream;
+		command.Voice = m_Data->NextVoice++;
+		command.Stream = std::move(stream);
+		command.Settings = settings;
+		return command.Voice;
+	}
+
+	void Audio::Stop(VoiceID voice)
+	{
+		if (!m_Data) return;
+
+		std::lock_guard lock(m_Data->Mutex);
+		AudioCommand& command = m_Data->Commands.emplace_back();
+		command.Type = AudioCommand::CommandType::Stop;
+		command.Voice = voice;
+	}
+
+	void Audio::SetVoiceSettings(VoiceID voice, const VoiceSettings& settings)
+	{
+		if (!m_Data) return;
+
+		std::lock_guard lock(m_Data->Mutex);
+		AudioCommand& command = m_Data->Commands.emplace_back();
+		command.Type = AudioCommand::CommandType::SetSettings;
+		command.Voice = voice;
+		command.Settings = settings;
+	}
+
+	void Audio::SetMasterVolume(float volume)
+	{
+		if (!m_Data) return;
+
+		std::lock_guard lock(m_Data->Mutex);
+		AudioCommand& command = m_Data->Commands.emplace_back();
+		command.Type = AudioCommand::CommandType::SetMasterVolume;
+		command.Volume = volume;
+	}
+
+	bool Audio::GetIsPlaying(VoiceID voice)
+	{
+		if (!m_Data || voice == 0) return false;
+
+		std::lock_guard lock(m_Data->Mutex);
+
+		//A stop not yet applied wins over a play before it, nothing else can have touched the voice since.
+		bool isQueued = false;
+		const auto check = [voice, &isQueued](AudioCommand::CommandType type, VoiceID commandVoice)
+		{
+			if (commandVoice != voice) return true;
+			if (type == AudioCommand::CommandType::Stop) return false;
+
+			isQueued = isQueued || type == AudioCommand::CommandType::PlayClip || type == AudioCommand::CommandType::PlayStream;
+			return true;
+		};
+		for (const auto& [type, commandVoice] : m_Data->TakenCommands)
+		{
+			if (!check(type, commandVoice)) return false;
+		}
+		for (const AudioCommand& command : m_Data->Commands)
+		{
+			if (!check(command.Type, command.Voice)) return false;
+		}
+		return isQueued || std::binary_search(m_Data->Voices.begin(), m_Data->Voices.end(), voice);
+	}
+
+	AudioStatistics Audio::GetStatistics()
+	{
+		if (!m_Data) return {};
+
+		std::lock_guard lock(m_Data->Mutex);
+		return m_Data->Statistics;
+	}
+
+	const char* Audio::GetDeviceName()
+	{
+		return m_Data ? m_Data->Device->GetName() : "None";
+	}
+
+	void Audio::MixerLoop()
+	{
+		using Clock = std::chrono::steady_clock;
+
+		const uint32_t blockFrames = m_Data->Settings.BlockFrames;
+		const double blockSeconds = static_cast<double>(blockFrames) / m_Data->Settings.SampleRate;
+
+		std::vector<AudioCommand> commands;
+		std::vector<VoiceID> voices;
+		std::vector<float> left(blockFrames);
+		std::vector<float> right(blockFrames);
+		std::vector<float> output(blockFrames * 2);
+		float load = 0.0f;
+
+		while (m_Data->IsRunning)
+		{
+			{
+				std::lock_guard lock(m_Data->Mutex);
+				commands.swap(m_Data->Commands);
+				for (const AudioCommand& command : commands)
+				{
+					m_Data->TakenCommands.emplace_back(command.Type, command.Voice);
+				}
+			}
+
+			const Clock::time_point start = Clock::now();
+			{
+				SE_PROFILE_SCOPE("Audio Mix");
+
+				Mixer& mixer = m_Data->Mixer;
+				for (AudioCommand& command : commands)
+				{
+					switch (command.Type)
+					{
+					case AudioCommand::CommandType::PlayClip:
+						mixer.Play(command.Voice, std::move(command.Clip), command.Settings);
+						break;
+					case AudioCommand::CommandType::PlayStream:
+						mixer.Play(command.Voice, std::move(command.Stream), command.Settings);
+						break;
+					case AudioCommand::CommandType::Stop:
+						mixer.Stop(command.Voice);
+						break;
+					case AudioCommand::CommandType::SetSettings:
+						mixer.SetSettings(command.Voice, command.Settings);
+						break;
+					case AudioCommand::CommandType::SetMasterVolume:
+						mixer.SetMasterVolume(command.Volume);
+						break;
+					}
+				}
+				commands.clear();
+
+				mixer.Mix(left.data(), right.data(), blockFrames);
+				for (uint32_t frame = 0; frame < blockFrames; frame++)
+				{
+					output[frame * 2] = std::clamp(left[frame], -1.0f, 1.0f);
+					output[frame * 2 + 1] = std::clamp(right[frame], -1.0f, 1.0f);
+				}
+				mixer.GetVoices(voices);
+				std::sort(voices.begin(), voices.end());
+			}
+
+			//Smoothed over roughly a second of blocks so the figure is readable in a debug overlay.
+			const double mixSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+			load += (static_cast<float>(mixSeconds / blockSeconds) - load) * 0.05f;
+
+			{
+				std::lock_guard lock(m_Data->Mutex);
+				m_Data->Voices.swap(voices);
+				m_Data->TakenCommands.clear();
+				m_Data->Statistics.RealVoices = m_Data->Mixer.GetStatistics().RealVoices;
+				m_Data->Statistics.VirtualVoices = m_Data->Mixer.GetStatistics().VirtualVoices;
+				m_Data->Statistics.MixerLoad = load;
+			}
+
+			m_Data->Device->Write(output.data(), blockFrames);
+		}
+	}
+}//namespace Sengine
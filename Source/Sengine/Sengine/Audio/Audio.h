@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "Mixer.h"
+
+namespace Sengine
+{
+	struct AudioSettings
+	{
+		bool Enabled = true;
+		uint32_t SampleRate = 48000;
+		//Frames mixed at a time. Smaller blocks lower the latency of new sounds but wake the mixer thread more often.
+		uint32_t BlockFrames = 512;
+		//Voices past this are virtual, see Mixer.
+		uint32_t MaxRealVoices = 64;
+		//Mixes as usual but discards the output, for headless runs, tests and servers. Also used when the platform
+		//has no output device.
+		bool UseNullDevice = false;
+	};
+
+	struct AudioStatistics
+	{
+		uint32_t RealVoices = 0;
+		uint32_t VirtualVoices = 0;
+		//Time spent mixing a block over the time the block plays for, so 0.05 is five percent of a core.
+		float MixerLoad = 0.0f;
+	};
+
+	//Owns the mixer and the thread that feeds the output device a block at a time. Everything here is thread safe,
+	//commands are queued and applied at the start of the mixer thread's next block.
+	class Audio
+	{
+	public:
+		static bool Init(const AudioSettings& settings);
+		static void Destroy();
+
+		//Returns the voice, or 0 when audio is disabled.
+		static VoiceID Play(std::shared_ptr<AudioClip> clip, const VoiceSettings& settings = {});
+		static VoiceID Play(std::shared_ptr<AudioStream> stream, const VoiceSettings& settings = {});
+		static void Stop(VoiceID voice);
+		static void SetVoiceSettings(VoiceID voice, const VoiceSettings& settings);
+		static void SetMasterVolume(float volume);
+
+		[[nodiscard]] static bool GetIsPlaying(VoiceID voice);
+		[[nodiscard]] static AudioStatistics GetStatistics();
+		[[nodiscard]] static const char* GetDeviceName();
+
+	private:
+		static void MixerLoop();
+
+	private:
+		struct AudioData;
+		inline static AudioData* m_Data = nullptr;
+	};
+}//namespace Sengine
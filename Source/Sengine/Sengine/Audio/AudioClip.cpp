@@ -0,0 +1,27 @@
+#include "AudioClip.h"
+
+#include "WavDecoder.h"
+
+namespace Sengine
+{
+	std::shared_ptr<AudioClip> AudioClip::Load(const std::filesystem::path& path)
+	{
+		WavDecoder decoder;
+		if (!decoder.Open(path)) return nullptr;
+
+		std::vector<float> samples(static_cast<size_t>(decoder.GetFrameCount()) * decoder.GetChannelCount());
+		const uint32_t frameCount = decoder.Decode(samples.data(), static_cast<uint32_t>(decoder.GetFrameCount()));
+		samples.resize(static_cast<size_t>(frameCount) * decoder.GetChannelCount());
+
+		return Create(std::move(samples), decoder.GetChannelCount(), decoder.GetSampleRate());
+	}
+
+	std::shared_ptr<AudioClip> AudioClip::Create(std::vector<float> samples, uint32_t channelCount, uint32_t sampleRate)
+	{
+		std::shared_ptr<AudioClip> clip = std::make_shared<AudioClip>();
+		clip->m_Samples = std::move(samples);
+		clip->m_ChannelCount = channelCount;
+		clip->m_SampleRate = sampleRate;
+		return clip;
+	}
+}//namespace Sengine
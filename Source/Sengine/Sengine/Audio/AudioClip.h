@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace Sengine
+{
+	//A sound decoded into memory up front, for short sounds that are played often. Interleaved float samples, mono or
+	//stereo, at the clip's own sample rate. Voices resample it while mixing.
+	class AudioClip
+	{
+	public:
+		//Any WAV WavDecoder reads. Returns nullptr if it can not be opened or decoded.
+		[[nodiscard]] static std::shared_ptr<AudioClip> Load(const std::filesystem::path& path);
+		[[nodiscard]] static std::shared_ptr<AudioClip> Create(std::vector<float> samples, uint32_t channelCount, uint32_t sampleRate);
+
+		[[nodiscard]] const std::vector<float>& GetSamples() const { return m_Samples; }
+		[[nodiscard]] uint32_t GetFrameCount() const { return static_cast<uint32_t>(m_Samples.size() / m_ChannelCount); }
+		[[nodiscard]] uint32_t GetChannelCount() const { return m_ChannelCount; }
+		[[nodiscard]] uint32_t GetSampleRate() const { return m_SampleRate; }
+
+	private:
+		std::vector<float> m_Samples;
+		uint32_t m_ChannelCount = 1;
+		uint32_t m_SampleRate = 48000;
+	};
+}//namespace Sengine
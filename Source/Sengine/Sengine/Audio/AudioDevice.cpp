@@ -0,0 +1,206 @@
+#include "AudioDevice.h"
+
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#ifdef SE_PLATFORM_WINDOWS
+	#include <Windows.h>
+	#include <mmsystem.h>
+
+	#pragma comment(lib, "winmm.lib")
+#else
+	#include <dlfcn.h>
+#endif
+
+namespace Sengine
+{
+	NullAudioDevice::NullAudioDevice(uint32_t sampleRate)
+		: m_SampleRate(sampleRate), m_Deadline(std::chrono::steady_clock::now())
+	{
+	}
+
+	void NullAudioDevice::Write(const float* /*samples*/, uint32_t frameCount)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		//After a stall, e.g. a debugger break, carries on from now instead of catching up in a burst.
+		const Clock::time_point now = Clock::now();
+		if (now - m_Deadline > std::chrono::milliseconds(100))
+		{
+			m_Deadline = now;
+		}
+
+		m_Deadline += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(static_cast<double>(frameCount) / m_SampleRate));
+		std::this_thread::sleep_until(m_Deadline);
+	}
+
+	namespace
+	{
+#ifdef SE_PLATFORM_WINDOWS
+		//Keeps a few blocks queued with the driver, Write waits for the oldest one to finish playing.
+		class WaveOutAudioDevice final : public AudioDevice
+		{
+		public:
+			~WaveOutAudioDevice() override
+			{
+				if (!m_Device) return;
+
+				waveOutReset(m_Device);
+				for (WAVEHDR& header : m_Headers)
+				{
+					if (header.dwFlags & WHDR_PREPARED)
+					{
+						waveOutUnprepareHeader(m_Device, &header, sizeof(WAVEHDR));
+					}
+				}
+				waveOutClose(m_Device);
+				CloseHandle(m_Event);
+			}
+
+			bool Open(uint32_t sampleRate)
+			{
+				m_Event = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+
+				WAVEFORMATEX format = {};
+				format.wFormatTag = WAVE_FORMAT_IEEE_FLOAT;
+				format.nChannels = 2;
+				format.nSamplesPerSec = sampleRate;
+				format.wBitsPerSample = 32;
+				format.nBlockAlign = format.nChannels * format.wBitsPerSample / 8;
+				format.nAvgBytesPerSec = sampleRate * format.nBlockAlign;
+
+				if (waveOutOpen(&m_Device, WAVE_MAPPER, &format, reinterpret_cast<DWORD_PTR>(m_Event), 0, CALLBACK_EVENT) != MMSYSERR_NOERROR)
+				{
+					m_Device = nullptr;
+					CloseHandle(m_Event);
+					return false;
+				}
+				return true;
+			}
+
+			void Write(const float* samples, uint32_t frameCount) override
+			{
+				WAVEHDR& header = m_Headers[m_Next];
+				while (header.dwFlags & WHDR_PREPARED && !(header.dwFlags & WHDR_DONE))
+				{
+					WaitForSingleObject(m_Event, 100);
+				}
+				if (header.dwFlags & WHDR_PREPARED)
+				{
+					waveOutUnprepareHeader(m_Device, &header, sizeof(WAVEHDR));
+				}
+
+				std::vector<float>& buffer = m_Buffers[m_Next];
+				buffer.assign(samples, samples + frameCount * 2);
+
+				header = {};
+				header.lpData = reinterpret_cast<LPSTR>(buffer.data());
+				header.dwBufferLength = static_cast<DWORD>(buffer.size() * sizeof(float));
+				waveOutPrepareHeader(m_Device, &header, sizeof(WAVEHDR));
+				waveOutWrite(m_Device, &header, sizeof(WAVEHDR));
+
+				m_Next = (m_Next + 1) % BufferCount;
+			}
+
+			[[nodiscard]] const char* GetName() const override { return "WinMM"; }
+
+		private:
+			static constexpr size_t BufferCount = 4;
+
+			HWAVEOUT m_Device = nullptr;
+			HANDLE m_Event = nullptr;
+			std::array<WAVEHDR, BufferCount> m_Headers = {};
+			std::array<std::vector<float>, BufferCount> m_Buffers;
+			size_t m_Next = 0;
+		};
+#else
+		//The simple API of PulseAudio, which PipeWire provides too. Loaded at run time so the engine neither links nor
+		//needs it, machines without it fall back to the null device.
+		struct PulseSampleSpec
+		{
+			int Format;
+			uint32_t Rate;
+			uint8_t Channels;
+		};
+
+		struct PulseBufferAttributes
+		{
+			uint32_t MaxLength;
+			uint32_t TargetLength;
+			uint32_t PreBuffer;
+			uint32_t MinimumRequest;
+			uint32_t FragmentSize;
+		};
+
+		using PulseNew = void* (*)(const char*, const char*, int, const char*, const char*, const PulseSampleSpec*, const void*, const PulseBufferAttributes*, int*);
+		using PulseWrite = int (*)(void*, const void*, size_t, int*);
+		using PulseFree = void (*)(void*);
+
+		constexpr int PulseStreamPlayback = 1;
+		constexpr int PulseSampleFloat32LE = 5;
+
+		class PulseAudioDevice final : public AudioDevice
+		{
+		public:
+			~PulseAudioDevice() override
+			{
+				if (m_Stream) m_Free(m_Stream);
+				if (m_Library) dlclose(m_Library);
+			}
+
+			bool Open(uint32_t sampleRate, uint32_t blockFrames)
+			{
+				m_Library = dlopen("libpulse-simple.so.0", RTLD_NOW | RTLD_LOCAL);
+				if (!m_Library) return false;
+
+				const PulseNew create = reinterpret_cast<PulseNew>(dlsym(m_Library, "pa_simple_new"));
+				m_Write = reinterpret_cast<PulseWrite>(dlsym(m_Library, "pa_simple_write"));
+				m_Free = reinterpret_cast<PulseFree>(dlsym(m_Library, "pa_simple_free"));
+				if (!create || !m_Write || !m_Free) return false;
+
+				//About four blocks of latency, the server's defaults buffer far more than a game wants.
+				const PulseSampleSpec specification = { PulseSampleFloat32LE, sampleRate, 2 };
+				PulseBufferAttributes attributes;
+				attributes.MaxLength = ~0u;
+				attributes.TargetLength = blockFrames * 4 * 2 * static_cast<uint32_t>(sizeof(float));
+				attributes.PreBuffer = ~0u;
+				attributes.MinimumRequest = ~0u;
+				attributes.FragmentSize = ~0u;
+
+				int error = 0;
+				m_Stream = create(nullptr, "Sengine", PulseStreamPlayback, nullptr, "Output", &specification, nullptr, &attributes, &error);
+				return m_Stream != nullptr;
+			}
+
+			void Write(const float* samples, uint32_t frameCount) override
+			{
+				int error = 0;
+				m_Write(m_Stream, samples, frameCount * 2 * sizeof(float), &error);
+			}
+
+			[[nodiscard]] const char* GetName() const override { return "PulseAudio"; }
+
+		private:
+			void* m_Library = nullptr;
+			void* m_Stream = nullptr;
+			PulseWrite m_Write = nullptr;
+			PulseFree m_Free = nullptr;
+		};
+#endif
+	}
+
+	std::unique_ptr<AudioDevice> CreatePlatformAudioDevice(uint32_t sampleRate, uint32_t blockFrames)
+	{
+#ifdef SE_PLATFORM_WINDOWS
+		std::unique_ptr<WaveOutAudioDevice> device = std::make_unique<WaveOutAudioDevice>();
+		if (!device->Open(sampleRate)) return nullptr;
+#else
+		std::unique_ptr<PulseAudioDevice> device = std::make_unique<PulseAudioDevice>();
+		if (!device->Open(sampleRate, blockFrames)) return nullptr;
+#endif
+		return device;
+	}
+}//namespace Sengine
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace Sengine
+{
+	//Where the mixed output goes, interleaved stereo float frames. Write blocks until the device has room for them,
+	//which is what paces the mixer thread.
+	class AudioDevice
+	{
+	public:
+		virtual ~AudioDevice() = default;
+
+		virtual void Write(const float* samples, uint32_t frameCount) = 0;
+
+		[[nodiscard]] virtual const char* GetName() const = 0;
+	};
+
+	//Takes samples at the rate a real device would and discards them, for headless runs, tests, servers and machines
+	//without audio.
+	class NullAudioDevice final : public AudioDevice
+	{
+	public:
+		explicit NullAudioDevice(uint32_t sampleRate);
+
+		void Write(const float* samples, uint32_t frameCount) override;
+
+		[[nodiscard]] const char* GetName() const override { return "Null"; }
+
+	private:
+		uint32_t m_SampleRate = 48000;
+		std::chrono::steady_clock::time_point m_Deadline;
+	};
+
+	//The default output of the platform: WinMM on Windows, PulseAudio elsewhere when it is installed. Returns nullptr
+	//if there is none.
+	[[nodiscard]] std::unique_ptr<AudioDevice> CreatePlatformAudioDevice(uint32_t sampleRate, uint32_t blockFrames);
+}//namespace Sengine
@@ -0,0 +1,108 @@
+#include "AudioStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Core/JobSystem.h"
+
+namespace Sengine
+{
+	std::shared_ptr<AudioStream> AudioStream::Open(const std::filesystem::path& path, bool isLooping)
+	{
+		std::shared_ptr<AudioStream> stream = std::make_shared<AudioStream>();
+		if (!stream->m_Decoder.Open(path) || stream->m_Decoder.GetFrameCount() == 0) return nullptr;
+
+		stream->m_IsLooping = isLooping;
+		stream->m_ChannelCount = stream->m_Decoder.GetChannelCount();
+		stream->m_SampleRate = stream->m_Decoder.GetSampleRate();
+		stream->m_Ring.resize(static_cast<size_t>(RingFrames) * stream->m_ChannelCount);
+
+		//The start is decoded before the first read, so playback does not begin with an underrun.
+		stream->DecodeAhead();
+		return stream;
+	}
+
+	uint32_t AudioStream::Read(float* samples, uint32_t frameCount)
+	{
+		const uint64_t read = m_ReadFrames.load(std::memory_order_relaxed);
+		const uint64_t written = m_WrittenFrames.load(std::memory_order_acquire);
+		const uint32_t count = static_cast<uint32_t>(std::min<uint64_t>(frameCount, written - read));
+
+		for (uint32_t copied = 0; copied < count;)
+		{
+			const uint32_t index = static_cast<uint32_t>((read + copied) % RingFrames);
+			const uint32_t frames = std::min(count - copied, RingFrames - index);
+			std::memcpy(samples + copied * m_ChannelCount, m_Ring.data() + index * m_ChannelCount, frames * m_ChannelCount * sizeof(float));
+			copied += frames;
+		}
+		m_ReadFrames.store(read + count, std::memory_order_release);
+
+		if (RingFrames - (written - read - count) >= DecodeFrames && !m_IsEndOfFile.load(std::memory_order_relaxed))
+		{
+			RequestDecode();
+		}
+		return count;
+	}
+
+	bool AudioStream::GetIsFinished() const
+	{
+		return m_IsEndOfFile.load(std::memory_order_acquire) && m_ReadFrames.load(std::memory_order_relaxed) == m_WrittenFrames.load(std::memory_order_acquire);
+	}
+
+	void AudioStream::RequestDecode()
+	{
+		if (m_IsDecoding.exchange(true, std::memory_order_acq_rel)) return;
+
+		//Without workers, e.g. in a tool that never started them, the caller decodes.
+		if (JobSystem::GetThreadCount() == 0)
+		{
+			DecodeAhead();
+			return;
+		}
+
+		//Holds the stream alive until the job is done, even if its voice stopped in the meantime.
+		JobSystem::Submit([stream = shared_from_this()]() { stream->DecodeAhead(); });
+	}
+
+	void AudioStream::DecodeAhead()
+	{
+		const uint64_t written = m_WrittenFrames.load(std::memory_order_relaxed);
+		const uint64_t free = RingFrames - (written - m_ReadFrames.load(std::memory_order_acquire));
+
+		uint64_t decoded = 0;
+		bool isEndOfFile = false;
+		bool isRewound = false;
+		while (decoded < free && !isEndOfFile)
+		{
+			const uint32_t index = static_cast<uint32_t>((written + decoded) % RingFrames);
+			const uint32_t frames = static_cast<uint32_t>(std::min<uint64_t>(free - decoded, RingFrames - index));
+			const uint32_t count = m_Decoder.Decode(m_Ring.data() + index * m_ChannelCount, frames);
+			decoded += count;
+
+			//A file that turns out to hold no frames, e.g. one truncated inside its first block, would rewind forever.
+			const bool isEmpty = isRewound && count == 0;
+			isRewound = false;
+
+			if (count < frames)
+			{
+				if (m_IsLooping && !isEmpty)
+				{
+					m_Decoder.Rewind();
+					isRewound = true;
+				}
+				else
+				{
+					isEndOfFile = true;
+				}
+			}
+		}
+
+		//The frames are published before the end, so the stream never looks finished with frames still to read.
+		m_WrittenFrames.store(written + decoded, std::memory_order_release);
+		if (isEndOfFile)
+		{
+			m_IsEndOfFile.store(true, std::memory_order_release);
+		}
+		m_IsDecoding.store(false, std::memory_order_release);
+	}
+}//namespace Sengine
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "WavDecoder.h"
+
+namespace Sengine
+{
+	//Music and other long sounds, decoded a little ahead of playback rather than all at once. Decoding runs as jobs,
+	//so the mixer thread only copies what is ready and never waits on the disk. One reader, the mixer, and one decode
+	//job at a time share a ring of decoded frames.
+	class AudioStream : public std::enable_shared_from_this<AudioStream>
+	{
+	public:
+		//Returns nullptr if the file can not be opened or decoded.
+		[[nodiscard]] static std::shared_ptr<AudioStream> Open(const std::filesystem::path& path, bool isLooping = false);
+
+		//Copies up to frameCount decoded frames and starts decoding more. Returns fewer when decoding has fallen behind or
+		//the stream has ended.
+		uint32_t Read(float* samples, uint32_t frameCount);
+		//Everything has been decoded and read.
+		[[nodiscard]] bool GetIsFinished() const;
+
+		[[nodiscard]] uint32_t GetChannelCount() const { return m_ChannelCount; }
+		[[nodiscard]] uint32_t GetSampleRate() const { return m_SampleRate; }
+
+	private:
+		void RequestDecode();
+		void DecodeAhead();
+
+	private:
+		//About a second and a half at 44.1 kHz. Decoding starts again once a quarter of it is free.
+		static constexpr uint32_t RingFrames = 65536;
+		static constexpr uint32_t DecodeFrames = RingFrames / 4;
+
+		//Only touched by the decode job, which the flag below keeps to one at a time.
+		WavDecoder m_Decoder;
+		bool m_IsLooping = false;
+
+		uint32_t m_ChannelCount = 0;
+		uint32_t m_SampleRate = 0;
+
+		std::vector<float> m_Ring;
+		//Frames written and read since the start, the ring index is these modulo its size.
+		std::atomic<uint64_t> m_WrittenFrames = 0;
+		std::atomic<uint64_t> m_ReadFrames = 0;
+		std::atomic<bool> m_IsDecoding = false;
+		std::atomic<bool> m_IsEndOfFile = false;
+	};
+}//namespace Sengine
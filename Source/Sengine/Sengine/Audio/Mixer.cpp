@@ -0,0 +1,397 @@
+#include "Mixer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "Core/Profiler.h"
+#include "Math/SoAMath.h"
+
+namespace Sengine
+{
+	namespace
+	{
+		constexpr uint32_t LaneCount = static_cast<uint32_t>(Math::LaneCount);
+		constexpr float FractionScale = 1.0f / 4294967296.0f;
+
+		//Adds frameCount frames resampled from an interleaved mono or stereo source, with the gains ramping by the deltas
+		//each frame. The source has to hold the frame after the last one read, it is interpolated towards.
+		void MixResampled(const float* source, uint32_t channelCount, uint64_t position, uint64_t step, float gainLeft, float gainRight,
+			float deltaLeft, float deltaRight, uint32_t frameCount, float* left, float* right)
+		{
+			//Mono reads the same channel for both sides.
+			const uint32_t rightChannel = channelCount - 1;
+
+			for (uint32_t frame = 0; frame < frameCount; frame += LaneCount)
+			{
+				const uint32_t laneCount = std::min(LaneCount, frameCount - frame);
+
+				//The gather is scalar, everything after it is a straight loop over the lanes the compiler vectorises.
+				alignas(32) float firstLeft[LaneCount] = {};
+				alignas(32) float secondLeft[LaneCount] = {};
+				alignas(32) float firstRight[LaneCount] = {};
+				alignas(32) float secondRight[LaneCount] = {};
+				alignas(32) float fraction[LaneCount] = {};
+				for (uint32_t lane = 0; lane < laneCount; lane++)
+				{
+					const uint64_t lanePosition = position + step * (frame + lane);
+					const size_t index = static_cast<size_t>(lanePosition >> 32) * channelCount;
+					firstLeft[lane] = source[index];
+					secondLeft[lane] = source[index + channelCount];
+					firstRight[lane] = source[index + rightChannel];
+					secondRight[lane] = source[index + channelCount + rightChannel];
+					fraction[lane] = static_cast<float>(lanePosition & 0xFFFFFFFF) * FractionScale;
+				}
+
+				alignas(32) float mixedLeft[LaneCount];
+				alignas(32) float mixedRight[LaneCount];
+				for (uint32_t lane = 0; lane < LaneCount; lane++)
+				{
+					const float laneFrame = static_cast<float>(frame + lane);
+					mixedLeft[lane] = (firstLeft[lane] + (secondLeft[lane] - firstLeft[lane]) * fraction[lane]) * (gainLeft + deltaLeft * laneFrame);
+					mixedRight[lane] = (firstRight[lane] + (secondRight[lane] - firstRight[lane]) * fraction[lane]) * (gainRight + deltaRight * laneFrame);
+				}
+
+				if (laneCount == LaneCount)
+				{
+					for (uint32_t lane = 0; lane < LaneCount; lane++)
+					{
+						left[frame + lane] += mixedLeft[lane];
+						right[frame + lane] += mixedRight[lane];
+					}
+				}
+				else
+				{
+					for (uint32_t lane = 0; lane < laneCount; lane++)
+					{
+						left[frame + lane] += mixedLeft[lane];
+						right[frame + lane] += mixedRight[lane];
+					}
+				}
+			}
+		}
+
+		//Sources at the output rate need no interpolation, which makes the whole loop contiguous.
+		void MixUnresampled(const float* source, uint32_t channelCount, float gainLeft, float gainRight, float deltaLeft, float deltaRight,
+			uint32_t frameCount, float* left, float* right)
+		{
+			if (channelCount == 1)
+			{
+				for (uint32_t frame = 0; frame < frameCount; frame++)
+				{
+					const float laneFrame = static_cast<float>(frame);
+					left[frame] += source[frame] * (gainLeft + deltaLeft * laneFrame);
+					right[frame] += source[frame] * (gainRight + deltaRight * laneFrame);
+				}
+				return;
+			}
+
+			for (uint32_t frame = 0; frame < frameCount; frame++)
+			{
+				const float laneFrame = static_cast<float>(frame);
+				left[frame] += source[frame * 2] * (gainLeft + deltaLeft * laneFrame);
+				right[frame] += source[frame * 2 + 1] * (gainRight + deltaRight * laneFrame);
+			}
+		}
+
+		void MixSpan(const float* source, uint32_t channelCount, uint64_t position, uint64_t step, float gainLeft, float gainRight,
+			float deltaLeft, float deltaRight, uint32_t frameCount, float* left, float* right)
+		{
+			if (step == (1ull << 32) && (position & 0xFFFFFFFF) == 0)
+			{
+				MixUnresampled(source + (position >> 32) * channelCount, channelCount, gainLeft, gainRight, deltaLeft, deltaRight, frameCount, left, right);
+			}
+			else
+			{
+				MixResampled(source, channelCount, position, step, gainLeft, gainRight, deltaLeft, deltaRight, frameCount, left, right);
+			}
+		}
+
+		//Mono pans with constant power, stereo balances one side down.
+		void GetGains(const VoiceSettings& settings, uint32_t channelCount, float& left, float& right)
+		{
+			const float pan = std::clamp(settings.Pan, -1.0f, 1.0f);
+			if (channelCount == 1)
+			{
+				const float angle = (pan + 1.0f) * 0.785398163f;
+				left = settings.Volume * std::cos(angle);
+				right = settings.Volume * std::sin(angle);
+			}
+			else
+			{
+				left = settings.Volume * std::min(1.0f, 1.0f - pan);
+				right = settings.Volume * std::min(1.0f, 1.0f + pan);
+			}
+		}
+	}
+
+	Mixer::Mixer(uint32_t sampleRate, uint32_t maxRealVoices)
+		: m_SampleRate(sampleRate), m_MaxRealVoices(maxRealVoices)
+	{
+	}
+
+	void Mixer::Play(VoiceID id, std::shared_ptr<AudioClip> clip, const VoiceSettings& settings)
+	{
+		if (!clip || clip->GetFrameCount() == 0) return;
+
+		Voice& voice = m_Voices.emplace_back();
+		voice.ID = id;
+		voice.Clip = std::move(clip);
+		voice.Settings = settings;
+	}
+
+	void Mixer::Play(VoiceID id, std::shared_ptr<AudioStream> stream, const VoiceSettings& settings)
+	{
+		if (!stream) return;
+
+		Voice& voice = m_Voices.emplace_back();
+		voice.ID = id;
+		voice.Stream = std::move(stream);
+		voice.Settings = settings;
+	}
+
+	void Mixer::Stop(VoiceID id)
+	{
+		const auto voice = std::find_if(m_Voices.begin(), m_Voices.end(), [id](const Voice& other) { return other.ID == id; });
+		if (voice != m_Voices.end())
+		{
+			voice->IsFinished = true;
+		}
+	}
+
+	void Mixer::SetSettings(VoiceID id, const VoiceSettings& settings)
+	{
+		const auto voice = std::find_if(m_Voices.begin(), m_Voices.end(), [id](const Voice& other) { return other.ID == id; });
+		if (voice != m_Voices.end())
+		{
+			voice->Settings = settings;
+		}
+	}
+
+	void Mixer::GetVoices(std::vector<VoiceID>& voices) const
+	{
+		voices.clear();
+		for (const Voice& voice : m_Voices)
+		{
+			if (!voice.IsFinished)
+			{
+				voices.push_back(voice.ID);
+			}
+		}
+	}
+
+	void Mixer::Mix(float* left, float* right, uint32_t frameCount)
+	{
+		SE_PROFILE_FUNCTION();
+
+		std::fill(left, left + frameCount, 0.0f);
+		std::fill(right, right + frameCount, 0.0f);
+
+		m_Voices.erase(std::remove_if(m_Voices.begin(), m_Voices.end(), [](const Voice& voice) { return voice.IsFinished; }), m_Voices.end());
+		SelectRealVoices();
+
+		m_Statistics = {};
+		for (Voice& voice : m_Voices)
+		{
+			const uint32_t channelCount = voice.Clip ? voice.Clip->GetChannelCount() : voice.Stream->GetChannelCount();
+			float targetLeft = 0.0f;
+			float targetRight = 0.0f;
+			if (voice.IsReal)
+			{
+				GetGains(voice.Settings, channelCount, targetLeft, targetRight);
+			}
+
+			//Virtual voices that have faded out only keep their place.
+			if (!voice.IsReal && voice.GainLeft == 0.0f && voice.GainRight == 0.0f)
+			{
+				AdvanceVirtual(voice, frameCount);
+				m_Statistics.VirtualVoices++;
+				continue;
+			}
+
+			if (voice.Clip)
+			{
+				MixClip(voice, left, right, frameCount, targetLeft, targetRight);
+			}
+			else
+			{
+				MixStream(voice, left, right, frameCount, targetLeft, targetRight);
+			}
+			m_Statistics.RealVoices++;
+		}
+
+		if (m_MasterVolume != 1.0f)
+		{
+			for (uint32_t frame = 0; frame < frameCount; frame++)
+			{
+				left[frame] *= m_MasterVolume;
+				right[frame] *= m_MasterVolume;
+			}
+		}
+	}
+
+	void Mixer::SelectRealVoices()
+	{
+		m_Order.clear();
+		for (uint32_t index = 0; index < m_Voices.size(); index++)
+		{
+			m_Order.push_back(index);
+		}
+
+		//Partitioned rather than sorted, only which side of the limit a voice is on matters.
+		const size_t realCount = std::min<size_t>(m_MaxRealVoices, m_Order.size());
+		if (realCount < m_Order.size())
+		{
+			std::nth_element(m_Order.begin(), m_Order.begin() + realCount, m_Order.end(), [this](uint32_t first, uint32_t second)
+			{
+				const Voice& a = m_Voices[first];
+				const Voice& b = m_Voices[second];
+				if ((a.Stream != nullptr) != (b.Stream != nullptr)) return a.Stream != nullptr;
+				if (a.Settings.Priority != b.Settings.Priority) return a.Settings.Priority > b.Settings.Priority;
+				if (a.Settings.Volume != b.Settings.Volume) return a.Settings.Volume > b.Settings.Volume;
+				return a.ID < b.ID;
+			});
+		}
+
+		for (size_t order = 0; order < m_Order.size(); order++)
+		{
+			Voice& voice = m_Voices[m_Order[order]];
+			const bool isReal = order < realCount;
+
+			//Voices heard from their very first frame start at full volume, any later change ramps.
+			if (isReal && !voice.IsReal && voice.Position == 0 && voice.WindowFrames == 0)
+			{
+				GetGains(voice.Settings, voice.Clip ? voice.Clip->GetChannelCount() : voice.Stream->GetChannelCount(), voice.GainLeft, voice.GainRight);
+			}
+			voice.IsReal = isReal;
+		}
+	}
+
+	void Mixer::MixClip(Voice& voice, float* left, float* right, uint32_t frameCount, float targetLeft, float targetRight)
+	{
+		const float* samples = voice.Clip->GetSamples().data();
+		const uint32_t channelCount = voice.Clip->GetChannelCount();
+		const uint32_t clipFrames = voice.Clip->GetFrameCount();
+		const uint64_t step = GetStep(voice);
+
+		const float deltaLeft = (targetLeft - voice.GainLeft) / static_cast<float>(frameCount);
+		const float deltaRight = (targetRight - voice.GainRight) / static_cast<float>(frameCount);
+
+		//Interpolating reads the frame after the position, so all but the last frame of the clip take the vector path.
+		const uint64_t end = static_cast<uint64_t>(clipFrames - 1) << 32;
+		uint32_t mixed = 0;
+		while (mixed < frameCount && !voice.IsFinished)
+		{
+			const float gainLeft = voice.GainLeft + deltaLeft * static_cast<float>(mixed);
+			const float gainRight = voice.GainRight + deltaRight * static_cast<float>(mixed);
+
+			if (voice.Position < end)
+			{
+				const uint32_t count = static_cast<uint32_t>(std::min<uint64_t>(frameCount - mixed, (end - 1 - voice.Position) / step + 1));
+				MixSpan(samples, channelCount, voice.Position, step, gainLeft, gainRight, deltaLeft, deltaRight, count, left + mixed, right + mixed);
+				voice.Position += step * count;
+				mixed += count;
+				continue;
+			}
+
+			//The last frame interpolates towards the first when looping, or towards silence.
+			const size_t index = static_cast<size_t>(voice.Position >> 32) * channelCount;
+			const float fraction = static_cast<float>(voice.Position & 0xFFFFFFFF) * FractionScale;
+			const float firstLeft = samples[index];
+			const float firstRight = samples[index + channelCount - 1];
+			const float secondLeft = voice.Settings.IsLooping ? samples[0] : 0.0f;
+			const float secondRight = voice.Settings.IsLooping ? samples[channelCount - 1] : 0.0f;
+			left[mixed] += (firstLeft + (secondLeft - firstLeft) * fraction) * gainLeft;
+			right[mixed] += (firstRight + (secondRight - firstRight) * fraction) * gainRight;
+
+			voice.Position += step;
+			mixed++;
+			if ((voice.Position >> 32) >= clipFrames)
+			{
+				if (voice.Settings.IsLooping)
+				{
+					voice.Position %= static_cast<uint64_t>(clipFrames) << 32;
+				}
+				else
+				{
+					voice.IsFinished = true;
+				}
+			}
+		}
+
+		voice.GainLeft = targetLeft;
+		voice.GainRight = targetRight;
+	}
+
+	void Mixer::MixStream(Voice& voice, float* left, float* right, uint32_t frameCount, float targetLeft, float targetRight)
+	{
+		AudioStream& stream = *voice.Stream;
+		const uint32_t channelCount = stream.GetChannelCount();
+		const uint64_t step = GetStep(voice);
+
+		//Tops the window up to every frame the block reads, including the one after the last.
+		const uint32_t neededFrames = static_cast<uint32_t>((voice.Position + step * (frameCount - 1)) >> 32) + 2;
+		if (voice.WindowFrames < neededFrames)
+		{
+			voice.Window.resize(std::max<size_t>(voice.Window.size(), static_cast<size_t>(neededFrames + 1) * channelCount));
+			voice.WindowFrames += stream.Read(voice.Window.data() + voice.WindowFrames * channelCount, neededFrames - voice.WindowFrames);
+
+			//A frame of silence after the end, so the last real frame can be interpolated too.
+			if (voice.WindowFrames < neededFrames && stream.GetIsFinished())
+			{
+				std::fill(voice.Window.begin() + voice.WindowFrames * channelCount, voice.Window.begin() + (voice.WindowFrames + 1) * channelCount, 0.0f);
+				voice.WindowFrames++;
+				voice.IsFinished = true;
+			}
+		}
+
+		//Decoding that has fallen behind leaves the rest of the block silent, the stream picks up where it stopped.
+		const uint64_t end = voice.WindowFrames >= 2 ? static_cast<uint64_t>(voice.WindowFrames - 1) << 32 : 0;
+		const uint32_t count = voice.Position < end ? static_cast<uint32_t>(std::min<uint64_t>(frameCount, (end - 1 - voice.Position) / step + 1)) : 0;
+
+		const float deltaLeft = (targetLeft - voice.GainLeft) / static_cast<float>(frameCount);
+		const float deltaRight = (targetRight - voice.GainRight) / static_cast<float>(frameCount);
+		MixSpan(voice.Window.data(), channelCount, voice.Position, step, voice.GainLeft, voice.GainRight, deltaLeft, deltaRight, count, left, right);
+		voice.Position += step * count;
+		voice.GainLeft = targetLeft;
+		voice.GainRight = targetRight;
+
+		//Frames behind the position are not needed again.
+		const uint32_t consumed = std::min(static_cast<uint32_t>(voice.Position >> 32), voice.WindowFrames);
+		std::memmove(voice.Window.data(), voice.Window.data() + consumed * channelCount, (voice.WindowFrames - consumed) * channelCount * sizeof(float));
+		voice.WindowFrames -= consumed;
+		voice.Position -= static_cast<uint64_t>(consumed) << 32;
+
+		//Finished only once everything up to the silence has been mixed.
+		if (voice.IsFinished && voice.WindowFrames > 1)
+		{
+			voice.IsFinished = false;
+		}
+	}
+
+	void Mixer::AdvanceVirtual(Voice& voice, uint32_t frameCount)
+	{
+		if (!voice.Clip) return;
+
+		const uint64_t length = static_cast<uint64_t>(voice.Clip->GetFrameCount()) << 32;
+		voice.Position += GetStep(voice) * frameCount;
+		if (voice.Position >= length)
+		{
+			if (voice.Settings.IsLooping)
+			{
+				voice.Position %= length;
+			}
+			else
+			{
+				voice.IsFinished = true;
+			}
+		}
+	}
+
+	uint64_t Mixer::GetStep(const Voice& voice) const
+	{
+		const uint32_t sampleRate = voice.Clip ? voice.Clip->GetSampleRate() : voice.Stream->GetSampleRate();
+		const double step = static_cast<double>(sampleRate) / m_SampleRate * std::clamp(voice.Settings.Pitch, 0.01f, 16.0f);
+		return std::max<uint64_t>(1, static_cast<uint64_t>(step * 4294967296.0));
+	}
+}//namespace Sengine
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "AudioClip.h"
+#include "AudioStream.h"
+
+namespace Sengine
+{
+	using VoiceID = uint32_t;
+
+	struct VoiceSettings
+	{
+		float Volume = 1.0f;
+		//-1 is fully left and 1 fully right.
+		float Pan = 0.0f;
+		//Playback speed, 2 is an octave up.
+		float Pitch = 1.0f;
+		//Clips only, streams loop when they are opened.
+		bool IsLooping = false;
+		//Above the real voice limit the highest priority voices are mixed and the rest only keep their place until
+		//they are heard again. Louder voices win ties.
+		int32_t Priority = 0;
+	};
+
+	struct MixerStatistics
+	{
+		uint32_t RealVoices = 0;
+		uint32_t VirtualVoices = 0;
+	};
+
+	//Mixes clip and stream voices into planar stereo at the output sample rate, resampling each with linear
+	//interpolation. Voices beyond the real voice limit are virtual: they cost a position update per block instead of a
+	//mix, so hundreds of sounds can play with only the most important ones heard. Volume changes and voices moving
+	//between real and virtual ramp across a block rather than clicking. Not thread safe, the audio system owns one on
+	//its mixer thread.
+	class Mixer
+	{
+	public:
+		Mixer(uint32_t sampleRate, uint32_t maxRealVoices);
+
+		//The ID is the caller's, so it can be handed out before the mixer thread sees the voice.
+		void Play(VoiceID id, std::shared_ptr<AudioClip> clip, const VoiceSettings& settings);
+		//Streams are never made virtual, skipping ahead in one would mean decoding what was skipped anyway.
+		void Play(VoiceID id, std::shared_ptr<AudioStream> stream, const VoiceSettings& settings);
+		void Stop(VoiceID id);
+		void SetSettings(VoiceID id, const VoiceSettings& settings);
+		void SetMasterVolume(float volume) { m_MasterVolume = volume; }
+
+		//Overwrites left and right with the next frameCount frames.
+		void Mix(float* left, float* right, uint32_t frameCount);
+
+		//IDs of the voices still playing, virtual ones included.
+		void GetVoices(std::vector<VoiceID>& voices) const;
+		[[nodiscard]] const MixerStatistics& GetStatistics() const { return m_Statistics; }
+		[[nodiscard]] uint32_t GetSampleRate() const { return m_SampleRate; }
+
+	private:
+		struct Voice
+		{
+			VoiceID ID = 0;
+			std::shared_ptr<AudioClip> Clip;
+			std::shared_ptr<AudioStream> Stream;
+			VoiceSettings Settings;
+
+			//Frames into the clip, or into the window for streams, in 32.32 fixed point so long clips do not drift.
+			uint64_t Position = 0;
+			//Gains reached at the end of the last block, where the next block's ramp starts.
+			float GainLeft = 0.0f;
+			float GainRight = 0.0f;
+			bool IsReal = false;
+			bool IsFinished = false;
+
+			//Streams only: decoded frames from the one under the position on.
+			std::vector<float> Window;
+			uint32_t WindowFrames = 0;
+		};
+
+		void SelectRealVoices();
+		void MixClip(Voice& voice, float* left, float* right, uint32_t frameCount, float targetLeft, float targetRight);
+		void MixStream(Voice& voice, float* left, float* right, uint32_t frameCount, float targetLeft, float targetRight);
+		void AdvanceVirtual(Voice& voice, uint32_t frameCount);
+
+		[[nodiscard]] uint64_t GetStep(const Voice& voice) const;
+
+	private:
+		uint32_t m_SampleRate = 48000;
+		uint32_t m_MaxRealVoices = 64;
+		float m_MasterVolume = 1.0f;
+
+		std::vector<Voice> m_Voices;
+		std::vector<uint32_t> m_Order;
+		MixerStatistics m_Statistics;
+	};
+}//namespace Sengine
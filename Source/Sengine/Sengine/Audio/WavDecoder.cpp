@@ -0,0 +1,272 @@
+#include "WavDecoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace Sengine
+{
+	namespace
+	{
+		constexpr uint16_t FormatPCM = 1;
+		constexpr uint16_t FormatFloat = 3;
+		constexpr uint16_t FormatImaAdpcm = 0x11;
+		//The real format is in the first two bytes of the sub format GUID.
+		constexpr uint16_t FormatExtensible = 0xFFFE;
+
+		constexpr int32_t AdpcmIndexTable[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+		constexpr int32_t AdpcmStepTable[89] =
+		{
+			7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97,
+			107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+			876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871,
+			5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623,
+			27086, 29794, 32767,
+		};
+
+		uint16_t ReadU16(const uint8_t* data) { return static_cast<uint16_t>(data[0] | (data[1] << 8)); }
+		uint32_t ReadU32(const uint8_t* data) { return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24); }
+
+		float DecodeAdpcmNibble(uint8_t nibble, int32_t& predictor, int32_t& index)
+		{
+			const int32_t step = AdpcmStepTable[index];
+			int32_t difference = step >> 3;
+			if (nibble & 1) difference += step >> 2;
+			if (nibble & 2) difference += step >> 1;
+			if (nibble & 4) difference += step;
+			if (nibble & 8) difference = -difference;
+
+			predictor = std::clamp(predictor + difference, -32768, 32767);
+			index = std::clamp(index + AdpcmIndexTable[nibble], 0, 88);
+			return static_cast<float>(predictor) / 32768.0f;
+		}
+	}
+
+	bool WavDecoder::Open(const std::filesystem::path& path)
+	{
+		if (!m_File.Open(path)) return false;
+
+		if (!Open(m_File.GetData(), m_File.GetSize()))
+		{
+			std::cout << "[Wav Decoder] Error: Could not decode " << path.string() << "\n";
+			m_File.Close();
+			return false;
+		}
+		return true;
+	}
+
+	bool WavDecoder::Open(const uint8_t* data, size_t size)
+	{
+		m_Samples = nullptr;
+		m_SamplesSize = 0;
+		if (!data || size < 12 || std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0) return false;
+
+		uint16_t format = 0;
+		uint64_t factFrameCount = 0;
+		bool hasFormat = false;
+		for (size_t offset = 12; offset + 8 <= size;)
+		{
+			const uint8_t* chunk = data + offset;
+			const size_t chunkSize = std::min<size_t>(ReadU32(chunk + 4), size - offset - 8);
+			const uint8_t* body = chunk + 8;
+
+			if (std::memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16)
+			{
+				format = ReadU16(body);
+				m_ChannelCount = ReadU16(body + 2);
+				m_SampleRate = ReadU32(body + 4);
+				m_BlockAlign = ReadU16(body + 12);
+				m_BitsPerSample = ReadU16(body + 14);
+				if (format == FormatExtensible && chunkSize >= 26)
+				{
+					format = ReadU16(body + 24);
+				}
+				if (format == FormatImaAdpcm && chunkSize >= 20)
+				{
+					m_FramesPerBlock = ReadU16(body + 18);
+				}
+				hasFormat = true;
+			}
+			else if (std::memcmp(chunk, "fact", 4) == 0 && chunkSize >= 4)
+			{
+				factFrameCount = ReadU32(body);
+			}
+			else if (std::memcmp(chunk, "data", 4) == 0)
+			{
+				m_Samples = body;
+				m_SamplesSize = chunkSize;
+			}
+
+			//Chunks are padded to an even size.
+			offset += 8 + chunkSize + (chunkSize & 1);
+		}
+
+		if (!hasFormat || !m_Samples || m_ChannelCount < 1 || m_ChannelCount > 2 || m_SampleRate == 0 || m_BlockAlign == 0) return false;
+
+		//Frames are read a block align apart but a whole sample per channel long, so the two have to agree.
+		if ((format == FormatPCM || format == FormatFloat) && m_BlockAlign != m_ChannelCount * m_BitsPerSample / 8)
+		{
+			std::cout << "[Wav Decoder] Error: Block align " << m_BlockAlign << " does not match " << m_ChannelCount << " channels of " << m_BitsPerSample << " bits\n";
+			return false;
+		}
+
+		if (format == FormatPCM && (m_BitsPerSample == 8 || m_BitsPerSample == 16 || m_BitsPerSample == 24))
+		{
+			m_Format = Format::PCM;
+			m_FrameCount = m_SamplesSize / m_BlockAlign;
+		}
+		else if (format == FormatFloat && m_BitsPerSample == 32)
+		{
+			m_Format = Format::Float;
+			m_FrameCount = m_SamplesSize / m_BlockAlign;
+		}
+		else if (format == FormatImaAdpcm && m_BitsPerSample == 4)
+		{
+			//Four bytes of header per channel hold the first frame, then every byte holds two.
+			if (m_BlockAlign <= 4 * m_ChannelCount) return false;
+			const uint32_t framesPerBlock = (m_BlockAlign - 4 * m_ChannelCount) * 2 / m_ChannelCount + 1;
+			if (m_FramesPerBlock == 0 || m_FramesPerBlock > framesPerBlock) m_FramesPerBlock = framesPerBlock;
+
+			m_Format = Format::ImaAdpcm;
+			m_Block.resize(static_cast<size_t>(m_FramesPerBlock) * m_ChannelCount);
+
+			const size_t blockCount = (m_SamplesSize + m_BlockAlign - 1) / m_BlockAlign;
+			//A fact chunk can claim more frames than the blocks hold.
+			m_FrameCount = blockCount * m_FramesPerBlock;
+			if (factFrameCount != 0) m_FrameCount = std::min<uint64_t>(m_FrameCount, factFrameCount);
+		}
+		else
+		{
+			std::cout << "[Wav Decoder] Error: Unsupported format " << format << " with " << m_BitsPerSample << " bits per sample\n";
+			return false;
+		}
+
+		Rewind();
+		return true;
+	}
+
+	uint32_t WavDecoder::Decode(float* samples, uint32_t frameCount)
+	{
+		const uint32_t count = static_cast<uint32_t>(std::min<uint64_t>(frameCount, m_FrameCount - m_Position));
+		const uint32_t sampleCount = count * m_ChannelCount;
+
+		if (m_Format == Format::ImaAdpcm)
+		{
+			uint32_t decoded = 0;
+			while (decoded < count)
+			{
+				if (m_BlockPosition == m_BlockFrames)
+				{
+					const uint64_t position = m_Position + decoded;
+					DecodeAdpcmBlock(static_cast<size_t>(position / m_FramesPerBlock));
+					m_BlockPosition = static_cast<uint32_t>(position % m_FramesPerBlock);
+
+					//A fact chunk that promises more frames than the last block holds.
+					if (m_BlockPosition >= m_BlockFrames)
+					{
+						m_FrameCount = position;
+						m_Position = position;
+						return decoded;
+					}
+				}
+
+				const uint32_t frames = std::min(count - decoded, m_BlockFrames - m_BlockPosition);
+				std::memcpy(samples + decoded * m_ChannelCount, m_Block.data() + m_BlockPosition * m_ChannelCount, frames * m_ChannelCount * sizeof(float));
+				m_BlockPosition += frames;
+				decoded += frames;
+			}
+		}
+		else
+		{
+			const uint8_t* source = m_Samples + m_Position * m_BlockAlign;
+			const uint32_t bytesPerSample = m_BitsPerSample / 8;
+			for (uint32_t sample = 0; sample < sampleCount; sample++)
+			{
+				const uint8_t* bytes = source + sample * bytesPerSample;
+				if (m_Format == Format::Float)
+				{
+					std::memcpy(&samples[sample], bytes, sizeof(float));
+				}
+				else if (bytesPerSample == 1)
+				{
+					samples[sample] = (static_cast<float>(bytes[0]) - 128.0f) / 128.0f;
+				}
+				else if (bytesPerSample == 2)
+				{
+					samples[sample] = static_cast<float>(static_cast<int16_t>(ReadU16(bytes))) / 32768.0f;
+				}
+				else
+				{
+					const int32_t value = static_cast<int32_t>((bytes[0] << 8) | (bytes[1] << 16) | (static_cast<uint32_t>(bytes[2]) << 24)) >> 8;
+					samples[sample] = static_cast<float>(value) / 8388608.0f;
+				}
+			}
+		}
+
+		m_Position += count;
+		return count;
+	}
+
+	void WavDecoder::Rewind()
+	{
+		m_Position = 0;
+		m_BlockFrames = 0;
+		m_BlockPosition = 0;
+	}
+
+	void WavDecoder::DecodeAdpcmBlock(size_t block)
+	{
+		//A truncated last block without a whole header decodes to nothing, which ends the file there.
+		const size_t headerSize = 4 * m_ChannelCount;
+		const size_t offset = block * m_BlockAlign;
+		if (offset >= m_SamplesSize || m_SamplesSize - offset < headerSize)
+		{
+			m_BlockFrames = 0;
+			return;
+		}
+
+		const uint8_t* source = m_Samples + offset;
+		const size_t size = std::min<size_t>(m_BlockAlign, m_SamplesSize - offset);
+
+		int32_t predictors[2] = {};
+		int32_t indices[2] = {};
+		for (uint32_t channel = 0; channel < m_ChannelCount; channel++)
+		{
+			predictors[channel] = static_cast<int16_t>(ReadU16(source + channel * 4));
+			indices[channel] = std::clamp<int32_t>(source[channel * 4 + 2], 0, 88);
+			m_Block[channel] = static_cast<float>(predictors[channel]) / 32768.0f;
+		}
+
+		//Mono is a byte per two frames. Stereo alternates four bytes, eight frames, of each channel.
+		uint32_t frames = 1;
+		if (m_ChannelCount == 1)
+		{
+			for (size_t byte = headerSize; byte < size && frames < m_FramesPerBlock; byte++)
+			{
+				m_Block[frames++] = DecodeAdpcmNibble(source[byte] & 0x0F, predictors[0], indices[0]);
+				if (frames < m_FramesPerBlock)
+				{
+					m_Block[frames++] = DecodeAdpcmNibble(source[byte] >> 4, predictors[0], indices[0]);
+				}
+			}
+		}
+		else
+		{
+			for (size_t group = headerSize; group + 8 <= size && frames + 8 <= m_FramesPerBlock; group += 8)
+			{
+				for (uint32_t channel = 0; channel < 2; channel++)
+				{
+					for (uint32_t byte = 0; byte < 4; byte++)
+					{
+						const uint8_t value = source[group + channel * 4 + byte];
+						m_Block[(frames + byte * 2) * 2 + channel] = DecodeAdpcmNibble(value & 0x0F, predictors[channel], indices[channel]);
+						m_Block[(frames + byte * 2 + 1) * 2 + channel] = DecodeAdpcmNibble(value >> 4, predictors[channel], indices[channel]);
+					}
+				}
+				frames += 8;
+			}
+		}
+
+		m_BlockFrames = frames;
+	}
+}//namespace Sengine
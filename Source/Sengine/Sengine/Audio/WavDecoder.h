@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "../Core/MappedFile.h"
+
+namespace Sengine
+{
+	//Decodes WAV files a piece at a time into interleaved float samples, so music can be played from disk without being
+	//decoded up front. Reads 8, 16 and 24 bit PCM, 32 bit float and IMA ADPCM, which is four bits a sample and a
+	//quarter of the size of 16 bit PCM. Mono and stereo only.
+	class WavDecoder
+	{
+	public:
+		//Maps the file, pages are read as decoding reaches them.
+		[[nodiscard]] bool Open(const std::filesystem::path& path);
+		//Decodes from memory owned by the caller, which has to outlive the decoder.
+		[[nodiscard]] bool Open(const uint8_t* data, size_t size);
+
+		//Decodes up to frameCount frames and returns how many it decoded, fewer only at the end of the file.
+		uint32_t Decode(float* samples, uint32_t frameCount);
+		void Rewind();
+
+		[[nodiscard]] uint32_t GetSampleRate() const { return m_SampleRate; }
+		[[nodiscard]] uint32_t GetChannelCount() const { return m_ChannelCount; }
+		[[nodiscard]] uint64_t GetFrameCount() const { return m_FrameCount; }
+
+	private:
+		enum class Format
+		{
+			PCM,
+			Float,
+			ImaAdpcm,
+		};
+
+		void DecodeAdpcmBlock(size_t block);
+
+	private:
+		MappedFile m_File;
+		const uint8_t* m_Samples = nullptr;
+		size_t m_SamplesSize = 0;
+
+		Format m_Format = Format::PCM;
+		uint32_t m_SampleRate = 0;
+		uint32_t m_ChannelCount = 0;
+		uint32_t m_BitsPerSample = 0;
+		uint32_t m_BlockAlign = 0;
+		uint64_t m_FrameCount = 0;
+		uint64_t m_Position = 0;
+
+		//IMA ADPCM decodes whole blocks, the frames of the current one not returned yet are kept here.
+		uint32_t m_FramesPerBlock = 0;
+		std::vector<float> m_Block;
+		uint32_t m_BlockFrames = 0;
+		uint32_t m_BlockPosition = 0;
+	};
+}//namespace Sengine
@@ -0,0 +1,82 @@
+#include "Determinism.h"
+
+#include <cfenv>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define SE_HAS_MXCSR
+#endif
+
+namespace Sengine
+{
+	struct Determinism::DeterminismData
+	{
+		DeterminismSettings Settings;
+		std::ofstream HashLog;
+	};
+
+	void Determinism::Init(const DeterminismSettings& settings)
+	{
+		m_Data = new DeterminismData();
+		m_Data->Settings = settings;
+
+		if (!settings.Enabled)
+		{
+			m_Data->Settings.Seed = (static_cast<uint64_t>(std::random_device()()) << 32) | std::random_device()();
+			return;
+		}
+
+		ApplyFloatingPointState();
+
+		if (!settings.HashLogPath.empty())
+		{
+			m_Data->HashLog.open(settings.HashLogPath);
+			if (!m_Data->HashLog.is_open())
+			{
+				std::cout << "[Determinism] Error: Failed to write " << settings.HashLogPath.string() << "\n";
+			}
+		}
+	}
+
+	void Determinism::Destroy()
+	{
+		delete m_Data;
+		m_Data = nullptr;
+	}
+
+	bool Determinism::GetIsEnabled()
+	{
+		return m_Data && m_Data->Settings.Enabled;
+	}
+
+	const DeterminismSettings& Determinism::GetSettings()
+	{
+		return m_Data->Settings;
+	}
+
+	void Determinism::ApplyFloatingPointState()
+	{
+		std::fesetround(FE_TONEAREST);
+
+#ifdef SE_HAS_MXCSR
+		//The power on default: every exception masked, round to nearest, no flush to zero or denormals as zero.
+		_mm_setcsr(0x1F80);
+#endif
+	}
+
+	Random Determinism::CreateRandom(uint64_t stream)
+	{
+		return Random(m_Data ? m_Data->Settings.Seed : 0, stream);
+	}
+
+	void Determinism::RecordTick(uint64_t tick, uint64_t hash)
+	{
+		if (!m_Data->HashLog.is_open()) return;
+
+		m_Data->HashLog << tick << " " << std::hex << std::setw(16) << std::setfill('0') << hash << std::dec << std::setfill(' ') << "\n";
+	}
+}//namespace Sengine
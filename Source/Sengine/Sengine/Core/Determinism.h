@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+#include "Random.h"
+
+namespace Sengine
+{
+	struct DeterminismSettings
+	{
+		//Runs the simulation the same way every time: one fixed tick per frame, seeded random numbers, the same floating
+		//point state on every thread and, with SerialJobs, jobs run in submission order. The state is hashed after each tick.
+		bool Enabled = false;
+		uint64_t Seed = 0;
+		//Runs every job on the thread that submits it. A run with parallel jobs that logs the same hashes as a serial one
+		//shows parallelising did not change the results.
+		bool SerialJobs = true;
+		//One "tick hash" line per fixed tick, so two runs can be diffed to find the first tick that differs.
+		std::filesystem::path HashLogPath = "StateHashes.txt";
+	};
+
+	class Determinism
+	{
+	public:
+		//Called by the application before the job system starts.
+		static void Init(const DeterminismSettings& settings);
+		static void Destroy();
+
+		[[nodiscard]] static bool GetIsEnabled();
+		[[nodiscard]] static const DeterminismSettings& GetSettings();
+
+		//Rounds to nearest and keeps denormals rather than flushing them, whatever a library or driver changed them to.
+		//Applied to the main thread and to each job worker when determinism is enabled.
+		static void ApplyFloatingPointState();
+
+		//A generator for one system or job, seeded from the session seed and the stream. Give each user its own stream,
+		//its numbers then do not depend on which thread runs it or what else drew numbers first.
+		//Without determinism the session seed is random.
+		[[nodiscard]] static Random CreateRandom(uint64_t stream);
+
+		//Writes the hash of the state at the end of a tick to the hash log.
+		static void RecordTick(uint64_t tick, uint64_t hash);
+
+	private:
+		struct DeterminismData;
+		inline static DeterminismData* m_Data = nullptr;
+	};
+}//namespace Sengine
@@ -0,0 +1,88 @@
+#include "JobSystem.h"
+
+#include "Determinism.h"
+#include "Profiler.h"
+
+#include "Utils/Assert.h"
+
+namespace Sengine
+{
+	void JobSystem::Init(uint32_t threadCount)
+	{
+		SE_Assert(m_IsRunning, "[Job System] Error: Init has been called twice");
+
+		if (threadCount == 0)
+		{
+			const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+
+		m_IsRunning = true;
+
+		m_Workers.reserve(threadCount);
+		for (uint32_t i = 0; i < threadCount; i++)
+		{
+			m_Workers.emplace_back(&JobSystem::WorkerLoop);
+		}
+	}
+
+	void JobSystem::Destroy()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_QueueMutex);
+			m_IsRunning = false;
+		}
+		m_QueueCondition.notify_all();
+
+		for (std::thread& worker : m_Workers)
+		{
+			worker.join();
+		}
+
+		m_Workers.clear();
+		m_Queue.clear();
+	}
+
+	void JobSystem::Submit(Job job)
+	{
+		if (m_IsSerial)
+		{
+			SE_PROFILE_SCOPE("Job");
+			job();
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_QueueMutex);
+			m_Queue.push_back(std::move(job));
+		}
+		m_QueueCondition.notify_one();
+	}
+
+	void JobSystem::WorkerLoop()
+	{
+		//Threads start with the platform's floating point state, not the main thread's.
+		if (Determinism::GetIsEnabled())
+		{
+			Determinism::ApplyFloatingPointState();
+		}
+
+		while (true)
+		{
+			Job job;
+			{
+				std::unique_lock<std::mutex> lock(m_QueueMutex);
+				m_QueueCondition.wait(lock, [] { return !m_IsRunning || !m_Queue.empty(); });
+
+				//Drain what is left so nothing that was submitted is lost on shutdown.
+				if (m_Queue.empty()) return;
+
+				job = std::move(m_Queue.front());
+				m_Queue.pop_front();
+			}
+
+			SE_PROFILE_SCOPE("Job");
+			job();
+		}
+	}
+}//namespace Sengine
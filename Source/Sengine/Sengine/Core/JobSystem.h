@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Sengine
+{
+	using Job = std::function<void()>;
+
+	//A fixed pool of worker threads that executes jobs in submission order.
+	//Jobs must not touch OpenGL as the context is only current on the main thread.
+	class JobSystem
+	{
+	public:
+		//Starts the workers. A thread count of 0 uses one worker per hardware thread, minus the main thread.
+		static void Init(uint32_t threadCount = 0);
+		static void Destroy();
+
+		static void Submit(Job job);
+
+		//Serial mode runs each job on the submitting thread before Submit returns, so jobs run one at a time in
+		//submission order. Used by determinism mode as the reference parallel runs are compared against.
+		static void SetIsSerial(bool isSerial) { m_IsSerial = isSerial; }
+		[[nodiscard]] static bool GetIsSerial() { return m_IsSerial; }
+
+		[[nodiscard]] static uint32_t GetThreadCount() { return static_cast<uint32_t>(m_Workers.size()); }
+
+	private:
+		static void WorkerLoop();
+
+	private:
+		inline static std::vector<std::thread> m_Workers;
+		inline static std::deque<Job> m_Queue;
+		inline static std::mutex m_QueueMutex;
+		inline static std::condition_variable m_QueueCondition;
+		inline static bool m_IsRunning = false;
+		inline static bool m_IsSerial = false;
+	};
+}//namespace Sengine
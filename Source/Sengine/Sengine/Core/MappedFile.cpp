@@ -0,0 +1,91 @@
+#include "MappedFile.h"
+
+#include <iostream>
+
+#ifdef SE_PLATFORM_WINDOWS
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace Sengine
+{
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open(const std::filesystem::path& path)
+	{
+		Close();
+
+#ifdef SE_PLATFORM_WINDOWS
+		m_File = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (m_File == INVALID_HANDLE_VALUE)
+		{
+			m_File = nullptr;
+			std::cout << "[Mapped File] Error: Could not open " << path.string() << "\n";
+			return false;
+		}
+
+		LARGE_INTEGER size = {};
+		GetFileSizeEx(m_File, &size);
+		m_Size = static_cast<size_t>(size.QuadPart);
+
+		m_Mapping = m_Size > 0 ? CreateFileMappingW(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+		if (m_Mapping)
+		{
+			m_Data = static_cast<const uint8_t*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+		}
+#else
+		const int file = open(path.c_str(), O_RDONLY);
+		if (file < 0)
+		{
+			std::cout << "[Mapped File] Error: Could not open " << path.string() << "\n";
+			return false;
+		}
+
+		struct stat status = {};
+		fstat(file, &status);
+		m_Size = static_cast<size_t>(status.st_size);
+
+		if (m_Size > 0)
+		{
+			void* data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, file, 0);
+			m_Data = data == MAP_FAILED ? nullptr : static_cast<const uint8_t*>(data);
+		}
+
+		//The mapping keeps the file alive on its own.
+		close(file);
+#endif
+
+		if (!m_Data)
+		{
+			std::cout << "[Mapped File] Error: Could not map " << path.string() << "\n";
+			Close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+#ifdef SE_PLATFORM_WINDOWS
+		if (m_Data) UnmapViewOfFile(m_Data);
+		if (m_Mapping) CloseHandle(m_Mapping);
+		if (m_File) CloseHandle(m_File);
+
+		m_Mapping = nullptr;
+		m_File = nullptr;
+#else
+		if (m_Data) munmap(const_cast<uint8_t*>(m_Data), m_Size);
+#endif
+
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+}//namespace Sengine
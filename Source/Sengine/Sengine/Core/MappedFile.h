@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace Sengine
+{
+	//A read only view of a whole file mapped into memory. Pages are loaded by the OS as they are touched,
+	//so large cooked data costs nothing until it is used. Non-copyable as it owns the mapping.
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		[[nodiscard]] bool Open(const std::filesystem::path& path);
+		void Close();
+
+		[[nodiscard]] const uint8_t* GetData() const { return m_Data; }
+		[[nodiscard]] size_t GetSize() const { return m_Size; }
+		[[nodiscard]] bool GetIsOpen() const { return m_Data != nullptr; }
+
+	private:
+		const uint8_t* m_Data = nullptr;
+		size_t m_Size = 0;
+
+#ifdef SE_PLATFORM_WINDOWS
+		void* m_File = nullptr;
+		void* m_Mapping = nullptr;
+#endif
+	};
+}//namespace Sengine
@@ -0,0 +1,185 @@
+#include "PngEncoder.h"
+
+#include <array>
+#include <fstream>
+#include <iostream>
+
+namespace Sengine
+{
+	namespace
+	{
+		//Writes bits least significant first, the order deflate packs them in.
+		class BitWriter
+		{
+		public:
+			explicit BitWriter(std::vector<uint8_t>& bytes)
+				: m_Bytes(bytes)
+			{
+			}
+
+			void Write(uint32_t value, uint32_t count)
+			{
+				for (uint32_t bit = 0; bit < count; bit++)
+				{
+					if (m_BitCount == 0) m_Bytes.push_back(0);
+					m_Bytes.back() |= static_cast<uint8_t>(((value >> bit) & 1) << m_BitCount);
+					m_BitCount = (m_BitCount + 1) % 8;
+				}
+			}
+
+			//Huffman codes are stored most significant bit first.
+			void WriteCode(uint32_t code, uint32_t length)
+			{
+				for (uint32_t bit = length; bit-- > 0;)
+				{
+					Write((code >> bit) & 1, 1);
+				}
+			}
+
+		private:
+			std::vector<uint8_t>& m_Bytes;
+			uint32_t m_BitCount = 0;
+		};
+
+		//Deflate's fixed Huffman code of a literal, length or end of block symbol.
+		void WriteSymbol(BitWriter& writer, uint32_t symbol)
+		{
+			if (symbol < 144) writer.WriteCode(0x30 + symbol, 8);
+			else if (symbol < 256) writer.WriteCode(0x190 + symbol - 144, 9);
+			else if (symbol < 280) writer.WriteCode(symbol - 256, 7);
+			else writer.WriteCode(0xC0 + symbol - 280, 8);
+		}
+
+		//A match of the given length with the previous byte, distance one.
+		void WriteRun(BitWriter& writer, uint32_t length)
+		{
+			constexpr std::array<uint16_t, 29> bases = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+			constexpr std::array<uint8_t, 29> extraBits = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+
+			uint32_t code = static_cast<uint32_t>(bases.size()) - 1;
+			while (bases[code] > length) code--;
+
+			WriteSymbol(writer, 257 + code);
+			writer.Write(length - bases[code], extraBits[code]);
+			writer.WriteCode(0, 5); //Distance one
+		}
+
+		//Literals and runs of the previous byte in one fixed Huffman block. Flat colours become runs of zeroes once
+		//rows are Sub filtered, which is most of what a test render is.
+		std::vector<uint8_t> Deflate(const std::vector<uint8_t>& data)
+		{
+			std::vector<uint8_t> zlib = { 0x78, 0x01 };
+			BitWriter writer(zlib);
+			writer.Write(1, 1); //Final block
+			writer.Write(1, 2); //Fixed Huffman codes
+
+			size_t index = 0;
+			while (index < data.size())
+			{
+				WriteSymbol(writer, data[index]);
+
+				size_t run = 0;
+				while (index + 1 + run < data.size() && run < 258 && data[index + 1 + run] == data[index])
+				{
+					run++;
+				}
+
+				if (run >= 3)
+				{
+					WriteRun(writer, static_cast<uint32_t>(run));
+					index += run;
+				}
+				index++;
+			}
+			WriteSymbol(writer, 256); //End of block
+
+			uint32_t a = 1;
+			uint32_t b = 0;
+			for (const uint8_t byte : data)
+			{
+				a = (a + byte) % 65521;
+				b = (b + a) % 65521;
+			}
+			for (int shift = 24; shift >= 0; shift -= 8)
+			{
+				zlib.push_back(static_cast<uint8_t>(((b << 16) | a) >> shift));
+			}
+
+			return zlib;
+		}
+
+		uint32_t Crc32(const uint8_t* bytes, size_t count)
+		{
+			uint32_t crc = 0xFFFFFFFF;
+			for (size_t index = 0; index < count; index++)
+			{
+				crc ^= bytes[index];
+				for (int bit = 0; bit < 8; bit++)
+				{
+					crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+				}
+			}
+			return ~crc;
+		}
+
+		void AppendBigEndian(std::vector<uint8_t>& bytes, uint32_t value)
+		{
+			for (int shift = 24; shift >= 0; shift -= 8)
+			{
+				bytes.push_back(static_cast<uint8_t>(value >> shift));
+			}
+		}
+
+		void AppendChunk(std::vector<uint8_t>& png, const char* type, const std::vector<uint8_t>& data)
+		{
+			AppendBigEndian(png, static_cast<uint32_t>(data.size()));
+			const size_t start = png.size();
+			png.insert(png.end(), type, type + 4);
+			png.insert(png.end(), data.begin(), data.end());
+			AppendBigEndian(png, Crc32(png.data() + start, png.size() - start));
+		}
+	}
+
+	std::vector<uint8_t> EncodePng(const uint8_t* pixels, uint32_t width, uint32_t height)
+	{
+		const size_t stride = static_cast<size_t>(width) * 4;
+
+		std::vector<uint8_t> scanlines;
+		scanlines.reserve((stride + 1) * height);
+		for (uint32_t y = 0; y < height; y++)
+		{
+			const uint8_t* row = pixels + y * stride;
+			scanlines.push_back(1); //Sub filter, each byte relative to the pixel to its left
+			for (size_t x = 0; x < stride; x++)
+			{
+				scanlines.push_back(static_cast<uint8_t>(row[x] - (x >= 4 ? row[x - 4] : 0)));
+			}
+		}
+
+		std::vector<uint8_t> header;
+		AppendBigEndian(header, width);
+		AppendBigEndian(header, height);
+		header.insert(header.end(), { 8, 6, 0, 0, 0 }); //8 bits, RGBA, deflate, adaptive filters, no interlacing
+
+		std::vector<uint8_t> png = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+		AppendChunk(png, "IHDR", header);
+		AppendChunk(png, "IDAT", Deflate(scanlines));
+		AppendChunk(png, "IEND", {});
+		return png;
+	}
+
+	bool WritePng(const std::filesystem::path& path, const uint8_t* pixels, uint32_t width, uint32_t height)
+	{
+		const std::vector<uint8_t> png = EncodePng(pixels, width, height);
+
+		std::ofstream file(path, std::ios::binary);
+		if (!file.is_open())
+		{
+			std::cout << "[Png Encoder] Error: Failed to write " << path.string() << "\n";
+			return false;
+		}
+		file.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+
+		return true;
+	}
+}//namespace Sengine
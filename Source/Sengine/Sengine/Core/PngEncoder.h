@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace Sengine
+{
+	//Tightly packed RGBA8 pixels, top row first, as a PNG. Rows are Sub filtered and compressed with deflate's fixed
+	//Huffman codes and runs of the previous byte, which keeps flat coloured images small without a full compressor.
+	[[nodiscard]] std::vector<uint8_t> EncodePng(const uint8_t* pixels, uint32_t width, uint32_t height);
+	[[nodiscard]] bool WritePng(const std::filesystem::path& path, const uint8_t* pixels, uint32_t width, uint32_t height);
+}//namespace Sengine
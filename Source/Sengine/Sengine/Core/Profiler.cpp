@@ -0,0 +1,114 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+namespace Sengine
+{
+	void Profiler::BeginSession(const std::string& path)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_FileMutex);
+			m_File.open(path);
+			if (!m_File.is_open())
+			{
+				std::cout << "[Profiler] Error: Failed to write " << path << "\n";
+				return;
+			}
+
+			//Complete events, one per scope, with times in microseconds from the start of the session.
+			m_File << "{\"otherData\":{},\"traceEvents\":[";
+			m_IsFirstEvent = true;
+		}
+
+		{
+			//Threads that have finished only hold their buffer through here.
+			std::lock_guard<std::mutex> lock(m_BuffersMutex);
+			m_Buffers.erase(std::remove_if(m_Buffers.begin(), m_Buffers.end(), [](const std::shared_ptr<ThreadBuffer>& buffer) { return buffer.use_count() == 1; }), m_Buffers.end());
+			for (const std::shared_ptr<ThreadBuffer>& buffer : m_Buffers)
+			{
+				std::lock_guard<std::mutex> bufferLock(buffer->Mutex);
+				buffer->Events.clear();
+			}
+		}
+
+		m_SessionStart = std::chrono::steady_clock::now();
+		m_IsRecording = true;
+	}
+
+	void Profiler::EndSession()
+	{
+		if (!m_IsRecording.exchange(false)) return;
+
+		{
+			std::lock_guard<std::mutex> lock(m_BuffersMutex);
+			for (const std::shared_ptr<ThreadBuffer>& buffer : m_Buffers)
+			{
+				Flush(*buffer);
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(m_FileMutex);
+		m_File << "]}";
+		m_File.close();
+	}
+
+	void Profiler::Record(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+	{
+		if (!m_IsRecording) return;
+
+		thread_local const std::shared_ptr<ThreadBuffer> buffer = CreateThreadBuffer();
+
+		bool isFull = false;
+		{
+			std::lock_guard<std::mutex> lock(buffer->Mutex);
+			buffer->Events.push_back({ name,
+				std::chrono::duration_cast<std::chrono::microseconds>(start - m_SessionStart).count(),
+				std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() });
+			isFull = buffer->Events.size() >= EventsPerFlush;
+		}
+
+		//Written by the thread that filled it. The write shows up in the trace as a gap in that thread's scopes.
+		if (isFull)
+		{
+			Flush(*buffer);
+		}
+	}
+
+	std::shared_ptr<Profiler::ThreadBuffer> Profiler::CreateThreadBuffer()
+	{
+		std::shared_ptr<ThreadBuffer> buffer = std::make_shared<ThreadBuffer>();
+		buffer->ThreadID = std::hash<std::thread::id>()(std::this_thread::get_id());
+		buffer->Events.reserve(EventsPerFlush);
+
+		std::lock_guard<std::mutex> lock(m_BuffersMutex);
+		m_Buffers.push_back(buffer);
+		return buffer;
+	}
+
+	void Profiler::Flush(ThreadBuffer& buffer)
+	{
+		//Swapped out so the thread can carry on recording while the events are written.
+		std::vector<ProfileEvent> events;
+		events.reserve(EventsPerFlush);
+		{
+			std::lock_guard<std::mutex> lock(buffer.Mutex);
+			events.swap(buffer.Events);
+		}
+
+		std::lock_guard<std::mutex> lock(m_FileMutex);
+		if (!m_File.is_open()) return;
+
+		for (const ProfileEvent& event : events)
+		{
+			m_File << (m_IsFirstEvent ? "" : ",") << "{\"cat\":\"function\",\"ph\":\"X\",\"pid\":0"
+				<< ",\"name\":\"" << event.Name << "\""
+				<< ",\"tid\":" << buffer.ThreadID
+				<< ",\"ts\":" << event.StartMicroseconds
+				<< ",\"dur\":" << event.DurationMicroseconds << "}";
+			m_IsFirstEvent = false;
+		}
+	}
+}//namespace Sengine
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Sengine
+{
+	//Records named scopes from any thread and writes them as a Chrome trace, which chrome://tracing and Perfetto open.
+	//Use the SE_PROFILE_ macros rather than this directly, they compile to nothing outside the Profile configuration.
+	//Each thread records into its own buffer, written out whenever it fills, so a long session neither grows without
+	//limit nor has its threads wait on each other to record.
+	class Profiler
+	{
+	public:
+		static void BeginSession(const std::string& path);
+		//Writes everything recorded since the last write and closes the trace.
+		static void EndSession();
+
+		static void Record(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+
+	private:
+		struct ProfileEvent
+		{
+			const char* Name;
+			int64_t StartMicroseconds;
+			int64_t DurationMicroseconds;
+		};
+
+		struct ThreadBuffer
+		{
+			//Only contended while the buffer is being written out.
+			std::mutex Mutex;
+			std::vector<ProfileEvent> Events;
+			size_t ThreadID = 0;
+		};
+
+		static std::shared_ptr<ThreadBuffer> CreateThreadBuffer();
+		//Takes the buffer's events and appends them to the trace.
+		static void Flush(ThreadBuffer& buffer);
+
+	private:
+		static constexpr size_t EventsPerFlush = 8192;
+
+		inline static std::chrono::steady_clock::time_point m_SessionStart;
+		inline static std::atomic<bool> m_IsRecording = false;
+
+		inline static std::vector<std::shared_ptr<ThreadBuffer>> m_Buffers;
+		inline static std::mutex m_BuffersMutex;
+
+		inline static std::ofstream m_File;
+		inline static std::mutex m_FileMutex;
+		inline static bool m_IsFirstEvent = true;
+	};
+
+	//Times the enclosing scope.
+	class ProfileScope
+	{
+	public:
+		explicit ProfileScope(const char* name)
+			: m_Name(name), m_Start(std::chrono::steady_clock::now())
+		{
+		}
+
+		~ProfileScope()
+		{
+			Profiler::Record(m_Name, m_Start, std::chrono::steady_clock::now());
+		}
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+	private:
+		const char* m_Name;
+		std::chrono::steady_clock::time_point m_Start;
+	};
+}//namespace Sengine
+
+#define SE_PROFILE_CONCAT_INNER(a, b) a##b
+#define SE_PROFILE_CONCAT(a, b) SE_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef SE_PROFILE
+	#define SE_PROFILE_BEGIN_SESSION(path) Sengine::Profiler::BeginSession(path)
+	#define SE_PROFILE_END_SESSION() Sengine::Profiler::EndSession()
+	//Names must outlive the session, string literals are the usual choice.
+	#define SE_PROFILE_SCOPE(name) Sengine::ProfileScope SE_PROFILE_CONCAT(profileScope, __LINE__)(name)
+	#define SE_PROFILE_FUNCTION() SE_PROFILE_SCOPE(__func__)
+#else
+	#define SE_PROFILE_BEGIN_SESSION(path)
+	#define SE_PROFILE_END_SESSION()
+	#define SE_PROFILE_SCOPE(name)
+	#define SE_PROFILE_FUNCTION()
+#endif
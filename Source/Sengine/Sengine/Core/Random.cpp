@@ -0,0 +1,48 @@
+#include "Random.h"
+
+namespace Sengine
+{
+	Random::Random(uint64_t seed, uint64_t stream)
+		: m_Increment((stream << 1) | 1)
+	{
+		(void)NextUInt();
+		m_State += seed;
+		(void)NextUInt();
+	}
+
+	uint32_t Random::NextUInt()
+	{
+		const uint64_t state = m_State;
+		m_State = state * 6364136223846793005ull + m_Increment;
+
+		const uint32_t xorShifted = static_cast<uint32_t>(((state >> 18) ^ state) >> 27);
+		const uint32_t rotation = static_cast<uint32_t>(state >> 59);
+		return (xorShifted >> rotation) | (xorShifted << ((0u - rotation) & 31));
+	}
+
+	float Random::NextFloat()
+	{
+		//The top 24 bits fill a float's mantissa exactly.
+		return static_cast<float>(NextUInt() >> 8) * (1.0f / 16777216.0f);
+	}
+
+	float Random::Range(float min, float max)
+	{
+		return min + (max - min) * NextFloat();
+	}
+
+	int32_t Random::Range(int32_t min, int32_t max)
+	{
+		const uint32_t range = static_cast<uint32_t>(max) - static_cast<uint32_t>(min) + 1;
+		if (range == 0) return static_cast<int32_t>(NextUInt()); //The whole int32_t range
+
+		//Values below the threshold would make the low results more likely, they are drawn again.
+		const uint32_t threshold = (0u - range) % range;
+		uint32_t value = NextUInt();
+		while (value < threshold)
+		{
+			value = NextUInt();
+		}
+		return static_cast<int32_t>(static_cast<uint32_t>(min) + value % range);
+	}
+}//namespace Sengine
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Sengine
+{
+	//A small, fast PCG32 generator. Sequences depend only on the seed and stream, never on the platform or standard library,
+	//so seeded runs produce the same numbers everywhere. Not thread safe, give each system or job its own.
+	class Random
+	{
+	public:
+		//Generators with the same seed but different streams produce unrelated sequences.
+		explicit Random(uint64_t seed = 0, uint64_t stream = 0);
+
+		[[nodiscard]] uint32_t NextUInt();
+		//In [0, 1).
+		[[nodiscard]] float NextFloat();
+		//In [min, max).
+		[[nodiscard]] float Range(float min, float max);
+		//In [min, max], without the bias of a plain modulo.
+		[[nodiscard]] int32_t Range(int32_t min, int32_t max);
+
+	private:
+		uint64_t m_State = 0;
+		uint64_t m_Increment = 0;
+	};
+}//namespace Sengine
@@ -0,0 +1,74 @@
+#include "StateHasher.h"
+
+#include "box2d/b2_body.h"
+#include "box2d/b2_world.h"
+
+#include "Scene/Scene.h"
+
+namespace Sengine
+{
+	void StateHasher::Add(const void* data, size_t size)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		for (size_t index = 0; index < size; index++)
+		{
+			m_Hash = (m_Hash ^ bytes[index]) * 0x100000001B3ull;
+		}
+	}
+
+	void StateHasher::Add(const std::string& text)
+	{
+		Add(static_cast<uint64_t>(text.size()));
+		Add(text.data(), text.size());
+	}
+
+	void StateHasher::Add(const Scene& scene)
+	{
+		const entt::registry& registry = scene.GetRegistry();
+
+		//Components are hashed field by field, padding bytes would make equal states hash differently.
+		for (const auto [entity] : registry.storage<entt::entity>()->each())
+		{
+			Add(entity);
+
+			if (const TagComponent* tag = registry.try_get<TagComponent>(entity))
+			{
+				Add(tag->Name);
+			}
+			if (const TransformComponent* transform = registry.try_get<TransformComponent>(entity))
+			{
+				Add(transform->Translation);
+				Add(transform->Rotation);
+				Add(transform->Scale);
+			}
+			if (const SpriteComponent* sprite = registry.try_get<SpriteComponent>(entity))
+			{
+				Add(sprite->Colour);
+			}
+			if (const RelationshipComponent* relationship = registry.try_get<RelationshipComponent>(entity))
+			{
+				Add(relationship->Parent);
+				Add(relationship->FirstChild);
+				Add(relationship->PreviousSibling);
+				Add(relationship->NextSibling);
+				Add(relationship->ChildCount);
+			}
+		}
+	}
+
+	void StateHasher::Add(const b2World& world)
+	{
+		for (const b2Body* body = world.GetBodyList(); body; body = body->GetNext())
+		{
+			const b2Transform& transform = body->GetTransform();
+			Add(transform.p.x);
+			Add(transform.p.y);
+			Add(transform.q.s);
+			Add(transform.q.c);
+			Add(body->GetLinearVelocity().x);
+			Add(body->GetLinearVelocity().y);
+			Add(body->GetAngularVelocity());
+			Add(static_cast<uint8_t>(body->IsAwake()));
+		}
+	}
+}//namespace Sengine
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+class b2World;
+
+namespace Sengine
+{
+	class Scene;
+
+	//Hashes simulation state into one value, so runs can be compared tick by tick without storing the state.
+	//Floats are hashed by their bits, so any difference in rounding shows up. Feed state in the same order every tick.
+	class StateHasher
+	{
+	public:
+		void Add(const void* data, size_t size);
+
+		template<typename T>
+		void Add(const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only plain data is hashed by its bytes, add an overload for the type");
+			Add(&value, sizeof(T));
+		}
+
+		void Add(const std::string& text);
+		//Every entity with its tag, transform, sprite and hierarchy, in storage order.
+		void Add(const Scene& scene);
+		//Every body's transform, velocities and awake state, in the world's body order.
+		void Add(const b2World& world);
+
+		[[nodiscard]] uint64_t GetHash() const { return m_Hash; }
+
+	private:
+		//FNV-1a
+		uint64_t m_Hash = 0xCBF29CE484222325ull;
+	};
+}//namespace Sengine
@@ -0,0 +1,58 @@
+#include "ImGuiLayer.h"
+
+//Has to be defined before Swindow is first included through the window header.
+#define SW_IMGUI_IMPLEMENTATION
+#include "Applicatiom/Window.h"
+
+#include "imgui/imgui.h"
+#include "imgui/backends/imgui_impl_opengl3.h"
+
+#include "Render/Renderer.h"
+
+namespace Sengine
+{
+	bool ImGuiLayer::Init(const Window& window)
+	{
+		IMGUI_CHECKVERSION();
+		ImGui::CreateContext();
+
+		ImGuiIO& io = ImGui::GetIO();
+		io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+
+		ImGui::StyleColorsDark();
+
+		if (!SwindowImGui::ImGui_ImplSwindow_Init(window.GetNativeWindow(), true)) return false;
+		if (!ImGui_ImplOpenGL3_Init("#version 460")) return false;
+
+		return true;
+	}
+
+	void ImGuiLayer::Destroy()
+	{
+		ImGui_ImplOpenGL3_Shutdown();
+		SwindowImGui::ImGui_ImplSwindow_Shutdown();
+		ImGui::DestroyContext();
+	}
+
+	void ImGuiLayer::Begin()
+	{
+		ImGui_ImplOpenGL3_NewFrame();
+		SwindowImGui::ImGui_ImplSwindow_NewFrame();
+		ImGui::NewFrame();
+	}
+
+	void ImGuiLayer::End()
+	{
+		ImGui::Render();
+
+		//The UI is drawn last in the frame graph, after every view it shows has been rendered.
+		Renderer::GetFrameGraph().AddPass("UI", [](RenderGraphBuilder& builder)
+			{
+				builder.Write(Renderer::GetBackbuffer());
+			},
+			[](const RenderGraph&)
+			{
+				ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+			});
+	}
+}//namespace Sengine
@@ -0,0 +1,21 @@
+#pragma once
+
+namespace Sengine
+{
+	class Window;
+}
+
+namespace Sengine
+{
+	//Owns the ImGui context and drives the Swindow and OpenGL backends.
+	class ImGuiLayer
+	{
+	public:
+		[[nodiscard]] static bool Init(const Window& window);
+		static void Destroy();
+
+		static void Begin();
+		//Adds the UI pass to the frame graph.
+		static void End();
+	};
+}//namespace Sengine
@@ -0,0 +1,258 @@
+#include "SoAMath.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Sengine::Math
+{
+	namespace
+	{
+		//Coefficients of Eberly's slerp series, sin(t * angle) / sin(angle) = t * sum of b_i(t) * (cos(angle) - 1)^i
+		//with b_i(t) = b_i-1(t) * (t^2 - i^2) / (i * (2i + 1)). The last term is scaled by mu to stand in for the rest.
+		constexpr float SlerpMu = 1.85298109240830f;
+		constexpr float SlerpU[8] = { 1.0f / (1 * 3), 1.0f / (2 * 5), 1.0f / (3 * 7), 1.0f / (4 * 9), 1.0f / (5 * 11), 1.0f / (6 * 13), 1.0f / (7 * 15), SlerpMu / (8 * 17) };
+		constexpr float SlerpV[8] = { 1.0f / 3, 2.0f / 5, 3.0f / 7, 4.0f / 9, 5.0f / 11, 6.0f / 13, 7.0f / 15, SlerpMu * 8 / 17 };
+
+		void Multiply(const glm::mat4& lhs, const glm::mat4& rhs, glm::mat4& out)
+		{
+#if GLM_CONFIG_SIMD == GLM_ENABLE && (GLM_ARCH & GLM_ARCH_SSE2_BIT)
+			//Each column of the result is the columns of lhs weighted by a column of rhs. Matrices in arrays are
+			//only float aligned, so they are read and written unaligned.
+			const float* left = &lhs[0][0];
+			const __m128 column0 = _mm_loadu_ps(left);
+			const __m128 column1 = _mm_loadu_ps(left + 4);
+			const __m128 column2 = _mm_loadu_ps(left + 8);
+			const __m128 column3 = _mm_loadu_ps(left + 12);
+
+			for (int column = 0; column < 4; column++)
+			{
+				const float* right = &rhs[column][0];
+				__m128 result = _mm_mul_ps(column0, _mm_set1_ps(right[0]));
+				result = _mm_add_ps(result, _mm_mul_ps(column1, _mm_set1_ps(right[1])));
+				result = _mm_add_ps(result, _mm_mul_ps(column2, _mm_set1_ps(right[2])));
+				result = _mm_add_ps(result, _mm_mul_ps(column3, _mm_set1_ps(right[3])));
+				_mm_storeu_ps(&out[column][0], result);
+			}
+#else
+			out = lhs * rhs;
+#endif
+		}
+	}
+
+	Vec3x8 Vec3x8::Load(const glm::vec3* points, size_t count)
+	{
+		Vec3x8 result = {};
+		for (size_t lane = 0; lane < std::min(count, LaneCount); lane++)
+		{
+			result.X[lane] = points[lane].x;
+			result.Y[lane] = points[lane].y;
+			result.Z[lane] = points[lane].z;
+		}
+		return result;
+	}
+
+	void Vec3x8::Store(glm::vec3* points, size_t count) const
+	{
+		for (size_t lane = 0; lane < std::min(count, LaneCount); lane++)
+		{
+			points[lane] = { X[lane], Y[lane], Z[lane] };
+		}
+	}
+
+	Quatx8 Quatx8::Load(const glm::quat* rotations, size_t count)
+	{
+		Quatx8 result = {};
+		for (size_t lane = 0; lane < LaneCount; lane++)
+		{
+			const glm::quat rotation = lane < count ? rotations[lane] : glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+			result.X[lane] = rotation.x;
+			result.Y[lane] = rotation.y;
+			result.Z[lane] = rotation.z;
+			result.W[lane] = rotation.w;
+		}
+		return result;
+	}
+
+	void Quatx8::Store(glm::quat* rotations, size_t count) const
+	{
+		for (size_t lane = 0; lane < std::min(count, LaneCount); lane++)
+		{
+			rotations[lane] = glm::quat(W[lane], X[lane], Y[lane], Z[lane]);
+		}
+	}
+
+	Vec3x8 operator+(const Vec3x8& a, const Vec3x8& b)
+	{
+		Vec3x8 result;
+		for (size_t lane = 0; lane < LaneCount; lane++)
+		{
+			result.X[lane] = a.X[lane] + b.X[lane];
+			result.Y[lane] = a.Y[lane] + b.Y[lane];
+			result.Z[lane] = a.Z[lane] + b.Z[lane];
+		}
+		return result;
+	}
+
+	Vec3x8 operator-(const Vec3x8& a, const Vec3x8& b)
+	{
+		Vec3x8 result;
+		for (size_t lane = 0; lane < LaneCount; lane++)
+		{
+			result.X[lane] = a.X[lane] - b.X[lane];
+			result.Y[lane] = a.Y[lane] - b.Y[lane];
+			result.Z[lane] = a.Z[lane] - b.Z[lane];
+		}
+		return result;
+	}
+
+	Vec3x8 operator*(const Vec3x8& a, float scale)
+	{
+		Vec3x8 result;
+		for (size_t lane = 0; lane < LaneCount; lane++)
+		{
+			result.X[lane] = a.X[lane] * scale;
+			result.Y[lane] = a.Y[lane] * scale;
+			result.Z[lane] = a.Z[lane] * scale;
+		}
+		return result;
+	}
+
+	Floatx8 Dot(const Vec3x8& a, const Vec3x8& b)
+	{
+		Floatx8 result;
+		for (size_t lane = 0; lane < LaneCount; lane++)
+		{
+			result.Lanes[lane] = a.X[lane] * b.X[lane] + a.Y[lane] * b.Y[lane] + a.Z[lane] * b.Z[lane];
+		}
+		return result;
+	}
+
+	Floatx8 Dot(const Vec3x8& a, const glm::vec3& b)
+	{
+		Floatx8 result;
+		for (size_t lane = 0; lane < LaneCount; lane++)
+		{
+			result.Lanes[lane] = a.X[lane] * b.x + a.Y[lane] * b.y + a.Z[lane] * b.z;
+		}
+		return result;
+	}
+
+	Vec3x8 Cross(const Vec3x8& a, const Vec3x8& b)
+	{
+		Vec3x8 result;
+		for (size_t lane = 0; lane < LaneCount; lane++)
+		{
+			result.X[lane] = a.Y[lane] * b.Z[lane] - a.Z[lane] * b.Y[lane];
+			result.Y[lane] = a.Z[lane] * b.X[lane] - a.X[lane] * b.Z[lane];
+			result.Z[lane] = a.X[lane] * b.Y[lane] - a.Y[lane] * b.X[lane];
+		}
+		return result;
+	}
+
+	Floatx8 Length(const Vec3x8& a)
+	{
+		Floatx8 result = Dot(a, a);
+		for (size_t lane = 0; lane < LaneCount; lane++)
+		{
+			result.Lanes[lane] = std::sqrt(result.Lanes[lane]);
+		}
+		return result;
+	}
+
+	Vec3x8 MultiplyAdd(const Vec3x8& a, const Vec3x8& b, float scale)
+	{
+		Vec3x8 result;
+		for (size_t lane = 0; lane < LaneCount; lane++)
+		{
+			result.X[lane] = a.X[lane] + b.X[lane] * scale;
+			result.Y[lane] = a.Y[lane] + b.Y[lane] * scale;
+			result.Z[lane] = a.Z[lane] + b.Z[lane] * scale;
+		}
+		return result;
+	}
+
+	Vec3x8 TransformPoints(const glm::mat4& transform, const Vec3x8& points)
+	{
+		Vec3x8 result;
+		for (size_t lane = 0; lane < LaneCount; lane++)
+		{
+			const float x = points.X[lane];
+			const float y = points.Y[lane];
+			const float z = points.Z[lane];
+			result.X[lane] = transform[0][0] * x + transform[1][0] * y + transform[2][0] * z + transform[3][0];
+			result.Y[lane] = transform[0][1] * x + transform[1][1] * y + transform[2][1] * z + transform[3][1];
+			result.Z[lane] = transform[0][2] * x + transform[1][2] * y + transform[2][2] * z + transform[3][2];
+		}
+		return result;
+	}
+
+	Quatx8 Slerp(const Quatx8& from, const Quatx8& to, const Floatx8& t)
+	{
+		//The sign flip takes the shorter way round, which also keeps cos(angle) in the range the series is fitted on.
+		float signs[LaneCount];
+		float cosinesMinusOne[LaneCount];
+		float fromWeights[LaneCount];
+		float toWeights[LaneCount];
+		for (size_t lane = 0; lane < LaneCount; lane++)
+		{
+			const float cosine = from.X[lane] * to.X[lane] + from.Y[lane] * to.Y[lane] + from.Z[lane] * to.Z[lane] + from.W[lane] * to.W[lane];
+			signs[lane] = cosine < 0.0f ? -1.0f : 1.0f;
+			cosinesMinusOne[lane] = cosine * signs[lane] - 1.0f;
+			fromWeights[lane] = 1.0f;
+			toWeights[lane] = 1.0f;
+		}
+
+		//Horner's rule over the series, for both weights at once.
+		for (int term = 7; term >= 0; term--)
+		{
+			for (size_t lane = 0; lane < LaneCount; lane++)
+			{
+				const float toT = t.Lanes[lane];
+				const float fromT = 1.0f - toT;
+				toWeights[lane] = 1.0f + (SlerpU[term] * toT * toT - SlerpV[term]) * cosinesMinusOne[lane] * toWeights[lane];
+				fromWeights[lane] = 1.0f + (SlerpU[term] * fromT * fromT - SlerpV[term]) * cosinesMinusOne[lane] * fromWeights[lane];
+			}
+		}
+
+		Quatx8 result;
+		for (size_t lane = 0; lane < LaneCount; lane++)
+		{
+			const float fromWeight = (1.0f - t.Lanes[lane]) * fromWeights[lane];
+			const float toWeight = t.Lanes[lane] * toWeights[lane] * signs[lane];
+			result.X[lane] = from.X[lane] * fromWeight + to.X[lane] * toWeight;
+			result.Y[lane] = from.Y[lane] * fromWeight + to.Y[lane] * toWeight;
+			result.Z[lane] = from.Z[lane] * fromWeight + to.Z[lane] * toWeight;
+			result.W[lane] = from.W[lane] * fromWeight + to.W[lane] * toWeight;
+		}
+		return result;
+	}
+
+	void MultiplyBatch(const glm::mat4& lhs, const glm::mat4* rhs, glm::mat4* out, size_t count)
+	{
+		for (size_t index = 0; index < count; index++)
+		{
+			Multiply(lhs, rhs[index], out[index]);
+		}
+	}
+
+	void MultiplyBatch(const glm::mat4* lhs, const glm::mat4* rhs, glm::mat4* out, size_t count)
+	{
+		for (size_t index = 0; index < count; index++)
+		{
+			Multiply(lhs[index], rhs[index], out[index]);
+		}
+	}
+
+	void SlerpBatch(const glm::quat* from, const glm::quat* to, const float* t, glm::quat* out, size_t count)
+	{
+		for (size_t first = 0; first < count; first += LaneCount)
+		{
+			const size_t laneCount = std::min(count - first, LaneCount);
+
+			Floatx8 lanesT = {};
+			std::copy(t + first, t + first + laneCount, lanesT.Lanes);
+
+			Slerp(Quatx8::Load(from + first, laneCount), Quatx8::Load(to + first, laneCount), lanesT).Store(out + first, laneCount);
+		}
+	}
+}//namespace Sengine::Math
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+namespace Sengine::Math
+{
+	//Eight of everything, one array per component, so each operation is a straight loop the compiler turns into
+	//one or two vector instructions. Used where the same maths runs over many values: culling, animation, particles.
+	constexpr size_t LaneCount = 8;
+
+	struct alignas(32) Floatx8
+	{
+		float Lanes[LaneCount];
+	};
+
+	struct alignas(32) Vec3x8
+	{
+		float X[LaneCount];
+		float Y[LaneCount];
+		float Z[LaneCount];
+
+		//Reads up to eight points, the lanes past count are zero.
+		[[nodiscard]] static Vec3x8 Load(const glm::vec3* points, size_t count = LaneCount);
+		void Store(glm::vec3* points, size_t count = LaneCount) const;
+	};
+
+	struct alignas(32) Quatx8
+	{
+		float X[LaneCount];
+		float Y[LaneCount];
+		float Z[LaneCount];
+		float W[LaneCount];
+
+		//Reads up to eight rotations, the lanes past count are the identity.
+		[[nodiscard]] static Quatx8 Load(const glm::quat* rotations, size_t count = LaneCount);
+		void Store(glm::quat* rotations, size_t count = LaneCount) const;
+	};
+
+	[[nodiscard]] Vec3x8 operator+(const Vec3x8& a, const Vec3x8& b);
+	[[nodiscard]] Vec3x8 operator-(const Vec3x8& a, const Vec3x8& b);
+	[[nodiscard]] Vec3x8 operator*(const Vec3x8& a, float scale);
+
+	[[nodiscard]] Floatx8 Dot(const Vec3x8& a, const Vec3x8& b);
+	//Dot product of every lane with the same vector, e.g. points against a plane normal.
+	[[nodiscard]] Floatx8 Dot(const Vec3x8& a, const glm::vec3& b);
+	[[nodiscard]] Vec3x8 Cross(const Vec3x8& a, const Vec3x8& b);
+	[[nodiscard]] Floatx8 Length(const Vec3x8& a);
+	//a + b * scale, e.g. positions moved by velocities over a time step.
+	[[nodiscard]] Vec3x8 MultiplyAdd(const Vec3x8& a, const Vec3x8& b, float scale);
+	//Transforms the lanes as points, with a w of one.
+	[[nodiscard]] Vec3x8 TransformPoints(const glm::mat4& transform, const Vec3x8& points);
+
+	//Interpolates between the rotations of each lane along the shortest arc. Uses Eberly's polynomial fit of slerp,
+	//which has no branches or trigonometry and stays within about 5e-5 of the exact result.
+	[[nodiscard]] Quatx8 Slerp(const Quatx8& from, const Quatx8& to, const Floatx8& t);
+
+	//out[i] = lhs * rhs[i], e.g. a parent transform applied to its children. Out may alias rhs.
+	void MultiplyBatch(const glm::mat4& lhs, const glm::mat4* rhs, glm::mat4* out, size_t count);
+	//out[i] = lhs[i] * rhs[i]. Out may alias either input.
+	void MultiplyBatch(const glm::mat4* lhs, const glm::mat4* rhs, glm::mat4* out, size_t count);
+	//out[i] = Slerp(from[i], to[i], t[i]), eight rotations at a time. Out may alias either input.
+	void SlerpBatch(const glm::quat* from, const glm::quat* to, const float* t, glm::quat* out, size_t count);
+}//namespace Sengine::Math
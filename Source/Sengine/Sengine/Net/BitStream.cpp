@@ -0,0 +1,85 @@
+#include "BitStream.h"
+
+namespace Sengine::Net
+{
+	BitWriter::BitWriter(std::vector<uint8_t>& bytes)
+		: m_Bytes(bytes), m_BitCount(bytes.size() * 8)
+	{
+	}
+
+	void BitWriter::Write(uint32_t value, uint32_t bitCount)
+	{
+		const size_t byte = m_BitCount / 8;
+		const uint32_t offset = static_cast<uint32_t>(m_BitCount % 8);
+		m_BitCount += bitCount;
+		m_Bytes.resize((m_BitCount + 7) / 8, 0);
+
+		//At most 39 bits once shifted to the offset, spread over at most 5 bytes.
+		uint64_t bits = static_cast<uint64_t>(bitCount < 32 ? value & ((1u << bitCount) - 1) : value) << offset;
+		for (size_t index = byte; bits != 0; index++)
+		{
+			m_Bytes[index] |= static_cast<uint8_t>(bits);
+			bits >>= 8;
+		}
+	}
+
+	void BitWriter::WriteVariable(uint32_t value)
+	{
+		uint32_t bitCount = 0;
+		while (bitCount < 32 && (value >> bitCount) != 0)
+		{
+			bitCount++;
+		}
+
+		//A length of 31 stands for 32, a value of zero needs no bits at all.
+		Write(bitCount == 32 ? 31 : bitCount, 5);
+		Write(value, bitCount == 31 ? 32 : bitCount);
+	}
+
+	void BitWriter::Truncate(size_t bitCount)
+	{
+		if (bitCount >= m_BitCount) return;
+
+		m_BitCount = bitCount;
+		m_Bytes.resize((bitCount + 7) / 8);
+		if (bitCount % 8 != 0)
+		{
+			m_Bytes.back() &= static_cast<uint8_t>((1u << (bitCount % 8)) - 1);
+		}
+	}
+
+	BitReader::BitReader(const uint8_t* bytes, size_t byteCount)
+		: m_Bytes(bytes), m_BitCount(byteCount * 8)
+	{
+	}
+
+	uint32_t BitReader::Read(uint32_t bitCount)
+	{
+		if (m_Position + bitCount > m_BitCount)
+		{
+			m_IsValid = false;
+			m_Position = m_BitCount;
+			return 0;
+		}
+
+		uint64_t value = 0;
+		uint32_t written = 0;
+		while (written < bitCount)
+		{
+			const uint32_t offset = static_cast<uint32_t>(m_Position % 8);
+			const uint32_t count = bitCount - written < 8 - offset ? bitCount - written : 8 - offset;
+
+			value |= static_cast<uint64_t>((m_Bytes[m_Position / 8] >> offset) & ((1u << count) - 1)) << written;
+
+			written += count;
+			m_Position += count;
+		}
+		return static_cast<uint32_t>(value);
+	}
+
+	uint32_t BitReader::ReadVariable()
+	{
+		const uint32_t length = Read(5);
+		return Read(length == 31 ? 32 : length);
+	}
+}//namespace Sengine::Net
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Sengine::Net
+{
+	//Packs values of any bit count from 1 to 32 with no padding between them, least significant bit first.
+	class BitWriter
+	{
+	public:
+		explicit BitWriter(std::vector<uint8_t>& bytes);
+
+		void Write(uint32_t value, uint32_t bitCount);
+		void WriteBool(bool value) { Write(value ? 1 : 0, 1); }
+		//Small values in few bits: a 5 bit length, then the value in that many bits.
+		void WriteVariable(uint32_t value);
+
+		//Bits written so far, e.g. to roll back with Truncate when something does not fit.
+		[[nodiscard]] size_t GetBitCount() const { return m_BitCount; }
+		[[nodiscard]] size_t GetByteCount() const { return (m_BitCount + 7) / 8; }
+		void Truncate(size_t bitCount);
+
+	private:
+		std::vector<uint8_t>& m_Bytes;
+		size_t m_BitCount = 0;
+	};
+
+	//Reads what BitWriter wrote. Reading past the end returns zeroes and marks the reader invalid, so a
+	//packet is decoded in full and checked once at the end instead of after every value.
+	class BitReader
+	{
+	public:
+		BitReader(const uint8_t* bytes, size_t byteCount);
+
+		[[nodiscard]] uint32_t Read(uint32_t bitCount);
+		[[nodiscard]] bool ReadBool() { return Read(1) != 0; }
+		[[nodiscard]] uint32_t ReadVariable();
+
+		[[nodiscard]] bool GetIsValid() const { return m_IsValid; }
+
+	private:
+		const uint8_t* m_Bytes = nullptr;
+		size_t m_BitCount = 0;
+		size_t m_Position = 0;
+		bool m_IsValid = true;
+	};
+}//namespace Sengine::Net
@@ -0,0 +1,80 @@
+#include "InProcessTransport.h"
+
+#include <deque>
+#include <mutex>
+#include <utility>
+
+#include "Core/Random.h"
+
+namespace Sengine::Net
+{
+	struct InProcessNetwork::NetworkData
+	{
+		struct Packet
+		{
+			NetAddress From;
+			std::vector<uint8_t> Data;
+		};
+
+		std::mutex Mutex;
+		//Indexed by port - 1.
+		std::vector<std::deque<Packet>> Queues;
+		float PacketLoss = 0.0f;
+		Random LossRandom;
+	};
+
+	class InProcessNetwork::Endpoint final : public Transport
+	{
+	public:
+		Endpoint(std::shared_ptr<NetworkData> data, uint16_t port)
+			: m_Data(std::move(data)), m_Port(port)
+		{
+		}
+
+		void Send(const NetAddress& address, const uint8_t* data, size_t size) override
+		{
+			std::lock_guard lock(m_Data->Mutex);
+			if (address.Port == 0 || address.Port > m_Data->Queues.size()) return;
+			if (m_Data->PacketLoss > 0.0f && m_Data->LossRandom.NextFloat() < m_Data->PacketLoss) return;
+
+			m_Data->Queues[address.Port - 1].push_back({ GetAddress(), std::vector<uint8_t>(data, data + size) });
+		}
+
+		bool Receive(NetAddress& address, std::vector<uint8_t>& data) override
+		{
+			std::lock_guard lock(m_Data->Mutex);
+			std::deque<NetworkData::Packet>& queue = m_Data->Queues[m_Port - 1];
+			if (queue.empty()) return false;
+
+			address = queue.front().From;
+			data = std::move(queue.front().Data);
+			queue.pop_front();
+			return true;
+		}
+
+		NetAddress GetAddress() const override { return { 0, m_Port }; }
+
+	private:
+		std::shared_ptr<NetworkData> m_Data;
+		uint16_t m_Port = 0;
+	};
+
+	InProcessNetwork::InProcessNetwork()
+		: m_Data(std::make_shared<NetworkData>())
+	{
+	}
+
+	std::unique_ptr<Transport> InProcessNetwork::CreateTransport()
+	{
+		std::lock_guard lock(m_Data->Mutex);
+		m_Data->Queues.emplace_back();
+		return std::make_unique<Endpoint>(m_Data, static_cast<uint16_t>(m_Data->Queues.size()));
+	}
+
+	void InProcessNetwork::SetPacketLoss(float fraction, uint64_t seed)
+	{
+		std::lock_guard lock(m_Data->Mutex);
+		m_Data->PacketLoss = fraction;
+		m_Data->LossRandom = Random(seed);
+	}
+}//namespace Sengine::Net
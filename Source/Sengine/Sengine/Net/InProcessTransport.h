@@ -0,0 +1,28 @@
+#pragma once
+
+#include <memory>
+
+#include "Transport.h"
+
+namespace Sengine::Net
+{
+	//Transports that hand packets to each other through queues in memory, so a server and its clients can run in one
+	//process with no sockets, e.g. in tests and benchmarks. Loss can be simulated to exercise the protocol.
+	class InProcessNetwork
+	{
+	public:
+		InProcessNetwork();
+
+		//Each transport gets its own port and can send to any other one made by this network. They may outlive it.
+		[[nodiscard]] std::unique_ptr<Transport> CreateTransport();
+
+		//Drops this fraction of the packets sent from now on. Seeded, so a run loses the same packets every time.
+		void SetPacketLoss(float fraction, uint64_t seed = 0);
+
+	private:
+		struct NetworkData;
+		class Endpoint;
+
+		std::shared_ptr<NetworkData> m_Data;
+	};
+}//namespace Sengine::Net
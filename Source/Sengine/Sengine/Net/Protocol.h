@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+#include "BitStream.h"
+
+namespace Sengine::Net
+{
+	//Every packet starts with the protocol ID and its type, packets without them are ignored.
+	constexpr uint32_t ProtocolID = 0x5345;
+
+	enum class PacketType : uint8_t
+	{
+		//Client to server until the first snapshot arrives.
+		Hello,
+		//Client to server, the newest snapshot sequence the client has decoded.
+		Acknowledge,
+		//Server to client, a sequence, the sequence of the baseline it is relative to and the changed entities.
+		Snapshot,
+		Disconnect,
+	};
+
+	inline void WritePacketHeader(BitWriter& writer, PacketType type)
+	{
+		writer.Write(ProtocolID, 16);
+		writer.Write(static_cast<uint32_t>(type), 8);
+	}
+
+	//Returns false for anything that is not one of ours.
+	[[nodiscard]] inline bool ReadPacketHeader(BitReader& reader, PacketType& type)
+	{
+		const uint32_t protocol = reader.Read(16);
+		const uint32_t packetType = reader.Read(8);
+		type = static_cast<PacketType>(packetType);
+		return reader.GetIsValid() && protocol == ProtocolID && packetType <= static_cast<uint32_t>(PacketType::Disconnect);
+	}
+}//namespace Sengine::Net
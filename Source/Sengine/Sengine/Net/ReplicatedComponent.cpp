@@ -0,0 +1,108 @@
+#include "ReplicatedComponent.h"
+
+#include <cmath>
+
+#include "Scene/Components.h"
+
+namespace Sengine::Net
+{
+	uint32_t QuantizedFloat::Quantize(float value) const
+	{
+		const double steps = static_cast<double>(Bits < 32 ? (1ull << Bits) - 1 : 0xFFFFFFFFull);
+		const double normalised = (static_cast<double>(value) - Min) / (static_cast<double>(Max) - Min);
+		if (!(normalised > 0.0)) return 0; //Also catches NaN
+		if (normalised >= 1.0) return static_cast<uint32_t>(steps);
+
+		return static_cast<uint32_t>(std::lround(normalised * steps));
+	}
+
+	float QuantizedFloat::Dequantize(uint32_t value) const
+	{
+		const double steps = static_cast<double>(Bits < 32 ? (1ull << Bits) - 1 : 0xFFFFFFFFull);
+		return static_cast<float>(Min + (static_cast<double>(Max) - Min) * (value / steps));
+	}
+
+	ReplicatedComponent CreateTransformReplication(const QuantizedFloat& translation, uint32_t rotationBits, const QuantizedFloat& scale)
+	{
+		constexpr float pi = 3.14159265358979323846f;
+		const QuantizedFloat rotation = { -pi, pi, rotationBits };
+
+		ReplicatedComponent component;
+		component.Name = "Transform";
+		component.ValueBits = {
+			static_cast<uint8_t>(translation.Bits), static_cast<uint8_t>(translation.Bits), static_cast<uint8_t>(translation.Bits),
+			static_cast<uint8_t>(rotation.Bits), static_cast<uint8_t>(rotation.Bits), static_cast<uint8_t>(rotation.Bits),
+			static_cast<uint8_t>(scale.Bits), static_cast<uint8_t>(scale.Bits), static_cast<uint8_t>(scale.Bits),
+		};
+		component.Priority = 1.0f;
+
+		component.Quantize = [translation, rotation, scale](const entt::registry& registry, entt::entity entity, uint32_t* values)
+		{
+			const TransformComponent* transform = registry.try_get<TransformComponent>(entity);
+			if (!transform) return false;
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+				//The top of the range is the same angle as the bottom, so it wraps to the bottom too.
+				const float angle = transform->Rotation[axis] - 2.0f * pi * std::floor((transform->Rotation[axis] + pi) / (2.0f * pi));
+				const uint32_t steps = rotation.Bits < 32 ? (1u << rotation.Bits) - 1 : 0xFFFFFFFFu;
+				const uint32_t quantized = rotation.Quantize(angle);
+
+				values[axis] = translation.Quantize(transform->Translation[axis]);
+				values[3 + axis] = quantized == steps ? 0 : quantized;
+				values[6 + axis] = scale.Quantize(transform->Scale[axis]);
+			}
+			return true;
+		};
+
+		component.Apply = [translation, rotation, scale](entt::registry& registry, entt::entity entity, const uint32_t* values)
+		{
+			TransformComponent transform;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				transform.Translation[axis] = translation.Dequantize(values[axis]);
+				transform.Rotation[axis] = rotation.Dequantize(values[3 + axis]);
+				transform.Scale[axis] = scale.Dequantize(values[6 + axis]);
+			}
+			registry.emplace_or_replace<TransformComponent>(entity, transform);
+		};
+
+		component.Remove = [](entt::registry& registry, entt::entity entity) { registry.remove<TransformComponent>(entity); };
+
+		return component;
+	}
+
+	ReplicatedComponent CreateSpriteReplication(const QuantizedFloat& colour)
+	{
+		ReplicatedComponent component;
+		component.Name = "Sprite";
+		component.ValueBits.assign(4, static_cast<uint8_t>(colour.Bits));
+		component.Priority = 0.25f;
+
+		component.Quantize = [colour](const entt::registry& registry, entt::entity entity, uint32_t* values)
+		{
+			const SpriteComponent* sprite = registry.try_get<SpriteComponent>(entity);
+			if (!sprite) return false;
+
+			for (int channel = 0; channel < 4; channel++)
+			{
+				values[channel] = colour.Quantize(sprite->Colour[channel]);
+			}
+			return true;
+		};
+
+		component.Apply = [colour](entt::registry& registry, entt::entity entity, const uint32_t* values)
+		{
+			SpriteComponent sprite;
+			for (int channel = 0; channel < 4; channel++)
+			{
+				sprite.Colour[channel] = colour.Dequantize(values[channel]);
+			}
+			registry.emplace_or_replace<SpriteComponent>(entity, sprite);
+		};
+
+		component.Remove = [](entt::registry& registry, entt::entity entity) { registry.remove<SpriteComponent>(entity); };
+
+		return component;
+	}
+}//namespace Sengine::Net
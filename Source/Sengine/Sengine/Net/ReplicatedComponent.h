@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "entt/entt.hpp"
+
+namespace Sengine::Net
+{
+	//Added to every entity a server replicates and every entity a client creates for one. IDs are the same on both
+	//sides and never reused while a server runs, entity handles are not.
+	struct NetworkedComponent
+	{
+		uint32_t NetID = 0;
+	};
+
+	//Maps a float in [Min, Max] onto an integer of Bits bits. Values outside the range are clamped.
+	struct QuantizedFloat
+	{
+		float Min = 0.0f;
+		float Max = 1.0f;
+		uint32_t Bits = 16;
+
+		[[nodiscard]] uint32_t Quantize(float value) const;
+		[[nodiscard]] float Dequantize(uint32_t value) const;
+	};
+
+	//How one component type is replicated. Its state is a fixed number of quantized values, each sent with its own bit
+	//count, so snapshots are flat arrays and comparing two of them is a compare of integers rather than of floats.
+	//The server and its clients have to be given the same components in the same order.
+	struct ReplicatedComponent
+	{
+		std::string Name;
+		//Bits of each value, from 1 to 32.
+		std::vector<uint8_t> ValueBits;
+		//How quickly an entity whose copy of this component is out of date rises to the front when the bandwidth budget
+		//can not send everything.
+		float Priority = 1.0f;
+
+		//Fills ValueBits.size() values if the entity has the component, returns false if it does not.
+		std::function<bool(const entt::registry&, entt::entity, uint32_t*)> Quantize;
+		//Adds or replaces the component from its quantized values.
+		std::function<void(entt::registry&, entt::entity, const uint32_t*)> Apply;
+		std::function<void(entt::registry&, entt::entity)> Remove;
+	};
+
+	//Rotation is always wrapped into [-pi, pi) before it is quantized, so it only needs a bit count.
+	[[nodiscard]] ReplicatedComponent CreateTransformReplication(const QuantizedFloat& translation = { -1024.0f, 1024.0f, 20 },
+		uint32_t rotationBits = 12, const QuantizedFloat& scale = { 0.0f, 16.0f, 12 });
+	[[nodiscard]] ReplicatedComponent CreateSpriteReplication(const QuantizedFloat& colour = { 0.0f, 1.0f, 8 });
+}//namespace Sengine::Net
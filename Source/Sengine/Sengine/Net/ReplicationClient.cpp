@@ -0,0 +1,276 @@
+#include "ReplicationClient.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "Core/Profiler.h"
+#include "Scene/Scene.h"
+
+namespace Sengine::Net
+{
+	namespace
+	{
+		constexpr float HelloInterval = 0.25f;
+	}
+
+	ReplicationClient::ReplicationClient(Scene& scene, Transport& transport, const NetAddress& server, std::vector<ReplicatedComponent> components)
+		: m_Scene(scene), m_Transport(transport), m_Server(server), m_Schema(std::move(components)), m_TimeSinceHello(HelloInterval)
+	{
+	}
+
+	ReplicationClient::~ReplicationClient()
+	{
+		//Saves the server waiting for the timeout. Lost or not, the client is gone either way.
+		if (m_IsConnected)
+		{
+			Send(PacketType::Disconnect);
+		}
+	}
+
+	void ReplicationClient::Update(float deltaSeconds)
+	{
+		SE_PROFILE_FUNCTION();
+
+		m_TimeSinceReceive += deltaSeconds;
+		m_TimeSinceHello += deltaSeconds;
+
+		NetAddress address;
+		while (m_Transport.Receive(address, m_Packet))
+		{
+			if (address != m_Server) continue;
+
+			BitReader reader(m_Packet.data(), m_Packet.size());
+			PacketType type;
+			if (!ReadPacketHeader(reader, type) || type != PacketType::Snapshot) continue;
+
+			ReceiveSnapshot(reader);
+		}
+
+		if (m_IsConnected && m_TimeSinceReceive > m_TimeoutSeconds)
+		{
+			Disconnect();
+		}
+
+		if (!m_IsConnected && m_TimeSinceHello >= HelloInterval)
+		{
+			Send(PacketType::Hello);
+			m_TimeSinceHello = 0.0f;
+		}
+	}
+
+	entt::entity ReplicationClient::GetEntity(uint32_t netID) const
+	{
+		const auto entity = m_Entities.find(netID);
+		return entity != m_Entities.end() ? entity->second : entt::null;
+	}
+
+	void ReplicationClient::ReceiveSnapshot(BitReader& reader)
+	{
+		const uint32_t sequence = reader.Read(32);
+		const uint32_t baselineSequence = reader.Read(32);
+		const uint32_t entityCount = reader.Read(16);
+		if (!reader.GetIsValid() || sequence == NoSequence) return;
+
+		//Older than what the scene already shows.
+		if (m_AppliedSequence != NoSequence && sequence <= m_AppliedSequence) return;
+
+		const Snapshot* baseline = &m_Empty;
+		if (baselineSequence != NoSequence)
+		{
+			//Gone after a disconnect, or pushed out of the history by acknowledgements the server never got. Nothing
+			//relative to it can be decoded, so the server is asked to start over from an empty baseline.
+			const ReceivedSnapshot& received = m_History[baselineSequence % HistorySize];
+			if (received.Sequence != baselineSequence)
+			{
+				if (m_TimeSinceHello >= HelloInterval)
+				{
+					Send(PacketType::Hello);
+					m_TimeSinceHello = 0.0f;
+				}
+				return;
+			}
+			baseline = &received.State;
+		}
+
+		m_Updates.Clear();
+		m_Removed.clear();
+		uint32_t netID = 0;
+		for (uint32_t index = 0; index < entityCount; index++)
+		{
+			netID += reader.ReadVariable();
+			m_Schema.ReadEntity(reader, netID, *baseline, m_Updates, m_Removed);
+		}
+		if (!reader.GetIsValid()) return;
+
+		//Merged aside first, the slot it goes in may hold the baseline.
+		m_Schema.Merge(*baseline, m_Updates, m_Removed, m_Merged);
+
+		//Every entity in the merged snapshot that differs from what the scene shows is applied, not just what the packet
+		//carried. Once this is acknowledged the server compares against the merged snapshot, so an entity left out
+		//because it matched an older baseline, while the scene shows a newer value it has since changed back from,
+		//would never be sent again. One the server put off for the budget goes back to the baseline's value until it
+		//is sent.
+		m_Changes.clear();
+		m_Schema.Compare(m_Merged, m_Applied, m_Changes);
+		m_Updates.Clear();
+		for (const EntityChange& change : m_Changes)
+		{
+			if (change.Current == EntityChange::None) continue;
+
+			m_Updates.Append(m_Merged, change.Current, 1, m_Schema.GetValueCount());
+		}
+
+		//Likewise removed are the entities the previous snapshot had and this one does not. After a reset the server
+		//starts from nothing, so entities not sent again yet stay until they are, or until it removes them outright.
+		const Snapshot& previous = baselineSequence != NoSequence && m_AppliedSequence != NoSequence ? m_History[m_AppliedSequence % HistorySize].State : m_Empty;
+		const size_t packetRemovedCount = m_Removed.size();
+		std::set_difference(previous.NetIDs.begin(), previous.NetIDs.end(), m_Merged.NetIDs.begin(), m_Merged.NetIDs.end(), std::back_inserter(m_Removed));
+		std::inplace_merge(m_Removed.begin(), m_Removed.begin() + packetRemovedCount, m_Removed.end());
+		m_Removed.erase(std::unique(m_Removed.begin(), m_Removed.end()), m_Removed.end());
+
+		ReceivedSnapshot& received = m_History[sequence % HistorySize];
+		received.Sequence = sequence;
+		std::swap(received.State, m_Merged);
+
+		ApplyToScene(m_Updates, m_Removed);
+		m_Schema.Merge(m_Applied, m_Updates, m_Removed, m_Merged);
+		std::swap(m_Applied, m_Merged);
+		m_AppliedSequence = sequence;
+		m_IsConnected = true;
+		m_TimeSinceReceive = 0.0f;
+
+		Send(PacketType::Acknowledge, sequence);
+	}
+
+	void ReplicationClient::ApplyToScene(const Snapshot& updates, const std::vector<uint32_t>& removed)
+	{
+		SE_PROFILE_FUNCTION();
+
+		entt::registry& registry = m_Scene.GetRegistry();
+		const std::vector<ReplicatedComponent>& components = m_Schema.GetComponents();
+
+		//Every new entity exists before any is parented to one.
+		for (const uint32_t netID : updates.NetIDs)
+		{
+			if (m_Entities.count(netID) != 0) continue;
+
+			const entt::entity entity = m_Scene.CreateEntity();
+			registry.emplace<NetworkedComponent>(entity, netID);
+			m_Entities[netID] = entity;
+		}
+
+		for (size_t index = 0; index < updates.GetEntityCount(); index++)
+		{
+			const uint32_t netID = updates.NetIDs[index];
+			const entt::entity entity = m_Entities[netID];
+			const uint32_t* values = updates.Values.data() + index * m_Schema.GetValueCount();
+			for (size_t component = 0; component < components.size(); component++)
+			{
+				if (updates.Masks[index] & (1u << component))
+				{
+					components[component].Apply(registry, entity, values + m_Schema.GetValueOffset(component));
+				}
+				else
+				{
+					components[component].Remove(registry, entity);
+				}
+			}
+
+			const uint32_t parent = updates.Parents[index];
+			const entt::entity parentEntity = parent != 0 ? GetEntity(parent - 1) : entt::null;
+			bool isRefused = false;
+			if (registry.get<RelationshipComponent>(entity).Parent != parentEntity)
+			{
+				isRefused = !m_Scene.SetParent(entity, parentEntity);
+			}
+
+			//The server can leave the parent for a later snapshot when the budget is tight, and a move that would make a
+			//cycle until the parent's own move arrives is refused.
+			if ((parent != 0 && parentEntity == entt::null) || isRefused)
+			{
+				m_MissingParents[netID] = parent - 1;
+			}
+			else
+			{
+				m_MissingParents.erase(netID);
+			}
+		}
+
+		for (auto missing = m_MissingParents.begin(); missing != m_MissingParents.end();)
+		{
+			const entt::entity entity = GetEntity(missing->first);
+			const entt::entity parent = GetEntity(missing->second);
+			bool isParented = false;
+			if (entity != entt::null && parent != entt::null)
+			{
+				isParented = m_Scene.SetParent(entity, parent);
+			}
+
+			missing = entity == entt::null || isParented ? m_MissingParents.erase(missing) : std::next(missing);
+		}
+
+		for (const uint32_t netID : removed)
+		{
+			const auto entry = m_Entities.find(netID);
+			if (entry == m_Entities.end()) continue;
+
+			RemoveEntity(entry->second);
+			m_Entities.erase(entry);
+			m_MissingParents.erase(netID);
+		}
+	}
+
+	void ReplicationClient::RemoveEntity(entt::entity entity)
+	{
+		//Destroying an entity destroys its children, but replicated children are removed by the server on their own,
+		//and may only have been moved to another parent in a snapshot still to come. Until then they wait for the
+		//parent like any other, a reset can remove one the server still has and send it again.
+		entt::registry& registry = m_Scene.GetRegistry();
+		const uint32_t netID = registry.get<NetworkedComponent>(entity).NetID;
+		while (registry.get<RelationshipComponent>(entity).FirstChild != entt::null)
+		{
+			const entt::entity child = registry.get<RelationshipComponent>(entity).FirstChild;
+			if (const NetworkedComponent* networked = registry.try_get<NetworkedComponent>(child))
+			{
+				m_MissingParents[networked->NetID] = netID;
+			}
+			m_Scene.SetParent(child, entt::null);
+		}
+
+		m_Scene.DestroyEntity(entity);
+	}
+
+	void ReplicationClient::Disconnect()
+	{
+		//A server seen again later starts over from nothing, so what it no longer has would never be removed.
+		for (const auto [netID, entity] : m_Entities)
+		{
+			RemoveEntity(entity);
+		}
+		m_Entities.clear();
+		m_MissingParents.clear();
+
+		for (ReceivedSnapshot& received : m_History)
+		{
+			received.Sequence = NoSequence;
+			received.State.Clear();
+		}
+		m_Applied.Clear();
+		m_AppliedSequence = NoSequence;
+		m_IsConnected = false;
+	}
+
+	void ReplicationClient::Send(PacketType type, uint32_t sequence)
+	{
+		std::vector<uint8_t> packet;
+		BitWriter writer(packet);
+		WritePacketHeader(writer, type);
+		if (type == PacketType::Acknowledge)
+		{
+			writer.Write(sequence, 32);
+		}
+
+		m_Transport.Send(m_Server, packet.data(), packet.size());
+	}
+}//namespace Sengine::Net
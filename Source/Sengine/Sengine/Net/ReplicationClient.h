@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Protocol.h"
+#include "Snapshot.h"
+#include "Transport.h"
+
+namespace Sengine
+{
+	class Scene;
+}
+
+namespace Sengine::Net
+{
+	//Mirrors a server's replicated entities into a scene. Creates, updates and destroys entities as snapshots arrive
+	//and acknowledges each one so the server can send the next relative to it. Snapshots older than the newest one
+	//applied are dropped. Losing the connection removes the mirrored entities.
+	class ReplicationClient
+	{
+	public:
+		//The components have to be the ones the server was given, in the same order.
+		ReplicationClient(Scene& scene, Transport& transport, const NetAddress& server, std::vector<ReplicatedComponent> components);
+		~ReplicationClient();
+
+		ReplicationClient(const ReplicationClient&) = delete;
+		ReplicationClient& operator=(const ReplicationClient&) = delete;
+
+		//Connects, receives and applies snapshots. Call every tick.
+		void Update(float deltaSeconds);
+
+		//Connected once a snapshot has arrived, until none has for the timeout.
+		[[nodiscard]] bool GetIsConnected() const { return m_IsConnected; }
+		//entt::null for network IDs the client has no entity for.
+		[[nodiscard]] entt::entity GetEntity(uint32_t netID) const;
+		//Sequence of the snapshot the scene shows.
+		[[nodiscard]] uint32_t GetSequence() const { return m_AppliedSequence; }
+
+		void SetTimeout(float seconds) { m_TimeoutSeconds = seconds; }
+
+	private:
+		void ReceiveSnapshot(BitReader& reader);
+		//The entities that differ from what the scene shows, and the ones that are gone.
+		void ApplyToScene(const Snapshot& updates, const std::vector<uint32_t>& removed);
+		void RemoveEntity(entt::entity entity);
+		void Disconnect();
+		void Send(PacketType type, uint32_t sequence = 0);
+
+	private:
+		//A snapshot can only be decoded against a baseline the client still has, and the server only uses ones the
+		//client acknowledged, so this has to cover the time acknowledgements take to arrive.
+		static constexpr size_t HistorySize = 32;
+
+		struct ReceivedSnapshot
+		{
+			uint32_t Sequence = NoSequence;
+			Snapshot State;
+		};
+
+		Scene& m_Scene;
+		Transport& m_Transport;
+		NetAddress m_Server;
+		ReplicationSchema m_Schema;
+
+		bool m_IsConnected = false;
+		float m_TimeSinceReceive = 0.0f;
+		float m_TimeSinceHello = 0.0f;
+		float m_TimeoutSeconds = 5.0f;
+
+		std::array<ReceivedSnapshot, HistorySize> m_History;
+		uint32_t m_AppliedSequence = NoSequence;
+		std::unordered_map<uint32_t, entt::entity> m_Entities;
+		//Network IDs of entities whose parent has not arrived yet, and of their parents.
+		std::unordered_map<uint32_t, uint32_t> m_MissingParents;
+
+		Snapshot m_Empty;
+		//What the scene shows. The last merged snapshot, plus entities from before a reset not sent again yet.
+		Snapshot m_Applied;
+		Snapshot m_Merged;
+		Snapshot m_Updates;
+		std::vector<uint32_t> m_Removed;
+		std::vector<EntityChange> m_Changes;
+		std::vector<uint8_t> m_Packet;
+	};
+}//namespace Sengine::Net
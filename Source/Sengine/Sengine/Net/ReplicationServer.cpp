@@ -0,0 +1,348 @@
+#include "ReplicationServer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+#include "Core/Profiler.h"
+#include "Protocol.h"
+#include "Scene/Scene.h"
+
+namespace Sengine::Net
+{
+	namespace
+	{
+		//Protocol, type, sequence, baseline and entity count.
+		constexpr size_t SnapshotHeaderBits = 16 + 8 + 32 + 32 + 16;
+		constexpr uint32_t MaxEntitiesPerSnapshot = 0xFFFF;
+		//Unacknowledged snapshots kept per client, about a second at the default send rate.
+		constexpr size_t MaxSentSnapshots = 32;
+		//Creating and removing entities goes ahead of updating the ones clients already have.
+		constexpr float CreateOrRemovePriority = 4.0f;
+		//Changes that did not fit before the rest are left for later snapshots.
+		constexpr uint32_t MaxMissesInARow = 8;
+
+		size_t GetVariableBitCount(uint32_t value)
+		{
+			uint32_t bitCount = 0;
+			while (bitCount < 32 && (value >> bitCount) != 0)
+			{
+				bitCount++;
+			}
+			return 5 + (bitCount == 31 ? 32 : bitCount);
+		}
+	}
+
+	ReplicationServer::ReplicationServer(Scene& scene, Transport& transport, std::vector<ReplicatedComponent> components, const ReplicationSettings& settings)
+		: m_Scene(scene), m_Transport(transport), m_Schema(std::move(components)), m_Settings(settings)
+	{
+	}
+
+	uint32_t ReplicationServer::Replicate(entt::entity entity)
+	{
+		entt::registry& registry = m_Scene.GetRegistry();
+		if (const NetworkedComponent* networked = registry.try_get<NetworkedComponent>(entity))
+		{
+			return networked->NetID;
+		}
+
+		registry.emplace<NetworkedComponent>(entity, m_NextNetID);
+		return m_NextNetID++;
+	}
+
+	void ReplicationServer::StopReplicating(entt::entity entity)
+	{
+		m_Scene.GetRegistry().remove<NetworkedComponent>(entity);
+	}
+
+	void ReplicationServer::Update(float deltaSeconds)
+	{
+		SE_PROFILE_FUNCTION();
+
+		ReceivePackets();
+
+		for (size_t index = 0; index < m_Clients.size();)
+		{
+			m_Clients[index].TimeSinceReceive += deltaSeconds;
+			if (m_Clients[index].TimeSinceReceive > m_Settings.TimeoutSeconds)
+			{
+				m_Clients.erase(m_Clients.begin() + index);
+				continue;
+			}
+			index++;
+		}
+
+		//A long frame sends one snapshot late rather than a burst of them.
+		const float interval = 1.0f / static_cast<float>(m_Settings.SendRate);
+		m_SendTimer += deltaSeconds;
+		if (m_SendTimer < interval) return;
+		m_SendTimer = std::min(m_SendTimer - interval, interval);
+
+		if (m_Clients.empty()) return;
+
+		//Captured once and compared against each client's own baseline.
+		m_Schema.Capture(m_Scene.GetRegistry(), m_Current);
+		FindOrphans();
+
+		for (Client& client : m_Clients)
+		{
+			SendSnapshot(client);
+		}
+		m_Sequence++;
+	}
+
+	void ReplicationServer::ReceivePackets()
+	{
+		NetAddress address;
+		while (m_Transport.Receive(address, m_Packet))
+		{
+			BitReader reader(m_Packet.data(), m_Packet.size());
+			PacketType type;
+			if (!ReadPacketHeader(reader, type)) continue;
+
+			const auto client = std::find_if(m_Clients.begin(), m_Clients.end(), [&address](const Client& other) { return other.Address == address; });
+			if (client == m_Clients.end())
+			{
+				if (type != PacketType::Hello) continue;
+
+				if (m_Clients.size() >= m_Settings.MaxClients)
+				{
+					std::cout << "[Replication] Error: Refused a client, the server is full\n";
+					continue;
+				}
+
+				Client& added = m_Clients.emplace_back();
+				added.Address = address;
+				continue;
+			}
+
+			client->TimeSinceReceive = 0.0f;
+			if (type == PacketType::Hello)
+			{
+				Reset(*client);
+				continue;
+			}
+			if (type == PacketType::Disconnect)
+			{
+				m_Clients.erase(client);
+				continue;
+			}
+
+			if (type == PacketType::Acknowledge)
+			{
+				const uint32_t sequence = reader.Read(32);
+				if (reader.GetIsValid())
+				{
+					Acknowledge(*client, sequence);
+				}
+			}
+		}
+	}
+
+	void ReplicationServer::FindOrphans()
+	{
+		size_t current = 0;
+		for (const uint32_t netID : m_PreviousNetIDs)
+		{
+			while (current < m_Current.GetEntityCount() && m_Current.NetIDs[current] < netID)
+			{
+				current++;
+			}
+			if (current < m_Current.GetEntityCount() && m_Current.NetIDs[current] == netID) continue;
+
+			//Removed since the last snapshot. Network IDs are never reused, so a removal the client did not need costs a
+			//couple of bytes and nothing else.
+			for (Client& client : m_Clients)
+			{
+				if (!std::binary_search(client.Baseline.NetIDs.begin(), client.Baseline.NetIDs.end(), netID))
+				{
+					client.Orphans.push_back(netID);
+				}
+			}
+		}
+
+		m_PreviousNetIDs = m_Current.NetIDs;
+	}
+
+	void ReplicationServer::Reset(Client& client)
+	{
+		//The client may still show entities the server has since removed, but with no baseline nothing would compare
+		//as removed, so every one it could have been sent goes on as an orphan. The rest arrive as new entities.
+		std::vector<uint32_t> mayHave = client.Orphans;
+		mayHave.insert(mayHave.end(), client.Baseline.NetIDs.begin(), client.Baseline.NetIDs.end());
+		for (SentSnapshot& sent : client.Sent)
+		{
+			mayHave.insert(mayHave.end(), sent.State.NetIDs.begin(), sent.State.NetIDs.end());
+			m_SpareSnapshots.push_back(std::move(sent.State));
+		}
+		std::sort(mayHave.begin(), mayHave.end());
+		mayHave.erase(std::unique(mayHave.begin(), mayHave.end()), mayHave.end());
+
+		client.Orphans.clear();
+		for (const uint32_t netID : mayHave)
+		{
+			if (!std::binary_search(m_Current.NetIDs.begin(), m_Current.NetIDs.end(), netID))
+			{
+				client.Orphans.push_back(netID);
+			}
+		}
+
+		client.BaselineSequence = NoSequence;
+		client.Baseline.Clear();
+		client.Sent.clear();
+		client.Priorities.clear();
+	}
+
+	void ReplicationServer::Acknowledge(Client& client, uint32_t sequence)
+	{
+		//Late and duplicate acknowledgements find nothing, the snapshots they are for have already been dropped.
+		const auto sent = std::find_if(client.Sent.begin(), client.Sent.end(), [sequence](const SentSnapshot& snapshot) { return snapshot.Sequence == sequence; });
+		if (sent == client.Sent.end()) return;
+
+		client.BaselineSequence = sequence;
+		std::swap(client.Baseline, sent->State);
+		for (const uint32_t netID : sent->RemovedOrphans)
+		{
+			client.Orphans.erase(std::remove(client.Orphans.begin(), client.Orphans.end(), netID), client.Orphans.end());
+		}
+		for (auto dropped = client.Sent.begin(); dropped != sent + 1; ++dropped)
+		{
+			m_SpareSnapshots.push_back(std::move(dropped->State));
+		}
+		client.Sent.erase(client.Sent.begin(), sent + 1);
+	}
+
+	void ReplicationServer::SendSnapshot(Client& client)
+	{
+		m_Changes.clear();
+		m_Schema.Compare(m_Current, client.Baseline, m_Changes);
+		for (const uint32_t netID : client.Orphans)
+		{
+			EntityChange& change = m_Changes.emplace_back();
+			change.NetID = netID;
+		}
+
+		//Priority builds up for as long as an entity is out of date, so even the least important changes get sent
+		//eventually however busy the scene is.
+		client.Priorities.resize(m_NextNetID, 0.0f);
+		const std::vector<ReplicatedComponent>& components = m_Schema.GetComponents();
+		m_Queue.clear();
+		for (size_t index = 0; index < m_Changes.size(); index++)
+		{
+			const EntityChange& change = m_Changes[index];
+			float priority = 0.0f;
+			if (change.Current == EntityChange::None || change.Baseline == EntityChange::None)
+			{
+				priority = CreateOrRemovePriority;
+			}
+			else
+			{
+				priority = change.IsParentChanged ? 1.0f : 0.0f;
+				for (size_t component = 0; component < components.size(); component++)
+				{
+					if (change.ChangedComponents & (1u << component))
+					{
+						priority += components[component].Priority;
+					}
+				}
+			}
+
+			client.Priorities[change.NetID] += priority;
+			m_Queue.push_back({ client.Priorities[change.NetID], static_cast<uint32_t>(index) });
+		}
+
+		//A busy scene has far more changes than fit in a packet, so they come off a heap until the budget runs out
+		//rather than all being sorted. Changes come from Compare in network ID order, so ties go to the lower ID.
+		const auto isLower = [](const QueuedChange& first, const QueuedChange& second)
+		{
+			return first.Priority != second.Priority ? first.Priority < second.Priority : first.Index > second.Index;
+		};
+		std::make_heap(m_Queue.begin(), m_Queue.end(), isLower);
+
+		//Smaller changes further down can still fill what a big one left, until a few in a row have not fit.
+		const uint32_t packetSize = std::min(m_Settings.MaxPacketSize, m_Settings.BytesPerSecond / m_Settings.SendRate);
+		const size_t budget = packetSize * size_t(8) > SnapshotHeaderBits ? packetSize * size_t(8) - SnapshotHeaderBits : 0;
+		size_t used = 0;
+		uint32_t missesInARow = 0;
+		m_Selected.clear();
+		while (!m_Queue.empty() && missesInARow < MaxMissesInARow && m_Selected.size() < MaxEntitiesPerSnapshot)
+		{
+			std::pop_heap(m_Queue.begin(), m_Queue.end(), isLower);
+			const EntityChange& change = m_Changes[m_Queue.back().Index];
+			m_Queue.pop_back();
+
+			//The network ID costs at most what it would on its own, it is written as the gap from the previous one.
+			const size_t cost = GetVariableBitCount(change.NetID) + m_Schema.GetEntityBitCount(change, m_Current);
+			if (used + cost > budget)
+			{
+				missesInARow++;
+				continue;
+			}
+
+			used += cost;
+			missesInARow = 0;
+			m_Selected.push_back(change);
+			client.Priorities[change.NetID] = 0.0f;
+		}
+		m_Statistics.EntitiesDeferred += m_Changes.size() - m_Selected.size();
+
+		std::sort(m_Selected.begin(), m_Selected.end(), [](const EntityChange& first, const EntityChange& second) { return first.NetID < second.NetID; });
+
+		m_Packet.clear();
+		BitWriter writer(m_Packet);
+		WritePacketHeader(writer, PacketType::Snapshot);
+		writer.Write(m_Sequence, 32);
+		writer.Write(client.BaselineSequence, 32);
+		writer.Write(static_cast<uint32_t>(m_Selected.size()), 16);
+
+		m_Updates.Clear();
+		m_Removed.clear();
+		uint32_t previousID = 0;
+		for (const EntityChange& change : m_Selected)
+		{
+			writer.WriteVariable(change.NetID - previousID);
+			m_Schema.WriteEntity(writer, change, m_Current);
+			previousID = change.NetID;
+
+			if (change.Current == EntityChange::None)
+			{
+				m_Removed.push_back(change.NetID);
+			}
+			else
+			{
+				m_Updates.Append(m_Current, change.Current, 1, m_Schema.GetValueCount());
+			}
+		}
+
+		m_Transport.Send(client.Address, m_Packet.data(), m_Packet.size());
+
+		//What the client will have once it decodes this snapshot, the baseline for later ones if it acknowledges it.
+		SentSnapshot sent;
+		if (client.Sent.size() == MaxSentSnapshots)
+		{
+			sent = std::move(client.Sent.front());
+			client.Sent.pop_front();
+		}
+		else if (!m_SpareSnapshots.empty())
+		{
+			sent.State = std::move(m_SpareSnapshots.back());
+			m_SpareSnapshots.pop_back();
+		}
+		sent.Sequence = m_Sequence;
+		//A recycled slot still holds the orphans of the snapshot it was, which this one may not have carried.
+		sent.RemovedOrphans.clear();
+		for (const EntityChange& change : m_Selected)
+		{
+			if (change.Current == EntityChange::None && change.Baseline == EntityChange::None)
+			{
+				sent.RemovedOrphans.push_back(change.NetID);
+			}
+		}
+		m_Schema.Merge(client.Baseline, m_Updates, m_Removed, sent.State);
+		client.Sent.push_back(std::move(sent));
+
+		m_Statistics.PacketsSent++;
+		m_Statistics.BytesSent += m_Packet.size();
+		m_Statistics.EntitiesSent += m_Selected.size();
+	}
+}//namespace Sengine::Net
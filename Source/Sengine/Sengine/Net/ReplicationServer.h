@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "Snapshot.h"
+#include "Transport.h"
+
+namespace Sengine
+{
+	class Scene;
+}
+
+namespace Sengine::Net
+{
+	struct ReplicationSettings
+	{
+		//Snapshots sent to each client per second.
+		uint32_t SendRate = 30;
+		//Per client. Changes that do not fit wait for a later snapshot, the longest waiting and most important first.
+		uint32_t BytesPerSecond = 32 * 1024;
+		//Under a typical MTU, so snapshots are never fragmented.
+		uint32_t MaxPacketSize = 1200;
+		uint32_t MaxClients = 64;
+		//Clients that send nothing for this long are dropped.
+		float TimeoutSeconds = 5.0f;
+	};
+
+	struct ReplicationStatistics
+	{
+		uint64_t PacketsSent = 0;
+		uint64_t BytesSent = 0;
+		uint64_t EntitiesSent = 0;
+		//Changed entities left for a later snapshot because the budget ran out.
+		uint64_t EntitiesDeferred = 0;
+	};
+
+	//Sends the replicated entities of a scene to every connected client. Each snapshot only holds what differs from
+	//the last one the client acknowledged, so lost packets need no resends: whatever they carried is still different
+	//from the baseline and goes out again in the next snapshot.
+	class ReplicationServer
+	{
+	public:
+		ReplicationServer(Scene& scene, Transport& transport, std::vector<ReplicatedComponent> components, const ReplicationSettings& settings = {});
+
+		ReplicationServer(const ReplicationServer&) = delete;
+		ReplicationServer& operator=(const ReplicationServer&) = delete;
+
+		//Returns the entity's network ID. Entities are replicated with their parent if the parent is replicated too.
+		uint32_t Replicate(entt::entity entity);
+		//Clients destroy their copy, as they do when the entity is destroyed.
+		void StopReplicating(entt::entity entity);
+
+		//Handles connections and acknowledgements and sends each client a snapshot when one is due. Call every tick.
+		void Update(float deltaSeconds);
+
+		[[nodiscard]] uint32_t GetClientCount() const { return static_cast<uint32_t>(m_Clients.size()); }
+		[[nodiscard]] const ReplicationStatistics& GetStatistics() const { return m_Statistics; }
+
+	private:
+		struct SentSnapshot
+		{
+			uint32_t Sequence = 0;
+			Snapshot State;
+			std::vector<uint32_t> RemovedOrphans;
+		};
+
+		struct Client
+		{
+			NetAddress Address;
+			float TimeSinceReceive = 0.0f;
+
+			//What the client is known to have, everything sent is relative to it.
+			uint32_t BaselineSequence = NoSequence;
+			Snapshot Baseline;
+			//Sent but not acknowledged yet, oldest first.
+			std::deque<SentSnapshot> Sent;
+			//Removed entities the client may have been sent, but which are not in the baseline. Created and removed again
+			//before an acknowledgement came back, so comparing with the baseline does not find them.
+			std::vector<uint32_t> Orphans;
+
+			//Indexed by network ID. Grows each snapshot an entity is out of date for, reset when it is sent.
+			std::vector<float> Priorities;
+		};
+
+		struct QueuedChange
+		{
+			float Priority = 0.0f;
+			uint32_t Index = 0;
+		};
+
+		void ReceivePackets();
+		void FindOrphans();
+		//Starts the client over from an empty baseline, for a client that says hello again because it lost its own.
+		void Reset(Client& client);
+		void Acknowledge(Client& client, uint32_t sequence);
+		void SendSnapshot(Client& client);
+
+	private:
+		Scene& m_Scene;
+		Transport& m_Transport;
+		ReplicationSchema m_Schema;
+		ReplicationSettings m_Settings;
+		ReplicationStatistics m_Statistics;
+
+		std::vector<Client> m_Clients;
+		uint32_t m_NextNetID = 0;
+		uint32_t m_Sequence = 0;
+		float m_SendTimer = 0.0f;
+
+		//Reused every snapshot so sending allocates nothing once sizes settle.
+		Snapshot m_Current;
+		std::vector<uint32_t> m_PreviousNetIDs;
+		Snapshot m_Updates;
+		std::vector<uint32_t> m_Removed;
+		std::vector<EntityChange> m_Changes;
+		std::vector<QueuedChange> m_Queue;
+		std::vector<EntityChange> m_Selected;
+		std::vector<uint8_t> m_Packet;
+		//Acknowledged snapshots keep their capacity for the next ones sent.
+		std::vector<Snapshot> m_SpareSnapshots;
+	};
+}//namespace Sengine::Net
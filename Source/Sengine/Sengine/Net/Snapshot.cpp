@@ -0,0 +1,298 @@
+#include "Snapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "Scene/Components.h"
+#include "Utils/Assert.h"
+
+namespace Sengine::Net
+{
+	namespace
+	{
+		uint32_t FindEntity(const Snapshot& snapshot, uint32_t netID)
+		{
+			const auto entry = std::lower_bound(snapshot.NetIDs.begin(), snapshot.NetIDs.end(), netID);
+			return entry != snapshot.NetIDs.end() && *entry == netID ? static_cast<uint32_t>(entry - snapshot.NetIDs.begin()) : EntityChange::None;
+		}
+	}
+
+	void Snapshot::Clear()
+	{
+		NetIDs.clear();
+		Parents.clear();
+		Masks.clear();
+		Values.clear();
+	}
+
+	void Snapshot::Append(const Snapshot& source, size_t index, size_t count, uint32_t valueCount)
+	{
+		NetIDs.insert(NetIDs.end(), source.NetIDs.begin() + index, source.NetIDs.begin() + index + count);
+		Parents.insert(Parents.end(), source.Parents.begin() + index, source.Parents.begin() + index + count);
+		Masks.insert(Masks.end(), source.Masks.begin() + index, source.Masks.begin() + index + count);
+		Values.insert(Values.end(), source.Values.begin() + index * valueCount, source.Values.begin() + (index + count) * valueCount);
+	}
+
+	ReplicationSchema::ReplicationSchema(std::vector<ReplicatedComponent> components)
+		: m_Components(std::move(components))
+	{
+		SE_Assert(m_Components.size() > MaxComponents, "[Replication] Error: Too many replicated components");
+
+		for (const ReplicatedComponent& component : m_Components)
+		{
+			m_Offsets.push_back(m_ValueCount);
+			m_ValueCount += static_cast<uint32_t>(component.ValueBits.size());
+		}
+	}
+
+	void ReplicationSchema::Capture(const entt::registry& registry, Snapshot& snapshot) const
+	{
+		snapshot.Clear();
+
+		std::vector<std::pair<uint32_t, entt::entity>> entities;
+		for (const auto [entity, networked] : registry.view<NetworkedComponent>().each())
+		{
+			entities.emplace_back(networked.NetID, entity);
+		}
+		std::sort(entities.begin(), entities.end());
+
+		snapshot.NetIDs.reserve(entities.size());
+		snapshot.Parents.reserve(entities.size());
+		snapshot.Masks.reserve(entities.size());
+		snapshot.Values.resize(entities.size() * m_ValueCount, 0);
+
+		for (size_t index = 0; index < entities.size(); index++)
+		{
+			const auto [netID, entity] = entities[index];
+
+			uint32_t parent = 0;
+			if (const RelationshipComponent* relationship = registry.try_get<RelationshipComponent>(entity); relationship && relationship->Parent != entt::null)
+			{
+				//Parents that are not replicated themselves leave the entity a root on clients.
+				const NetworkedComponent* parentNetworked = registry.try_get<NetworkedComponent>(relationship->Parent);
+				parent = parentNetworked ? parentNetworked->NetID + 1 : 0;
+			}
+
+			uint32_t mask = 0;
+			uint32_t* values = snapshot.Values.data() + index * m_ValueCount;
+			for (size_t component = 0; component < m_Components.size(); component++)
+			{
+				if (m_Components[component].Quantize(registry, entity, values + m_Offsets[component]))
+				{
+					mask |= 1u << component;
+				}
+			}
+
+			snapshot.NetIDs.push_back(netID);
+			snapshot.Parents.push_back(parent);
+			snapshot.Masks.push_back(mask);
+		}
+	}
+
+	void ReplicationSchema::Compare(const Snapshot& current, const Snapshot& baseline, std::vector<EntityChange>& changes) const
+	{
+		uint32_t currentIndex = 0;
+		uint32_t baselineIndex = 0;
+		while (currentIndex < current.GetEntityCount() || baselineIndex < baseline.GetEntityCount())
+		{
+			const uint32_t currentID = currentIndex < current.GetEntityCount() ? current.NetIDs[currentIndex] : ~0u;
+			const uint32_t baselineID = baselineIndex < baseline.GetEntityCount() ? baseline.NetIDs[baselineIndex] : ~0u;
+
+			EntityChange change;
+			if (currentID < baselineID)
+			{
+				change.NetID = currentID;
+				change.Current = currentIndex++;
+				change.ChangedComponents = current.Masks[change.Current];
+				change.IsParentChanged = current.Parents[change.Current] != 0;
+				changes.push_back(change);
+				continue;
+			}
+
+			if (baselineID < currentID)
+			{
+				change.NetID = baselineID;
+				change.Baseline = baselineIndex++;
+				changes.push_back(change);
+				continue;
+			}
+
+			change.NetID = currentID;
+			change.Current = currentIndex++;
+			change.Baseline = baselineIndex++;
+
+			const uint32_t* currentValues = current.Values.data() + size_t(change.Current) * m_ValueCount;
+			const uint32_t* baselineValues = baseline.Values.data() + size_t(change.Baseline) * m_ValueCount;
+
+			//Most entities in a snapshot have not changed since the last one a client acknowledged.
+			const bool isSame = current.Masks[change.Current] == baseline.Masks[change.Baseline] && current.Parents[change.Current] == baseline.Parents[change.Baseline] &&
+				std::memcmp(currentValues, baselineValues, m_ValueCount * sizeof(uint32_t)) == 0;
+			if (isSame) continue;
+
+			change.IsParentChanged = current.Parents[change.Current] != baseline.Parents[change.Baseline];
+			change.ChangedComponents = current.Masks[change.Current] ^ baseline.Masks[change.Baseline];
+			for (size_t component = 0; component < m_Components.size(); component++)
+			{
+				const uint32_t offset = m_Offsets[component];
+				const size_t size = m_Components[component].ValueBits.size() * sizeof(uint32_t);
+				if (std::memcmp(currentValues + offset, baselineValues + offset, size) != 0)
+				{
+					change.ChangedComponents |= 1u << component;
+				}
+			}
+			changes.push_back(change);
+		}
+	}
+
+	size_t ReplicationSchema::GetEntityBitCount(const EntityChange& change, const Snapshot& current) const
+	{
+		if (change.Current == EntityChange::None) return 1;
+
+		size_t bitCount = 2 + m_Components.size();
+		if (change.IsParentChanged)
+		{
+			const uint32_t parent = current.Parents[change.Current];
+			uint32_t parentBits = 0;
+			while (parentBits < 32 && (parent >> parentBits) != 0)
+			{
+				parentBits++;
+			}
+			bitCount += 5 + (parentBits == 31 ? 32 : parentBits);
+		}
+
+		for (size_t component = 0; component < m_Components.size(); component++)
+		{
+			if ((change.ChangedComponents & (1u << component)) == 0) continue;
+
+			bitCount++;
+			if ((current.Masks[change.Current] & (1u << component)) == 0) continue;
+
+			for (const uint8_t bits : m_Components[component].ValueBits)
+			{
+				bitCount += bits;
+			}
+		}
+		return bitCount;
+	}
+
+	void ReplicationSchema::WriteEntity(BitWriter& writer, const EntityChange& change, const Snapshot& current) const
+	{
+		writer.WriteBool(change.Current == EntityChange::None);
+		if (change.Current == EntityChange::None) return;
+
+		writer.WriteBool(change.IsParentChanged);
+		if (change.IsParentChanged)
+		{
+			writer.WriteVariable(current.Parents[change.Current]);
+		}
+
+		const uint32_t* values = current.Values.data() + size_t(change.Current) * m_ValueCount;
+		for (size_t component = 0; component < m_Components.size(); component++)
+		{
+			const bool isChanged = (change.ChangedComponents & (1u << component)) != 0;
+			writer.WriteBool(isChanged);
+			if (!isChanged) continue;
+
+			const bool isPresent = (current.Masks[change.Current] & (1u << component)) != 0;
+			writer.WriteBool(isPresent);
+			if (!isPresent) continue;
+
+			const std::vector<uint8_t>& bits = m_Components[component].ValueBits;
+			for (size_t value = 0; value < bits.size(); value++)
+			{
+				writer.Write(values[m_Offsets[component] + value], bits[value]);
+			}
+		}
+	}
+
+	void ReplicationSchema::ReadEntity(BitReader& reader, uint32_t netID, const Snapshot& baseline, Snapshot& updates, std::vector<uint32_t>& removed) const
+	{
+		if (reader.ReadBool())
+		{
+			removed.push_back(netID);
+			return;
+		}
+
+		//Anything not sent is as it was in the baseline, or absent for an entity the baseline does not have.
+		const uint32_t baselineIndex = FindEntity(baseline, netID);
+		uint32_t parent = 0;
+		uint32_t mask = 0;
+		updates.Values.resize(updates.Values.size() + m_ValueCount, 0);
+		uint32_t* values = updates.Values.data() + updates.Values.size() - m_ValueCount;
+		if (baselineIndex != EntityChange::None)
+		{
+			parent = baseline.Parents[baselineIndex];
+			mask = baseline.Masks[baselineIndex];
+			std::memcpy(values, baseline.Values.data() + size_t(baselineIndex) * m_ValueCount, m_ValueCount * sizeof(uint32_t));
+		}
+
+		if (reader.ReadBool())
+		{
+			parent = reader.ReadVariable();
+		}
+
+		for (size_t component = 0; component < m_Components.size(); component++)
+		{
+			if (!reader.ReadBool()) continue;
+
+			const std::vector<uint8_t>& bits = m_Components[component].ValueBits;
+			uint32_t* componentValues = values + m_Offsets[component];
+			if (!reader.ReadBool())
+			{
+				mask &= ~(1u << component);
+				std::fill(componentValues, componentValues + bits.size(), 0u);
+				continue;
+			}
+
+			mask |= 1u << component;
+			for (size_t value = 0; value < bits.size(); value++)
+			{
+				componentValues[value] = reader.Read(bits[value]);
+			}
+		}
+
+		updates.NetIDs.push_back(netID);
+		updates.Parents.push_back(parent);
+		updates.Masks.push_back(mask);
+	}
+
+	void ReplicationSchema::Merge(const Snapshot& baseline, const Snapshot& updates, const std::vector<uint32_t>& removed, Snapshot& output) const
+	{
+		output.Clear();
+		output.NetIDs.reserve(baseline.GetEntityCount() + updates.GetEntityCount());
+		output.Parents.reserve(baseline.GetEntityCount() + updates.GetEntityCount());
+		output.Masks.reserve(baseline.GetEntityCount() + updates.GetEntityCount());
+		output.Values.reserve((baseline.GetEntityCount() + updates.GetEntityCount()) * m_ValueCount);
+
+		//Runs of baseline entities between updates and removals are copied whole, most of a snapshot is unchanged.
+		size_t baselineIndex = 0;
+		size_t updateIndex = 0;
+		size_t removedIndex = 0;
+		while (baselineIndex < baseline.GetEntityCount() || updateIndex < updates.GetEntityCount())
+		{
+			const uint32_t updateID = updateIndex < updates.GetEntityCount() ? updates.NetIDs[updateIndex] : ~0u;
+			const uint32_t removedID = removedIndex < removed.size() ? removed[removedIndex] : ~0u;
+			const uint32_t nextID = std::min(updateID, removedID);
+
+			const size_t runEnd = static_cast<size_t>(std::lower_bound(baseline.NetIDs.begin() + baselineIndex, baseline.NetIDs.end(), nextID) - baseline.NetIDs.begin());
+			output.Append(baseline, baselineIndex, runEnd - baselineIndex, m_ValueCount);
+			baselineIndex = runEnd;
+			if (nextID == ~0u) break;
+
+			if (baselineIndex < baseline.GetEntityCount() && baseline.NetIDs[baselineIndex] == nextID)
+			{
+				baselineIndex++;
+			}
+
+			if (updateID == nextID)
+			{
+				output.Append(updates, updateIndex++, 1, m_ValueCount);
+			}
+			else
+			{
+				removedIndex++;
+			}
+		}
+	}
+}//namespace Sengine::Net
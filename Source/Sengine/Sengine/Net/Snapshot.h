@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BitStream.h"
+#include "ReplicatedComponent.h"
+
+namespace Sengine::Net
+{
+	constexpr uint32_t NoSequence = 0xFFFFFFFF;
+
+	//The quantized state of every replicated entity at one point, sorted by network ID. Kept as flat arrays so copying
+	//and comparing snapshots for dozens of clients a tick is a few copies and integer compares.
+	struct Snapshot
+	{
+		std::vector<uint32_t> NetIDs;
+		//Network ID of the parent plus one, zero for roots.
+		std::vector<uint32_t> Parents;
+		//A bit per replicated component the entity has.
+		std::vector<uint32_t> Masks;
+		//ReplicationSchema::GetValueCount() values per entity, zero for components it does not have.
+		std::vector<uint32_t> Values;
+
+		void Clear();
+		//Copies count entities from index on.
+		void Append(const Snapshot& source, size_t index, size_t count, uint32_t valueCount);
+
+		[[nodiscard]] size_t GetEntityCount() const { return NetIDs.size(); }
+	};
+
+	//How one entity differs from the snapshot a client is known to have. A removed entity has no current index, a new
+	//one no baseline index.
+	struct EntityChange
+	{
+		static constexpr uint32_t None = ~0u;
+
+		uint32_t NetID = 0;
+		uint32_t Current = None;
+		uint32_t Baseline = None;
+		uint32_t ChangedComponents = 0;
+		bool IsParentChanged = false;
+	};
+
+	//The replicated components, shared by the server and its clients, and the wire format of entities built from them.
+	//Only what differs from the baseline is written and a changed component is always sent whole, so an entity the
+	//client has decoded always matches the server's snapshot exactly.
+	class ReplicationSchema
+	{
+	public:
+		static constexpr uint32_t MaxComponents = 32;
+
+		explicit ReplicationSchema(std::vector<ReplicatedComponent> components);
+
+		[[nodiscard]] const std::vector<ReplicatedComponent>& GetComponents() const { return m_Components; }
+		[[nodiscard]] uint32_t GetValueCount() const { return m_ValueCount; }
+		[[nodiscard]] uint32_t GetValueOffset(size_t component) const { return m_Offsets[component]; }
+
+		//Quantizes every entity with a NetworkedComponent.
+		void Capture(const entt::registry& registry, Snapshot& snapshot) const;
+
+		//Appends the entities of current that differ from baseline, both sorted by network ID.
+		void Compare(const Snapshot& current, const Snapshot& baseline, std::vector<EntityChange>& changes) const;
+
+		//Size of WriteEntity's output, without the network ID.
+		[[nodiscard]] size_t GetEntityBitCount(const EntityChange& change, const Snapshot& current) const;
+		void WriteEntity(BitWriter& writer, const EntityChange& change, const Snapshot& current) const;
+		//Reads an entity WriteEntity wrote against the same baseline. Adds it to updates, or its network ID to removed.
+		void ReadEntity(BitReader& reader, uint32_t netID, const Snapshot& baseline, Snapshot& updates, std::vector<uint32_t>& removed) const;
+
+		//The snapshot a client ends up with after applying a packet, the baseline with the updated entities replaced and
+		//the removed ones left out. Updates and removed are sorted by network ID.
+		void Merge(const Snapshot& baseline, const Snapshot& updates, const std::vector<uint32_t>& removed, Snapshot& output) const;
+
+	private:
+		std::vector<ReplicatedComponent> m_Components;
+		std::vector<uint32_t> m_Offsets;
+		uint32_t m_ValueCount = 0;
+	};
+}//namespace Sengine::Net
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Sengine::Net
+{
+	//An IPv4 address and port in host byte order. In process transports use the port alone.
+	struct NetAddress
+	{
+		uint32_t Host = 0;
+		uint16_t Port = 0;
+
+		[[nodiscard]] bool operator==(const NetAddress& other) const { return Host == other.Host && Port == other.Port; }
+		[[nodiscard]] bool operator!=(const NetAddress& other) const { return !(*this == other); }
+	};
+
+	//Unreliable, unordered datagrams. Replication copes with loss and reordering itself, so a transport only has to
+	//deliver whole packets or none at all.
+	class Transport
+	{
+	public:
+		virtual ~Transport() = default;
+
+		virtual void Send(const NetAddress& address, const uint8_t* data, size_t size) = 0;
+		//Never blocks, returns false when nothing is waiting.
+		[[nodiscard]] virtual bool Receive(NetAddress& address, std::vector<uint8_t>& data) = 0;
+
+		[[nodiscard]] virtual NetAddress GetAddress() const = 0;
+	};
+}//namespace Sengine::Net
@@ -0,0 +1,148 @@
+#include "UdpTransport.h"
+
+#include <iostream>
+
+#ifdef SE_PLATFORM_WINDOWS
+	#include <WinSock2.h>
+
+	#pragma comment(lib, "Ws2_32.lib")
+#else
+	#include <arpa/inet.h>
+	#include <fcntl.h>
+	#include <netinet/in.h>
+	#include <sys/socket.h>
+	#include <unistd.h>
+#endif
+
+namespace Sengine::Net
+{
+	namespace
+	{
+#ifdef SE_PLATFORM_WINDOWS
+		using SocketLength = int;
+		constexpr uint64_t InvalidSocket = static_cast<uint64_t>(INVALID_SOCKET);
+
+		void CloseSocket(uint64_t socket) { closesocket(static_cast<SOCKET>(socket)); }
+#else
+		using SocketLength = socklen_t;
+		constexpr uint64_t InvalidSocket = ~0ull;
+
+		void CloseSocket(uint64_t socket) { close(static_cast<int>(socket)); }
+#endif
+
+		//Larger than any packet replication sends, a bigger datagram is truncated and dropped.
+		constexpr size_t MaxDatagramSize = 2048;
+	}
+
+	std::unique_ptr<UdpTransport> UdpTransport::Create(uint16_t port)
+	{
+#ifdef SE_PLATFORM_WINDOWS
+		//Reference counted by Winsock, so every transport starting it again is fine.
+		WSADATA data = {};
+		if (WSAStartup(MAKEWORD(2, 2), &data) != 0)
+		{
+			std::cout << "[UDP Transport] Error: Failed to start Winsock\n";
+			return nullptr;
+		}
+
+		const SOCKET handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+		const uint64_t udpSocket = handle == INVALID_SOCKET ? InvalidSocket : static_cast<uint64_t>(handle);
+#else
+		const int handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+		const uint64_t udpSocket = handle < 0 ? InvalidSocket : static_cast<uint64_t>(handle);
+#endif
+		if (udpSocket == InvalidSocket)
+		{
+#ifdef SE_PLATFORM_WINDOWS
+			WSACleanup();
+#endif
+			std::cout << "[UDP Transport] Error: Failed to create a socket\n";
+			return nullptr;
+		}
+
+		std::unique_ptr<UdpTransport> transport(new UdpTransport());
+		transport->m_Socket = udpSocket;
+
+		sockaddr_in address = {};
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(0x7F000001);
+		address.sin_port = htons(port);
+
+		SocketLength length = sizeof(address);
+		if (bind(handle, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+			getsockname(handle, reinterpret_cast<sockaddr*>(&address), &length) != 0)
+		{
+			std::cout << "[UDP Transport] Error: Failed to bind port " << port << "\n";
+			return nullptr;
+		}
+
+#ifdef SE_PLATFORM_WINDOWS
+		u_long nonBlocking = 1;
+		const bool isNonBlocking = ioctlsocket(handle, FIONBIO, &nonBlocking) == 0;
+#else
+		const bool isNonBlocking = fcntl(handle, F_SETFL, fcntl(handle, F_GETFL, 0) | O_NONBLOCK) == 0;
+#endif
+		if (!isNonBlocking)
+		{
+			std::cout << "[UDP Transport] Error: Failed to make the socket non blocking\n";
+			return nullptr;
+		}
+
+		transport->m_Address = { ntohl(address.sin_addr.s_addr), ntohs(address.sin_port) };
+		return transport;
+	}
+
+	UdpTransport::~UdpTransport()
+	{
+		if (m_Socket == InvalidSocket) return;
+
+		CloseSocket(m_Socket);
+#ifdef SE_PLATFORM_WINDOWS
+		WSACleanup();
+#endif
+	}
+
+	void UdpTransport::Send(const NetAddress& address, const uint8_t* data, size_t size)
+	{
+		sockaddr_in destination = {};
+		destination.sin_family = AF_INET;
+		destination.sin_addr.s_addr = htonl(address.Host);
+		destination.sin_port = htons(address.Port);
+
+#ifdef SE_PLATFORM_WINDOWS
+		sendto(static_cast<SOCKET>(m_Socket), reinterpret_cast<const char*>(data), static_cast<int>(size), 0,
+			reinterpret_cast<const sockaddr*>(&destination), sizeof(destination));
+#else
+		sendto(static_cast<int>(m_Socket), data, size, 0, reinterpret_cast<const sockaddr*>(&destination), sizeof(destination));
+#endif
+	}
+
+	bool UdpTransport::Receive(NetAddress& address, std::vector<uint8_t>& data)
+	{
+		data.resize(MaxDatagramSize);
+
+		sockaddr_in source = {};
+		SocketLength length = sizeof(source);
+#ifdef SE_PLATFORM_WINDOWS
+		//Windows reports a port unreachable from an earlier send on the next receive, which says nothing about what is waiting.
+		int size = 0;
+		do
+		{
+			size = recvfrom(static_cast<SOCKET>(m_Socket), reinterpret_cast<char*>(data.data()), static_cast<int>(data.size()), 0,
+				reinterpret_cast<sockaddr*>(&source), &length);
+		} while (size < 0 && WSAGetLastError() == WSAECONNRESET);
+#else
+		const ssize_t size = recvfrom(static_cast<int>(m_Socket), data.data(), data.size(), 0, reinterpret_cast<sockaddr*>(&source), &length);
+#endif
+		//Nothing waiting.
+		if (size <= 0)
+		{
+			data.clear();
+			return false;
+		}
+
+		data.resize(static_cast<size_t>(size));
+		address = { ntohl(source.sin_addr.s_addr), ntohs(source.sin_port) };
+		return true;
+	}
+}//namespace Sengine::Net
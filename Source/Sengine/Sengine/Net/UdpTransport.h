@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+
+#include "Transport.h"
+
+namespace Sengine::Net
+{
+	//A non blocking UDP socket.
+	class UdpTransport final : public Transport
+	{
+	public:
+		//Binds to the port on the loopback interface, or any free port for 0. Returns nullptr if the socket can not be
+		//created or bound.
+		[[nodiscard]] static std::unique_ptr<UdpTransport> Create(uint16_t port = 0);
+		~UdpTransport() override;
+
+		UdpTransport(const UdpTransport&) = delete;
+		UdpTransport& operator=(const UdpTransport&) = delete;
+
+		void Send(const NetAddress& address, const uint8_t* data, size_t size) override;
+		bool Receive(NetAddress& address, std::vector<uint8_t>& data) override;
+
+		[[nodiscard]] NetAddress GetAddress() const override { return m_Address; }
+
+		//127.0.0.1
+		[[nodiscard]] static NetAddress GetLoopbackAddress(uint16_t port) { return { 0x7F000001, port }; }
+
+	private:
+		UdpTransport() = default;
+
+	private:
+		//A SOCKET on Windows and a file descriptor elsewhere.
+		uint64_t m_Socket = ~0ull;
+		NetAddress m_Address;
+	};
+}//namespace Sengine::Net
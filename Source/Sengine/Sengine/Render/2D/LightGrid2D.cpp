@@ -0,0 +1,77 @@
+#include "LightGrid2D.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace Sengine::Renderer2D
+{
+	void LightGrid2D::Build(const std::vector<PointLight2D>& lights, const glm::mat4& viewProjection, uint32_t width, uint32_t height)
+	{
+		m_TileCountX = (width + TileSize - 1) / TileSize;
+		m_TileCountY = (height + TileSize - 1) / TileSize;
+		m_Tiles.assign(static_cast<size_t>(m_TileCountX) * m_TileCountY, glm::uvec2(0));
+		m_Lights.clear();
+		m_LightIndices.clear();
+		m_LightTileRects.clear();
+
+		if (m_Tiles.empty()) return;
+
+		const glm::vec2 viewportSize = { static_cast<float>(width), static_cast<float>(height) };
+		for (const PointLight2D& light : lights)
+		{
+			if (light.Radius <= 0.0f || light.Intensity <= 0.0f) continue;
+
+			//The corners of the light's square in the sprite plane bound it on screen, whatever the camera's rotation.
+			glm::vec2 min(std::numeric_limits<float>::max());
+			glm::vec2 max(std::numeric_limits<float>::lowest());
+			for (const glm::vec2 corner : { glm::vec2(-1.0f, -1.0f), glm::vec2(1.0f, -1.0f), glm::vec2(1.0f, 1.0f), glm::vec2(-1.0f, 1.0f) })
+			{
+				const glm::vec4 clip = viewProjection * glm::vec4(glm::vec2(light.Position) + corner * light.Radius, 0.0f, 1.0f);
+				const glm::vec2 pixel = (glm::vec2(clip) / clip.w * 0.5f + 0.5f) * viewportSize;
+				min = glm::min(min, pixel);
+				max = glm::max(max, pixel);
+			}
+
+			if (max.x < 0.0f || max.y < 0.0f || min.x >= viewportSize.x || min.y >= viewportSize.y) continue;
+
+			const glm::uvec2 firstTile = glm::uvec2(glm::max(min, glm::vec2(0.0f))) / TileSize;
+			const glm::uvec2 lastTile = glm::min(glm::uvec2(glm::min(max, viewportSize - 1.0f)) / TileSize, glm::uvec2(m_TileCountX - 1, m_TileCountY - 1));
+			m_LightTileRects.emplace_back(firstTile, lastTile);
+			m_Lights.push_back(light);
+		}
+
+		//Counting sort: count the lights per tile, turn the counts into offsets, then fill the ranges.
+		for (const glm::uvec4& rect : m_LightTileRects)
+		{
+			for (uint32_t y = rect.y; y <= rect.w; y++)
+			{
+				for (uint32_t x = rect.x; x <= rect.z; x++)
+				{
+					m_Tiles[y * m_TileCountX + x].y++;
+				}
+			}
+		}
+
+		uint32_t total = 0;
+		for (glm::uvec2& tile : m_Tiles)
+		{
+			tile.x = total;
+			total += tile.y;
+			tile.y = 0;
+		}
+
+		m_LightIndices.resize(total);
+		for (uint32_t lightIndex = 0; lightIndex < m_LightTileRects.size(); lightIndex++)
+		{
+			const glm::uvec4& rect = m_LightTileRects[lightIndex];
+			for (uint32_t y = rect.y; y <= rect.w; y++)
+			{
+				for (uint32_t x = rect.x; x <= rect.z; x++)
+				{
+					glm::uvec2& tile = m_Tiles[y * m_TileCountX + x];
+					m_LightIndices[tile.x + tile.y++] = lightIndex;
+				}
+			}
+		}
+	}
+}//namespace Sengine::Renderer2D
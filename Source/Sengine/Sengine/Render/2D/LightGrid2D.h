@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+namespace Sengine::Renderer2D
+{
+	struct PointLight2D
+	{
+		//The z is the height of the light above the sprites, which are lit as if they lay at z = 0.
+		glm::vec3 Position = { 0.0f, 0.0f, 1.0f };
+		float Radius = 5.0f;
+		glm::vec3 Colour = { 1.0f, 1.0f, 1.0f };
+		float Intensity = 1.0f;
+	};
+
+	//Screen space tiles with the lights that reach each of them, laid out the way the sprite shader reads them:
+	//a range into the index list per tile, row by row.
+	class LightGrid2D
+	{
+	public:
+		static constexpr uint32_t TileSize = 32;
+
+		//Bins the lights into tiles of a width x height target, by the screen rectangle around each light's radius.
+		void Build(const std::vector<PointLight2D>& lights, const glm::mat4& viewProjection, uint32_t width, uint32_t height);
+
+		[[nodiscard]] uint32_t GetTileCountX() const { return m_TileCountX; }
+		[[nodiscard]] uint32_t GetTileCountY() const { return m_TileCountY; }
+		[[nodiscard]] const std::vector<PointLight2D>& GetLights() const { return m_Lights; }
+		//Offset into the light indices and light count of each tile.
+		[[nodiscard]] const std::vector<glm::uvec2>& GetTiles() const { return m_Tiles; }
+		[[nodiscard]] const std::vector<uint32_t>& GetLightIndices() const { return m_LightIndices; }
+		[[nodiscard]] bool GetIsEmpty() const { return m_Lights.empty(); }
+
+	private:
+		uint32_t m_TileCountX = 0;
+		uint32_t m_TileCountY = 0;
+
+		std::vector<PointLight2D> m_Lights;
+		std::vector<glm::uvec2> m_Tiles;
+		std::vector<uint32_t> m_LightIndices;
+		std::vector<glm::uvec4> m_LightTileRects; //Scratch, the tile range each light covers
+	};
+}//namespace Sengine::Renderer2D
@@ -0,0 +1,80 @@
+#include "QuadBatch.h"
+
+#include <algorithm>
+
+namespace Sengine::Renderer2D
+{
+	namespace
+	{
+		constexpr std::array<glm::vec4, 4> QuadPositions =
+		{
+			glm::vec4(-0.5f, -0.5f, 0.0f, 1.0f),
+			glm::vec4(0.5f, -0.5f, 0.0f, 1.0f),
+			glm::vec4(0.5f,  0.5f, 0.0f, 1.0f),
+			glm::vec4(-0.5f,  0.5f, 0.0f, 1.0f),
+		};
+	}
+
+	QuadBatch::QuadBatch()
+	{
+		m_Vertices.reserve(MaxVertices);
+	}
+
+	void QuadBatch::SetReservedTextures(uint32_t white, uint32_t flatNormal)
+	{
+		m_TextureSlots[0] = white;
+		m_TextureSlots[1] = flatNormal;
+	}
+
+	bool QuadBatch::Add(const glm::mat4& transform, uint32_t texture, uint32_t normalMap, const glm::vec4& region, const glm::vec4& colour, int entityID)
+	{
+		if (m_Vertices.size() >= MaxVertices) return false;
+
+		//Both textures need a slot in the same batch, so neither is added if either might not fit.
+		const auto begin = m_TextureSlots.begin();
+		const auto hasSlot = [&](uint32_t id) { return std::find(begin, begin + m_TextureSlotCount, id) != begin + m_TextureSlotCount; };
+		const uint32_t slotsNeeded = (hasSlot(texture) ? 0 : 1) + (hasSlot(normalMap) || normalMap == texture ? 0 : 1);
+		if (m_TextureSlotCount + slotsNeeded > MaxTextureSlots) return false;
+
+		const auto getSlot = [&](uint32_t id)
+			{
+				auto slot = std::find(begin, begin + m_TextureSlotCount, id);
+				if (slot == begin + m_TextureSlotCount)
+				{
+					*slot = id;
+					m_TextureSlotCount++;
+				}
+				return static_cast<int>(slot - begin);
+			};
+		const glm::ivec2 textureIndices = { getSlot(texture), getSlot(normalMap) };
+
+		const std::array<glm::vec2, 4> texCoords =
+		{
+			glm::vec2(region.x, region.y),
+			glm::vec2(region.z, region.y),
+			glm::vec2(region.z, region.w),
+			glm::vec2(region.x, region.w),
+		};
+
+		const glm::vec2 tangent = glm::vec2(transform[0]);
+		const glm::vec2 bitangent = glm::vec2(transform[1]);
+		const glm::vec4 tangentFrame =
+		{
+			glm::length(tangent) > 0.0f ? glm::normalize(tangent) : glm::vec2(1.0f, 0.0f),
+			glm::length(bitangent) > 0.0f ? glm::normalize(bitangent) : glm::vec2(0.0f, 1.0f),
+		};
+
+		for (uint32_t corner = 0; corner < 4; corner++)
+		{
+			m_Vertices.push_back({ glm::vec3(transform * QuadPositions[corner]), colour, texCoords[corner], tangentFrame, textureIndices, entityID });
+		}
+
+		return true;
+	}
+
+	void QuadBatch::Clear()
+	{
+		m_Vertices.clear();
+		m_TextureSlotCount = ReservedTextureSlots;
+	}
+}//namespace Sengine::Renderer2D
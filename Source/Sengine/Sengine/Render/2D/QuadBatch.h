@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+namespace Sengine::Renderer2D
+{
+	struct QuadVertex
+	{
+		glm::vec3 Position;
+		glm::vec4 Colour;
+		glm::vec2 TexCoord;
+		glm::vec4 TangentFrame; //Directions of the texture's x and y axes in the xy plane
+		glm::ivec2 TextureIndices; //Colour and normal map slots
+		int EntityID;
+	};
+
+	//The CPU side of the 2D batch: the vertices of the quads and the texture slots they sample, until the batch is drawn.
+	//Textures are only IDs here, so the batch can be filled and measured without a context.
+	class QuadBatch
+	{
+	public:
+		static constexpr uint32_t MaxQuads = 10000;
+		static constexpr uint32_t MaxVertices = MaxQuads * 4;
+		static constexpr uint32_t MaxTextureSlots = 16;
+		//Slot 0 always holds a white texture and slot 1 a flat normal map, so untextured quads share batches with textured ones.
+		static constexpr uint32_t ReservedTextureSlots = 2;
+
+		QuadBatch();
+
+		void SetReservedTextures(uint32_t white, uint32_t flatNormal);
+
+		//Adds nothing and returns false when the quad's vertices or textures do not fit. Draw and clear the batch, then add it again.
+		[[nodiscard]] bool Add(const glm::mat4& transform, uint32_t texture, uint32_t normalMap, const glm::vec4& region, const glm::vec4& colour, int entityID);
+		void Clear();
+
+		[[nodiscard]] const std::vector<QuadVertex>& GetVertices() const { return m_Vertices; }
+		[[nodiscard]] uint32_t GetQuadCount() const { return static_cast<uint32_t>(m_Vertices.size() / 4); }
+		[[nodiscard]] const uint32_t* GetTextureSlots() const { return m_TextureSlots.data(); }
+		[[nodiscard]] uint32_t GetTextureSlotCount() const { return m_TextureSlotCount; }
+		[[nodiscard]] bool GetIsEmpty() const { return m_Vertices.empty(); }
+
+	private:
+		std::vector<QuadVertex> m_Vertices;
+		std::array<uint32_t, MaxTextureSlots> m_TextureSlots = {};
+		uint32_t m_TextureSlotCount = ReservedTextureSlots;
+	};
+}//namespace Sengine::Renderer2D
@@ -1,23 +1,319 @@
 ﻿#include "Renderer2D.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
 
+#include "glad/glad.h"
+
+#include "Render/Shader.h"
+#include "Render/Texture.h"
 #include "Utils/Assert.h"
 
+#include "LightGrid2D.h"
+#include "QuadBatch.h"
+
 namespace Sengine::Renderer2D
 {
-	void Renderer2D::BeginRender()
+	namespace
+	{
+		constexpr uint32_t MaxIndices = QuadBatch::MaxQuads * 6;
+
+		const char* QuadVertexSource = R"(
+			#version 460 core
+			layout(location = 0) in vec3 a_Position;
+			layout(location = 1) in vec4 a_Colour;
+			layout(location = 2) in vec2 a_TexCoord;
+			layout(location = 3) in vec4 a_TangentFrame;
+			layout(location = 4) in ivec2 a_TextureIndices;
+			layout(location = 5) in int a_EntityID;
+
+			uniform mat4 u_ViewProjection;
+
+			out vec3 v_Position;
+			out vec4 v_Colour;
+			out vec2 v_TexCoord;
+			flat out vec4 v_TangentFrame;
+			flat out ivec2 v_TextureIndices;
+			flat out int v_EntityID;
+
+			void main()
+			{
+				v_Position = a_Position;
+				v_Colour = a_Colour;
+				v_TexCoord = a_TexCoord;
+				v_TangentFrame = a_TangentFrame;
+				v_TextureIndices = a_TextureIndices;
+				v_EntityID = a_EntityID;
+				gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
+			}
+		)";
+
+		//The texture cases are filled in by CreateQuadFragmentSource. Lights are read from the tile under the
+		//fragment, so one pass shades with every light no matter how many there are.
+		const char* QuadFragmentSource = R"(
+			#version 460 core
+			layout(location = 0) out vec4 o_Colour;
+			layout(location = 1) out int o_EntityID;
+
+			struct PointLight
+			{
+				vec4 PositionRadius;
+				vec4 ColourIntensity;
+			};
+
+			layout(std430, binding = 0) readonly buffer Lights { PointLight b_Lights[]; };
+			layout(std430, binding = 1) readonly buffer LightTiles { uvec2 b_LightTiles[]; };
+			layout(std430, binding = 2) readonly buffer LightIndices { uint b_LightIndices[]; };
+
+			in vec3 v_Position;
+			in vec4 v_Colour;
+			in vec2 v_TexCoord;
+			flat in vec4 v_TangentFrame;
+			flat in ivec2 v_TextureIndices;
+			flat in int v_EntityID;
+
+			uniform sampler2D u_Textures[16];
+			//Zero tiles means the view has no lights and is drawn unlit.
+			uniform int u_LightTileCountX;
+			uniform vec3 u_AmbientLight;
+
+			vec4 SampleTexture(int slot)
+			{
+				switch (slot)
+				{
+					TEXTURE_CASES
+				}
+				return vec4(1.0);
+			}
+
+			vec3 GetLighting()
+			{
+				if (u_LightTileCountX == 0) return vec3(1.0);
+
+				const vec3 tangentNormal = SampleTexture(v_TextureIndices.y).xyz * 2.0 - 1.0;
+				const vec3 normal = normalize(vec3(v_TangentFrame.xy * tangentNormal.x + v_TangentFrame.zw * tangentNormal.y, tangentNormal.z));
+
+				const uvec2 tileCoordinate = uvec2(gl_FragCoord.xy) / TILE_SIZE;
+				const uvec2 tile = b_LightTiles[tileCoordinate.y * uint(u_LightTileCountX) + tileCoordinate.x];
+
+				vec3 lighting = u_AmbientLight;
+				for (uint index = tile.x; index < tile.x + tile.y; index++)
+				{
+					const PointLight light = b_Lights[b_LightIndices[index]];
+					const vec3 toLight = light.PositionRadius.xyz - vec3(v_Position.xy, 0.0);
+					const float distance = length(toLight);
+					const float falloff = clamp(1.0 - distance / light.PositionRadius.w, 0.0, 1.0);
+
+					lighting += light.ColourIntensity.rgb * light.ColourIntensity.a * falloff * falloff * max(dot(normal, toLight / distance), 0.0);
+				}
+				return lighting;
+			}
+
+			void main()
+			{
+				const vec4 colour = v_Colour * SampleTexture(v_TextureIndices.x);
+				if (colour.a == 0.0) discard;
+
+				o_Colour = vec4(colour.rgb * GetLighting(), colour.a);
+				o_EntityID = v_EntityID;
+			}
+		)";
+
+		//Sampler arrays may only be indexed with values that are the same for the whole draw, so every slot gets a case.
+		std::string CreateQuadFragmentSource()
+		{
+			std::string cases;
+			for (uint32_t slot = 0; slot < QuadBatch::MaxTextureSlots; slot++)
+			{
+				const std::string index = std::to_string(slot);
+				cases += "case " + index + ": return texture(u_Textures[" + index + "], v_TexCoord);\n";
+			}
+
+			std::string source = QuadFragmentSource;
+			source.replace(source.find("TEXTURE_CASES"), std::string("TEXTURE_CASES").size(), cases);
+			source.replace(source.find("TILE_SIZE"), std::string("TILE_SIZE").size(), std::to_string(LightGrid2D::TileSize) + "u");
+			return source;
+		}
+	}
+
+	struct Renderer2D::Renderer2DData
+	{
+		uint32_t VertexArray = 0;
+		uint32_t VertexBuffer = 0;
+		uint32_t IndexBuffer = 0;
+		std::unique_ptr<Shader> QuadShader;
+		std::unique_ptr<Texture2D> WhiteTexture;
+		std::unique_ptr<Texture2D> FlatNormalTexture;
+
+		QuadBatch Batch;
+
+		//Lights, tile ranges and light indices, bound as shader storage.
+		std::array<uint32_t, 3> LightBuffers = {};
+		glm::mat4 ViewProjection = glm::mat4(1.0f);
+	};
+
+	void Renderer2D::Init()
+	{
+		m_Data = new Renderer2DData();
+
+		glCreateBuffers(1, &m_Data->VertexBuffer);
+		glNamedBufferStorage(m_Data->VertexBuffer, QuadBatch::MaxVertices * sizeof(QuadVertex), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+		std::vector<uint32_t> indices(MaxIndices);
+		for (uint32_t quad = 0, offset = 0; quad < QuadBatch::MaxQuads; quad++, offset += 4)
+		{
+			indices[quad * 6 + 0] = offset + 0;
+			indices[quad * 6 + 1] = offset + 1;
+			indices[quad * 6 + 2] = offset + 2;
+			indices[quad * 6 + 3] = offset + 2;
+			indices[quad * 6 + 4] = offset + 3;
+			indices[quad * 6 + 5] = offset + 0;
+		}
+
+		glCreateBuffers(1, &m_Data->IndexBuffer);
+		glNamedBufferStorage(m_Data->IndexBuffer, MaxIndices * sizeof(uint32_t), indices.data(), 0);
+
+		glCreateVertexArrays(1, &m_Data->VertexArray);
+		glVertexArrayVertexBuffer(m_Data->VertexArray, 0, m_Data->VertexBuffer, 0, sizeof(QuadVertex));
+		glVertexArrayElementBuffer(m_Data->VertexArray, m_Data->IndexBuffer);
+
+		glEnableVertexArrayAttrib(m_Data->VertexArray, 0);
+		glVertexArrayAttribFormat(m_Data->VertexArray, 0, 3, GL_FLOAT, GL_FALSE, offsetof(QuadVertex, Position));
+		glVertexArrayAttribBinding(m_Data->VertexArray, 0, 0);
+
+		glEnableVertexArrayAttrib(m_Data->VertexArray, 1);
+		glVertexArrayAttribFormat(m_Data->VertexArray, 1, 4, GL_FLOAT, GL_FALSE, offsetof(QuadVertex, Colour));
+		glVertexArrayAttribBinding(m_Data->VertexArray, 1, 0);
+
+		glEnableVertexArrayAttrib(m_Data->VertexArray, 2);
+		glVertexArrayAttribFormat(m_Data->VertexArray, 2, 2, GL_FLOAT, GL_FALSE, offsetof(QuadVertex, TexCoord));
+		glVertexArrayAttribBinding(m_Data->VertexArray, 2, 0);
+
+		glEnableVertexArrayAttrib(m_Data->VertexArray, 3);
+		glVertexArrayAttribFormat(m_Data->VertexArray, 3, 4, GL_FLOAT, GL_FALSE, offsetof(QuadVertex, TangentFrame));
+		glVertexArrayAttribBinding(m_Data->VertexArray, 3, 0);
+
+		glEnableVertexArrayAttrib(m_Data->VertexArray, 4);
+		glVertexArrayAttribIFormat(m_Data->VertexArray, 4, 2, GL_INT, offsetof(QuadVertex, TextureIndices));
+		glVertexArrayAttribBinding(m_Data->VertexArray, 4, 0);
+
+		glEnableVertexArrayAttrib(m_Data->VertexArray, 5);
+		glVertexArrayAttribIFormat(m_Data->VertexArray, 5, 1, GL_INT, offsetof(QuadVertex, EntityID));
+		glVertexArrayAttribBinding(m_Data->VertexArray, 5, 0);
+
+		glCreateBuffers(static_cast<GLsizei>(m_Data->LightBuffers.size()), m_Data->LightBuffers.data());
+
+		m_Data->QuadShader = std::make_unique<Shader>(QuadVertexSource, CreateQuadFragmentSource());
+		for (uint32_t slot = 0; slot < QuadBatch::MaxTextureSlots; slot++)
+		{
+			m_Data->QuadShader->SetInt("u_Textures[" + std::to_string(slot) + "]", static_cast<int>(slot));
+		}
+
+		constexpr uint32_t white = 0xFFFFFFFF;
+		m_Data->WhiteTexture = std::make_unique<Texture2D>(1, 1, &white);
+
+		constexpr uint32_t flatNormal = 0xFFFF8080;
+		m_Data->FlatNormalTexture = std::make_unique<Texture2D>(1, 1, &flatNormal);
+		m_Data->Batch.SetReservedTextures(m_Data->WhiteTexture->GetRendererID(), m_Data->FlatNormalTexture->GetRendererID());
+
+		SetLightGrid(nullptr);
+	}
+
+	void Renderer2D::Destroy()
+	{
+		glDeleteVertexArrays(1, &m_Data->VertexArray);
+		glDeleteBuffers(1, &m_Data->VertexBuffer);
+		glDeleteBuffers(1, &m_Data->IndexBuffer);
+		glDeleteBuffers(static_cast<GLsizei>(m_Data->LightBuffers.size()), m_Data->LightBuffers.data());
+
+		delete m_Data;
+		m_Data = nullptr;
+	}
+
+	void Renderer2D::BeginRender(const glm::mat4& viewProjection)
 	{
 		SE_Assert(m_CurrentRenderIndex == 1, "[Render 2D] Error: Has not called End Render function after the draw function");
 
 		m_CurrentRenderIndex++;
+
+		m_Data->ViewProjection = viewProjection;
+		m_Data->Batch.Clear();
 	}
 	void Renderer2D::EndRender()
 	{
+		Flush();
+
 		m_CurrentRenderIndex = 0; //Reset the counter
 	}
-	void Renderer2D::DrawQuad()
+	void Renderer2D::DrawQuad(const glm::mat4& transform, const glm::vec4& colour, int entityID)
+	{
+		AddQuad(transform, m_Data->WhiteTexture->GetRendererID(), m_Data->FlatNormalTexture->GetRendererID(), { 0.0f, 0.0f, 1.0f, 1.0f }, colour, entityID);
+	}
+
+	void Renderer2D::DrawQuad(const glm::mat4& transform, const Texture2D& texture, const glm::vec4& region, const glm::vec4& colour, int entityID)
+	{
+		AddQuad(transform, texture.GetRendererID(), m_Data->FlatNormalTexture->GetRendererID(), region, colour, entityID);
+	}
+
+	void Renderer2D::DrawQuad(const glm::mat4& transform, const Texture2D& texture, const Texture2D& normalMap, const glm::vec4& region, const glm::vec4& colour, int entityID)
+	{
+		AddQuad(transform, texture.GetRendererID(), normalMap.GetRendererID(), region, colour, entityID);
+	}
+
+	void Renderer2D::SetLightGrid(const LightGrid2D* lightGrid, const glm::vec3& ambientLight)
+	{
+		m_Data->QuadShader->SetInt("u_LightTileCountX", 0);
+		if (!lightGrid || lightGrid->GetIsEmpty()) return;
+
+		//std430 lays a light out as two vec4s, which is how PointLight2D is stored.
+		static_assert(sizeof(PointLight2D) == sizeof(glm::vec4) * 2);
+
+		const auto upload = [](uint32_t buffer, uint32_t binding, const auto& values)
+			{
+				glNamedBufferData(buffer, static_cast<GLsizeiptr>(values.size() * sizeof(values[0])), values.data(), GL_STREAM_DRAW);
+				glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, buffer);
+			};
+		upload(m_Data->LightBuffers[0], 0, lightGrid->GetLights());
+		upload(m_Data->LightBuffers[1], 1, lightGrid->GetTiles());
+		upload(m_Data->LightBuffers[2], 2, lightGrid->GetLightIndices().empty() ? std::vector<uint32_t>{ 0 } : lightGrid->GetLightIndices());
+
+		m_Data->QuadShader->SetInt("u_LightTileCountX", static_cast<int>(lightGrid->GetTileCountX()));
+		m_Data->QuadShader->SetFloat3("u_AmbientLight", ambientLight);
+	}
+
+	void Renderer2D::AddQuad(const glm::mat4& transform, uint32_t texture, uint32_t normalMap, const glm::vec4& region, const glm::vec4& colour, int entityID)
 	{
 		SE_Assert(m_CurrentRenderIndex == 0, "[Render 2D] Error: Has not called either Begin Render function before draw function");
+
+		//A full batch is drawn and the quad goes into the emptied one, where it always fits.
+		if (!m_Data->Batch.Add(transform, texture, normalMap, region, colour, entityID))
+		{
+			Flush();
+			const bool isAdded = m_Data->Batch.Add(transform, texture, normalMap, region, colour, entityID);
+			SE_Assert(!isAdded, "[Render 2D] Error: A quad does not fit into an empty batch");
+		}
+	}
+
+	void Renderer2D::Flush()
+	{
+		const QuadBatch& batch = m_Data->Batch;
+		if (batch.GetIsEmpty()) return;
+
+		const uint32_t quadCount = batch.GetQuadCount();
+		glNamedBufferSubData(m_Data->VertexBuffer, 0, static_cast<GLsizeiptr>(batch.GetVertices().size() * sizeof(QuadVertex)), batch.GetVertices().data());
+
+		m_Data->QuadShader->Bind();
+		m_Data->QuadShader->SetMat4("u_ViewProjection", m_Data->ViewProjection);
+		glBindTextures(0, static_cast<GLsizei>(batch.GetTextureSlotCount()), batch.GetTextureSlots());
+
+		glBindVertexArray(m_Data->VertexArray);
+		glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(quadCount * 6), GL_UNSIGNED_INT, nullptr);
+
+		m_Data->Batch.Clear();
 	}
-}//namespace Sengine::Renderer2D
\ No newline at end of file
+}//namespace Sengine::Renderer2D
@@ -1,22 +1,50 @@
 ﻿#pragma once
 
+#include "glm/glm.hpp"
+
+namespace Sengine
+{
+	class Texture2D;
+}
+
 namespace Sengine::Renderer2D
 {
+	class LightGrid2D;
+
 	class Renderer2D
 	{
 	public:
-		static void BeginRender();
+		static void Init();
+		static void Destroy();
+
+		static void BeginRender(const glm::mat4& viewProjection);
 		static void EndRender();
 
 		//Draw Functions
 
-		static void DrawQuad();
+		//Quads are batched and drawn when the batch is full or on EndRender.
+		//The entity ID is written to the second colour attachment for picking, -1 means no entity.
+		static void DrawQuad(const glm::mat4& transform, const glm::vec4& colour, int entityID = -1);
+		//Draws a region of a texture, given as the minimum and maximum texture coordinates. Texels with no alpha are discarded.
+		static void DrawQuad(const glm::mat4& transform, const Texture2D& texture, const glm::vec4& region, const glm::vec4& colour, int entityID = -1);
+		//The normal map is in tangent space, with the texture's x and y axes following the quad's.
+		static void DrawQuad(const glm::mat4& transform, const Texture2D& texture, const Texture2D& normalMap, const glm::vec4& region, const glm::vec4& colour, int entityID = -1);
+
+		//Lights every following draw with the lights of the grid, or draws unlit without one.
+		//The grid has to match the size of the target being drawn to.
+		static void SetLightGrid(const LightGrid2D* lightGrid, const glm::vec3& ambientLight = glm::vec3(0.0f));
+
+	private:
+		static void Flush();
+		static void AddQuad(const glm::mat4& transform, uint32_t texture, uint32_t normalMap, const glm::vec4& region, const glm::vec4& colour, int entityID);
 
 	private:
 		//Just a simple variable to keep track of the begin/end functions calls.
 		//Will error if a Draw function is called and either a Begin/End function has not been found. 
 		inline static int m_CurrentRenderIndex = 0;
+
+		struct Renderer2DData;
+		inline static Renderer2DData* m_Data = nullptr;
 	};
 }//namespace Sengine::Renderer2D
 
-
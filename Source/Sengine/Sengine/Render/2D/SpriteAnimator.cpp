@@ -0,0 +1,180 @@
+#include "SpriteAnimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Utils/Assert.h"
+
+namespace Sengine::Renderer2D
+{
+	uint32_t SpriteAtlas::AddGrid(uint32_t columns, uint32_t rows)
+	{
+		const uint32_t first = static_cast<uint32_t>(Regions.size());
+		const glm::vec2 cellSize = { 1.0f / static_cast<float>(columns), 1.0f / static_cast<float>(rows) };
+
+		//Texture rows start at the bottom, so the top row of the image is the last one.
+		for (uint32_t row = 0; row < rows; row++)
+		{
+			for (uint32_t column = 0; column < columns; column++)
+			{
+				const glm::vec2 min = { column * cellSize.x, 1.0f - (row + 1) * cellSize.y };
+				Regions.emplace_back(min, min + cellSize);
+			}
+		}
+
+		return first;
+	}
+
+	SpriteAnimator::SpriteAnimator(std::shared_ptr<SpriteAtlas> atlas)
+		: m_Atlas(std::move(atlas))
+	{
+	}
+
+	uint32_t SpriteAnimator::AddClip(const FlipbookClip& clip)
+	{
+		SE_Assert(clip.Frames.empty() || clip.FramesPerSecond <= 0.0f, "[Sprite Animator] Error: A clip needs frames and a positive frame rate");
+
+		m_Clips.push_back(clip);
+		return static_cast<uint32_t>(m_Clips.size() - 1);
+	}
+
+	AnimatorHandle SpriteAnimator::Create(uint32_t clip, float speed, float startTime)
+	{
+		AnimatorHandle handle = static_cast<AnimatorHandle>(m_Indices.size());
+		if (!m_FreeHandles.empty())
+		{
+			handle = m_FreeHandles.back();
+			m_FreeHandles.pop_back();
+		}
+		else
+		{
+			m_Indices.push_back(0);
+		}
+
+		const uint32_t index = static_cast<uint32_t>(m_Times.size());
+		m_Indices[handle] = index;
+		m_Handles.push_back(handle);
+
+		m_Times.push_back(startTime);
+		m_Speeds.push_back(speed);
+		m_Durations.push_back(0.0f);
+		m_FramesPerSecond.push_back(0.0f);
+		m_LastFrames.push_back(0.0f);
+		m_LoopMasks.push_back(0.0f);
+		m_FrameIndices.push_back(0);
+		m_ClipIndices.push_back(0);
+		SetClip(index, clip);
+
+		return handle;
+	}
+
+	void SpriteAnimator::Destroy(AnimatorHandle animation)
+	{
+		//The last animation moves into the gap, so the arrays stay packed.
+		const uint32_t index = m_Indices[animation];
+		const uint32_t last = static_cast<uint32_t>(m_Times.size() - 1);
+
+		const auto removeAt = [index](auto& values)
+			{
+				values[index] = values.back();
+				values.pop_back();
+			};
+		removeAt(m_Times);
+		removeAt(m_Speeds);
+		removeAt(m_Durations);
+		removeAt(m_FramesPerSecond);
+		removeAt(m_LastFrames);
+		removeAt(m_LoopMasks);
+		removeAt(m_FrameIndices);
+		removeAt(m_ClipIndices);
+
+		if (index != last)
+		{
+			m_Indices[m_Handles[last]] = index;
+		}
+		removeAt(m_Handles);
+
+		m_Indices[animation] = UINT32_MAX;
+		m_FreeHandles.push_back(animation);
+	}
+
+	void SpriteAnimator::Play(AnimatorHandle animation, uint32_t clip, bool restart)
+	{
+		const uint32_t index = m_Indices[animation];
+		if (restart)
+		{
+			m_Times[index] = 0.0f;
+		}
+		SetClip(index, clip);
+	}
+
+	void SpriteAnimator::SetSpeed(AnimatorHandle animation, float speed)
+	{
+		m_Speeds[m_Indices[animation]] = speed;
+	}
+
+	void SpriteAnimator::Update(float deltaTime)
+	{
+		const size_t count = m_Times.size();
+		float* times = m_Times.data();
+		const float* speeds = m_Speeds.data();
+		const float* durations = m_Durations.data();
+		const float* framesPerSecond = m_FramesPerSecond.data();
+		const float* lastFrames = m_LastFrames.data();
+		const float* loopMasks = m_LoopMasks.data();
+		uint32_t* frameIndices = m_FrameIndices.data();
+
+		//Each loop is a single pass over a few arrays with no branches, so it runs several animations per instruction.
+		for (size_t index = 0; index < count; index++)
+		{
+			times[index] += deltaTime * speeds[index];
+		}
+
+		//Looping clips wrap in both directions, the others hold their first or last frame.
+		for (size_t index = 0; index < count; index++)
+		{
+			const float time = times[index];
+			const float duration = durations[index];
+			const float wrapped = time - std::floor(time / duration) * duration;
+			const float clamped = std::min(std::max(time, 0.0f), duration);
+			times[index] = clamped + (wrapped - clamped) * loopMasks[index];
+		}
+
+		for (size_t index = 0; index < count; index++)
+		{
+			frameIndices[index] = static_cast<uint32_t>(std::min(times[index] * framesPerSecond[index], lastFrames[index]));
+		}
+	}
+
+	uint32_t SpriteAnimator::GetFrame(AnimatorHandle animation) const
+	{
+		return m_FrameIndices[m_Indices[animation]];
+	}
+
+	const glm::vec4& SpriteAnimator::GetRegion(AnimatorHandle animation) const
+	{
+		const uint32_t index = m_Indices[animation];
+		return m_Atlas->Regions[m_Clips[m_ClipIndices[index]].Frames[m_FrameIndices[index]]];
+	}
+
+	bool SpriteAnimator::GetIsFinished(AnimatorHandle animation) const
+	{
+		const uint32_t index = m_Indices[animation];
+		if (m_LoopMasks[index] != 0.0f) return false;
+
+		return m_Speeds[index] >= 0.0f ? m_Times[index] >= m_Durations[index] : m_Times[index] <= 0.0f;
+	}
+
+	void SpriteAnimator::SetClip(uint32_t index, uint32_t clip)
+	{
+		const FlipbookClip& flipbook = m_Clips[clip];
+		const float frameCount = static_cast<float>(flipbook.Frames.size());
+
+		m_ClipIndices[index] = clip;
+		m_Durations[index] = frameCount / flipbook.FramesPerSecond;
+		m_FramesPerSecond[index] = flipbook.FramesPerSecond;
+		m_LastFrames[index] = frameCount - 1.0f;
+		m_LoopMasks[index] = flipbook.IsLooping ? 1.0f : 0.0f;
+		m_FrameIndices[index] = static_cast<uint32_t>(std::min(std::max(m_Times[index], 0.0f) * flipbook.FramesPerSecond, frameCount - 1.0f));
+	}
+}//namespace Sengine::Renderer2D
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+namespace Sengine
+{
+	class Texture2D;
+}
+
+namespace Sengine::Renderer2D
+{
+	//A texture and the regions of the images packed into it, each the minimum and maximum texture coordinates.
+	struct SpriteAtlas
+	{
+		std::shared_ptr<Texture2D> AtlasTexture;
+		std::vector<glm::vec4> Regions;
+
+		//Adds the cells of a grid of equally sized frames, row by row from the top left. Returns the first new region.
+		uint32_t AddGrid(uint32_t columns, uint32_t rows);
+	};
+
+	//A sequence of atlas regions played at a fixed rate.
+	struct FlipbookClip
+	{
+		std::vector<uint32_t> Frames;
+		float FramesPerSecond = 12.0f;
+		bool IsLooping = true;
+	};
+
+	using AnimatorHandle = uint32_t;
+	constexpr AnimatorHandle InvalidAnimatorHandle = UINT32_MAX;
+
+	//Plays flipbook clips of one atlas for any number of sprites. The state of every animation lives in parallel
+	//arrays, so a single Update advances all of them in branch free loops the compiler vectorises.
+	//Handles stay valid until they are destroyed, after which they may be handed out again.
+	class SpriteAnimator
+	{
+	public:
+		explicit SpriteAnimator(std::shared_ptr<SpriteAtlas> atlas);
+
+		uint32_t AddClip(const FlipbookClip& clip);
+
+		//A negative speed plays the clip backwards.
+		[[nodiscard]] AnimatorHandle Create(uint32_t clip, float speed = 1.0f, float startTime = 0.0f);
+		void Destroy(AnimatorHandle animation);
+
+		//Switches clip. Without a restart the time carries over, so e.g. a walk can change direction mid stride.
+		void Play(AnimatorHandle animation, uint32_t clip, bool restart = true);
+		void SetSpeed(AnimatorHandle animation, float speed);
+
+		//Advances every animation. Call once per frame, before their sprites are submitted.
+		void Update(float deltaTime);
+
+		[[nodiscard]] uint32_t GetFrame(AnimatorHandle animation) const;
+		[[nodiscard]] const glm::vec4& GetRegion(AnimatorHandle animation) const;
+		//True once a clip that does not loop has reached its last frame.
+		[[nodiscard]] bool GetIsFinished(AnimatorHandle animation) const;
+
+		[[nodiscard]] const SpriteAtlas& GetAtlas() const { return *m_Atlas; }
+		[[nodiscard]] uint32_t GetCount() const { return static_cast<uint32_t>(m_Times.size()); }
+
+	private:
+		void SetClip(uint32_t index, uint32_t clip);
+
+	private:
+		std::shared_ptr<SpriteAtlas> m_Atlas;
+		std::vector<FlipbookClip> m_Clips;
+
+		//Packed, one entry per animation. Clip values are copied in so Update never looks at the clips.
+		std::vector<float> m_Times;
+		std::vector<float> m_Speeds;
+		std::vector<float> m_Durations;
+		std::vector<float> m_FramesPerSecond;
+		std::vector<float> m_LastFrames;
+		std::vector<float> m_LoopMasks; //1 for looping clips, 0 otherwise
+		std::vector<uint32_t> m_FrameIndices;
+		std::vector<uint32_t> m_ClipIndices;
+
+		std::vector<AnimatorHandle> m_Handles; //Packed index to handle
+		std::vector<uint32_t> m_Indices; //Handle to packed index
+		std::vector<AnimatorHandle> m_FreeHandles;
+	};
+}//namespace Sengine::Renderer2D
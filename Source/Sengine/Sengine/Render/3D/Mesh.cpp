@@ -0,0 +1,69 @@
+#include "Mesh.h"
+
+#include "glad/glad.h"
+
+namespace Sengine::Renderer3D
+{
+	Mesh::Mesh(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& normals, const std::vector<uint32_t>& indices)
+		: m_IndexCount(static_cast<uint32_t>(indices.size()))
+	{
+		glCreateBuffers(1, &m_PositionBuffer);
+		glNamedBufferStorage(m_PositionBuffer, static_cast<GLsizeiptr>(positions.size() * sizeof(glm::vec3)), positions.data(), 0);
+
+		glCreateBuffers(1, &m_NormalBuffer);
+		glNamedBufferStorage(m_NormalBuffer, static_cast<GLsizeiptr>(normals.size() * sizeof(glm::vec3)), normals.data(), 0);
+
+		glCreateBuffers(1, &m_IndexBuffer);
+		glNamedBufferStorage(m_IndexBuffer, static_cast<GLsizeiptr>(indices.size() * sizeof(uint32_t)), indices.data(), 0);
+
+		//Both vertex arrays share the position and index buffers, the position only one just never touches the normals.
+		for (uint32_t* vertexArray : { &m_VertexArray, &m_PositionVertexArray })
+		{
+			glCreateVertexArrays(1, vertexArray);
+			glVertexArrayVertexBuffer(*vertexArray, 0, m_PositionBuffer, 0, sizeof(glm::vec3));
+			glVertexArrayElementBuffer(*vertexArray, m_IndexBuffer);
+
+			glEnableVertexArrayAttrib(*vertexArray, 0);
+			glVertexArrayAttribFormat(*vertexArray, 0, 3, GL_FLOAT, GL_FALSE, 0);
+			glVertexArrayAttribBinding(*vertexArray, 0, 0);
+		}
+
+		glVertexArrayVertexBuffer(m_VertexArray, 1, m_NormalBuffer, 0, sizeof(glm::vec3));
+		glEnableVertexArrayAttrib(m_VertexArray, 1);
+		glVertexArrayAttribFormat(m_VertexArray, 1, 3, GL_FLOAT, GL_FALSE, 0);
+		glVertexArrayAttribBinding(m_VertexArray, 1, 1);
+	}
+
+	Mesh::~Mesh()
+	{
+		glDeleteVertexArrays(1, &m_VertexArray);
+		glDeleteVertexArrays(1, &m_PositionVertexArray);
+		glDeleteBuffers(1, &m_PositionBuffer);
+		glDeleteBuffers(1, &m_NormalBuffer);
+		glDeleteBuffers(1, &m_IndexBuffer);
+	}
+
+	void Mesh::Bind() const
+	{
+		glBindVertexArray(m_VertexArray);
+	}
+
+	void Mesh::BindPositions() const
+	{
+		glBindVertexArray(m_PositionVertexArray);
+	}
+
+	void Mesh::ReadData(std::vector<glm::vec3>& positions, std::vector<glm::vec3>& normals, std::vector<uint32_t>& indices) const
+	{
+		GLint positionBytes = 0;
+		glGetNamedBufferParameteriv(m_PositionBuffer, GL_BUFFER_SIZE, &positionBytes);
+
+		positions.resize(static_cast<size_t>(positionBytes) / sizeof(glm::vec3));
+		normals.resize(positions.size());
+		indices.resize(m_IndexCount);
+
+		glGetNamedBufferSubData(m_PositionBuffer, 0, positionBytes, positions.data());
+		glGetNamedBufferSubData(m_NormalBuffer, 0, positionBytes, normals.data());
+		glGetNamedBufferSubData(m_IndexBuffer, 0, static_cast<GLsizeiptr>(indices.size() * sizeof(uint32_t)), indices.data());
+	}
+}//namespace Sengine::Renderer3D
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+namespace Sengine::Renderer3D
+{
+	//Indexed triangles on the GPU. Positions are kept in their own vertex stream so depth only passes
+	//fetch 12 bytes per vertex, with everything else in a second stream. Non-copyable as it owns the OpenGL handles.
+	class Mesh
+	{
+	public:
+		Mesh(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& normals, const std::vector<uint32_t>& indices);
+		~Mesh();
+
+		Mesh(const Mesh&) = delete;
+		Mesh& operator=(const Mesh&) = delete;
+
+		//Binds every attribute.
+		void Bind() const;
+		//Binds only the position stream.
+		void BindPositions() const;
+
+		//Reads the buffers back from the GPU, e.g. to capture the mesh. Waits for the GPU to finish with them.
+		void ReadData(std::vector<glm::vec3>& positions, std::vector<glm::vec3>& normals, std::vector<uint32_t>& indices) const;
+
+		[[nodiscard]] uint32_t GetIndexCount() const { return m_IndexCount; }
+		[[nodiscard]] uint32_t GetRendererID() const { return m_VertexArray; }
+
+	private:
+		uint32_t m_PositionBuffer = 0;
+		uint32_t m_NormalBuffer = 0;
+		uint32_t m_IndexBuffer = 0;
+
+		uint32_t m_VertexArray = 0;
+		uint32_t m_PositionVertexArray = 0;
+		uint32_t m_IndexCount = 0;
+	};
+}//namespace Sengine::Renderer3D
@@ -1,6 +1,348 @@
 ﻿#include "Renderer3D.h"
 
+#include <memory>
+#include <string>
+
+#include "glad/glad.h"
+
+#include "Mesh.h"
+#include "Render/Shader.h"
+
 namespace Sengine::Renderer3D
 {
-	
-}//namespace Sengine::Renderer3D
\ No newline at end of file
+	namespace
+	{
+		//The opaque pass tests against the prepass's depth with a different program, so every vertex shader here
+		//declares gl_Position invariant. Otherwise the two need not compute the same depth and opaque fragments could
+		//fail the test.
+		const char* DepthVertexSource = R"(
+			#version 460 core
+			layout(location = 0) in vec3 a_Position;
+
+			uniform mat4 u_ViewProjection;
+			uniform mat4 u_Transform;
+
+			invariant gl_Position;
+
+			void main()
+			{
+				gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0);
+			}
+		)";
+
+		const char* DepthFragmentSource = R"(
+			#version 460 core
+
+			void main()
+			{
+			}
+		)";
+
+		const char* LitVertexSource = R"(
+			#version 460 core
+			layout(location = 0) in vec3 a_Position;
+			layout(location = 1) in vec3 a_Normal;
+
+			uniform mat4 u_ViewProjection;
+			uniform mat4 u_Transform;
+
+			out vec3 v_Normal;
+			invariant gl_Position;
+
+			void main()
+			{
+				v_Normal = mat3(transpose(inverse(u_Transform))) * a_Normal;
+				gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0);
+			}
+		)";
+
+		const char* LitFragmentSource = R"(
+			#version 460 core
+			layout(location = 0) out vec4 o_Colour;
+			layout(location = 1) out int o_EntityID;
+
+			in vec3 v_Normal;
+
+			uniform vec4 u_Colour;
+			uniform int u_EntityID;
+			uniform vec3 u_LightDirection;
+
+			void main()
+			{
+				const vec3 normal = normalize(v_Normal);
+				const float diffuse = max(dot(normal, -u_LightDirection), 0.0);
+				const vec3 ambient = mix(vec3(0.05, 0.05, 0.08), vec3(0.2, 0.2, 0.25), normal.y * 0.5 + 0.5);
+
+				o_Colour = vec4(u_Colour.rgb * (ambient + diffuse), u_Colour.a);
+				o_EntityID = u_EntityID;
+			}
+		)";
+
+		//CDLOD: each vertex slides towards the grid of the next coarser level as it nears the end of its level's range,
+		//so neighbouring levels meet without cracks or popping.
+		const char* TerrainVertexSource = R"(
+			#version 460 core
+			layout(location = 0) in vec2 a_GridPosition;
+			layout(location = 1) in vec4 a_OffsetSize;
+			layout(location = 2) in vec4 a_TileRegion;
+
+			uniform mat4 u_ViewProjection;
+			uniform vec3 u_CameraPosition;
+			uniform vec2 u_MorphRanges[16];
+			uniform float u_GridResolution;
+			uniform float u_TileResolution;
+			uniform float u_BaseHeight;
+			uniform float u_HeightScale;
+
+			uniform sampler2DArray u_Heights;
+			uniform sampler2DArray u_Normals;
+
+			out vec3 v_Normal;
+			invariant gl_Position;
+
+			vec3 GetTileCoordinate(vec2 gridPosition)
+			{
+				const vec2 tile = a_TileRegion.xy + gridPosition * a_TileRegion.z;
+				return vec3((tile * u_TileResolution + 0.5) / (u_TileResolution + 1.0), a_TileRegion.w);
+			}
+
+			vec3 GetWorldPosition(vec2 gridPosition)
+			{
+				const vec2 world = a_OffsetSize.xy + gridPosition * a_OffsetSize.z;
+				const float height = textureLod(u_Heights, GetTileCoordinate(gridPosition), 0.0).r;
+				return vec3(world.x, u_BaseHeight + height * u_HeightScale, world.y);
+			}
+
+			void main()
+			{
+				vec2 gridPosition = a_GridPosition;
+				const vec2 range = u_MorphRanges[int(a_OffsetSize.w)];
+				const float morph = clamp((distance(u_CameraPosition, GetWorldPosition(gridPosition)) - range.x) / (range.y - range.x), 0.0, 1.0);
+
+				//Odd vertices move onto their even neighbour, which is where the coarser grid has its vertex.
+				gridPosition -= fract(gridPosition * u_GridResolution * 0.5) * 2.0 / u_GridResolution * morph;
+
+				v_Normal = textureLod(u_Normals, GetTileCoordinate(gridPosition), 0.0).xyz * 2.0 - 1.0;
+				gl_Position = u_ViewProjection * vec4(GetWorldPosition(gridPosition), 1.0);
+			}
+		)";
+
+		//Vertices of the grid, (n + 1)^2 points from 0 to 1. The indices hold the full grid followed by one at
+		//half the resolution that skips every other vertex.
+		void CreateTerrainGrid(std::vector<glm::vec2>& positions, std::vector<uint32_t>& indices, uint32_t& halfGridFirstIndex)
+		{
+			constexpr uint32_t resolution = Terrain::GridResolution;
+			constexpr uint32_t samples = resolution + 1;
+
+			positions.clear();
+			for (uint32_t z = 0; z < samples; z++)
+			{
+				for (uint32_t x = 0; x < samples; x++)
+				{
+					positions.emplace_back(static_cast<float>(x) / resolution, static_cast<float>(z) / resolution);
+				}
+			}
+
+			indices.clear();
+			for (const uint32_t step : { 1u, 2u })
+			{
+				if (step == 2)
+				{
+					halfGridFirstIndex = static_cast<uint32_t>(indices.size());
+				}
+
+				for (uint32_t z = 0; z < resolution; z += step)
+				{
+					for (uint32_t x = 0; x < resolution; x += step)
+					{
+						const uint32_t corner = z * samples + x;
+						const uint32_t right = corner + step;
+						const uint32_t front = corner + step * samples;
+						indices.insert(indices.end(), { corner, front, right, right, front, front + step });
+					}
+				}
+			}
+		}
+	}
+
+	struct Renderer3D::Renderer3DData
+	{
+		std::unique_ptr<Shader> DepthShader;
+		std::unique_ptr<Shader> LitShader;
+
+		std::unique_ptr<Shader> TerrainDepthShader;
+		std::unique_ptr<Shader> TerrainShader;
+		uint32_t TerrainGridBuffer = 0;
+		uint32_t TerrainIndexBuffer = 0;
+		uint32_t TerrainInstanceBuffer = 0;
+		uint32_t TerrainVertexArray = 0;
+		uint32_t TerrainHalfGridFirstIndex = 0;
+		uint32_t TerrainIndexCount = 0;
+	};
+
+	void Renderer3D::Init()
+	{
+		m_Data = new Renderer3DData();
+		m_Data->DepthShader = std::make_unique<Shader>(DepthVertexSource, DepthFragmentSource);
+		m_Data->LitShader = std::make_unique<Shader>(LitVertexSource, LitFragmentSource);
+		m_Data->TerrainDepthShader = std::make_unique<Shader>(TerrainVertexSource, DepthFragmentSource);
+		m_Data->TerrainShader = std::make_unique<Shader>(TerrainVertexSource, LitFragmentSource);
+
+		std::vector<glm::vec2> gridPositions;
+		std::vector<uint32_t> gridIndices;
+		CreateTerrainGrid(gridPositions, gridIndices, m_Data->TerrainHalfGridFirstIndex);
+		m_Data->TerrainIndexCount = static_cast<uint32_t>(gridIndices.size());
+
+		glCreateBuffers(1, &m_Data->TerrainGridBuffer);
+		glNamedBufferStorage(m_Data->TerrainGridBuffer, static_cast<GLsizeiptr>(gridPositions.size() * sizeof(glm::vec2)), gridPositions.data(), 0);
+		glCreateBuffers(1, &m_Data->TerrainIndexBuffer);
+		glNamedBufferStorage(m_Data->TerrainIndexBuffer, static_cast<GLsizeiptr>(gridIndices.size() * sizeof(uint32_t)), gridIndices.data(), 0);
+		glCreateBuffers(1, &m_Data->TerrainInstanceBuffer);
+
+		glCreateVertexArrays(1, &m_Data->TerrainVertexArray);
+		const uint32_t vertexArray = m_Data->TerrainVertexArray;
+		glVertexArrayVertexBuffer(vertexArray, 0, m_Data->TerrainGridBuffer, 0, sizeof(glm::vec2));
+		glVertexArrayElementBuffer(vertexArray, m_Data->TerrainIndexBuffer);
+		glEnableVertexArrayAttrib(vertexArray, 0);
+		glVertexArrayAttribFormat(vertexArray, 0, 2, GL_FLOAT, GL_FALSE, 0);
+		glVertexArrayAttribBinding(vertexArray, 0, 0);
+
+		glVertexArrayBindingDivisor(vertexArray, 1, 1);
+		for (uint32_t attribute = 1; attribute <= 2; attribute++)
+		{
+			glEnableVertexArrayAttrib(vertexArray, attribute);
+			glVertexArrayAttribFormat(vertexArray, attribute, 4, GL_FLOAT, GL_FALSE, (attribute - 1) * sizeof(glm::vec4));
+			glVertexArrayAttribBinding(vertexArray, attribute, 1);
+		}
+	}
+
+	void Renderer3D::Destroy()
+	{
+		glDeleteVertexArrays(1, &m_Data->TerrainVertexArray);
+		glDeleteBuffers(1, &m_Data->TerrainGridBuffer);
+		glDeleteBuffers(1, &m_Data->TerrainIndexBuffer);
+		glDeleteBuffers(1, &m_Data->TerrainInstanceBuffer);
+
+		delete m_Data;
+		m_Data = nullptr;
+	}
+
+	void Renderer3D::Submit(DrawList& drawList, const Mesh& mesh, const glm::mat4& transform, const glm::vec4& colour, int entityID)
+	{
+		//The origin of the mesh stands in for its depth, which is enough to order whole objects.
+		const float depth = -(drawList.View * transform[3]).z;
+
+		const uint32_t drawIndex = static_cast<uint32_t>(drawList.Draws.size());
+		drawList.Draws.push_back({ &mesh, transform, colour, entityID });
+		drawList.Commands.Submit(RenderCommandQueue::MakeKey(RenderLayer::Opaque, depth, mesh.GetRendererID()), drawIndex);
+	}
+
+	void Renderer3D::SubmitTerrain(DrawList& drawList, Terrain& terrain, int entityID)
+	{
+		TerrainDraw& draw = drawList.Terrains.emplace_back();
+		draw.DrawTerrain = &terrain;
+		draw.CameraPosition = glm::vec3(glm::inverse(drawList.View)[3]);
+		draw.EntityID = entityID;
+
+		terrain.Select(drawList.Projection * drawList.View, draw.CameraPosition, draw.Selection);
+	}
+
+	void Renderer3D::Sort(DrawList& drawList)
+	{
+		drawList.Commands.Sort();
+	}
+
+	void Renderer3D::DrawDepth(const DrawList& drawList)
+	{
+		m_Data->DepthShader->Bind();
+		m_Data->DepthShader->SetMat4("u_ViewProjection", drawList.Projection * drawList.View);
+
+		for (const RenderCommand& command : drawList.Commands.GetCommands())
+		{
+			const MeshDraw& draw = drawList.Draws[command.DrawIndex];
+
+			m_Data->DepthShader->SetMat4("u_Transform", draw.Transform);
+			draw.DrawMesh->BindPositions();
+			glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(draw.DrawMesh->GetIndexCount()), GL_UNSIGNED_INT, nullptr);
+		}
+
+		DrawTerrains(drawList, *m_Data->TerrainDepthShader);
+	}
+
+	void Renderer3D::DrawOpaque(const DrawList& drawList)
+	{
+		m_Data->LitShader->Bind();
+		m_Data->LitShader->SetMat4("u_ViewProjection", drawList.Projection * drawList.View);
+		m_Data->LitShader->SetFloat3("u_LightDirection", glm::normalize(glm::vec3(-0.4f, -1.0f, -0.3f)));
+
+		for (const RenderCommand& command : drawList.Commands.GetCommands())
+		{
+			const MeshDraw& draw = drawList.Draws[command.DrawIndex];
+
+			m_Data->LitShader->SetMat4("u_Transform", draw.Transform);
+			m_Data->LitShader->SetFloat4("u_Colour", draw.Colour);
+			m_Data->LitShader->SetInt("u_EntityID", draw.EntityID);
+			draw.DrawMesh->Bind();
+			glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(draw.DrawMesh->GetIndexCount()), GL_UNSIGNED_INT, nullptr);
+		}
+
+		m_Data->TerrainShader->Bind();
+		m_Data->TerrainShader->SetFloat3("u_LightDirection", glm::normalize(glm::vec3(-0.4f, -1.0f, -0.3f)));
+		m_Data->TerrainShader->SetFloat4("u_Colour", glm::vec4(1.0f));
+		DrawTerrains(drawList, *m_Data->TerrainShader);
+	}
+
+	void Renderer3D::DrawTerrains(const DrawList& drawList, Shader& shader)
+	{
+		if (drawList.Terrains.empty()) return;
+
+		shader.Bind();
+		shader.SetMat4("u_ViewProjection", drawList.Projection * drawList.View);
+		shader.SetFloat("u_TileResolution", static_cast<float>(Terrain::GridResolution));
+		shader.SetInt("u_Heights", 0);
+		shader.SetInt("u_Normals", 1);
+		glBindVertexArray(m_Data->TerrainVertexArray);
+
+		for (const TerrainDraw& draw : drawList.Terrains)
+		{
+			const TerrainSelection& selection = draw.Selection;
+			if (selection.Nodes.empty() && selection.Quarters.empty()) continue;
+
+			const Terrain& terrain = *draw.DrawTerrain;
+			const TerrainDescription& description = terrain.GetDescription();
+			shader.SetFloat3("u_CameraPosition", draw.CameraPosition);
+			shader.SetFloat("u_BaseHeight", description.Origin.y);
+			shader.SetFloat("u_HeightScale", description.HeightScale);
+			shader.SetInt("u_EntityID", draw.EntityID);
+			for (uint32_t level = 0; level < terrain.GetLevelCount(); level++)
+			{
+				shader.SetFloat2("u_MorphRanges[" + std::to_string(level) + "]", terrain.GetMorphRange(level));
+			}
+			terrain.Bind(0);
+
+			//Both passes upload the selection again, it is a few kilobytes and saves tracking which pass runs first.
+			std::vector<TerrainInstance> instances;
+			instances.reserve(selection.Nodes.size() + selection.Quarters.size());
+			instances.insert(instances.end(), selection.Nodes.begin(), selection.Nodes.end());
+			instances.insert(instances.end(), selection.Quarters.begin(), selection.Quarters.end());
+			glNamedBufferData(m_Data->TerrainInstanceBuffer, static_cast<GLsizeiptr>(instances.size() * sizeof(TerrainInstance)), instances.data(), GL_STREAM_DRAW);
+			glVertexArrayVertexBuffer(m_Data->TerrainVertexArray, 1, m_Data->TerrainInstanceBuffer, 0, sizeof(TerrainInstance));
+
+			const uint32_t halfGridFirst = m_Data->TerrainHalfGridFirstIndex;
+			if (!selection.Nodes.empty())
+			{
+				shader.SetFloat("u_GridResolution", static_cast<float>(Terrain::GridResolution));
+				glDrawElementsInstancedBaseInstance(GL_TRIANGLES, static_cast<GLsizei>(halfGridFirst), GL_UNSIGNED_INT, nullptr,
+					static_cast<GLsizei>(selection.Nodes.size()), 0);
+			}
+
+			if (!selection.Quarters.empty())
+			{
+				shader.SetFloat("u_GridResolution", static_cast<float>(Terrain::GridResolution / 2));
+				glDrawElementsInstancedBaseInstance(GL_TRIANGLES, static_cast<GLsizei>(m_Data->TerrainIndexCount - halfGridFirst), GL_UNSIGNED_INT,
+					reinterpret_cast<const void*>(static_cast<uintptr_t>(halfGridFirst) * sizeof(uint32_t)),
+					static_cast<GLsizei>(selection.Quarters.size()), static_cast<GLuint>(selection.Nodes.size()));
+			}
+		}
+	}
+}//namespace Sengine::Renderer3D
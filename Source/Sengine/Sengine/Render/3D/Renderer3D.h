@@ -1,13 +1,72 @@
 ﻿#pragma once
 
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "Render/RenderCommandQueue.h"
+
+#include "Terrain.h"
+
+namespace Sengine
+{
+	class Shader;
+}
+
 namespace Sengine::Renderer3D
 {
+	class Mesh;
+
+	struct MeshDraw
+	{
+		const Mesh* DrawMesh = nullptr;
+		glm::mat4 Transform = glm::mat4(1.0f);
+		glm::vec4 Colour = glm::vec4(1.0f);
+		int EntityID = -1;
+	};
+
+	struct TerrainDraw
+	{
+		const Terrain* DrawTerrain = nullptr;
+		TerrainSelection Selection;
+		glm::vec3 CameraPosition = glm::vec3(0.0f);
+		int EntityID = -1;
+	};
+
+	//The opaque draws of one view. Commands index into the draws and are sorted front to back.
+	struct DrawList
+	{
+		glm::mat4 View = glm::mat4(1.0f);
+		glm::mat4 Projection = glm::mat4(1.0f);
+
+		std::vector<MeshDraw> Draws;
+		RenderCommandQueue Commands;
+
+		std::vector<TerrainDraw> Terrains;
+	};
+
 	class Renderer3D
 	{
 	public:
+		static void Init();
+		static void Destroy();
 
-	};
-}//namespace Sengine::Renderer3D
+		static void Submit(DrawList& drawList, const Mesh& mesh, const glm::mat4& transform, const glm::vec4& colour, int entityID = -1);
+		//Selects the terrain's nodes for the view of the draw list. Terrains are drawn after the meshes.
+		static void SubmitTerrain(DrawList& drawList, Terrain& terrain, int entityID = -1);
+		static void Sort(DrawList& drawList);
 
+		//Writes depth only, reading nothing but the position stream.
+		static void DrawDepth(const DrawList& drawList);
+		//Lit draw, the entity ID is written to the second colour attachment for picking.
+		static void DrawOpaque(const DrawList& drawList);
 
+	private:
+		//Two instanced draws per terrain, one for whole nodes and one for quarters.
+		static void DrawTerrains(const DrawList& drawList, Shader& shader);
 
+	private:
+		struct Renderer3DData;
+		inline static Renderer3DData* m_Data = nullptr;
+	};
+}//namespace Sengine::Renderer3D
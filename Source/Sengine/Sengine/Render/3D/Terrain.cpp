@@ -0,0 +1,392 @@
+#include "Terrain.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <limits>
+
+#include "glad/glad.h"
+
+#include "Core/JobSystem.h"
+
+namespace Sengine::Renderer3D
+{
+	namespace
+	{
+		bool IsPowerOfTwo(uint32_t value)
+		{
+			return value != 0 && (value & (value - 1)) == 0;
+		}
+
+		uint16_t ReadSample(const uint8_t* heightmap, uint32_t size, int64_t x, int64_t z)
+		{
+			x = std::clamp<int64_t>(x, 0, size - 1);
+			z = std::clamp<int64_t>(z, 0, size - 1);
+
+			uint16_t sample = 0;
+			std::memcpy(&sample, heightmap + (static_cast<size_t>(z) * size + static_cast<size_t>(x)) * sizeof(uint16_t), sizeof(sample));
+			return sample;
+		}
+
+		uint32_t PackNormal(const glm::vec3& normal)
+		{
+			const glm::uvec3 packed = glm::uvec3(glm::round((normal * 0.5f + 0.5f) * 255.0f));
+			return packed.x | (packed.y << 8) | (packed.z << 16) | (255u << 24);
+		}
+
+		bool IntersectsFrustum(const glm::vec4 (&planes)[6], const glm::vec3& min, const glm::vec3& max)
+		{
+			//Only the corner furthest along each plane's normal needs testing.
+			for (const glm::vec4& plane : planes)
+			{
+				const glm::vec3 corner = { plane.x >= 0.0f ? max.x : min.x, plane.y >= 0.0f ? max.y : min.y, plane.z >= 0.0f ? max.z : min.z };
+				if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f) return false;
+			}
+			return true;
+		}
+
+		bool IntersectsSphere(const glm::vec3& centre, float radius, const glm::vec3& min, const glm::vec3& max)
+		{
+			const glm::vec3 offset = centre - glm::clamp(centre, min, max);
+			return glm::dot(offset, offset) <= radius * radius;
+		}
+	}
+
+	Terrain::~Terrain()
+	{
+		Unload();
+	}
+
+	bool Terrain::Load(const TerrainDescription& description)
+	{
+		Unload();
+
+		const uint32_t intervals = description.HeightmapSize > 0 ? description.HeightmapSize - 1 : 0;
+		if (intervals < GridResolution || intervals % GridResolution != 0 || !IsPowerOfTwo(intervals / GridResolution))
+		{
+			std::cout << "[Terrain] Error: Heightmap size must be " << GridResolution << " times a power of two, plus one\n";
+			return false;
+		}
+
+		uint32_t levelCount = 1;
+		while ((GridResolution << (levelCount - 1)) < intervals) levelCount++;
+		if (levelCount > MaxLevels)
+		{
+			std::cout << "[Terrain] Error: Heightmap needs more than " << MaxLevels << " levels\n";
+			return false;
+		}
+
+		auto sharedState = std::make_shared<SharedState>();
+		if (!sharedState->Heightmap.Open(description.HeightmapPath)) return false;
+
+		const size_t expectedSize = static_cast<size_t>(description.HeightmapSize) * description.HeightmapSize * sizeof(uint16_t);
+		if (sharedState->Heightmap.GetSize() < expectedSize)
+		{
+			std::cout << "[Terrain] Error: " << description.HeightmapPath.string() << " is smaller than a " << description.HeightmapSize << "^2 heightmap\n";
+			return false;
+		}
+
+		m_Description = description;
+		m_Description.MaxResidentTiles = std::max(m_Description.MaxResidentTiles, 1u);
+		m_LevelCount = levelCount;
+		m_SharedState = std::move(sharedState);
+
+		//The coarsest level is never out of range, so the whole terrain is always covered by something.
+		for (uint32_t level = 0; level < m_LevelCount; level++)
+		{
+			m_Ranges[level] = description.LodDistance * static_cast<float>(1u << level);
+		}
+		m_Ranges[m_LevelCount - 1] = std::numeric_limits<float>::max();
+
+		const GLsizei layers = static_cast<GLsizei>(m_Description.MaxResidentTiles);
+		glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &m_HeightTextures);
+		glTextureStorage3D(m_HeightTextures, 1, GL_R16, TileSamples, TileSamples, layers);
+		glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &m_NormalTextures);
+		glTextureStorage3D(m_NormalTextures, 1, GL_RGBA8, TileSamples, TileSamples, layers);
+
+		for (const uint32_t texture : { m_HeightTextures, m_NormalTextures })
+		{
+			glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		}
+
+		m_LayerOwners.assign(m_Description.MaxResidentTiles, UINT64_MAX);
+		m_FreeLayers.resize(m_Description.MaxResidentTiles);
+		for (uint32_t layer = 0; layer < m_Description.MaxResidentTiles; layer++)
+		{
+			m_FreeLayers[layer] = m_Description.MaxResidentTiles - 1 - layer;
+		}
+
+		(void)RequestTile(MakeKey(m_LevelCount - 1, 0, 0));
+		return true;
+	}
+
+	void Terrain::Unload()
+	{
+		if (!m_SharedState) return;
+
+		glDeleteTextures(1, &m_HeightTextures);
+		glDeleteTextures(1, &m_NormalTextures);
+		m_HeightTextures = 0;
+		m_NormalTextures = 0;
+
+		m_Tiles.clear();
+		m_Requests.clear();
+		m_PendingUploads.clear();
+		m_LayerOwners.clear();
+		m_FreeLayers.clear();
+
+		//Jobs still in flight hold their own reference, the heightmap is unmapped once the last one finishes.
+		m_SharedState.reset();
+		m_JobsInFlight = 0;
+		m_LevelCount = 0;
+	}
+
+	void Terrain::Update()
+	{
+		if (!m_SharedState) return;
+
+		m_FrameIndex++;
+
+		//Dispatch requests, dropping the ones no view has asked for since they were made.
+		while (m_JobsInFlight < MaxJobsInFlight && !m_Requests.empty())
+		{
+			const uint64_t key = m_Requests.front();
+			m_Requests.pop_front();
+
+			const auto it = m_Tiles.find(key);
+			if (it == m_Tiles.end() || it->second.State != TileState::Requested) continue;
+
+			const bool isRoot = key == MakeKey(m_LevelCount - 1, 0, 0);
+			if (!isRoot && it->second.LastUsedFrame + 2 < m_FrameIndex)
+			{
+				m_Tiles.erase(it);
+				continue;
+			}
+
+			it->second.State = TileState::Loading;
+			m_JobsInFlight++;
+
+			JobSystem::Submit([sharedState = m_SharedState, description = m_Description, key]()
+				{
+					StreamedTile tile;
+					StreamTile(*sharedState, description, key, tile);
+
+					std::lock_guard<std::mutex> lock(sharedState->Mutex);
+					sharedState->Completed.push_back(std::move(tile));
+				});
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_SharedState->Mutex);
+			m_JobsInFlight -= static_cast<uint32_t>(m_SharedState->Completed.size());
+			std::move(m_SharedState->Completed.begin(), m_SharedState->Completed.end(), std::back_inserter(m_PendingUploads));
+			m_SharedState->Completed.clear();
+		}
+
+		//Uploads are spread over frames so flying into a new area never causes a hitch.
+		for (uint32_t uploads = 0; uploads < MaxUploadsPerFrame && !m_PendingUploads.empty();)
+		{
+			StreamedTile& streamed = m_PendingUploads.front();
+
+			const auto it = m_Tiles.find(streamed.Key);
+			if (it == m_Tiles.end())
+			{
+				m_PendingUploads.pop_front();
+				continue;
+			}
+
+			uint32_t layer = 0;
+			if (!AllocateLayer(layer)) break;
+
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+			glTextureSubImage3D(m_HeightTextures, 0, 0, 0, static_cast<GLint>(layer), TileSamples, TileSamples, 1, GL_RED, GL_UNSIGNED_SHORT, streamed.Heights.data());
+			glTextureSubImage3D(m_NormalTextures, 0, 0, 0, static_cast<GLint>(layer), TileSamples, TileSamples, 1, GL_RGBA, GL_UNSIGNED_BYTE, streamed.Normals.data());
+
+			it->second.State = TileState::Resident;
+			it->second.Layer = layer;
+			it->second.MinHeight = streamed.MinHeight;
+			it->second.MaxHeight = streamed.MaxHeight;
+			m_LayerOwners[layer] = streamed.Key;
+
+			m_PendingUploads.pop_front();
+			uploads++;
+		}
+	}
+
+	void Terrain::Select(const glm::mat4& viewProjection, const glm::vec3& cameraPosition, TerrainSelection& selection)
+	{
+		selection.Nodes.clear();
+		selection.Quarters.clear();
+		if (!m_SharedState) return;
+
+		//Planes of the frustum in world space, pointing inwards.
+		Frustum frustum;
+		const glm::mat4 matrix = glm::transpose(viewProjection);
+		for (uint32_t plane = 0; plane < 3; plane++)
+		{
+			frustum.Planes[plane * 2 + 0] = matrix[3] + matrix[plane];
+			frustum.Planes[plane * 2 + 1] = matrix[3] - matrix[plane];
+		}
+
+		(void)SelectNode(m_LevelCount - 1, 0, 0, frustum, cameraPosition, selection);
+	}
+
+	void Terrain::Bind(uint32_t slot) const
+	{
+		glBindTextureUnit(slot, m_HeightTextures);
+		glBindTextureUnit(slot + 1, m_NormalTextures);
+	}
+
+	glm::vec2 Terrain::GetMorphRange(uint32_t level) const
+	{
+		const float end = m_Ranges[level];
+		return { end * (1.0f - m_Description.MorphFraction), end };
+	}
+
+	void Terrain::StreamTile(const SharedState& sharedState, const TerrainDescription& description, uint64_t key, StreamedTile& tile)
+	{
+		const uint32_t level = static_cast<uint32_t>(key >> 48);
+		const uint32_t x = static_cast<uint32_t>(key >> 24) & 0xFFFFFF;
+		const uint32_t z = static_cast<uint32_t>(key) & 0xFFFFFF;
+
+		//A node's tile samples the heightmap every 2^level texels, so every level costs the same to stream.
+		const int64_t stride = int64_t(1) << level;
+		const int64_t firstX = static_cast<int64_t>(x) * GridResolution * stride;
+		const int64_t firstZ = static_cast<int64_t>(z) * GridResolution * stride;
+
+		const uint8_t* heightmap = sharedState.Heightmap.GetData();
+		const uint32_t size = description.HeightmapSize;
+		const float heightScale = description.HeightScale / 65535.0f;
+		const float spacing = description.WorldSize / static_cast<float>(size - 1) * static_cast<float>(stride);
+
+		tile.Key = key;
+		tile.Heights.resize(TileSamples * TileSamples);
+		tile.Normals.resize(TileSamples * TileSamples);
+
+		uint16_t minSample = UINT16_MAX;
+		uint16_t maxSample = 0;
+		for (uint32_t row = 0; row < TileSamples; row++)
+		{
+			for (uint32_t column = 0; column < TileSamples; column++)
+			{
+				const int64_t sampleX = firstX + column * stride;
+				const int64_t sampleZ = firstZ + row * stride;
+
+				const uint16_t sample = ReadSample(heightmap, size, sampleX, sampleZ);
+				minSample = std::min(minSample, sample);
+				maxSample = std::max(maxSample, sample);
+
+				const float left = ReadSample(heightmap, size, sampleX - stride, sampleZ) * heightScale;
+				const float right = ReadSample(heightmap, size, sampleX + stride, sampleZ) * heightScale;
+				const float back = ReadSample(heightmap, size, sampleX, sampleZ - stride) * heightScale;
+				const float front = ReadSample(heightmap, size, sampleX, sampleZ + stride) * heightScale;
+
+				tile.Heights[row * TileSamples + column] = sample;
+				tile.Normals[row * TileSamples + column] = PackNormal(glm::normalize(glm::vec3(left - right, 2.0f * spacing, back - front)));
+			}
+		}
+
+		//The grid interpolates between samples, so coarse tiles can miss peaks the finer ones have. Culling pads the bounds for that.
+		tile.MinHeight = minSample * heightScale;
+		tile.MaxHeight = maxSample * heightScale;
+	}
+
+	bool Terrain::SelectNode(uint32_t level, uint32_t x, uint32_t z, const Frustum& frustum, const glm::vec3& cameraPosition, TerrainSelection& selection)
+	{
+		const float size = GetNodeSize(level);
+		const glm::vec3& origin = m_Description.Origin;
+		glm::vec3 min = { origin.x + x * size, origin.y, origin.z + z * size };
+		glm::vec3 max = { min.x + size, origin.y + m_Description.HeightScale, min.z + size };
+
+		//Tested against the whole height range first, so nodes that are culled or out of range never stream their tile
+		//in or keep it from being evicted. Outside the frustum counts as handled, so the parent does not draw it either.
+		if (!IntersectsFrustum(frustum.Planes, min, max)) return true;
+		if (!IntersectsSphere(cameraPosition, m_Ranges[level], min, max)) return false;
+
+		const Tile* tile = RequestTile(MakeKey(level, x, z));
+		if (!tile) return false;
+
+		const float padding = size / GridResolution;
+		min.y = origin.y + tile->MinHeight - padding;
+		max.y = origin.y + tile->MaxHeight + padding;
+		if (!IntersectsFrustum(frustum.Planes, min, max)) return true;
+		if (!IntersectsSphere(cameraPosition, m_Ranges[level], min, max)) return false;
+
+		const float layer = static_cast<float>(tile->Layer);
+		if (level == 0 || !IntersectsSphere(cameraPosition, m_Ranges[level - 1], min, max))
+		{
+			selection.Nodes.push_back({ { min.x, min.z, size, static_cast<float>(level) }, { 0.0f, 0.0f, 1.0f, layer } });
+			return true;
+		}
+
+		//Children that are too far for their level, or still streaming, are drawn as a quarter of this node.
+		for (uint32_t child = 0; child < 4; child++)
+		{
+			const uint32_t childX = child & 1;
+			const uint32_t childZ = child >> 1;
+			if (SelectNode(level - 1, x * 2 + childX, z * 2 + childZ, frustum, cameraPosition, selection)) continue;
+
+			selection.Quarters.push_back(
+				{
+					{ min.x + childX * size * 0.5f, min.z + childZ * size * 0.5f, size * 0.5f, static_cast<float>(level) },
+					{ childX * 0.5f, childZ * 0.5f, 0.5f, layer },
+				});
+		}
+		return true;
+	}
+
+	const Terrain::Tile* Terrain::RequestTile(uint64_t key)
+	{
+		const auto [it, isNew] = m_Tiles.try_emplace(key);
+		it->second.LastUsedFrame = m_FrameIndex;
+		if (isNew)
+		{
+			m_Requests.push_back(key);
+		}
+
+		return it->second.State == TileState::Resident ? &it->second : nullptr;
+	}
+
+	bool Terrain::AllocateLayer(uint32_t& layer)
+	{
+		if (!m_FreeLayers.empty())
+		{
+			layer = m_FreeLayers.back();
+			m_FreeLayers.pop_back();
+			return true;
+		}
+
+		//Evict the least recently used tile. Ones drawn last frame are kept, as is the root every view falls back to.
+		const uint64_t rootKey = MakeKey(m_LevelCount - 1, 0, 0);
+		uint64_t oldestFrame = m_FrameIndex - 1;
+		uint32_t oldestLayer = UINT32_MAX;
+		for (uint32_t candidate = 0; candidate < m_LayerOwners.size(); candidate++)
+		{
+			const uint64_t owner = m_LayerOwners[candidate];
+			if (owner == rootKey) continue;
+
+			const Tile& tile = m_Tiles.at(owner);
+			if (tile.LastUsedFrame < oldestFrame)
+			{
+				oldestFrame = tile.LastUsedFrame;
+				oldestLayer = candidate;
+			}
+		}
+
+		if (oldestLayer == UINT32_MAX) return false;
+
+		m_Tiles.erase(m_LayerOwners[oldestLayer]);
+		m_LayerOwners[oldestLayer] = UINT64_MAX;
+		layer = oldestLayer;
+		return true;
+	}
+
+	float Terrain::GetNodeSize(uint32_t level) const
+	{
+		return m_Description.WorldSize / static_cast<float>(1u << (m_LevelCount - 1 - level));
+	}
+}//namespace Sengine::Renderer3D
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "Core/MappedFile.h"
+
+namespace Sengine::Renderer3D
+{
+	struct TerrainDescription
+	{
+		//Square heightmap of little endian 16 bit samples. Its size minus one must be the grid resolution times a power of two.
+		std::filesystem::path HeightmapPath;
+		uint32_t HeightmapSize = 0;
+
+		//Minimum corner of the terrain, heights are added on top of it.
+		glm::vec3 Origin = { 0.0f, 0.0f, 0.0f };
+		float WorldSize = 1024.0f;
+		float HeightScale = 128.0f;
+
+		//Distance the finest level is drawn to, every coarser level doubles it.
+		float LodDistance = 32.0f;
+		//Fraction at the far end of each level's range spent morphing into the next level.
+		float MorphFraction = 0.3f;
+
+		//Layers of the tile texture arrays. Least recently used tiles are evicted once they are full.
+		uint32_t MaxResidentTiles = 256;
+	};
+
+	//One quadtree node to draw, laid out as the per instance vertex stream.
+	struct TerrainInstance
+	{
+		glm::vec4 OffsetSize = glm::vec4(0.0f); //World x and z of the minimum corner, edge length, LOD level
+		glm::vec4 TileRegion = glm::vec4(0.0f); //Offset and scale of the area within the tile, texture array layer
+	};
+
+	//What one view draws. Whole nodes use the full grid, quarters of a node use the half resolution grid
+	//so their vertices stay spaced like the node they belong to.
+	struct TerrainSelection
+	{
+		std::vector<TerrainInstance> Nodes;
+		std::vector<TerrainInstance> Quarters;
+	};
+
+	//Heightmap terrain drawn with continuous distance dependent LOD (CDLOD). Every quadtree node has a tile of
+	//height and normal samples at its own resolution, streamed from a memory mapped heightmap on the job system.
+	//Any selection is drawn with one instanced grid, so the cost does not grow with the size of the map.
+	//Non-copyable as it owns the OpenGL handles.
+	class Terrain
+	{
+	public:
+		static constexpr uint32_t GridResolution = 64;
+		static constexpr uint32_t TileSamples = GridResolution + 1;
+		static constexpr uint32_t MaxLevels = 16;
+
+		//How many tile jobs may be in flight, and how many finished tiles are uploaded each frame.
+		static constexpr uint32_t MaxJobsInFlight = 16;
+		static constexpr uint32_t MaxUploadsPerFrame = 8;
+
+		Terrain() = default;
+		~Terrain();
+
+		Terrain(const Terrain&) = delete;
+		Terrain& operator=(const Terrain&) = delete;
+
+		[[nodiscard]] bool Load(const TerrainDescription& description);
+		void Unload();
+
+		//Dispatches tile requests and uploads finished tiles. Call once per frame on the main thread.
+		void Update();
+
+		//Walks the quadtree, culling nodes outside the frustum and picking the level of each area by its distance.
+		//Tiles that are missing are requested and their parent covers the area until they arrive.
+		void Select(const glm::mat4& viewProjection, const glm::vec3& cameraPosition, TerrainSelection& selection);
+
+		//Heights to the given slot, normals to the next one.
+		void Bind(uint32_t slot = 0) const;
+
+		//Distances over which a level morphs into the next one.
+		[[nodiscard]] glm::vec2 GetMorphRange(uint32_t level) const;
+
+		[[nodiscard]] const TerrainDescription& GetDescription() const { return m_Description; }
+		[[nodiscard]] uint32_t GetLevelCount() const { return m_LevelCount; }
+		[[nodiscard]] uint32_t GetResidentTileCount() const { return m_Description.MaxResidentTiles - static_cast<uint32_t>(m_FreeLayers.size()); }
+		[[nodiscard]] bool GetIsLoaded() const { return m_SharedState != nullptr; }
+
+	private:
+		enum class TileState : uint8_t
+		{
+			Requested,
+			Loading,
+			Resident,
+		};
+
+		struct Tile
+		{
+			TileState State = TileState::Requested;
+			uint32_t Layer = 0;
+			uint64_t LastUsedFrame = 0;
+			float MinHeight = 0.0f;
+			float MaxHeight = 0.0f;
+		};
+
+		struct StreamedTile
+		{
+			uint64_t Key = 0;
+			std::vector<uint16_t> Heights;
+			std::vector<uint32_t> Normals; //RGBA8, packed into the 0 to 1 range
+			float MinHeight = 0.0f;
+			float MaxHeight = 0.0f;
+		};
+
+		//Shared with the jobs, so the heightmap stays mapped and results can be dropped if the terrain is unloaded first.
+		struct SharedState
+		{
+			MappedFile Heightmap;
+			std::mutex Mutex;
+			std::vector<StreamedTile> Completed;
+		};
+
+		struct Frustum
+		{
+			glm::vec4 Planes[6];
+		};
+
+		[[nodiscard]] static uint64_t MakeKey(uint32_t level, uint32_t x, uint32_t z) { return (static_cast<uint64_t>(level) << 48) | (static_cast<uint64_t>(x) << 24) | z; }
+		static void StreamTile(const SharedState& sharedState, const TerrainDescription& description, uint64_t key, StreamedTile& tile);
+
+		//Returns false if the area is not drawn by this node and its parent should cover it instead.
+		[[nodiscard]] bool SelectNode(uint32_t level, uint32_t x, uint32_t z, const Frustum& frustum, const glm::vec3& cameraPosition, TerrainSelection& selection);
+		[[nodiscard]] const Tile* RequestTile(uint64_t key);
+
+		[[nodiscard]] bool AllocateLayer(uint32_t& layer);
+		[[nodiscard]] float GetNodeSize(uint32_t level) const;
+
+	private:
+		TerrainDescription m_Description;
+		uint32_t m_LevelCount = 0;
+		float m_Ranges[MaxLevels] = {};
+
+		uint32_t m_HeightTextures = 0;
+		uint32_t m_NormalTextures = 0;
+
+		std::unordered_map<uint64_t, Tile> m_Tiles;
+		std::deque<uint64_t> m_Requests;
+		std::deque<StreamedTile> m_PendingUploads;
+		std::vector<uint64_t> m_LayerOwners;
+		std::vector<uint32_t> m_FreeLayers;
+
+		std::shared_ptr<SharedState> m_SharedState;
+		uint32_t m_JobsInFlight = 0;
+		uint64_t m_FrameIndex = 0;
+	};
+}//namespace Sengine::Renderer3D
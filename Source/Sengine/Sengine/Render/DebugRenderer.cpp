@@ -0,0 +1,317 @@
+#include "DebugRenderer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "glad/glad.h"
+#include "glm/gtc/constants.hpp"
+#include "glm/gtc/packing.hpp"
+#include "imgui/imgui.h"
+
+#include "Shader.h"
+
+namespace Sengine
+{
+	namespace
+	{
+		const char* DebugVertexSource = R"(
+			#version 460 core
+			layout(location = 0) in vec3 a_Position;
+			layout(location = 1) in vec4 a_Colour;
+			layout(location = 2) in vec2 a_TexCoord;
+
+			uniform mat4 u_ViewProjection;
+
+			out vec4 v_Colour;
+			out vec2 v_TexCoord;
+
+			void main()
+			{
+				v_Colour = a_Colour;
+				v_TexCoord = a_TexCoord;
+				gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
+			}
+		)";
+
+		//Lines and triangles sample the white texel of the font atlas, so text shares the shader and the stream.
+		const char* DebugFragmentSource = R"(
+			#version 460 core
+			layout(location = 0) out vec4 o_Colour;
+
+			in vec4 v_Colour;
+			in vec2 v_TexCoord;
+
+			uniform sampler2D u_FontAtlas;
+
+			void main()
+			{
+				const vec4 colour = v_Colour * texture(u_FontAtlas, v_TexCoord);
+				if (colour.a == 0.0) discard;
+
+				o_Colour = colour;
+			}
+		)";
+
+		struct DebugVertex
+		{
+			glm::vec3 Position;
+			uint32_t Colour; //RGBA8
+			glm::vec2 TexCoord;
+		};
+
+		struct DebugText
+		{
+			glm::vec3 Position;
+			uint32_t Colour;
+			float Size;
+			std::string Text;
+		};
+
+		//Keeps the primitives whose time has not run out, in order. Every primitive is a fixed number of vertices.
+		template<typename T>
+		void RemoveExpired(std::vector<T>& values, std::vector<float>& remainingTimes, uint32_t valuesPerPrimitive, float deltaTime)
+		{
+			size_t kept = 0;
+			for (size_t primitive = 0; primitive < remainingTimes.size(); primitive++)
+			{
+				const float remainingTime = remainingTimes[primitive] - deltaTime;
+				if (remainingTime <= 0.0f) continue;
+
+				for (uint32_t value = 0; value < valuesPerPrimitive; value++)
+				{
+					values[kept * valuesPerPrimitive + value] = std::move(values[primitive * valuesPerPrimitive + value]);
+				}
+				remainingTimes[kept++] = remainingTime;
+			}
+
+			values.resize(kept * valuesPerPrimitive);
+			remainingTimes.resize(kept);
+		}
+	}
+
+	struct DebugRenderer::DebugRendererData
+	{
+		std::unique_ptr<Shader> DebugShader;
+		uint32_t VertexArray = 0;
+		uint32_t VertexBuffer = 0;
+		size_t VertexBufferCapacity = 0;
+
+		std::vector<DebugVertex> LineVertices;
+		std::vector<float> LineTimes;
+		std::vector<DebugVertex> TriangleVertices;
+		std::vector<float> TriangleTimes;
+		std::vector<DebugText> Texts;
+		std::vector<float> TextTimes;
+
+		//Text faces the camera, so it is built again for every view after the lines and triangles.
+		std::vector<DebugVertex> TextVertices;
+		bool IsUploaded = false;
+
+		std::chrono::steady_clock::time_point LastFrameTime = std::chrono::steady_clock::now();
+	};
+
+	void DebugRenderer::Init()
+	{
+		m_Data = new DebugRendererData();
+		m_Data->DebugShader = std::make_unique<Shader>(DebugVertexSource, DebugFragmentSource);
+		m_Data->DebugShader->SetInt("u_FontAtlas", 0);
+
+		glCreateBuffers(1, &m_Data->VertexBuffer);
+		glCreateVertexArrays(1, &m_Data->VertexArray);
+		glVertexArrayVertexBuffer(m_Data->VertexArray, 0, m_Data->VertexBuffer, 0, sizeof(DebugVertex));
+
+		glEnableVertexArrayAttrib(m_Data->VertexArray, 0);
+		glVertexArrayAttribFormat(m_Data->VertexArray, 0, 3, GL_FLOAT, GL_FALSE, offsetof(DebugVertex, Position));
+		glVertexArrayAttribBinding(m_Data->VertexArray, 0, 0);
+
+		glEnableVertexArrayAttrib(m_Data->VertexArray, 1);
+		glVertexArrayAttribFormat(m_Data->VertexArray, 1, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(DebugVertex, Colour));
+		glVertexArrayAttribBinding(m_Data->VertexArray, 1, 0);
+
+		glEnableVertexArrayAttrib(m_Data->VertexArray, 2);
+		glVertexArrayAttribFormat(m_Data->VertexArray, 2, 2, GL_FLOAT, GL_FALSE, offsetof(DebugVertex, TexCoord));
+		glVertexArrayAttribBinding(m_Data->VertexArray, 2, 0);
+	}
+
+	void DebugRenderer::Destroy()
+	{
+		glDeleteVertexArrays(1, &m_Data->VertexArray);
+		glDeleteBuffers(1, &m_Data->VertexBuffer);
+
+		delete m_Data;
+		m_Data = nullptr;
+	}
+
+	void DebugRenderer::DrawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec4& colour, float duration)
+	{
+		const uint32_t packedColour = glm::packUnorm4x8(colour);
+		const glm::vec2 white = { ImGui::GetIO().Fonts->TexUvWhitePixel.x, ImGui::GetIO().Fonts->TexUvWhitePixel.y };
+
+		m_Data->LineVertices.push_back({ from, packedColour, white });
+		m_Data->LineVertices.push_back({ to, packedColour, white });
+		m_Data->LineTimes.push_back(duration);
+		m_Data->IsUploaded = false;
+	}
+
+	void DebugRenderer::DrawTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec4& colour, float duration)
+	{
+		const uint32_t packedColour = glm::packUnorm4x8(colour);
+		const glm::vec2 white = { ImGui::GetIO().Fonts->TexUvWhitePixel.x, ImGui::GetIO().Fonts->TexUvWhitePixel.y };
+
+		m_Data->TriangleVertices.push_back({ a, packedColour, white });
+		m_Data->TriangleVertices.push_back({ b, packedColour, white });
+		m_Data->TriangleVertices.push_back({ c, packedColour, white });
+		m_Data->TriangleTimes.push_back(duration);
+		m_Data->IsUploaded = false;
+	}
+
+	void DebugRenderer::DrawCircle(const glm::vec3& centre, float radius, const glm::vec3& normal, const glm::vec4& colour, float duration, uint32_t segments)
+	{
+		//Any two axes perpendicular to the normal span the circle's plane.
+		const glm::vec3 axis = glm::normalize(normal);
+		const glm::vec3 helper = std::abs(axis.z) < 0.9f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+		const glm::vec3 tangent = glm::normalize(glm::cross(helper, axis)) * radius;
+		const glm::vec3 bitangent = glm::cross(axis, tangent);
+
+		glm::vec3 previous = centre + tangent;
+		for (uint32_t segment = 1; segment <= segments; segment++)
+		{
+			const float angle = glm::two_pi<float>() * static_cast<float>(segment) / static_cast<float>(segments);
+			const glm::vec3 current = centre + tangent * std::cos(angle) + bitangent * std::sin(angle);
+			DrawLine(previous, current, colour, duration);
+			previous = current;
+		}
+	}
+
+	void DebugRenderer::DrawAABB(const glm::vec3& min, const glm::vec3& max, const glm::vec4& colour, float duration)
+	{
+		const auto corner = [&](uint32_t index)
+			{
+				return glm::vec3(index & 1 ? max.x : min.x, index & 2 ? max.y : min.y, index & 4 ? max.z : min.z);
+			};
+
+		//Each edge joins two corners that differ along one axis.
+		for (uint32_t index = 0; index < 8; index++)
+		{
+			for (const uint32_t axis : { 1u, 2u, 4u })
+			{
+				if ((index & axis) == 0)
+				{
+					DrawLine(corner(index), corner(index | axis), colour, duration);
+				}
+			}
+		}
+	}
+
+	void DebugRenderer::DrawText3D(const glm::vec3& position, const std::string& text, const glm::vec4& colour, float size, float duration)
+	{
+		m_Data->Texts.push_back({ position, glm::packUnorm4x8(colour), size, text });
+		m_Data->TextTimes.push_back(duration);
+	}
+
+	void DebugRenderer::Draw(const glm::mat4& viewProjection)
+	{
+		if (GetIsEmpty()) return;
+
+		const size_t lineCount = m_Data->LineVertices.size();
+		const size_t triangleCount = m_Data->TriangleVertices.size();
+
+		//The camera's right and up in world space, which text is laid out along.
+		const glm::mat4 inverseViewProjection = glm::inverse(viewProjection);
+		const glm::vec3 right = glm::normalize(glm::vec3(inverseViewProjection[0]));
+		const glm::vec3 up = glm::normalize(glm::vec3(inverseViewProjection[1]));
+
+		//Glyphs come from the font ImGui already keeps in its atlas, with the first line of the font as the unit size.
+		m_Data->TextVertices.clear();
+		const ImFont* font = ImGui::GetIO().Fonts->Fonts.empty() ? nullptr : ImGui::GetIO().Fonts->Fonts[0];
+		for (size_t index = 0; font && index < m_Data->Texts.size(); index++)
+		{
+			const DebugText& text = m_Data->Texts[index];
+			const float scale = text.Size / font->FontSize;
+
+			float width = 0.0f;
+			for (const char character : text.Text)
+			{
+				const ImFontGlyph* glyph = font->FindGlyph(static_cast<ImWchar>(static_cast<unsigned char>(character)));
+				width += glyph ? glyph->AdvanceX : 0.0f;
+			}
+
+			//Font coordinates run down from the top left, the text is centred on its position.
+			const glm::vec3 origin = text.Position - right * (width * 0.5f * scale) + up * (text.Size * 0.5f);
+			float cursor = 0.0f;
+			for (const char character : text.Text)
+			{
+				const ImFontGlyph* glyph = font->FindGlyph(static_cast<ImWchar>(static_cast<unsigned char>(character)));
+				if (!glyph) continue;
+
+				if (glyph->Visible)
+				{
+					const auto vertex = [&](float x, float y, float u, float v) -> DebugVertex
+						{
+							return { origin + right * ((cursor + x) * scale) - up * (y * scale), text.Colour, { u, v } };
+						};
+
+					const DebugVertex topLeft = vertex(glyph->X0, glyph->Y0, glyph->U0, glyph->V0);
+					const DebugVertex topRight = vertex(glyph->X1, glyph->Y0, glyph->U1, glyph->V0);
+					const DebugVertex bottomRight = vertex(glyph->X1, glyph->Y1, glyph->U1, glyph->V1);
+					const DebugVertex bottomLeft = vertex(glyph->X0, glyph->Y1, glyph->U0, glyph->V1);
+					m_Data->TextVertices.insert(m_Data->TextVertices.end(), { topLeft, bottomLeft, bottomRight, bottomRight, topRight, topLeft });
+				}
+				cursor += glyph->AdvanceX;
+			}
+		}
+
+		//Lines and triangles are the same for every view, so they are uploaded once a frame with room for the text after them.
+		const size_t textOffset = lineCount + triangleCount;
+		const size_t requiredCapacity = textOffset + m_Data->TextVertices.size();
+		if (!m_Data->IsUploaded || requiredCapacity > m_Data->VertexBufferCapacity)
+		{
+			m_Data->VertexBufferCapacity = std::max(requiredCapacity, m_Data->VertexBufferCapacity);
+			glNamedBufferData(m_Data->VertexBuffer, static_cast<GLsizeiptr>(m_Data->VertexBufferCapacity * sizeof(DebugVertex)), nullptr, GL_STREAM_DRAW);
+			glNamedBufferSubData(m_Data->VertexBuffer, 0, static_cast<GLsizeiptr>(lineCount * sizeof(DebugVertex)), m_Data->LineVertices.data());
+			glNamedBufferSubData(m_Data->VertexBuffer, static_cast<GLintptr>(lineCount * sizeof(DebugVertex)),
+				static_cast<GLsizeiptr>(triangleCount * sizeof(DebugVertex)), m_Data->TriangleVertices.data());
+			m_Data->IsUploaded = true;
+		}
+		glNamedBufferSubData(m_Data->VertexBuffer, static_cast<GLintptr>(textOffset * sizeof(DebugVertex)),
+			static_cast<GLsizeiptr>(m_Data->TextVertices.size() * sizeof(DebugVertex)), m_Data->TextVertices.data());
+
+		m_Data->DebugShader->Bind();
+		m_Data->DebugShader->SetMat4("u_ViewProjection", viewProjection);
+		glBindTextureUnit(0, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(ImGui::GetIO().Fonts->TexID)));
+		glBindVertexArray(m_Data->VertexArray);
+
+		if (lineCount > 0)
+		{
+			glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(lineCount));
+		}
+
+		//Text follows the triangles in the buffer, so both go in the one draw.
+		const size_t triangleVertexCount = triangleCount + m_Data->TextVertices.size();
+		if (triangleVertexCount > 0)
+		{
+			glDrawArrays(GL_TRIANGLES, static_cast<GLint>(lineCount), static_cast<GLsizei>(triangleVertexCount));
+		}
+	}
+
+	void DebugRenderer::EndFrame()
+	{
+		const auto now = std::chrono::steady_clock::now();
+		const float deltaTime = std::chrono::duration<float>(now - m_Data->LastFrameTime).count();
+		m_Data->LastFrameTime = now;
+
+		RemoveExpired(m_Data->LineVertices, m_Data->LineTimes, 2, deltaTime);
+		RemoveExpired(m_Data->TriangleVertices, m_Data->TriangleTimes, 3, deltaTime);
+		RemoveExpired(m_Data->Texts, m_Data->TextTimes, 1, deltaTime);
+		m_Data->IsUploaded = false;
+	}
+
+	bool DebugRenderer::GetIsEmpty()
+	{
+		return m_Data->LineTimes.empty() && m_Data->TriangleTimes.empty() && m_Data->TextTimes.empty();
+	}
+}//namespace Sengine
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "glm/glm.hpp"
+
+namespace Sengine
+{
+	//Lines, filled triangles and text for debug views, gathered from anywhere during the frame and drawn over every view.
+	//All primitives share one vertex stream and are drawn with one draw call per topology.
+	//A duration of zero lasts the current frame, longer ones are kept and drawn until that many seconds have passed.
+	class DebugRenderer
+	{
+	public:
+		static void Init();
+		static void Destroy();
+
+		static void DrawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec4& colour, float duration = 0.0f);
+		static void DrawTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec4& colour, float duration = 0.0f);
+		//The circle lies in the plane facing its normal.
+		static void DrawCircle(const glm::vec3& centre, float radius, const glm::vec3& normal, const glm::vec4& colour, float duration = 0.0f, uint32_t segments = 32);
+		static void DrawAABB(const glm::vec3& min, const glm::vec3& max, const glm::vec4& colour, float duration = 0.0f);
+		//Text that always faces the camera, centred on the position. The size is the height of a line in world units.
+		static void DrawText3D(const glm::vec3& position, const std::string& text, const glm::vec4& colour, float size = 1.0f, float duration = 0.0f);
+
+		//Draws everything into the bound targets, blended and depth tested against what is already there.
+		static void Draw(const glm::mat4& viewProjection);
+		//Drops the primitives that have run out of time. Called by the renderer once the frame has been drawn.
+		static void EndFrame();
+
+		[[nodiscard]] static bool GetIsEmpty();
+
+	private:
+		struct DebugRendererData;
+		inline static DebugRendererData* m_Data = nullptr;
+	};
+}//namespace Sengine
@@ -0,0 +1,32 @@
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Sengine
+{
+	void DynamicResolution::Update(float gpuMilliseconds, const DynamicResolutionSettings& settings)
+	{
+		//An exponential average rides over single frame spikes such as shader compiles.
+		m_SmoothedMilliseconds = m_SmoothedMilliseconds == 0.0f ? gpuMilliseconds : m_SmoothedMilliseconds + (gpuMilliseconds - m_SmoothedMilliseconds) * 0.1f;
+
+		if (!settings.Enabled)
+		{
+			m_Scale = 1.0f;
+			return;
+		}
+
+		if (++m_FramesSinceChange < settings.CooldownFrames) return;
+		if (m_SmoothedMilliseconds <= 0.0f) return;
+
+		//GPU time follows the pixel count, which goes with the square of the scale.
+		const float idealScale = m_Scale * std::sqrt(settings.TargetMilliseconds / m_SmoothedMilliseconds);
+		const float step = std::max(settings.Step, 0.01f);
+		const float scale = std::clamp(std::round(idealScale / step) * step, settings.MinScale, settings.MaxScale);
+
+		if (std::abs(scale - m_Scale) < step * 0.5f) return;
+
+		m_Scale = scale;
+		m_FramesSinceChange = 0;
+	}
+}//namespace Sengine
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Sengine
+{
+	struct DynamicResolutionSettings
+	{
+		bool Enabled = false;
+
+		//GPU time to hold, the default leaves a little headroom under 60 fps.
+		float TargetMilliseconds = 15.0f;
+		float MinScale = 0.5f;
+		float MaxScale = 1.0f;
+
+		//Scales are rounded to steps, so the render target pool only ever sees a handful of sizes.
+		float Step = 0.05f;
+		//Frames to wait after a change before the next one, so the measured time can settle.
+		uint32_t CooldownFrames = 30;
+	};
+
+	//Picks the scale of the scene render targets from measured GPU frame times.
+	class DynamicResolution
+	{
+	public:
+		void Update(float gpuMilliseconds, const DynamicResolutionSettings& settings);
+
+		[[nodiscard]] float GetScale() const { return m_Scale; }
+		[[nodiscard]] float GetSmoothedMilliseconds() const { return m_SmoothedMilliseconds; }
+
+	private:
+		float m_Scale = 1.0f;
+		float m_SmoothedMilliseconds = 0.0f;
+		uint32_t m_FramesSinceChange = 0;
+	};
+}//namespace Sengine
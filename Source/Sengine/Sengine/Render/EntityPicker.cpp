@@ -0,0 +1,68 @@
+#include "EntityPicker.h"
+
+#include "glad/glad.h"
+
+#include "Framebuffer.h"
+
+namespace Sengine
+{
+	EntityPicker::EntityPicker()
+	{
+		for (Readback& readback : m_Readbacks)
+		{
+			glCreateBuffers(1, &readback.Buffer);
+			glNamedBufferStorage(readback.Buffer, sizeof(int), nullptr, GL_CLIENT_STORAGE_BIT);
+		}
+	}
+
+	EntityPicker::~EntityPicker()
+	{
+		for (Readback& readback : m_Readbacks)
+		{
+			glDeleteSync(static_cast<GLsync>(readback.Fence));
+			glDeleteBuffers(1, &readback.Buffer);
+		}
+	}
+
+	bool EntityPicker::RequestPick(const Framebuffer& framebuffer, uint32_t attachmentIndex, int x, int y)
+	{
+		if (m_PendingCount == RingSize) return false;
+
+		const FramebufferSpecification& specification = framebuffer.GetSpecification();
+		if (x < 0 || y < 0 || x >= static_cast<int>(specification.Width) || y >= static_cast<int>(specification.Height)) return false;
+
+		Readback& readback = m_Readbacks[(m_Head + m_PendingCount) % RingSize];
+
+		//With a pixel pack buffer bound glReadPixels only records a copy, it returns without waiting for the GPU.
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer.GetRendererID());
+		glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.Buffer);
+		glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, nullptr);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+		readback.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_PendingCount++;
+		return true;
+	}
+
+	bool EntityPicker::PollResult(int& entityID)
+	{
+		if (m_PendingCount == 0) return false;
+
+		Readback& readback = m_Readbacks[m_Head];
+
+		//A timeout of zero only queries the fence. The flush makes sure it is submitted so it can eventually signal.
+		const GLenum status = glClientWaitSync(static_cast<GLsync>(readback.Fence), GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) return false;
+
+		glGetNamedBufferSubData(readback.Buffer, 0, sizeof(int), &entityID);
+
+		glDeleteSync(static_cast<GLsync>(readback.Fence));
+		readback.Fence = nullptr;
+
+		m_Head = (m_Head + 1) % RingSize;
+		m_PendingCount--;
+		return true;
+	}
+}//namespace Sengine
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace Sengine
+{
+	class Framebuffer;
+
+	//Reads entity IDs back from an integer framebuffer attachment without stalling the GPU.
+	//Each pick is copied into a pixel buffer and fenced, the result is collected a frame or two later once the fence has signalled.
+	class EntityPicker
+	{
+	public:
+		static constexpr uint32_t RingSize = 3;
+
+		EntityPicker();
+		~EntityPicker();
+
+		EntityPicker(const EntityPicker&) = delete;
+		EntityPicker& operator=(const EntityPicker&) = delete;
+
+		//Queues a read of the pixel at (x, y), with the origin at the bottom left. Returns false if every buffer in the ring is in flight.
+		bool RequestPick(const Framebuffer& framebuffer, uint32_t attachmentIndex, int x, int y);
+
+		//Returns true and the ID of the oldest pick once it has landed. Never blocks.
+		[[nodiscard]] bool PollResult(int& entityID);
+
+	private:
+		struct Readback
+		{
+			uint32_t Buffer = 0;
+			void* Fence = nullptr;
+		};
+
+		std::array<Readback, RingSize> m_Readbacks;
+		uint32_t m_Head = 0; //Oldest pick in flight
+		uint32_t m_PendingCount = 0;
+	};
+}//namespace Sengine
@@ -0,0 +1,232 @@
+#include "FrameCapture.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+
+#include "3D/Mesh.h"
+#include "Texture.h"
+
+namespace Sengine
+{
+	namespace
+	{
+		constexpr uint32_t CaptureMagic = 0x50434553; //"SECP"
+		constexpr uint32_t CaptureVersion = 1;
+
+		//Sizes of everything written as raw memory. A capture from a build where any of them differ is refused.
+		constexpr uint32_t LayoutSizes[] =
+		{
+			sizeof(RendererSettings),
+			sizeof(RenderView),
+			sizeof(CapturedQuad),
+			sizeof(CapturedMeshDraw),
+			sizeof(Renderer2D::PointLight2D),
+		};
+
+		template<typename T>
+		void Write(std::ostream& stream, const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only plain data is written as raw memory");
+			stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		template<typename T>
+		void WriteVector(std::ostream& stream, const std::vector<T>& values)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only plain data is written as raw memory");
+			Write(stream, static_cast<uint64_t>(values.size()));
+			stream.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+		}
+
+		template<typename T>
+		bool Read(std::istream& stream, T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only plain data is read as raw memory");
+			return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+		}
+
+		template<typename T>
+		bool ReadVector(std::istream& stream, std::vector<T>& values)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Only plain data is read as raw memory");
+
+			//Anything larger than a gigabyte is a corrupt file rather than a frame.
+			uint64_t count = 0;
+			if (!Read(stream, count) || count > (1ull << 30) / sizeof(T)) return false;
+
+			values.resize(static_cast<size_t>(count));
+			return static_cast<bool>(stream.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(count * sizeof(T))));
+		}
+	}
+
+	bool CapturedFrame::Save(const std::filesystem::path& path) const
+	{
+		std::ofstream stream(path, std::ios::binary);
+		if (!stream.is_open())
+		{
+			std::cout << "[Frame Capture] Error: Failed to write " << path.string() << "\n";
+			return false;
+		}
+
+		Write(stream, CaptureMagic);
+		Write(stream, CaptureVersion);
+		for (const uint32_t size : LayoutSizes)
+		{
+			Write(stream, size);
+		}
+
+		Write(stream, Width);
+		Write(stream, Height);
+		Write(stream, Settings);
+
+		Write(stream, static_cast<uint64_t>(Textures.size()));
+		for (const CapturedTexture& texture : Textures)
+		{
+			Write(stream, texture.Width);
+			Write(stream, texture.Height);
+			WriteVector(stream, texture.Pixels);
+		}
+
+		Write(stream, static_cast<uint64_t>(Meshes.size()));
+		for (const CapturedMesh& mesh : Meshes)
+		{
+			WriteVector(stream, mesh.Positions);
+			WriteVector(stream, mesh.Normals);
+			WriteVector(stream, mesh.Indices);
+		}
+
+		Write(stream, static_cast<uint64_t>(Views.size()));
+		for (const CapturedView& view : Views)
+		{
+			Write(stream, static_cast<uint8_t>(view.Is3D));
+			Write(stream, view.ViewProjection);
+			Write(stream, view.View);
+			Write(stream, view.Projection);
+			Write(stream, view.Target);
+			WriteVector(stream, view.Quads);
+			WriteVector(stream, view.Lights);
+			WriteVector(stream, view.Meshes);
+		}
+
+		return static_cast<bool>(stream);
+	}
+
+	bool CapturedFrame::Load(const std::filesystem::path& path)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		if (!stream.is_open())
+		{
+			std::cout << "[Frame Capture] Error: Failed to read " << path.string() << "\n";
+			return false;
+		}
+
+		uint32_t magic = 0;
+		uint32_t version = 0;
+		bool isValid = Read(stream, magic) && magic == CaptureMagic && Read(stream, version) && version == CaptureVersion;
+		for (const uint32_t expectedSize : LayoutSizes)
+		{
+			uint32_t size = 0;
+			isValid = isValid && Read(stream, size) && size == expectedSize;
+		}
+		if (!isValid)
+		{
+			std::cout << "[Frame Capture] Error: " << path.string() << " is not a capture from this build of the engine\n";
+			return false;
+		}
+
+		*this = CapturedFrame();
+		isValid = Read(stream, Width) && Read(stream, Height) && Read(stream, Settings);
+
+		uint64_t count = 0;
+		isValid = isValid && Read(stream, count) && count < (1u << 20);
+		Textures.resize(isValid ? static_cast<size_t>(count) : 0);
+		for (CapturedTexture& texture : Textures)
+		{
+			isValid = isValid && Read(stream, texture.Width) && Read(stream, texture.Height) && ReadVector(stream, texture.Pixels)
+				&& texture.Pixels.size() == static_cast<size_t>(texture.Width) * texture.Height * 4;
+		}
+
+		isValid = isValid && Read(stream, count) && count < (1u << 20);
+		Meshes.resize(isValid ? static_cast<size_t>(count) : 0);
+		for (CapturedMesh& mesh : Meshes)
+		{
+			isValid = isValid && ReadVector(stream, mesh.Positions) && ReadVector(stream, mesh.Normals) && ReadVector(stream, mesh.Indices);
+		}
+
+		isValid = isValid && Read(stream, count) && count < (1u << 20);
+		Views.resize(isValid ? static_cast<size_t>(count) : 0);
+		for (CapturedView& view : Views)
+		{
+			uint8_t is3D = 0;
+			isValid = isValid && Read(stream, is3D) && Read(stream, view.ViewProjection) && Read(stream, view.View) && Read(stream, view.Projection)
+				&& Read(stream, view.Target) && ReadVector(stream, view.Quads) && ReadVector(stream, view.Lights) && ReadVector(stream, view.Meshes);
+			view.Is3D = is3D != 0;
+		}
+
+		//Indices are checked once here, so replays can trust them.
+		for (const CapturedView& view : Views)
+		{
+			for (const CapturedQuad& quad : view.Quads)
+			{
+				isValid = isValid && quad.Texture < static_cast<int32_t>(Textures.size()) && quad.NormalMap < static_cast<int32_t>(Textures.size())
+					&& (quad.NormalMap < 0 || quad.Texture >= 0);
+			}
+			for (const CapturedMeshDraw& draw : view.Meshes)
+			{
+				isValid = isValid && draw.Mesh < Meshes.size();
+			}
+		}
+		//Normals are fetched with the same index as positions, so both have to cover every index.
+		for (const CapturedMesh& mesh : Meshes)
+		{
+			const size_t vertexCount = mesh.Positions.size();
+			isValid = isValid && mesh.Normals.size() == vertexCount
+				&& std::all_of(mesh.Indices.begin(), mesh.Indices.end(), [vertexCount](uint32_t index) { return index < vertexCount; });
+		}
+
+		if (!isValid)
+		{
+			std::cout << "[Frame Capture] Error: " << path.string() << " is truncated or corrupt\n";
+			*this = CapturedFrame();
+			return false;
+		}
+
+		return true;
+	}
+
+	FrameRecorder::FrameRecorder(uint32_t width, uint32_t height)
+	{
+		m_Frame.Width = width;
+		m_Frame.Height = height;
+	}
+
+	int32_t FrameRecorder::AddTexture(const Texture2D* texture)
+	{
+		if (!texture) return -1;
+
+		const auto [entry, isAdded] = m_TextureIndices.try_emplace(texture, static_cast<int32_t>(m_Frame.Textures.size()));
+		if (isAdded)
+		{
+			m_Frame.Textures.push_back({ texture->GetWidth(), texture->GetHeight(), texture->ReadData() });
+		}
+		return entry->second;
+	}
+
+	uint32_t FrameRecorder::AddMesh(const Renderer3D::Mesh& mesh)
+	{
+		const auto [entry, isAdded] = m_MeshIndices.try_emplace(&mesh, static_cast<uint32_t>(m_Frame.Meshes.size()));
+		if (isAdded)
+		{
+			CapturedMesh& captured = m_Frame.Meshes.emplace_back();
+			mesh.ReadData(captured.Positions, captured.Normals, captured.Indices);
+		}
+		return entry->second;
+	}
+
+	void FrameRecorder::AddView(CapturedView view)
+	{
+		m_Frame.Views.push_back(std::move(view));
+	}
+}//namespace Sengine
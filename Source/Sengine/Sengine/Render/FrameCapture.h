@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "2D/LightGrid2D.h"
+#include "Renderer.h"
+
+namespace Sengine
+{
+	struct CapturedQuad
+	{
+		glm::mat4 Transform = glm::mat4(1.0f);
+		glm::vec4 Colour = glm::vec4(1.0f);
+		int EntityID = -1;
+		//Indices into the frame's textures, -1 for none.
+		int32_t Texture = -1;
+		int32_t NormalMap = -1;
+		glm::vec4 Region = { 0.0f, 0.0f, 1.0f, 1.0f };
+	};
+
+	struct CapturedMeshDraw
+	{
+		//Index into the frame's meshes.
+		uint32_t Mesh = 0;
+		glm::mat4 Transform = glm::mat4(1.0f);
+		glm::vec4 Colour = glm::vec4(1.0f);
+		int EntityID = -1;
+	};
+
+	//RGBA8, rows in the order Texture2D takes them.
+	struct CapturedTexture
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		std::vector<uint8_t> Pixels;
+	};
+
+	struct CapturedMesh
+	{
+		std::vector<glm::vec3> Positions;
+		std::vector<glm::vec3> Normals;
+		std::vector<uint32_t> Indices;
+	};
+
+	//A 2D or 3D view as it was submitted. The view's texture handles only record whether it had them,
+	//a replay creates its own targets of the same size.
+	struct CapturedView
+	{
+		bool Is3D = false;
+		//2D views use the view projection, 3D views the view and projection.
+		glm::mat4 ViewProjection = glm::mat4(1.0f);
+		glm::mat4 View = glm::mat4(1.0f);
+		glm::mat4 Projection = glm::mat4(1.0f);
+		RenderView Target;
+
+		//Opaque and transparent together, in the order they were submitted. The renderer splits and sorts them again.
+		std::vector<CapturedQuad> Quads;
+		std::vector<Renderer2D::PointLight2D> Lights;
+		std::vector<CapturedMeshDraw> Meshes;
+	};
+
+	//Everything the Renderer was given during one frame, with the contents of the textures and meshes it drew,
+	//so the frame can be submitted again without the application that produced it.
+	//Passes added straight to the frame graph, terrains and debug primitives are not captured, and neither is the colour grading LUT.
+	struct CapturedFrame
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		RendererSettings Settings;
+
+		std::vector<CapturedTexture> Textures;
+		std::vector<CapturedMesh> Meshes;
+		std::vector<CapturedView> Views;
+
+		//Captures store settings and draws as they are laid out in memory, so only the same build of the engine reads them back.
+		[[nodiscard]] bool Save(const std::filesystem::path& path) const;
+		[[nodiscard]] bool Load(const std::filesystem::path& path);
+	};
+
+	//Builds a CapturedFrame as the renderer's views end. Textures and meshes are read back from the GPU
+	//the first time a view uses them, which stalls, so captured frames take longer than the rest.
+	class FrameRecorder
+	{
+	public:
+		FrameRecorder(uint32_t width, uint32_t height);
+
+		//Returns the index of the resource in the frame, reading it back if the frame does not have it yet.
+		[[nodiscard]] int32_t AddTexture(const Texture2D* texture);
+		[[nodiscard]] uint32_t AddMesh(const Renderer3D::Mesh& mesh);
+		void AddView(CapturedView view);
+
+		[[nodiscard]] CapturedFrame& GetFrame() { return m_Frame; }
+
+	private:
+		CapturedFrame m_Frame;
+		std::unordered_map<const Texture2D*, int32_t> m_TextureIndices;
+		std::unordered_map<const Renderer3D::Mesh*, uint32_t> m_MeshIndices;
+	};
+}//namespace Sengine
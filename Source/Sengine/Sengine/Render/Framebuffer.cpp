@@ -0,0 +1,105 @@
+#include "Framebuffer.h"
+
+#include "glad/glad.h"
+
+#include "RenderTargetPool.h"
+#include "Utils/Assert.h"
+
+namespace Sengine
+{
+	Framebuffer::Framebuffer(FramebufferSpecification specification)
+		: m_Specification(std::move(specification))
+	{
+		Invalidate();
+	}
+
+	Framebuffer::~Framebuffer()
+	{
+		ReleaseAttachments();
+		glDeleteFramebuffers(1, &m_RendererID);
+	}
+
+	void Framebuffer::Bind() const
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
+		glViewport(0, 0, static_cast<GLsizei>(m_Specification.Width), static_cast<GLsizei>(m_Specification.Height));
+	}
+
+	void Framebuffer::Unbind()
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	void Framebuffer::Resize(uint32_t width, uint32_t height)
+	{
+		if (width == 0 || height == 0) return;
+		if (width == m_Specification.Width && height == m_Specification.Height) return;
+
+		m_Specification.Width = width;
+		m_Specification.Height = height;
+		Invalidate();
+	}
+
+	void Framebuffer::ClearAttachment(uint32_t attachmentIndex, int value) const
+	{
+		glClearTexImage(m_ColorAttachments[attachmentIndex], 0, GL_RED_INTEGER, GL_INT, &value);
+	}
+
+	void Framebuffer::Invalidate()
+	{
+		//The old attachments go back to the pool first, so resizing back to a recent size picks them straight up again.
+		ReleaseAttachments();
+
+		if (m_Specification.Width == 0 || m_Specification.Height == 0) return;
+
+		if (m_RendererID == 0)
+		{
+			glCreateFramebuffers(1, &m_RendererID);
+		}
+
+		std::vector<GLenum> drawBuffers;
+		for (const FramebufferTextureFormat format : m_Specification.Attachments)
+		{
+			const uint32_t texture = RenderTargetPool::Acquire({ m_Specification.Width, m_Specification.Height, format });
+
+			if (IsDepthFormat(format))
+			{
+				glNamedFramebufferTexture(m_RendererID, GL_DEPTH_STENCIL_ATTACHMENT, texture, 0);
+				m_DepthAttachment = texture;
+			}
+			else
+			{
+				const GLenum attachment = GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(m_ColorAttachments.size());
+				glNamedFramebufferTexture(m_RendererID, attachment, texture, 0);
+				drawBuffers.push_back(attachment);
+				m_ColorAttachments.push_back(texture);
+			}
+		}
+
+		if (drawBuffers.empty())
+		{
+			glNamedFramebufferDrawBuffer(m_RendererID, GL_NONE);
+		}
+		else
+		{
+			glNamedFramebufferDrawBuffers(m_RendererID, static_cast<GLsizei>(drawBuffers.size()), drawBuffers.data());
+		}
+
+		SE_Assert(glCheckNamedFramebufferStatus(m_RendererID, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE, "[Framebuffer] Error: Framebuffer is incomplete");
+	}
+
+	void Framebuffer::ReleaseAttachments()
+	{
+		for (const uint32_t texture : m_ColorAttachments)
+		{
+			RenderTargetPool::Release(texture);
+		}
+		if (m_DepthAttachment != 0)
+		{
+			RenderTargetPool::Release(m_DepthAttachment);
+		}
+
+		m_ColorAttachments.clear();
+		m_DepthAttachment = 0;
+	}
+}//namespace Sengine
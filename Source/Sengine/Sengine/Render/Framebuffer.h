@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Sengine
+{
+	enum class FramebufferTextureFormat : uint8_t
+	{
+		None = 0,
+
+		//Colour
+		RGBA8,
+		RGBA16F,
+		RedInteger,
+
+		//Depth/stencil
+		Depth24Stencil8,
+	};
+
+	[[nodiscard]] inline bool IsDepthFormat(FramebufferTextureFormat format)
+	{
+		return format == FramebufferTextureFormat::Depth24Stencil8;
+	}
+
+	struct FramebufferSpecification
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		std::vector<FramebufferTextureFormat> Attachments;
+	};
+
+	//An off screen render target made of one texture per attachment. The textures are borrowed from the RenderTargetPool,
+	//so a resize returns the old attachments to the pool rather than deleting them. Non-copyable as it owns the OpenGL handles.
+	class Framebuffer
+	{
+	public:
+		explicit Framebuffer(FramebufferSpecification specification);
+		~Framebuffer();
+
+		Framebuffer(const Framebuffer&) = delete;
+		Framebuffer& operator=(const Framebuffer&) = delete;
+
+		void Bind() const;
+		static void Unbind();
+
+		void Resize(uint32_t width, uint32_t height);
+
+		//Clears an integer colour attachment, used to reset the entity ID attachment.
+		void ClearAttachment(uint32_t attachmentIndex, int value) const;
+
+		[[nodiscard]] uint32_t GetRendererID() const { return m_RendererID; }
+		[[nodiscard]] uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const { return m_ColorAttachments[index]; }
+		[[nodiscard]] uint32_t GetDepthAttachmentRendererID() const { return m_DepthAttachment; }
+		[[nodiscard]] const FramebufferSpecification& GetSpecification() const { return m_Specification; }
+
+	private:
+		void Invalidate();
+		void ReleaseAttachments();
+
+	private:
+		FramebufferSpecification m_Specification;
+
+		uint32_t m_RendererID = 0;
+		std::vector<uint32_t> m_ColorAttachments;
+		uint32_t m_DepthAttachment = 0;
+	};
+}//namespace Sengine
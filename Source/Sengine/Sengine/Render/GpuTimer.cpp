@@ -0,0 +1,63 @@
+#include "GpuTimer.h"
+
+#include "glad/glad.h"
+
+namespace Sengine
+{
+	GpuTimer::GpuTimer()
+	{
+		for (TimestampPair& query : m_Queries)
+		{
+			glCreateQueries(GL_TIMESTAMP, 1, &query.Start);
+			glCreateQueries(GL_TIMESTAMP, 1, &query.End);
+		}
+	}
+
+	GpuTimer::~GpuTimer()
+	{
+		for (TimestampPair& query : m_Queries)
+		{
+			glDeleteQueries(1, &query.Start);
+			glDeleteQueries(1, &query.End);
+		}
+	}
+
+	void GpuTimer::Begin()
+	{
+		m_IsMeasuring = m_PendingCount < RingSize;
+		if (!m_IsMeasuring) return;
+
+		glQueryCounter(m_Queries[(m_Head + m_PendingCount) % RingSize].Start, GL_TIMESTAMP);
+	}
+
+	void GpuTimer::End()
+	{
+		if (!m_IsMeasuring) return;
+
+		glQueryCounter(m_Queries[(m_Head + m_PendingCount) % RingSize].End, GL_TIMESTAMP);
+		m_PendingCount++;
+		m_IsMeasuring = false;
+	}
+
+	bool GpuTimer::PollResult(float& milliseconds)
+	{
+		if (m_PendingCount == 0) return false;
+
+		const TimestampPair& query = m_Queries[m_Head];
+
+		//The end timestamp lands after the start one, so its availability covers both.
+		GLint isAvailable = GL_FALSE;
+		glGetQueryObjectiv(query.End, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+		if (isAvailable == GL_FALSE) return false;
+
+		GLuint64 start = 0;
+		GLuint64 end = 0;
+		glGetQueryObjectui64v(query.Start, GL_QUERY_RESULT, &start);
+		glGetQueryObjectui64v(query.End, GL_QUERY_RESULT, &end);
+		milliseconds = static_cast<float>(end - start) / 1000000.0f;
+
+		m_Head = (m_Head + 1) % RingSize;
+		m_PendingCount--;
+		return true;
+	}
+}//namespace Sengine
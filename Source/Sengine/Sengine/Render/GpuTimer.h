@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace Sengine
+{
+	//Measures GPU time between Begin and End with timestamp queries, without stalling.
+	//Results are collected a few frames later once the GPU has caught up, frames are skipped while every query is in flight.
+	class GpuTimer
+	{
+	public:
+		static constexpr uint32_t RingSize = 4;
+
+		GpuTimer();
+		~GpuTimer();
+
+		GpuTimer(const GpuTimer&) = delete;
+		GpuTimer& operator=(const GpuTimer&) = delete;
+
+		void Begin();
+		void End();
+
+		//Returns true and the time of the oldest measurement once it has landed. Never blocks.
+		[[nodiscard]] bool PollResult(float& milliseconds);
+
+	private:
+		struct TimestampPair
+		{
+			uint32_t Start = 0;
+			uint32_t End = 0;
+		};
+
+		std::array<TimestampPair, RingSize> m_Queries;
+		uint32_t m_Head = 0; //Oldest measurement in flight
+		uint32_t m_PendingCount = 0;
+		bool m_IsMeasuring = false;
+	};
+}//namespace Sengine
@@ -0,0 +1,85 @@
+#include "PhysicsDebugDraw.h"
+
+#include <cmath>
+
+#include "DebugRenderer.h"
+
+namespace Sengine
+{
+	namespace
+	{
+		//Filled shapes are drawn see-through with a solid outline, the way the Box2D testbed shows them.
+		constexpr float FillAlpha = 0.5f;
+		constexpr float TransformAxisLength = 0.4f;
+		constexpr uint32_t CircleSegments = 16;
+	}
+
+	PhysicsDebugDraw::PhysicsDebugDraw(float depth)
+		: m_Depth(depth)
+	{
+	}
+
+	void PhysicsDebugDraw::DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color)
+	{
+		const glm::vec4 colour = { color.r, color.g, color.b, color.a };
+		for (int32 index = 0; index < vertexCount; index++)
+		{
+			const b2Vec2& from = vertices[index];
+			const b2Vec2& to = vertices[(index + 1) % vertexCount];
+			DebugRenderer::DrawLine({ from.x, from.y, m_Depth }, { to.x, to.y, m_Depth }, colour);
+		}
+	}
+
+	void PhysicsDebugDraw::DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color)
+	{
+		//Box2D polygons are convex, so a fan from the first vertex fills them.
+		const glm::vec4 fill = { color.r, color.g, color.b, color.a * FillAlpha };
+		const glm::vec3 first = { vertices[0].x, vertices[0].y, m_Depth };
+		for (int32 index = 1; index + 1 < vertexCount; index++)
+		{
+			DebugRenderer::DrawTriangle(first, { vertices[index].x, vertices[index].y, m_Depth }, { vertices[index + 1].x, vertices[index + 1].y, m_Depth }, fill);
+		}
+
+		DrawPolygon(vertices, vertexCount, color);
+	}
+
+	void PhysicsDebugDraw::DrawCircle(const b2Vec2& center, float radius, const b2Color& color)
+	{
+		DebugRenderer::DrawCircle({ center.x, center.y, m_Depth }, radius, { 0.0f, 0.0f, 1.0f }, { color.r, color.g, color.b, color.a }, 0.0f, CircleSegments);
+	}
+
+	void PhysicsDebugDraw::DrawSolidCircle(const b2Vec2& center, float radius, const b2Vec2& axis, const b2Color& color)
+	{
+		b2Vec2 vertices[CircleSegments];
+		for (uint32_t segment = 0; segment < CircleSegments; segment++)
+		{
+			const float angle = b2_pi * 2.0f * static_cast<float>(segment) / static_cast<float>(CircleSegments);
+			vertices[segment] = center + radius * b2Vec2(std::cos(angle), std::sin(angle));
+		}
+		DrawSolidPolygon(vertices, static_cast<int32>(CircleSegments), color);
+
+		//The axis shows the body's rotation.
+		DrawSegment(center, center + radius * axis, color);
+	}
+
+	void PhysicsDebugDraw::DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color)
+	{
+		DebugRenderer::DrawLine({ p1.x, p1.y, m_Depth }, { p2.x, p2.y, m_Depth }, { color.r, color.g, color.b, color.a });
+	}
+
+	void PhysicsDebugDraw::DrawTransform(const b2Transform& xf)
+	{
+		DrawSegment(xf.p, xf.p + TransformAxisLength * xf.q.GetXAxis(), b2Color(1.0f, 0.0f, 0.0f));
+		DrawSegment(xf.p, xf.p + TransformAxisLength * xf.q.GetYAxis(), b2Color(0.0f, 1.0f, 0.0f));
+	}
+
+	void PhysicsDebugDraw::DrawPoint(const b2Vec2& p, float size, const b2Color& color)
+	{
+		const float halfSize = size * m_PointScale * 0.5f;
+		const glm::vec4 colour = { color.r, color.g, color.b, color.a };
+		const glm::vec3 min = { p.x - halfSize, p.y - halfSize, m_Depth };
+		const glm::vec3 max = { p.x + halfSize, p.y + halfSize, m_Depth };
+		DebugRenderer::DrawTriangle(min, { max.x, min.y, m_Depth }, max, colour);
+		DebugRenderer::DrawTriangle(max, { min.x, max.y, m_Depth }, min, colour);
+	}
+}//namespace Sengine
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "box2d/b2_draw.h"
+
+namespace Sengine
+{
+	//Draws a Box2D world with the debug renderer. Register it with b2World::SetDebugDraw, pick what to show with
+	//SetFlags, then call b2World::DebugDraw each frame. The world lies in the z = depth plane.
+	class PhysicsDebugDraw final : public b2Draw
+	{
+	public:
+		explicit PhysicsDebugDraw(float depth = 0.0f);
+
+		void DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) override;
+		void DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) override;
+		void DrawCircle(const b2Vec2& center, float radius, const b2Color& color) override;
+		void DrawSolidCircle(const b2Vec2& center, float radius, const b2Vec2& axis, const b2Color& color) override;
+		void DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color) override;
+		void DrawTransform(const b2Transform& xf) override;
+		void DrawPoint(const b2Vec2& p, float size, const b2Color& color) override;
+
+		//World units per pixel of Box2D's point sizes.
+		void SetPointScale(float pointScale) { m_PointScale = pointScale; }
+
+	private:
+		float m_Depth = 0.0f;
+		float m_PointScale = 0.01f;
+	};
+}//namespace Sengine
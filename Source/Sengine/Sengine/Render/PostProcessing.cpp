@@ -0,0 +1,498 @@
+#include "PostProcessing.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "glad/glad.h"
+
+#include "Shader.h"
+
+namespace Sengine
+{
+	namespace
+	{
+		//A triangle covering the screen, generated from the vertex index so no vertex buffer is needed.
+		const char* FullscreenVertexSource = R"(
+			#version 460 core
+			out vec2 v_TexCoord;
+
+			void main()
+			{
+				v_TexCoord = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+				gl_Position = vec4(v_TexCoord * 2.0 - 1.0, 0.0, 1.0);
+			}
+		)";
+
+		//Four bilinear taps average a 4x4 block of the source. The first downsample also keeps only the bright parts,
+		//with a soft knee so the threshold does not show as an edge.
+		const char* DownsampleFragmentSource = R"(
+			#version 460 core
+			layout(location = 0) out vec4 o_Colour;
+
+			in vec2 v_TexCoord;
+
+			layout(binding = 0) uniform sampler2D u_Source;
+			uniform vec2 u_SourceTexelSize;
+			uniform float u_Threshold;
+
+			void main()
+			{
+				const vec4 offset = u_SourceTexelSize.xyxy * vec4(-1.0, -1.0, 1.0, 1.0);
+				vec3 colour = texture(u_Source, v_TexCoord + offset.xy).rgb;
+				colour += texture(u_Source, v_TexCoord + offset.zy).rgb;
+				colour += texture(u_Source, v_TexCoord + offset.xw).rgb;
+				colour += texture(u_Source, v_TexCoord + offset.zw).rgb;
+				colour *= 0.25;
+
+				if (u_Threshold >= 0.0)
+				{
+					const float brightness = max(colour.r, max(colour.g, colour.b));
+					const float knee = u_Threshold * 0.5;
+					float soft = clamp(brightness - u_Threshold + knee, 0.0, 2.0 * knee);
+					soft = soft * soft / (4.0 * knee + 0.0001);
+					colour *= max(soft, brightness - u_Threshold) / max(brightness, 0.0001);
+				}
+
+				o_Colour = vec4(colour, 1.0);
+			}
+		)";
+
+		//9 tap gaussian in 5 bilinear taps, run once per axis.
+		const char* BlurFragmentSource = R"(
+			#version 460 core
+			layout(location = 0) out vec4 o_Colour;
+
+			in vec2 v_TexCoord;
+
+			layout(binding = 0) uniform sampler2D u_Source;
+			uniform vec2 u_Direction;
+
+			const float Offsets[3] = float[](0.0, 1.3846153846, 3.2307692308);
+			const float Weights[3] = float[](0.2270270270, 0.3162162162, 0.0702702703);
+
+			void main()
+			{
+				vec3 colour = texture(u_Source, v_TexCoord).rgb * Weights[0];
+				for (int tap = 1; tap < 3; tap++)
+				{
+					colour += texture(u_Source, v_TexCoord + u_Direction * Offsets[tap]).rgb * Weights[tap];
+					colour += texture(u_Source, v_TexCoord - u_Direction * Offsets[tap]).rgb * Weights[tap];
+				}
+
+				o_Colour = vec4(colour, 1.0);
+			}
+		)";
+
+		//3x3 tent filter over the smaller mip, added onto the larger one by blending.
+		const char* UpsampleFragmentSource = R"(
+			#version 460 core
+			layout(location = 0) out vec4 o_Colour;
+
+			in vec2 v_TexCoord;
+
+			layout(binding = 0) uniform sampler2D u_Source;
+			uniform vec2 u_SourceTexelSize;
+
+			void main()
+			{
+				const vec4 offset = u_SourceTexelSize.xyxy * vec4(1.0, 1.0, -1.0, 0.0);
+				vec3 colour = texture(u_Source, v_TexCoord - offset.xy).rgb;
+				colour += texture(u_Source, v_TexCoord - offset.wy).rgb * 2.0;
+				colour += texture(u_Source, v_TexCoord - offset.zy).rgb;
+				colour += texture(u_Source, v_TexCoord + offset.zw).rgb * 2.0;
+				colour += texture(u_Source, v_TexCoord).rgb * 4.0;
+				colour += texture(u_Source, v_TexCoord + offset.xw).rgb * 2.0;
+				colour += texture(u_Source, v_TexCoord + offset.zy).rgb;
+				colour += texture(u_Source, v_TexCoord + offset.wy).rgb * 2.0;
+				colour += texture(u_Source, v_TexCoord + offset.xy).rgb;
+
+				o_Colour = vec4(colour / 16.0, 1.0);
+			}
+		)";
+
+		const char* CompositeFragmentSource = R"(
+			#version 460 core
+			layout(location = 0) out vec4 o_Colour;
+
+			in vec2 v_TexCoord;
+
+			layout(binding = 0) uniform sampler2D u_SceneColour;
+			layout(binding = 1) uniform sampler2D u_Bloom;
+			layout(binding = 2) uniform sampler3D u_LUT;
+
+			uniform float u_Exposure;
+			uniform float u_BloomIntensity;
+			uniform int u_Tonemapper;
+			uniform int u_HasBloom;
+			uniform int u_HasLUT;
+			uniform int u_WriteLuma;
+
+			//Fit of the ACES reference curve by Krzysztof Narkowicz.
+			vec3 TonemapACES(vec3 colour)
+			{
+				return clamp((colour * (2.51 * colour + 0.03)) / (colour * (2.43 * colour + 0.59) + 0.14), 0.0, 1.0);
+			}
+
+			void main()
+			{
+				vec3 colour = texture(u_SceneColour, v_TexCoord).rgb;
+				if (u_HasBloom != 0)
+				{
+					colour += texture(u_Bloom, v_TexCoord).rgb * u_BloomIntensity;
+				}
+				colour *= u_Exposure;
+
+				if (u_Tonemapper == 1) colour = colour / (1.0 + colour);
+				else if (u_Tonemapper == 2) colour = TonemapACES(colour);
+				colour = clamp(colour, 0.0, 1.0);
+
+				if (u_HasLUT != 0)
+				{
+					//Samples on texel centres so the ends of the range map to the first and last entries.
+					const float size = float(textureSize(u_LUT, 0).x);
+					colour = texture(u_LUT, colour * ((size - 1.0) / size) + 0.5 / size).rgb;
+				}
+
+				//FXAA reads luma from alpha, the final target wants it opaque.
+				const float luma = dot(colour, vec3(0.299, 0.587, 0.114));
+				o_Colour = vec4(colour, u_WriteLuma != 0 ? luma : 1.0);
+			}
+		)";
+
+		//The compact FXAA by Timothy Lottes: blur along the edge direction found from the luma of the corners.
+		const char* FXAAFragmentSource = R"(
+			#version 460 core
+			layout(location = 0) out vec4 o_Colour;
+
+			in vec2 v_TexCoord;
+
+			layout(binding = 0) uniform sampler2D u_Source;
+			uniform vec2 u_TexelSize;
+
+			const float ReduceMin = 1.0 / 128.0;
+			const float ReduceMultiplier = 1.0 / 8.0;
+			const float SpanMax = 8.0;
+
+			void main()
+			{
+				const float lumaNW = texture(u_Source, v_TexCoord + vec2(-1.0, -1.0) * u_TexelSize).a;
+				const float lumaNE = texture(u_Source, v_TexCoord + vec2(1.0, -1.0) * u_TexelSize).a;
+				const float lumaSW = texture(u_Source, v_TexCoord + vec2(-1.0, 1.0) * u_TexelSize).a;
+				const float lumaSE = texture(u_Source, v_TexCoord + vec2(1.0, 1.0) * u_TexelSize).a;
+				const vec4 centre = texture(u_Source, v_TexCoord);
+
+				const float lumaMin = min(centre.a, min(min(lumaNW, lumaNE), min(lumaSW, lumaSE)));
+				const float lumaMax = max(centre.a, max(max(lumaNW, lumaNE), max(lumaSW, lumaSE)));
+
+				vec2 direction = vec2(-((lumaNW + lumaNE) - (lumaSW + lumaSE)), (lumaNW + lumaSW) - (lumaNE + lumaSE));
+				const float directionReduce = max((lumaNW + lumaNE + lumaSW + lumaSE) * 0.25 * ReduceMultiplier, ReduceMin);
+				const float inverseDirectionMin = 1.0 / (min(abs(direction.x), abs(direction.y)) + directionReduce);
+				direction = clamp(direction * inverseDirectionMin, -SpanMax, SpanMax) * u_TexelSize;
+
+				const vec3 colourA = 0.5 * (texture(u_Source, v_TexCoord + direction * (1.0 / 3.0 - 0.5)).rgb
+					+ texture(u_Source, v_TexCoord + direction * (2.0 / 3.0 - 0.5)).rgb);
+				const vec3 colourB = colourA * 0.5 + 0.25 * (texture(u_Source, v_TexCoord - direction * 0.5).rgb
+					+ texture(u_Source, v_TexCoord + direction * 0.5).rgb);
+
+				const float lumaB = dot(colourB, vec3(0.299, 0.587, 0.114));
+				o_Colour = vec4(lumaB < lumaMin || lumaB > lumaMax ? colourA : colourB, 1.0);
+			}
+		)";
+
+		//Texel fetches per output pixel of each shader, used to estimate the cost of the stack.
+		constexpr float DownsampleFetches = 4.0f;
+		constexpr float BlurFetches = 5.0f;
+		constexpr float UpsampleFetches = 9.0f;
+		constexpr float FXAAFetches = 9.0f;
+
+		glm::vec2 GetTexelSize(const RenderTargetDescription& description)
+		{
+			return { 1.0f / static_cast<float>(description.Width), 1.0f / static_cast<float>(description.Height) };
+		}
+
+		//Mip sizes of the bloom pyramid, halving from the bloom resolution.
+		std::vector<glm::uvec2> GetBloomMipSizes(const PostProcessSettings& settings, uint32_t width, uint32_t height)
+		{
+			const uint32_t divisor = static_cast<uint32_t>(settings.BloomResolution);
+			glm::uvec2 size = { std::max(width / divisor, 1u), std::max(height / divisor, 1u) };
+
+			std::vector<glm::uvec2> sizes;
+			while (sizes.size() < settings.BloomMips && size.x >= 2 && size.y >= 2)
+			{
+				sizes.push_back(size);
+				size /= 2u;
+			}
+			return sizes;
+		}
+	}
+
+	struct PostProcessing::PostProcessingData
+	{
+		std::unique_ptr<Shader> DownsampleShader;
+		std::unique_ptr<Shader> BlurShader;
+		std::unique_ptr<Shader> UpsampleShader;
+		std::unique_ptr<Shader> CompositeShader;
+		std::unique_ptr<Shader> FXAAShader;
+
+		uint32_t FullscreenVertexArray = 0;
+	};
+
+	void PostProcessing::Init()
+	{
+		m_Data = new PostProcessingData();
+		m_Data->DownsampleShader = std::make_unique<Shader>(FullscreenVertexSource, DownsampleFragmentSource);
+		m_Data->BlurShader = std::make_unique<Shader>(FullscreenVertexSource, BlurFragmentSource);
+		m_Data->UpsampleShader = std::make_unique<Shader>(FullscreenVertexSource, UpsampleFragmentSource);
+		m_Data->CompositeShader = std::make_unique<Shader>(FullscreenVertexSource, CompositeFragmentSource);
+		m_Data->FXAAShader = std::make_unique<Shader>(FullscreenVertexSource, FXAAFragmentSource);
+
+		glCreateVertexArrays(1, &m_Data->FullscreenVertexArray);
+	}
+
+	void PostProcessing::Destroy()
+	{
+		glDeleteVertexArrays(1, &m_Data->FullscreenVertexArray);
+
+		delete m_Data;
+		m_Data = nullptr;
+	}
+
+	void PostProcessing::AddPasses(RenderGraph& graph, RenderGraphResource sceneColour, RenderGraphResource output, const PostProcessSettings& settings)
+	{
+		const RenderTargetDescription& outputDescription = graph.GetDescription(output);
+		const uint32_t width = outputDescription.Width;
+		const uint32_t height = outputDescription.Height;
+
+		const PostProcessSettings fitted = FitToBudget(settings, width, height);
+		m_EstimatedMilliseconds = EstimateTexelFetches(fitted, width, height) / fitted.TexelFetchesPerMillisecond;
+
+		//Bloom follows the scene resolution, the composite upscales the scene to the output.
+		const RenderTargetDescription& sceneDescription = graph.GetDescription(sceneColour);
+		const RenderGraphResource bloom = fitted.Bloom ? AddBloomPasses(graph, sceneColour, fitted, sceneDescription.Width, sceneDescription.Height) : InvalidRenderGraphResource;
+
+		RenderGraphResource composite = output;
+		graph.AddPass("Composite", [&](RenderGraphBuilder& builder)
+			{
+				builder.Read(sceneColour);
+				if (bloom != InvalidRenderGraphResource) builder.Read(bloom);
+				if (fitted.FXAA)
+				{
+					composite = builder.Create("PostComposite", { width, height, FramebufferTextureFormat::RGBA8 });
+				}
+				builder.Write(composite);
+			},
+			[sceneColour, bloom, fitted](const RenderGraph& frameGraph)
+			{
+				Shader& shader = *m_Data->CompositeShader;
+				shader.Bind();
+				shader.SetFloat("u_Exposure", fitted.Exposure);
+				shader.SetFloat("u_BloomIntensity", fitted.BloomIntensity);
+				shader.SetInt("u_Tonemapper", static_cast<int>(fitted.Tonemapping));
+				shader.SetInt("u_HasBloom", bloom != InvalidRenderGraphResource ? 1 : 0);
+				shader.SetInt("u_HasLUT", fitted.ColourGradingLUT != 0 ? 1 : 0);
+				shader.SetInt("u_WriteLuma", fitted.FXAA ? 1 : 0);
+
+				glDisable(GL_DEPTH_TEST);
+				glBindTextureUnit(0, frameGraph.GetTexture(sceneColour));
+				if (bloom != InvalidRenderGraphResource) glBindTextureUnit(1, frameGraph.GetTexture(bloom));
+				if (fitted.ColourGradingLUT != 0) glBindTextureUnit(2, fitted.ColourGradingLUT);
+
+				glBindVertexArray(m_Data->FullscreenVertexArray);
+				glDrawArrays(GL_TRIANGLES, 0, 3);
+			});
+
+		if (!fitted.FXAA) return;
+
+		graph.AddPass("FXAA", [&](RenderGraphBuilder& builder)
+			{
+				builder.Read(composite);
+				builder.Write(output);
+			},
+			[composite](const RenderGraph& frameGraph)
+			{
+				Shader& shader = *m_Data->FXAAShader;
+				shader.Bind();
+				shader.SetFloat2("u_TexelSize", GetTexelSize(frameGraph.GetDescription(composite)));
+
+				glDisable(GL_DEPTH_TEST);
+				glBindTextureUnit(0, frameGraph.GetTexture(composite));
+				glBindVertexArray(m_Data->FullscreenVertexArray);
+				glDrawArrays(GL_TRIANGLES, 0, 3);
+			});
+	}
+
+	uint32_t PostProcessing::CreateColourGradingLUT(const uint8_t* texels, uint32_t size)
+	{
+		uint32_t lut = 0;
+		glCreateTextures(GL_TEXTURE_3D, 1, &lut);
+		glTextureStorage3D(lut, 1, GL_RGBA8, static_cast<GLsizei>(size), static_cast<GLsizei>(size), static_cast<GLsizei>(size));
+		glTextureSubImage3D(lut, 0, 0, 0, 0, static_cast<GLsizei>(size), static_cast<GLsizei>(size), static_cast<GLsizei>(size), GL_RGBA, GL_UNSIGNED_BYTE, texels);
+
+		glTextureParameteri(lut, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(lut, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTextureParameteri(lut, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(lut, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(lut, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+		return lut;
+	}
+
+	void PostProcessing::DestroyColourGradingLUT(uint32_t lut)
+	{
+		glDeleteTextures(1, &lut);
+	}
+
+	PostProcessSettings PostProcessing::FitToBudget(const PostProcessSettings& settings, uint32_t width, uint32_t height)
+	{
+		PostProcessSettings fitted = settings;
+		if (settings.BudgetMilliseconds <= 0.0f) return fitted;
+
+		const float maxFetches = settings.BudgetMilliseconds * settings.TexelFetchesPerMillisecond;
+		const auto fits = [&]() { return EstimateTexelFetches(fitted, width, height) <= maxFetches; };
+
+		//Cheapest loss of quality first.
+		while (!fits() && fitted.Bloom && fitted.BloomResolution != PostResolution::Quarter)
+		{
+			fitted.BloomResolution = fitted.BloomResolution == PostResolution::Full ? PostResolution::Half : PostResolution::Quarter;
+		}
+		if (!fits()) fitted.BloomBlur = false;
+		if (!fits()) fitted.FXAA = false;
+		if (!fits()) fitted.Bloom = false;
+
+		return fitted;
+	}
+
+	float PostProcessing::EstimateTexelFetches(const PostProcessSettings& settings, uint32_t width, uint32_t height)
+	{
+		const float pixels = static_cast<float>(width) * static_cast<float>(height);
+
+		float fetches = pixels * (1.0f + (settings.Bloom ? 1.0f : 0.0f) + (settings.ColourGradingLUT != 0 ? 1.0f : 0.0f));
+		if (settings.FXAA)
+		{
+			fetches += pixels * FXAAFetches;
+		}
+
+		if (settings.Bloom)
+		{
+			const std::vector<glm::uvec2> mips = GetBloomMipSizes(settings, width, height);
+			for (size_t mip = 0; mip < mips.size(); mip++)
+			{
+				const float mipPixels = static_cast<float>(mips[mip].x) * static_cast<float>(mips[mip].y);
+				fetches += mipPixels * DownsampleFetches;
+				if (mip + 1 < mips.size())
+				{
+					fetches += mipPixels * UpsampleFetches;
+				}
+			}
+			if (settings.BloomBlur && !mips.empty())
+			{
+				fetches += static_cast<float>(mips.back().x) * static_cast<float>(mips.back().y) * BlurFetches * 2.0f;
+			}
+		}
+
+		return fetches;
+	}
+
+	RenderGraphResource PostProcessing::AddBloomPasses(RenderGraph& graph, RenderGraphResource sceneColour, const PostProcessSettings& settings, uint32_t width, uint32_t height)
+	{
+		const std::vector<glm::uvec2> sizes = GetBloomMipSizes(settings, width, height);
+		if (sizes.empty()) return InvalidRenderGraphResource;
+
+		const auto drawFullscreen = []()
+			{
+				glBindVertexArray(m_Data->FullscreenVertexArray);
+				glDrawArrays(GL_TRIANGLES, 0, 3);
+			};
+
+		std::vector<RenderGraphResource> mips;
+		RenderGraphResource source = sceneColour;
+		for (size_t mip = 0; mip < sizes.size(); mip++)
+		{
+			RenderGraphResource target = InvalidRenderGraphResource;
+			graph.AddPass("BloomDownsample", [&](RenderGraphBuilder& builder)
+				{
+					builder.Read(source);
+					target = builder.Write(builder.Create("BloomMip" + std::to_string(mip), { sizes[mip].x, sizes[mip].y, FramebufferTextureFormat::RGBA16F }));
+				},
+				[source, threshold = mip == 0 ? settings.BloomThreshold : -1.0f, drawFullscreen](const RenderGraph& frameGraph)
+				{
+					Shader& shader = *m_Data->DownsampleShader;
+					shader.Bind();
+					shader.SetFloat2("u_SourceTexelSize", GetTexelSize(frameGraph.GetDescription(source)));
+					shader.SetFloat("u_Threshold", threshold);
+
+					glDisable(GL_DEPTH_TEST);
+					glBindTextureUnit(0, frameGraph.GetTexture(source));
+					drawFullscreen();
+				});
+
+			mips.push_back(target);
+			source = target;
+		}
+
+		if (settings.BloomBlur)
+		{
+			//Horizontal into a scratch target, then vertical back into the smallest mip.
+			const glm::uvec2 size = sizes.back();
+			const RenderGraphResource smallest = mips.back();
+			RenderGraphResource scratch = InvalidRenderGraphResource;
+
+			const auto blur = [drawFullscreen](RenderGraphResource from, const glm::vec2& direction)
+				{
+					return [from, direction, drawFullscreen](const RenderGraph& frameGraph)
+						{
+							Shader& shader = *m_Data->BlurShader;
+							shader.Bind();
+							shader.SetFloat2("u_Direction", direction * GetTexelSize(frameGraph.GetDescription(from)));
+
+							glDisable(GL_DEPTH_TEST);
+							glBindTextureUnit(0, frameGraph.GetTexture(from));
+							drawFullscreen();
+						};
+				};
+
+			graph.AddPass("BloomBlurHorizontal", [&](RenderGraphBuilder& builder)
+				{
+					builder.Read(smallest);
+					scratch = builder.Write(builder.Create("BloomBlur", { size.x, size.y, FramebufferTextureFormat::RGBA16F }));
+				},
+				blur(smallest, { 1.0f, 0.0f }));
+
+			graph.AddPass("BloomBlurVertical", [&](RenderGraphBuilder& builder)
+				{
+					builder.Read(scratch);
+					builder.Write(smallest);
+				},
+				blur(scratch, { 0.0f, 1.0f }));
+		}
+
+		//Each mip gets the tent filtered mip below it added on, carrying the wide glow up to the first mip.
+		for (size_t mip = mips.size() - 1; mip > 0; mip--)
+		{
+			const RenderGraphResource from = mips[mip];
+			const RenderGraphResource to = mips[mip - 1];
+
+			graph.AddPass("BloomUpsample", [&](RenderGraphBuilder& builder)
+				{
+					builder.Read(from);
+					builder.Write(to);
+				},
+				[from, drawFullscreen](const RenderGraph& frameGraph)
+				{
+					Shader& shader = *m_Data->UpsampleShader;
+					shader.Bind();
+					shader.SetFloat2("u_SourceTexelSize", GetTexelSize(frameGraph.GetDescription(from)));
+
+					glDisable(GL_DEPTH_TEST);
+					glEnable(GL_BLEND);
+					glBlendFunc(GL_ONE, GL_ONE);
+					glBindTextureUnit(0, frameGraph.GetTexture(from));
+					drawFullscreen();
+					glDisable(GL_BLEND);
+				});
+		}
+
+		return mips.front();
+	}
+}//namespace Sengine
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+
+#include "RenderGraph.h"
+
+namespace Sengine
+{
+	enum class Tonemapper : uint8_t
+	{
+		None = 0,
+		Reinhard,
+		ACES,
+	};
+
+	//Size of the targets an effect runs at, relative to the view.
+	enum class PostResolution : uint8_t
+	{
+		Full = 1,
+		Half = 2,
+		Quarter = 4,
+	};
+
+	struct PostProcessSettings
+	{
+		float Exposure = 1.0f;
+		Tonemapper Tonemapping = Tonemapper::None;
+
+		//Only colours brighter than the threshold bloom, so untouched LDR content stays as it is.
+		bool Bloom = true;
+		float BloomThreshold = 1.0f;
+		float BloomIntensity = 0.05f;
+		uint32_t BloomMips = 5;
+		PostResolution BloomResolution = PostResolution::Half;
+		//A separable gaussian on the smallest mip widens the glow without extra mips.
+		bool BloomBlur = true;
+
+		bool FXAA = true;
+
+		//A 3D texture created with PostProcessing::CreateColourGradingLUT, zero disables grading.
+		uint32_t ColourGradingLUT = 0;
+
+		//Caps the estimated cost of the stack, counted in texel fetches. Bloom is moved to lower resolutions and loses
+		//its blur, then FXAA and bloom are dropped until it fits. The throughput is that of the target hardware,
+		//a budget of zero disables the cap.
+		float BudgetMilliseconds = 0.0f;
+		float TexelFetchesPerMillisecond = 20000000.0f;
+	};
+
+	//Adds the post stack to the frame graph: bloom, then exposure, tonemapping and grading in one composite pass, then FXAA.
+	class PostProcessing
+	{
+	public:
+		static void Init();
+		static void Destroy();
+
+		static void AddPasses(RenderGraph& graph, RenderGraphResource sceneColour, RenderGraphResource output, const PostProcessSettings& settings);
+
+		//Takes size^3 RGBA8 texels, red varying fastest.
+		[[nodiscard]] static uint32_t CreateColourGradingLUT(const uint8_t* texels, uint32_t size);
+		static void DestroyColourGradingLUT(uint32_t lut);
+
+		//Estimated cost of the last stack added, after fitting it to the budget.
+		[[nodiscard]] static float GetEstimatedMilliseconds() { return m_EstimatedMilliseconds; }
+
+	private:
+		//The settings with the effects scaled down until they fit the budget.
+		[[nodiscard]] static PostProcessSettings FitToBudget(const PostProcessSettings& settings, uint32_t width, uint32_t height);
+		[[nodiscard]] static float EstimateTexelFetches(const PostProcessSettings& settings, uint32_t width, uint32_t height);
+
+		//Returns the first mip of the pyramid, which holds the bloom once every mip has been added back up.
+		[[nodiscard]] static RenderGraphResource AddBloomPasses(RenderGraph& graph, RenderGraphResource sceneColour, const PostProcessSettings& settings, uint32_t width, uint32_t height);
+
+	private:
+		struct PostProcessingData;
+		inline static PostProcessingData* m_Data = nullptr;
+		inline static float m_EstimatedMilliseconds = 0.0f;
+	};
+}//namespace Sengine
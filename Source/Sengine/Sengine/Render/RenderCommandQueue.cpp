@@ -0,0 +1,66 @@
+#include "RenderCommandQueue.h"
+
+#include <array>
+#include <cstring>
+
+namespace Sengine
+{
+	uint64_t RenderCommandQueue::MakeKey(RenderLayer layer, float depth, uint32_t material)
+	{
+		//The bits of a positive float grow with its value, so the top bits are an ordered depth without a known far plane.
+		depth = depth > 0.0f ? depth : 0.0f;
+		uint32_t depthBits = 0;
+		std::memcpy(&depthBits, &depth, sizeof(depthBits));
+		uint64_t quantizedDepth = depthBits >> (32 - DepthBits);
+
+		constexpr uint64_t depthMask = (1ull << DepthBits) - 1;
+		if (layer == RenderLayer::Transparent)
+		{
+			quantizedDepth = depthMask - quantizedDepth;
+		}
+
+		constexpr uint64_t materialMask = (1ull << MaterialBits) - 1;
+		return (static_cast<uint64_t>(layer) << LayerShift)
+			| ((quantizedDepth & depthMask) << DepthShift)
+			| ((static_cast<uint64_t>(material) & materialMask) << MaterialShift);
+	}
+
+	void RenderCommandQueue::Sort()
+	{
+		if (m_Commands.size() < 2) return;
+
+		m_Scratch.resize(m_Commands.size());
+
+		uint64_t sharedBits = ~0ull;
+		const uint64_t firstKey = m_Commands.front().SortKey;
+		for (const RenderCommand& command : m_Commands)
+		{
+			sharedBits &= ~(command.SortKey ^ firstKey);
+		}
+
+		for (uint32_t shift = 0; shift < 64; shift += 8)
+		{
+			if (((sharedBits >> shift) & 0xFF) == 0xFF) continue;
+
+			std::array<uint32_t, 256> offsets = {};
+			for (const RenderCommand& command : m_Commands)
+			{
+				offsets[(command.SortKey >> shift) & 0xFF]++;
+			}
+
+			uint32_t total = 0;
+			for (uint32_t& offset : offsets)
+			{
+				const uint32_t count = offset;
+				offset = total;
+				total += count;
+			}
+
+			for (const RenderCommand& command : m_Commands)
+			{
+				m_Scratch[offsets[(command.SortKey >> shift) & 0xFF]++] = command;
+			}
+			m_Commands.swap(m_Scratch);
+		}
+	}
+}//namespace Sengine
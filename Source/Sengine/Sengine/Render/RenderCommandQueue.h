@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Sengine
+{
+	//A draw reduced to a 64 bit key and the index of its data, so sorting only moves 16 bytes per draw.
+	//
+	//  63   62 61                     38 37              22 21                0
+	//  | layer | depth (24 bits)        | material (16)    | unused          |
+	//
+	//Opaque draws sort front to back so early depth testing rejects hidden fragments, transparent ones back to front.
+	struct RenderCommand
+	{
+		uint64_t SortKey = 0;
+		uint32_t DrawIndex = 0;
+	};
+
+	enum class RenderLayer : uint8_t
+	{
+		Opaque = 0,
+		Transparent = 1,
+	};
+
+	class RenderCommandQueue
+	{
+	public:
+		static constexpr uint32_t LayerShift = 62;
+		static constexpr uint32_t DepthShift = 38;
+		static constexpr uint32_t DepthBits = 24;
+		static constexpr uint32_t MaterialShift = 22;
+		static constexpr uint32_t MaterialBits = 16;
+
+		//Depth is the distance along the view direction. Negative depths, behind the camera, sort first.
+		[[nodiscard]] static uint64_t MakeKey(RenderLayer layer, float depth, uint32_t material);
+
+		void Submit(uint64_t sortKey, uint32_t drawIndex) { m_Commands.push_back({ sortKey, drawIndex }); }
+		//Radix sort on the key bytes, skipping the bytes every key shares.
+		void Sort();
+		void Clear() { m_Commands.clear(); }
+
+		[[nodiscard]] const std::vector<RenderCommand>& GetCommands() const { return m_Commands; }
+		[[nodiscard]] bool GetIsEmpty() const { return m_Commands.empty(); }
+
+	private:
+		std::vector<RenderCommand> m_Commands;
+		std::vector<RenderCommand> m_Scratch;
+	};
+}//namespace Sengine
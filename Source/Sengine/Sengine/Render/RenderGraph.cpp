@@ -0,0 +1,301 @@
+#include "RenderGraph.h"
+
+#include <algorithm>
+
+#include "glad/glad.h"
+
+#include "Utils/Assert.h"
+
+namespace Sengine
+{
+	RenderGraphResource RenderGraphBuilder::Create(const std::string& name, const RenderTargetDescription& description)
+	{
+		RenderGraph::Resource resource;
+		resource.Name = name;
+		resource.Description = description;
+		m_Graph.m_Resources.push_back(std::move(resource));
+
+		return static_cast<RenderGraphResource>(m_Graph.m_Resources.size() - 1);
+	}
+
+	RenderGraphResource RenderGraphBuilder::Read(RenderGraphResource resource)
+	{
+		SE_Assert(resource >= m_Graph.m_Resources.size(), "[Render Graph] Error: Pass reads an invalid resource");
+
+		m_Graph.m_Passes[m_PassIndex].Reads.push_back(resource);
+		return resource;
+	}
+
+	RenderGraphResource RenderGraphBuilder::Write(RenderGraphResource resource)
+	{
+		SE_Assert(resource >= m_Graph.m_Resources.size(), "[Render Graph] Error: Pass writes an invalid resource");
+
+		m_Graph.m_Passes[m_PassIndex].Writes.push_back(resource);
+		return resource;
+	}
+
+	void RenderGraphBuilder::SetHasSideEffects()
+	{
+		m_Graph.m_Passes[m_PassIndex].HasSideEffects = true;
+	}
+
+	RenderGraph::RenderGraph() = default;
+
+	RenderGraph::~RenderGraph()
+	{
+		if (m_Framebuffer != 0)
+		{
+			glDeleteFramebuffers(1, &m_Framebuffer);
+		}
+	}
+
+	RenderGraphResource RenderGraph::ImportTexture(const std::string& name, uint32_t texture, const RenderTargetDescription& description)
+	{
+		Resource resource;
+		resource.Name = name;
+		resource.Description = description;
+		resource.IsImported = true;
+		resource.Texture = texture;
+		m_Resources.push_back(std::move(resource));
+
+		return static_cast<RenderGraphResource>(m_Resources.size() - 1);
+	}
+
+	RenderGraphResource RenderGraph::ImportBackbuffer(uint32_t width, uint32_t height)
+	{
+		const RenderGraphResource backbuffer = ImportTexture("Backbuffer", 0, { width, height, FramebufferTextureFormat::RGBA8 });
+		m_Resources[backbuffer].IsBackbuffer = true;
+		return backbuffer;
+	}
+
+	void RenderGraph::AddPass(const std::string& name, const SetupFunction& setup, ExecuteFunction execute)
+	{
+		Pass pass;
+		pass.Name = name;
+		pass.Execute = std::move(execute);
+		m_Passes.push_back(std::move(pass));
+
+		RenderGraphBuilder builder(*this, static_cast<uint32_t>(m_Passes.size() - 1));
+		setup(builder);
+
+		m_IsCompiled = false;
+	}
+
+	void RenderGraph::Compile()
+	{
+		//Walking back from the last pass, a pass is kept if it has side effects or writes something that is
+		//imported or used by a pass that is kept. Everything it reads or writes is then needed by earlier passes.
+		std::vector<bool> isNeeded(m_Resources.size(), false);
+		for (auto pass = m_Passes.rbegin(); pass != m_Passes.rend(); ++pass)
+		{
+			bool isUsed = pass->HasSideEffects;
+			for (const RenderGraphResource resource : pass->Writes)
+			{
+				isUsed |= m_Resources[resource].IsImported || isNeeded[resource];
+			}
+
+			pass->IsCulled = !isUsed;
+			if (pass->IsCulled) continue;
+
+			for (const RenderGraphResource resource : pass->Reads) isNeeded[resource] = true;
+			for (const RenderGraphResource resource : pass->Writes) isNeeded[resource] = true;
+		}
+
+		for (Resource& resource : m_Resources)
+		{
+			resource.FirstPass = UINT32_MAX;
+			resource.LastPass = 0;
+			resource.PhysicalIndex = UINT32_MAX;
+		}
+
+		m_LastCulledPassCount = 0;
+		for (uint32_t passIndex = 0; passIndex < m_Passes.size(); passIndex++)
+		{
+			const Pass& pass = m_Passes[passIndex];
+			if (pass.IsCulled)
+			{
+				m_LastCulledPassCount++;
+				continue;
+			}
+
+			const auto extendLifetime = [&](RenderGraphResource resource)
+				{
+					Resource& used = m_Resources[resource];
+					used.FirstPass = std::min(used.FirstPass, passIndex);
+					used.LastPass = std::max(used.LastPass, passIndex);
+				};
+			std::for_each(pass.Reads.begin(), pass.Reads.end(), extendLifetime);
+			std::for_each(pass.Writes.begin(), pass.Writes.end(), extendLifetime);
+		}
+
+		//Transient textures are handed out in the order they are first used. One whose lifetime starts after
+		//another has ended takes over its memory when the size and format match.
+		std::vector<uint32_t> transients;
+		for (uint32_t resourceIndex = 0; resourceIndex < m_Resources.size(); resourceIndex++)
+		{
+			const Resource& resource = m_Resources[resourceIndex];
+			if (!resource.IsImported && resource.FirstPass != UINT32_MAX)
+			{
+				transients.push_back(resourceIndex);
+			}
+		}
+		std::stable_sort(transients.begin(), transients.end(), [this](uint32_t a, uint32_t b)
+			{
+				return m_Resources[a].FirstPass < m_Resources[b].FirstPass;
+			});
+
+		m_PhysicalTextures.clear();
+		m_LastTransientMemory = 0;
+		m_LastTransientMemoryWithoutAliasing = 0;
+		for (const uint32_t resourceIndex : transients)
+		{
+			Resource& resource = m_Resources[resourceIndex];
+			m_LastTransientMemoryWithoutAliasing += RenderTargetPool::GetTextureSize(resource.Description);
+
+			for (uint32_t physicalIndex = 0; physicalIndex < m_PhysicalTextures.size(); physicalIndex++)
+			{
+				PhysicalTexture& physical = m_PhysicalTextures[physicalIndex];
+				if (physical.Description == resource.Description && physical.LastPass < resource.FirstPass)
+				{
+					physical.LastPass = resource.LastPass;
+					resource.PhysicalIndex = physicalIndex;
+					break;
+				}
+			}
+
+			if (resource.PhysicalIndex == UINT32_MAX)
+			{
+				resource.PhysicalIndex = static_cast<uint32_t>(m_PhysicalTextures.size());
+				m_PhysicalTextures.push_back({ resource.Description, resource.LastPass, 0 });
+				m_LastTransientMemory += RenderTargetPool::GetTextureSize(resource.Description);
+			}
+		}
+
+		m_LastPassCount = static_cast<uint32_t>(m_Passes.size());
+		m_IsCompiled = true;
+	}
+
+	void RenderGraph::Execute()
+	{
+		if (!m_IsCompiled)
+		{
+			Compile();
+		}
+
+		//Transient textures start with whatever the last user left in them, passes clear what they create.
+		for (PhysicalTexture& physical : m_PhysicalTextures)
+		{
+			physical.Texture = RenderTargetPool::Acquire(physical.Description);
+		}
+		for (Resource& resource : m_Resources)
+		{
+			if (resource.PhysicalIndex != UINT32_MAX)
+			{
+				resource.Texture = m_PhysicalTextures[resource.PhysicalIndex].Texture;
+			}
+		}
+
+		for (const Pass& pass : m_Passes)
+		{
+			if (pass.IsCulled) continue;
+
+			BindTargets(pass);
+			pass.Execute(*this);
+		}
+
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		for (const PhysicalTexture& physical : m_PhysicalTextures)
+		{
+			RenderTargetPool::Release(physical.Texture);
+		}
+
+		Clear();
+	}
+
+	void RenderGraph::Clear()
+	{
+		m_Resources.clear();
+		m_Passes.clear();
+		m_PhysicalTextures.clear();
+		m_IsCompiled = false;
+	}
+
+	uint32_t RenderGraph::GetTexture(RenderGraphResource resource) const
+	{
+		return m_Resources[resource].Texture;
+	}
+
+	const RenderTargetDescription& RenderGraph::GetDescription(RenderGraphResource resource) const
+	{
+		return m_Resources[resource].Description;
+	}
+
+	RenderGraphResource RenderGraph::Find(const std::string& name) const
+	{
+		for (auto resource = m_Resources.rbegin(); resource != m_Resources.rend(); ++resource)
+		{
+			if (resource->Name == name)
+			{
+				return static_cast<RenderGraphResource>(std::distance(resource, m_Resources.rend()) - 1);
+			}
+		}
+
+		return InvalidRenderGraphResource;
+	}
+
+	void RenderGraph::BindTargets(const Pass& pass)
+	{
+		if (pass.Writes.empty()) return;
+
+		const Resource& first = m_Resources[pass.Writes.front()];
+		if (first.IsBackbuffer)
+		{
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			glViewport(0, 0, static_cast<GLsizei>(first.Description.Width), static_cast<GLsizei>(first.Description.Height));
+			return;
+		}
+
+		if (m_Framebuffer == 0)
+		{
+			glCreateFramebuffers(1, &m_Framebuffer);
+		}
+
+		std::vector<GLenum> drawBuffers;
+		uint32_t depthTexture = 0;
+		for (const RenderGraphResource write : pass.Writes)
+		{
+			const Resource& resource = m_Resources[write];
+			if (IsDepthFormat(resource.Description.Format))
+			{
+				depthTexture = resource.Texture;
+				continue;
+			}
+
+			const GLenum attachment = GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(drawBuffers.size());
+			glNamedFramebufferTexture(m_Framebuffer, attachment, resource.Texture, 0);
+			drawBuffers.push_back(attachment);
+		}
+
+		//Attachments left over from the previous pass would otherwise still be rendered to.
+		for (uint32_t index = static_cast<uint32_t>(drawBuffers.size()); index < m_AttachedColourCount; index++)
+		{
+			glNamedFramebufferTexture(m_Framebuffer, GL_COLOR_ATTACHMENT0 + index, 0, 0);
+		}
+		m_AttachedColourCount = static_cast<uint32_t>(drawBuffers.size());
+
+		glNamedFramebufferTexture(m_Framebuffer, GL_DEPTH_STENCIL_ATTACHMENT, depthTexture, 0);
+
+		if (drawBuffers.empty())
+		{
+			glNamedFramebufferDrawBuffer(m_Framebuffer, GL_NONE);
+		}
+		else
+		{
+			glNamedFramebufferDrawBuffers(m_Framebuffer, static_cast<GLsizei>(drawBuffers.size()), drawBuffers.data());
+		}
+
+		glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+		glViewport(0, 0, static_cast<GLsizei>(first.Description.Width), static_cast<GLsizei>(first.Description.Height));
+	}
+}//namespace Sengine
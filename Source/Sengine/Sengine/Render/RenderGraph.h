@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "RenderTargetPool.h"
+
+namespace Sengine
+{
+	//Handle to a texture declared in a render graph. Only valid for the frame it was declared in.
+	using RenderGraphResource = uint32_t;
+	constexpr RenderGraphResource InvalidRenderGraphResource = UINT32_MAX;
+
+	class RenderGraph;
+
+	//Handed to a pass while it is added, to declare the textures it reads and writes.
+	class RenderGraphBuilder
+	{
+	public:
+		//Creates a transient texture. It only lives between the first and last pass using it, and its memory is
+		//shared with other transient textures of the same size and format whose lifetimes do not overlap.
+		RenderGraphResource Create(const std::string& name, const RenderTargetDescription& description);
+
+		//The pass samples the texture.
+		RenderGraphResource Read(RenderGraphResource resource);
+		//The pass renders to the texture. Colour targets are attached in the order they are written.
+		//Writing keeps what earlier passes rendered, so a write also depends on them.
+		RenderGraphResource Write(RenderGraphResource resource);
+
+		//Keeps the pass even when nothing uses what it writes, e.g. a pass that reads back results.
+		void SetHasSideEffects();
+
+	private:
+		friend class RenderGraph;
+		RenderGraphBuilder(RenderGraph& graph, uint32_t passIndex) : m_Graph(graph), m_PassIndex(passIndex) {}
+
+	private:
+		RenderGraph& m_Graph;
+		uint32_t m_PassIndex;
+	};
+
+	//A frame described as passes and the textures they use. Passes run in the order they were added, passes whose
+	//results are never used are culled, and transient textures are aliased once their last user has run.
+	//Passes whose output should survive the frame write to imported textures, which are never culled.
+	class RenderGraph
+	{
+	public:
+		using SetupFunction = std::function<void(RenderGraphBuilder&)>;
+		using ExecuteFunction = std::function<void(const RenderGraph&)>;
+
+		RenderGraph();
+		~RenderGraph();
+
+		RenderGraph(const RenderGraph&) = delete;
+		RenderGraph& operator=(const RenderGraph&) = delete;
+
+		//Makes a texture owned outside of the graph usable by its passes.
+		RenderGraphResource ImportTexture(const std::string& name, uint32_t texture, const RenderTargetDescription& description);
+		//The default framebuffer. Passes writing it render to the window.
+		RenderGraphResource ImportBackbuffer(uint32_t width, uint32_t height);
+
+		void AddPass(const std::string& name, const SetupFunction& setup, ExecuteFunction execute);
+
+		//Culls the unused passes and works out which transient textures share memory.
+		void Compile();
+		//Runs the passes that survived compiling, then clears the graph for the next frame.
+		void Execute();
+		void Clear();
+
+		//Only valid while the graph executes.
+		[[nodiscard]] uint32_t GetTexture(RenderGraphResource resource) const;
+		[[nodiscard]] const RenderTargetDescription& GetDescription(RenderGraphResource resource) const;
+
+		//Finds the most recently declared texture with the name, so separate modules can hook onto each others passes.
+		[[nodiscard]] RenderGraphResource Find(const std::string& name) const;
+
+		//Stats of the last compiled frame.
+		[[nodiscard]] uint32_t GetPassCount() const { return m_LastPassCount; }
+		[[nodiscard]] uint32_t GetCulledPassCount() const { return m_LastCulledPassCount; }
+		[[nodiscard]] uint64_t GetTransientMemoryUsage() const { return m_LastTransientMemory; }
+		[[nodiscard]] uint64_t GetTransientMemoryWithoutAliasing() const { return m_LastTransientMemoryWithoutAliasing; }
+
+	private:
+		friend class RenderGraphBuilder;
+
+		struct Resource
+		{
+			std::string Name;
+			RenderTargetDescription Description;
+
+			bool IsImported = false;
+			bool IsBackbuffer = false;
+			uint32_t Texture = 0; //The imported texture, or the transient one while executing
+
+			//Lifetime in pass indices, set when compiling.
+			uint32_t FirstPass = UINT32_MAX;
+			uint32_t LastPass = 0;
+			uint32_t PhysicalIndex = UINT32_MAX;
+		};
+
+		struct Pass
+		{
+			std::string Name;
+			ExecuteFunction Execute;
+
+			std::vector<RenderGraphResource> Reads;
+			std::vector<RenderGraphResource> Writes;
+			bool HasSideEffects = false;
+			bool IsCulled = false;
+		};
+
+		//Memory shared by the transient textures aliased onto it.
+		struct PhysicalTexture
+		{
+			RenderTargetDescription Description;
+			uint32_t LastPass = 0;
+			uint32_t Texture = 0;
+		};
+
+		void BindTargets(const Pass& pass);
+
+	private:
+		std::vector<Resource> m_Resources;
+		std::vector<Pass> m_Passes;
+		std::vector<PhysicalTexture> m_PhysicalTextures;
+		bool m_IsCompiled = false;
+
+		//Targets are attached to one framebuffer object as each pass runs, rather than one object per pass.
+		uint32_t m_Framebuffer = 0;
+		uint32_t m_AttachedColourCount = 0;
+
+		uint32_t m_LastPassCount = 0;
+		uint32_t m_LastCulledPassCount = 0;
+		uint64_t m_LastTransientMemory = 0;
+		uint64_t m_LastTransientMemoryWithoutAliasing = 0;
+	};
+}//namespace Sengine
@@ -0,0 +1,106 @@
+#include "RenderTargetPool.h"
+
+#include "glad/glad.h"
+
+namespace Sengine
+{
+	namespace
+	{
+		GLenum ToInternalFormat(FramebufferTextureFormat format)
+		{
+			switch (format)
+			{
+			case FramebufferTextureFormat::RGBA8:			return GL_RGBA8;
+			case FramebufferTextureFormat::RGBA16F:			return GL_RGBA16F;
+			case FramebufferTextureFormat::RedInteger:		return GL_R32I;
+			case FramebufferTextureFormat::Depth24Stencil8:	return GL_DEPTH24_STENCIL8;
+			default:										return GL_NONE;
+			}
+		}
+
+		uint64_t GetBytesPerPixel(FramebufferTextureFormat format)
+		{
+			return format == FramebufferTextureFormat::RGBA16F ? 8 : 4;
+		}
+	}
+
+	uint32_t RenderTargetPool::Acquire(const RenderTargetDescription& description)
+	{
+		const auto it = m_FreeTextures.find(description);
+		if (it != m_FreeTextures.end() && !it->second.empty())
+		{
+			const uint32_t texture = it->second.back().Texture;
+			it->second.pop_back();
+			return texture;
+		}
+
+		return CreateTexture(description);
+	}
+
+	void RenderTargetPool::Release(uint32_t texture)
+	{
+		const auto it = m_Descriptions.find(texture);
+		if (it == m_Descriptions.end()) return;
+
+		m_FreeTextures[it->second].push_back({ texture, m_FrameIndex });
+	}
+
+	void RenderTargetPool::EndFrame()
+	{
+		m_FrameIndex++;
+
+		for (auto it = m_FreeTextures.begin(); it != m_FreeTextures.end();)
+		{
+			std::vector<FreeTexture>& textures = it->second;
+
+			//Released in order, so the oldest textures are at the front.
+			std::size_t expired = 0;
+			while (expired < textures.size() && textures[expired].ReleasedFrame + MaxIdleFrames < m_FrameIndex)
+			{
+				glDeleteTextures(1, &textures[expired].Texture);
+				m_MemoryUsage -= GetTextureSize(it->first);
+				m_Descriptions.erase(textures[expired].Texture);
+				expired++;
+			}
+			textures.erase(textures.begin(), textures.begin() + static_cast<std::ptrdiff_t>(expired));
+
+			it = textures.empty() ? m_FreeTextures.erase(it) : std::next(it);
+		}
+	}
+
+	void RenderTargetPool::Destroy()
+	{
+		for (const auto& [texture, description] : m_Descriptions)
+		{
+			glDeleteTextures(1, &texture);
+		}
+
+		m_FreeTextures.clear();
+		m_Descriptions.clear();
+		m_MemoryUsage = 0;
+	}
+
+	uint32_t RenderTargetPool::CreateTexture(const RenderTargetDescription& description)
+	{
+		uint32_t texture = 0;
+		glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+		glTextureStorage2D(texture, 1, ToInternalFormat(description.Format),
+			static_cast<GLsizei>(description.Width), static_cast<GLsizei>(description.Height));
+
+		//Integer textures can not be filtered.
+		const GLint filter = description.Format == FramebufferTextureFormat::RedInteger ? GL_NEAREST : GL_LINEAR;
+		glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, filter);
+		glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, filter);
+		glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		m_Descriptions.emplace(texture, description);
+		m_MemoryUsage += GetTextureSize(description);
+		return texture;
+	}
+
+	uint64_t RenderTargetPool::GetTextureSize(const RenderTargetDescription& description)
+	{
+		return static_cast<uint64_t>(description.Width) * description.Height * GetBytesPerPixel(description.Format);
+	}
+}//namespace Sengine
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Framebuffer.h"
+
+namespace Sengine
+{
+	struct RenderTargetDescription
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		FramebufferTextureFormat Format = FramebufferTextureFormat::None;
+
+		bool operator==(const RenderTargetDescription& other) const
+		{
+			return Width == other.Width && Height == other.Height && Format == other.Format;
+		}
+	};
+
+	//Recycles render target textures by size and format. Released textures stay in the pool for a while,
+	//so framebuffers that are resized back and forth, or recreated every frame, reuse memory instead of reallocating it.
+	class RenderTargetPool
+	{
+	public:
+		//Frames a released texture is kept before it is deleted.
+		static constexpr uint64_t MaxIdleFrames = 120;
+
+		[[nodiscard]] static uint32_t Acquire(const RenderTargetDescription& description);
+		static void Release(uint32_t texture);
+
+		//Ages the free textures and deletes those that have not been reused. Call once at the end of a frame.
+		static void EndFrame();
+		//Deletes every texture, pooled or not. Only valid once nothing holds an acquired texture.
+		static void Destroy();
+
+		[[nodiscard]] static uint32_t GetTextureCount() { return static_cast<uint32_t>(m_Descriptions.size()); }
+		[[nodiscard]] static uint64_t GetMemoryUsage() { return m_MemoryUsage; }
+
+		[[nodiscard]] static uint64_t GetTextureSize(const RenderTargetDescription& description);
+
+	private:
+		struct DescriptionHash
+		{
+			std::size_t operator()(const RenderTargetDescription& description) const
+			{
+				return (static_cast<std::size_t>(description.Width) << 32) ^ (static_cast<std::size_t>(description.Height) << 8) ^ static_cast<std::size_t>(description.Format);
+			}
+		};
+
+		struct FreeTexture
+		{
+			uint32_t Texture = 0;
+			uint64_t ReleasedFrame = 0;
+		};
+
+		[[nodiscard]] static uint32_t CreateTexture(const RenderTargetDescription& description);
+
+	private:
+		inline static std::unordered_map<RenderTargetDescription, std::vector<FreeTexture>, DescriptionHash> m_FreeTextures;
+		inline static std::unordered_map<uint32_t, RenderTargetDescription> m_Descriptions; //Every live texture, acquired or free
+		inline static uint64_t m_FrameIndex = 0;
+		inline static uint64_t m_MemoryUsage = 0;
+	};
+}//namespace Sengine
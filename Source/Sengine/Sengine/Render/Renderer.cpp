@@ -1,33 +1,541 @@
 ﻿#include "Renderer.h"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "glad/glad.h"
+
+#include "Core/Profiler.h"
+
+#include "2D/LightGrid2D.h"
 #include "2D/Renderer2D.h"
+#include "2D/SpriteAnimator.h"
+#include "3D/Mesh.h"
 #include "3D/Renderer3D.h"
+#include "DebugRenderer.h"
+#include "DynamicResolution.h"
+#include "FrameCapture.h"
+#include "GpuTimer.h"
+#include "PostProcessing.h"
+#include "RenderTargetPool.h"
+#include "Texture.h"
 
 namespace Sengine
 {
+	namespace
+	{
+		//Targets of a view are cleared by its first opaque pass. Depth is kept if a prepass already wrote it.
+		void ClearOpaqueTargets(const glm::vec4& clearColour, bool hasEntityID, bool hasDepthPrepass)
+		{
+			glClearBufferfv(GL_COLOR, 0, &clearColour.x);
+			if (hasEntityID)
+			{
+				constexpr int noEntity = -1;
+				glClearBufferiv(GL_COLOR, 1, &noEntity);
+			}
+
+			glEnable(GL_DEPTH_TEST);
+			glDepthMask(GL_TRUE);
+			if (!hasDepthPrepass)
+			{
+				glClear(GL_DEPTH_BUFFER_BIT);
+			}
+
+			//After a prepass only the visible fragment of each pixel passes the test, and depth is already written.
+			glDepthFunc(hasDepthPrepass ? GL_LEQUAL : GL_LESS);
+			glDepthMask(hasDepthPrepass ? GL_FALSE : GL_TRUE);
+		}
+
+		//Debug primitives go over the finished scene of each view, before post processing so they share its depth.
+		void AddDebugPass(RenderGraph& graph, RenderGraphResource sceneColour, RenderGraphResource sceneDepth, const glm::mat4& viewProjection)
+		{
+			graph.AddPass("Debug", [&](RenderGraphBuilder& builder)
+				{
+					builder.Write(sceneColour);
+					builder.Write(sceneDepth);
+				},
+				[viewProjection](const RenderGraph&)
+				{
+					glEnable(GL_DEPTH_TEST);
+					glDepthFunc(GL_LEQUAL);
+					glDepthMask(GL_FALSE);
+					glEnable(GL_BLEND);
+					glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+					DebugRenderer::Draw(viewProjection);
+
+					glDisable(GL_BLEND);
+				});
+		}
+
+		struct QuadDraw
+		{
+			glm::mat4 Transform;
+			glm::vec4 Colour;
+			int EntityID;
+			//Untextured if null. The texture has to live until the frame has ended.
+			const Texture2D* QuadTexture = nullptr;
+			glm::vec4 Region = { 0.0f, 0.0f, 1.0f, 1.0f };
+			const Texture2D* NormalMap = nullptr;
+		};
+
+		//The draws of one view. Shared by its passes, which run after the view has been submitted.
+		struct ViewDrawList
+		{
+			Camera2D Camera;
+			RenderView View;
+
+			std::vector<QuadDraw> OpaqueQuads;
+			std::vector<QuadDraw> TransparentQuads;
+
+			std::vector<Renderer2D::PointLight2D> Lights;
+			Renderer2D::LightGrid2D LightGrid;
+		};
+
+		struct MeshDrawList
+		{
+			RenderView View;
+			Renderer3D::DrawList Draws;
+		};
+
+		void DrawQuads(const std::vector<QuadDraw>& quads, const glm::mat4& viewProjection)
+		{
+			Renderer2D::Renderer2D::BeginRender(viewProjection);
+			for (const QuadDraw& quad : quads)
+			{
+				if (quad.NormalMap)
+				{
+					Renderer2D::Renderer2D::DrawQuad(quad.Transform, *quad.QuadTexture, *quad.NormalMap, quad.Region, quad.Colour, quad.EntityID);
+				}
+				else if (quad.QuadTexture)
+				{
+					Renderer2D::Renderer2D::DrawQuad(quad.Transform, *quad.QuadTexture, quad.Region, quad.Colour, quad.EntityID);
+				}
+				else
+				{
+					Renderer2D::Renderer2D::DrawQuad(quad.Transform, quad.Colour, quad.EntityID);
+				}
+			}
+			Renderer2D::Renderer2D::EndRender();
+		}
+	}
+
+	struct Renderer::RendererData
+	{
+		RenderGraph FrameGraph;
+		RenderGraphResource Backbuffer = InvalidRenderGraphResource;
+		RendererSettings Settings;
+
+		std::unique_ptr<GpuTimer> FrameTimer;
+		DynamicResolution Resolution;
+		float GpuFrameMilliseconds = 0.0f;
+
+		std::shared_ptr<ViewDrawList> CurrentView;
+		std::shared_ptr<MeshDrawList> CurrentMeshView;
+
+		//A capture requested during a frame starts with the next one.
+		std::filesystem::path PendingCapturePath;
+		std::filesystem::path CapturePath;
+		std::unique_ptr<FrameRecorder> Recorder;
+	};
+
+	void Renderer::Init()
+	{
+		m_Data = new RendererData();
+
+		Renderer2D::Renderer2D::Init();
+		Renderer3D::Renderer3D::Init();
+		PostProcessing::Init();
+		DebugRenderer::Init();
+
+		m_Data->FrameTimer = std::make_unique<GpuTimer>();
+	}
+
+	void Renderer::Destroy()
+	{
+		Renderer2D::Renderer2D::Destroy();
+		Renderer3D::Renderer3D::Destroy();
+		PostProcessing::Destroy();
+		DebugRenderer::Destroy();
+
+		//The frame graph owns a framebuffer object, so it goes before the pool while the context is still alive.
+		delete m_Data;
+		m_Data = nullptr;
+
+		RenderTargetPool::Destroy();
+	}
+
+	void Renderer::BeginFrame(uint32_t width, uint32_t height)
+	{
+		m_Data->FrameGraph.Clear();
+		m_Data->Backbuffer = m_Data->FrameGraph.ImportBackbuffer(width, height);
+
+		if (!m_Data->PendingCapturePath.empty())
+		{
+			m_Data->CapturePath = std::move(m_Data->PendingCapturePath);
+			m_Data->PendingCapturePath.clear();
+			m_Data->Recorder = std::make_unique<FrameRecorder>(width, height);
+		}
+	}
+
+	void Renderer::EndFrame()
+	{
+		SE_PROFILE_FUNCTION();
+
+		m_Data->FrameGraph.Compile();
+
+		m_Data->FrameTimer->Begin();
+		m_Data->FrameGraph.Execute();
+		m_Data->FrameTimer->End();
+
+		//Timings arrive a few frames late, the scale they pick applies from the next frame on.
+		float milliseconds = 0.0f;
+		while (m_Data->FrameTimer->PollResult(milliseconds))
+		{
+			m_Data->GpuFrameMilliseconds = milliseconds;
+			m_Data->Resolution.Update(milliseconds, m_Data->Settings.DynamicResolution);
+		}
+
+		if (m_Data->Recorder)
+		{
+			CapturedFrame& frame = m_Data->Recorder->GetFrame();
+			frame.Settings = m_Data->Settings;
+			frame.Settings.PostProcess.ColourGradingLUT = 0;
+			(void)frame.Save(m_Data->CapturePath);
+
+			m_Data->Recorder = nullptr;
+		}
+
+		DebugRenderer::EndFrame();
+		RenderTargetPool::EndFrame();
+	}
+
+	RenderGraph& Renderer::GetFrameGraph()
+	{
+		return m_Data->FrameGraph;
+	}
+
+	RenderGraphResource Renderer::GetBackbuffer()
+	{
+		return m_Data->Backbuffer;
+	}
+
+	RendererSettings& Renderer::GetSettings()
+	{
+		return m_Data->Settings;
+	}
 
-	void Renderer::BeginRender2D(const Camera2D& camera)
+	float Renderer::GetRenderScale()
 	{
-		Renderer2D::Renderer2D::BeginRender();
+		return m_Data->Resolution.GetScale();
+	}
+
+	float Renderer::GetGpuFrameMilliseconds()
+	{
+		return m_Data->GpuFrameMilliseconds;
+	}
+
+	void Renderer::CaptureFrame(const std::filesystem::path& path)
+	{
+		m_Data->PendingCapturePath = path;
+	}
+
+	void Renderer::BeginRender2D(const Camera2D& camera, const RenderView& view)
+	{
+		m_Data->CurrentView = std::make_shared<ViewDrawList>();
+		m_Data->CurrentView->Camera = camera;
+		m_Data->CurrentView->View = view;
 	}
 
 	void Renderer::EndRender2D()
 	{
-		Renderer2D::Renderer2D::EndRender();
+		const std::shared_ptr<ViewDrawList> drawList = std::move(m_Data->CurrentView);
+		RenderView& view = drawList->View;
+		RenderGraph& graph = m_Data->FrameGraph;
+		const RendererSettings& settings = m_Data->Settings;
+
+		RenderGraphResource output = InvalidRenderGraphResource;
+		RenderGraphResource entityID = InvalidRenderGraphResource;
+		glm::uvec2 sceneSize = { 0, 0 };
+		if (!ImportView(view, output, entityID, sceneSize)) return;
+
+		if (m_Data->Recorder)
+		{
+			CapturedView captured;
+			captured.ViewProjection = drawList->Camera.ViewProjection;
+			captured.Target = view;
+			captured.Lights = drawList->Lights;
+			for (const std::vector<QuadDraw>* quads : { &drawList->OpaqueQuads, &drawList->TransparentQuads })
+			{
+				for (const QuadDraw& quad : *quads)
+				{
+					captured.Quads.push_back({ quad.Transform, quad.Colour, quad.EntityID, m_Data->Recorder->AddTexture(quad.QuadTexture),
+						m_Data->Recorder->AddTexture(quad.NormalMap), quad.Region });
+				}
+			}
+			m_Data->Recorder->AddView(std::move(captured));
+		}
+
+		//Transparent quads are blended back to front, the camera looks down negative z.
+		std::stable_sort(drawList->TransparentQuads.begin(), drawList->TransparentQuads.end(), [](const QuadDraw& a, const QuadDraw& b)
+			{
+				return a.Transform[3].z < b.Transform[3].z;
+			});
+
+		//Lights are binned once per view, on the CPU, for the size the scene is rendered at.
+		drawList->LightGrid.Build(drawList->Lights, drawList->Camera.ViewProjection, sceneSize.x, sceneSize.y);
+
+		RenderGraphResource sceneDepth = InvalidRenderGraphResource;
+		const bool hasDepthPrepass = settings.DepthPrepass && !drawList->OpaqueQuads.empty();
+		if (hasDepthPrepass)
+		{
+			graph.AddPass("DepthPrepass", [&](RenderGraphBuilder& builder)
+				{
+					sceneDepth = builder.Write(builder.Create("SceneDepth", { sceneSize.x, sceneSize.y, FramebufferTextureFormat::Depth24Stencil8 }));
+				},
+				[drawList](const RenderGraph&)
+				{
+					glEnable(GL_DEPTH_TEST);
+					glDepthFunc(GL_LESS);
+					glDepthMask(GL_TRUE);
+					glClear(GL_DEPTH_BUFFER_BIT);
+
+					DrawQuads(drawList->OpaqueQuads, drawList->Camera.ViewProjection);
+				});
+		}
+
+		RenderGraphResource sceneColour = InvalidRenderGraphResource;
+		graph.AddPass("Opaque", [&](RenderGraphBuilder& builder)
+			{
+				sceneColour = builder.Write(builder.Create("SceneColour", { sceneSize.x, sceneSize.y, FramebufferTextureFormat::RGBA16F }));
+				if (entityID != InvalidRenderGraphResource) builder.Write(entityID);
+				if (sceneDepth == InvalidRenderGraphResource)
+				{
+					sceneDepth = builder.Create("SceneDepth", { sceneSize.x, sceneSize.y, FramebufferTextureFormat::Depth24Stencil8 });
+				}
+				builder.Write(sceneDepth);
+			},
+			[drawList, hasDepthPrepass, hasEntityID = entityID != InvalidRenderGraphResource](const RenderGraph&)
+			{
+				ClearOpaqueTargets(drawList->View.ClearColour, hasEntityID, hasDepthPrepass);
+
+				Renderer2D::Renderer2D::SetLightGrid(&drawList->LightGrid, drawList->View.AmbientLight);
+				DrawQuads(drawList->OpaqueQuads, drawList->Camera.ViewProjection);
+				Renderer2D::Renderer2D::SetLightGrid(nullptr);
+			});
+
+		if (!drawList->TransparentQuads.empty())
+		{
+			graph.AddPass("Transparent", [&](RenderGraphBuilder& builder)
+				{
+					builder.Write(sceneColour);
+					if (entityID != InvalidRenderGraphResource) builder.Write(entityID);
+					builder.Write(sceneDepth);
+				},
+				[drawList](const RenderGraph&)
+				{
+					glEnable(GL_DEPTH_TEST);
+					glDepthFunc(GL_LEQUAL);
+					glDepthMask(GL_FALSE);
+					glEnable(GL_BLEND);
+					glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+					Renderer2D::Renderer2D::SetLightGrid(&drawList->LightGrid, drawList->View.AmbientLight);
+					DrawQuads(drawList->TransparentQuads, drawList->Camera.ViewProjection);
+					Renderer2D::Renderer2D::SetLightGrid(nullptr);
+
+					glDisable(GL_BLEND);
+				});
+		}
+
+		AddDebugPass(graph, sceneColour, sceneDepth, drawList->Camera.ViewProjection);
+		PostProcessing::AddPasses(graph, sceneColour, output, m_Data->Settings.PostProcess);
+	}
+
+	void Renderer::Draw2D(const glm::mat4& transform, const glm::vec4& colour, int entityID)
+	{
+		if (colour.a < 1.0f)
+		{
+			m_Data->CurrentView->TransparentQuads.push_back({ transform, colour, entityID });
+		}
+		else
+		{
+			m_Data->CurrentView->OpaqueQuads.push_back({ transform, colour, entityID });
+		}
+	}
+
+	void Renderer::Draw2D(const glm::mat4& transform, const Texture2D& texture, const glm::vec4& region, const glm::vec4& colour, int entityID)
+	{
+		//The opaque pass only discards texels without alpha, partly transparent ones have to be blended.
+		if (colour.a < 1.0f || !texture.GetIsOpaque())
+		{
+			m_Data->CurrentView->TransparentQuads.push_back({ transform, colour, entityID, &texture, region });
+		}
+		else
+		{
+			m_Data->CurrentView->OpaqueQuads.push_back({ transform, colour, entityID, &texture, region });
+		}
+	}
+
+	void Renderer::Draw2D(const glm::mat4& transform, const Texture2D& texture, const Texture2D& normalMap, const glm::vec4& region, const glm::vec4& colour, int entityID)
+	{
+		if (colour.a < 1.0f || !texture.GetIsOpaque())
+		{
+			m_Data->CurrentView->TransparentQuads.push_back({ transform, colour, entityID, &texture, region, &normalMap });
+		}
+		else
+		{
+			m_Data->CurrentView->OpaqueQuads.push_back({ transform, colour, entityID, &texture, region, &normalMap });
+		}
 	}
 
-	void Renderer::Draw2D()
+	void Renderer::DrawLight2D(const Renderer2D::PointLight2D& light)
 	{
-		Renderer2D::Renderer2D::DrawQuad();
+		m_Data->CurrentView->Lights.push_back(light);
+	}
+
+	void Renderer::Draw2D(const glm::mat4& transform, const Renderer2D::SpriteAnimator& animator, Renderer2D::AnimatorHandle animation, const glm::vec4& colour, int entityID)
+	{
+		Draw2D(transform, *animator.GetAtlas().AtlasTexture, animator.GetRegion(animation), colour, entityID);
 	}
 	 
-	void Renderer::BeginRender3D(const Camera3D& camera)
+	void Renderer::BeginRender3D(const Camera3D& camera, const RenderView& view)
 	{
-		
+		m_Data->CurrentMeshView = std::make_shared<MeshDrawList>();
+		m_Data->CurrentMeshView->View = view;
+		m_Data->CurrentMeshView->Draws.View = camera.View;
+		m_Data->CurrentMeshView->Draws.Projection = camera.Projection;
 	}
 
-	void Renderer::EndRenderer()
+	void Renderer::EndRender3D()
 	{
+		const std::shared_ptr<MeshDrawList> drawList = std::move(m_Data->CurrentMeshView);
+		RenderView& view = drawList->View;
+		RenderGraph& graph = m_Data->FrameGraph;
+
+		RenderGraphResource output = InvalidRenderGraphResource;
+		RenderGraphResource entityID = InvalidRenderGraphResource;
+		glm::uvec2 sceneSize = { 0, 0 };
+		if (!ImportView(view, output, entityID, sceneSize)) return;
+
+		if (m_Data->Recorder)
+		{
+			CapturedView captured;
+			captured.Is3D = true;
+			captured.View = drawList->Draws.View;
+			captured.Projection = drawList->Draws.Projection;
+			captured.Target = view;
+			for (const Renderer3D::MeshDraw& draw : drawList->Draws.Draws)
+			{
+				captured.Meshes.push_back({ m_Data->Recorder->AddMesh(*draw.DrawMesh), draw.Transform, draw.Colour, draw.EntityID });
+			}
+			m_Data->Recorder->AddView(std::move(captured));
+		}
+
+		Renderer3D::Renderer3D::Sort(drawList->Draws);
+
+		RenderGraphResource sceneDepth = InvalidRenderGraphResource;
+		const bool hasDepthPrepass = m_Data->Settings.DepthPrepass && (!drawList->Draws.Commands.GetIsEmpty() || !drawList->Draws.Terrains.empty());
+		if (hasDepthPrepass)
+		{
+			graph.AddPass("DepthPrepass", [&](RenderGraphBuilder& builder)
+				{
+					sceneDepth = builder.Write(builder.Create("SceneDepth", { sceneSize.x, sceneSize.y, FramebufferTextureFormat::Depth24Stencil8 }));
+				},
+				[drawList](const RenderGraph&)
+				{
+					glEnable(GL_DEPTH_TEST);
+					glDepthFunc(GL_LESS);
+					glDepthMask(GL_TRUE);
+					glClear(GL_DEPTH_BUFFER_BIT);
+
+					Renderer3D::Renderer3D::DrawDepth(drawList->Draws);
+				});
+		}
+
+		RenderGraphResource sceneColour = InvalidRenderGraphResource;
+		graph.AddPass("Opaque", [&](RenderGraphBuilder& builder)
+			{
+				sceneColour = builder.Write(builder.Create("SceneColour", { sceneSize.x, sceneSize.y, FramebufferTextureFormat::RGBA16F }));
+				if (entityID != InvalidRenderGraphResource) builder.Write(entityID);
+				if (sceneDepth == InvalidRenderGraphResource)
+				{
+					sceneDepth = builder.Create("SceneDepth", { sceneSize.x, sceneSize.y, FramebufferTextureFormat::Depth24Stencil8 });
+				}
+				builder.Write(sceneDepth);
+			},
+			[drawList, hasDepthPrepass, hasEntityID = entityID != InvalidRenderGraphResource](const RenderGraph&)
+			{
+				ClearOpaqueTargets(drawList->View.ClearColour, hasEntityID, hasDepthPrepass);
+				glEnable(GL_CULL_FACE);
+
+				Renderer3D::Renderer3D::DrawOpaque(drawList->Draws);
+
+				glDisable(GL_CULL_FACE);
+			});
+
+		AddDebugPass(graph, sceneColour, sceneDepth, drawList->Draws.Projection * drawList->Draws.View);
+		PostProcessing::AddPasses(graph, sceneColour, output, m_Data->Settings.PostProcess);
+	}
+
+	void Renderer::Draw3D(const Renderer3D::Mesh& mesh, const glm::mat4& transform, const glm::vec4& colour, int entityID)
+	{
+		Renderer3D::Renderer3D::Submit(m_Data->CurrentMeshView->Draws, mesh, transform, colour, entityID);
+	}
+
+	void Renderer::DrawTerrain(Renderer3D::Terrain& terrain, int entityID)
+	{
+		Renderer3D::Renderer3D::SubmitTerrain(m_Data->CurrentMeshView->Draws, terrain, entityID);
+	}
+
+	void Renderer::DrawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec4& colour, float duration)
+	{
+		DebugRenderer::DrawLine(from, to, colour, duration);
+	}
+
+	void Renderer::DrawCircle(const glm::vec3& centre, float radius, const glm::vec3& normal, const glm::vec4& colour, float duration)
+	{
+		DebugRenderer::DrawCircle(centre, radius, normal, colour, duration);
+	}
+
+	void Renderer::DrawAABB(const glm::vec3& min, const glm::vec3& max, const glm::vec4& colour, float duration)
+	{
+		DebugRenderer::DrawAABB(min, max, colour, duration);
+	}
+
+	void Renderer::DrawText3D(const glm::vec3& position, const std::string& text, const glm::vec4& colour, float size, float duration)
+	{
+		DebugRenderer::DrawText3D(position, text, colour, size, duration);
+	}
+
+	bool Renderer::ImportView(RenderView& view, RenderGraphResource& output, RenderGraphResource& entityID, glm::uvec2& sceneSize)
+	{
+		RenderGraph& graph = m_Data->FrameGraph;
+
+		output = m_Data->Backbuffer;
+		if (view.ColourTexture != 0)
+		{
+			output = graph.ImportTexture("ViewColour", view.ColourTexture, { view.Width, view.Height, FramebufferTextureFormat::RGBA8 });
+		}
+		else
+		{
+			view.Width = graph.GetDescription(output).Width;
+			view.Height = graph.GetDescription(output).Height;
+		}
+		if (view.Width == 0 || view.Height == 0) return false;
+
+		entityID = InvalidRenderGraphResource;
+		if (view.EntityIDTexture != 0)
+		{
+			entityID = graph.ImportTexture("EntityID", view.EntityIDTexture, { view.Width, view.Height, FramebufferTextureFormat::RedInteger });
+		}
+
+		//The scene renders at the dynamic resolution and is upscaled by the composite pass, the output keeps the view size.
+		const float scale = m_Data->Resolution.GetScale();
+		sceneSize.x = std::max(static_cast<uint32_t>(static_cast<float>(view.Width) * scale), 1u);
+		sceneSize.y = std::max(static_cast<uint32_t>(static_cast<float>(view.Height) * scale), 1u);
 
+		return true;
 	}
 }
@@ -1,30 +1,139 @@
 ﻿#pragma once
 
+#include <filesystem>
+#include <string>
+
+#include "glm/glm.hpp"
+
+#include "DynamicResolution.h"
+#include "PostProcessing.h"
+#include "RenderGraph.h"
+
+namespace Sengine
+{
+	class Texture2D;
+}
+
+namespace Sengine::Renderer2D
+{
+	class SpriteAnimator;
+	using AnimatorHandle = uint32_t;
+	struct PointLight2D;
+}
+
+namespace Sengine::Renderer3D
+{
+	class Mesh;
+	class Terrain;
+}
+
 namespace Sengine
 {
 	struct Camera2D
 	{
-		
+		glm::mat4 ViewProjection = glm::mat4(1.0f);
 	};
 
 	struct Camera3D
 	{
-		
+		glm::mat4 View = glm::mat4(1.0f);
+		glm::mat4 Projection = glm::mat4(1.0f);
+	};
+
+	//Where a scene is rendered to. A colour texture of zero renders to the window.
+	//The textures are owned by the caller, the renderer imports them into the frame graph.
+	struct RenderView
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		uint32_t ColourTexture = 0;
+		//Optional RedInteger target used for picking. With dynamic resolution the IDs only fill
+		//the bottom left Width x Height times the render scale of it.
+		uint32_t EntityIDTexture = 0;
+
+		glm::vec4 ClearColour = { 0.1f, 0.1f, 0.1f, 1.0f };
+		//Light every 2D sprite gets once the view has any 2D lights. Views without lights are drawn unlit.
+		glm::vec3 AmbientLight = { 0.1f, 0.1f, 0.1f };
+	};
+
+	struct RendererSettings
+	{
+		//Lays down depth with a position only pass first, so the opaque pass shades each pixel once.
+		//Worth it when fragment shading dominates, e.g. overdraw heavy interiors.
+		bool DepthPrepass = false;
+
+		PostProcessSettings PostProcess;
+		DynamicResolutionSettings DynamicResolution;
 	};
 
 	class Renderer
 	{
 	public:
+		static void Init();
+		static void Destroy();
+
+		//Starts recording the frame graph. Called by the application before the client ticks.
+		static void BeginFrame(uint32_t width, uint32_t height);
+		//Executes the frame graph. Called by the application once the frame has been submitted.
+		static void EndFrame();
+
+		//Passes added here run in order when the frame ends.
+		[[nodiscard]] static RenderGraph& GetFrameGraph();
+		[[nodiscard]] static RenderGraphResource GetBackbuffer();
+		[[nodiscard]] static RendererSettings& GetSettings();
+
+		//Scale of the scene render targets this frame, picked by dynamic resolution.
+		[[nodiscard]] static float GetRenderScale();
+		[[nodiscard]] static float GetGpuFrameMilliseconds();
+
+		//Records everything submitted during the next frame, with the textures and meshes it draws, into a file
+		//FrameReplay can submit again on its own. Reading the resources back stalls that frame.
+		static void CaptureFrame(const std::filesystem::path& path);
+
 		//2D Renderer
 
-		static void BeginRender2D(const Camera2D& camera);
+		static void BeginRender2D(const Camera2D& camera, const RenderView& view = RenderView());
+		//Adds the depth prepass, opaque, transparent and post processing passes of the view to the frame graph.
 		static void EndRender2D();
 
-		static void Draw2D();
+		static void Draw2D(const glm::mat4& transform = glm::mat4(1.0f), const glm::vec4& colour = glm::vec4(1.0f), int entityID = -1);
+		//Region is the minimum and maximum texture coordinates. Texels without alpha are cut out. Sprites are blended when
+		//the colour's alpha is below one or the texture is not opaque. The texture has to live until the frame has ended.
+		static void Draw2D(const glm::mat4& transform, const Texture2D& texture, const glm::vec4& region, const glm::vec4& colour = glm::vec4(1.0f), int entityID = -1);
+		//Sprites are lit by the 2D lights of the view, with the normal map's x and y following the sprite's axes.
+		static void Draw2D(const glm::mat4& transform, const Texture2D& texture, const Texture2D& normalMap, const glm::vec4& region, const glm::vec4& colour = glm::vec4(1.0f), int entityID = -1);
+		//Draws the current frame of an animation. Advance the animator before submitting its sprites.
+		static void Draw2D(const glm::mat4& transform, const Renderer2D::SpriteAnimator& animator, Renderer2D::AnimatorHandle animation, const glm::vec4& colour = glm::vec4(1.0f), int entityID = -1);
+
+		//Lights are binned into screen tiles when the view ends, so every sprite is shaded by all of them in one pass.
+		static void DrawLight2D(const Renderer2D::PointLight2D& light);
 
 		//3D Renderer
 
-		static void BeginRender3D(const Camera3D& camera);
-		static void EndRenderer();
+		static void BeginRender3D(const Camera3D& camera, const RenderView& view = RenderView());
+		//Adds the depth prepass, opaque and post processing passes of the view to the frame graph. Opaque draws run front to back.
+		static void EndRender3D();
+
+		static void Draw3D(const Renderer3D::Mesh& mesh, const glm::mat4& transform = glm::mat4(1.0f), const glm::vec4& colour = glm::vec4(1.0f), int entityID = -1);
+		//The terrain selects its nodes for the current camera here, call Terrain::Update once per frame before.
+		static void DrawTerrain(Renderer3D::Terrain& terrain, int entityID = -1);
+
+		//Debug
+
+		//Drawn over every view of the frame, depth tested against the scene. A duration of zero lasts this frame only,
+		//longer ones stay for that many seconds whether or not they are submitted again.
+		static void DrawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec4& colour = glm::vec4(1.0f), float duration = 0.0f);
+		static void DrawCircle(const glm::vec3& centre, float radius, const glm::vec3& normal = { 0.0f, 0.0f, 1.0f }, const glm::vec4& colour = glm::vec4(1.0f), float duration = 0.0f);
+		static void DrawAABB(const glm::vec3& min, const glm::vec3& max, const glm::vec4& colour = glm::vec4(1.0f), float duration = 0.0f);
+		//Text faces the camera, centred on the position, and is size world units tall.
+		static void DrawText3D(const glm::vec3& position, const std::string& text, const glm::vec4& colour = glm::vec4(1.0f), float size = 1.0f, float duration = 0.0f);
+
+	private:
+		//Imports the targets of the view into the frame graph. Returns false if there is nothing to render to.
+		[[nodiscard]] static bool ImportView(RenderView& view, RenderGraphResource& output, RenderGraphResource& entityID, glm::uvec2& sceneSize);
+
+	private:
+		struct RendererData;
+		inline static RendererData* m_Data = nullptr;
 	};
 }
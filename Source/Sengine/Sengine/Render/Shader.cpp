@@ -0,0 +1,131 @@
+#include "Shader.h"
+
+#include <iostream>
+#include <vector>
+
+#include "glad/glad.h"
+#include "glm/gtc/type_ptr.hpp"
+
+namespace Sengine
+{
+	namespace
+	{
+		uint32_t CompileStage(GLenum stage, const std::string& source)
+		{
+			const uint32_t shader = glCreateShader(stage);
+			const char* sourceString = source.c_str();
+			glShaderSource(shader, 1, &sourceString, nullptr);
+			glCompileShader(shader);
+
+			int isCompiled = 0;
+			glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
+			if (!isCompiled)
+			{
+				int length = 0;
+				glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+				std::vector<char> log(static_cast<size_t>(length) + 1);
+				glGetShaderInfoLog(shader, length, &length, log.data());
+				std::cout << "[Shader] Error: Failed to compile stage\n" << log.data() << "\n";
+
+				glDeleteShader(shader);
+				return 0;
+			}
+
+			return shader;
+		}
+
+		uint32_t LinkProgram(const std::vector<uint32_t>& stages)
+		{
+			for (const uint32_t stage : stages)
+			{
+				if (stage == 0)
+				{
+					for (const uint32_t other : stages) glDeleteShader(other);
+					return 0;
+				}
+			}
+
+			const uint32_t program = glCreateProgram();
+			for (const uint32_t stage : stages) glAttachShader(program, stage);
+			glLinkProgram(program);
+
+			for (const uint32_t stage : stages)
+			{
+				glDetachShader(program, stage);
+				glDeleteShader(stage);
+			}
+
+			int isLinked = 0;
+			glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+			if (!isLinked)
+			{
+				int length = 0;
+				glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+				std::vector<char> log(static_cast<size_t>(length) + 1);
+				glGetProgramInfoLog(program, length, &length, log.data());
+				std::cout << "[Shader] Error: Failed to link program\n" << log.data() << "\n";
+
+				glDeleteProgram(program);
+				return 0;
+			}
+
+			return program;
+		}
+	}
+
+	Shader::Shader(const std::string& vertexSource, const std::string& fragmentSource)
+	{
+		m_RendererID = LinkProgram({ CompileStage(GL_VERTEX_SHADER, vertexSource), CompileStage(GL_FRAGMENT_SHADER, fragmentSource) });
+	}
+
+	Shader::~Shader()
+	{
+		glDeleteProgram(m_RendererID);
+	}
+
+	void Shader::Bind() const
+	{
+		glUseProgram(m_RendererID);
+	}
+
+	void Shader::SetInt(const std::string& name, int value)
+	{
+		glProgramUniform1i(m_RendererID, GetUniformLocation(name), value);
+	}
+
+	void Shader::SetFloat(const std::string& name, float value)
+	{
+		glProgramUniform1f(m_RendererID, GetUniformLocation(name), value);
+	}
+
+	void Shader::SetFloat2(const std::string& name, const glm::vec2& value)
+	{
+		glProgramUniform2f(m_RendererID, GetUniformLocation(name), value.x, value.y);
+	}
+
+	void Shader::SetFloat3(const std::string& name, const glm::vec3& value)
+	{
+		glProgramUniform3f(m_RendererID, GetUniformLocation(name), value.x, value.y, value.z);
+	}
+
+	void Shader::SetFloat4(const std::string& name, const glm::vec4& value)
+	{
+		glProgramUniform4f(m_RendererID, GetUniformLocation(name), value.x, value.y, value.z, value.w);
+	}
+
+	void Shader::SetMat4(const std::string& name, const glm::mat4& value)
+	{
+		glProgramUniformMatrix4fv(m_RendererID, GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));
+	}
+
+	int Shader::GetUniformLocation(const std::string& name)
+	{
+		//Looking a uniform up by name is a driver round trip, so they are cached per program.
+		const auto it = m_UniformLocations.find(name);
+		if (it != m_UniformLocations.end()) return it->second;
+
+		const int location = glGetUniformLocation(m_RendererID, name.c_str());
+		m_UniformLocations.emplace(name, location);
+		return location;
+	}
+}//namespace Sengine
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "glm/glm.hpp"
+
+namespace Sengine
+{
+	//A linked vertex/fragment program. Non-copyable as it owns the OpenGL handle.
+	class Shader
+	{
+	public:
+		Shader(const std::string& vertexSource, const std::string& fragmentSource);
+		~Shader();
+
+		Shader(const Shader&) = delete;
+		Shader& operator=(const Shader&) = delete;
+
+		void Bind() const;
+
+		void SetInt(const std::string& name, int value);
+		void SetFloat(const std::string& name, float value);
+		void SetFloat2(const std::string& name, const glm::vec2& value);
+		void SetFloat3(const std::string& name, const glm::vec3& value);
+		void SetFloat4(const std::string& name, const glm::vec4& value);
+		void SetMat4(const std::string& name, const glm::mat4& value);
+
+		[[nodiscard]] bool GetIsValid() const { return m_RendererID != 0; }
+		[[nodiscard]] uint32_t GetRendererID() const { return m_RendererID; }
+
+	private:
+		[[nodiscard]] int GetUniformLocation(const std::string& name);
+
+	private:
+		uint32_t m_RendererID = 0;
+		std::unordered_map<std::string, int> m_UniformLocations;
+	};
+}//namespace Sengine
@@ -0,0 +1,57 @@
+#include "Texture.h"
+
+#include "glad/glad.h"
+
+namespace Sengine
+{
+	Texture2D::Texture2D(uint32_t width, uint32_t height, const void* data)
+		: m_Width(width), m_Height(height)
+	{
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
+		glTextureStorage2D(m_RendererID, 1, GL_RGBA8, static_cast<GLsizei>(width), static_cast<GLsizei>(height));
+
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		if (data)
+		{
+			m_IsOpaque = true;
+			SetData(0, 0, width, height, data);
+		}
+	}
+
+	Texture2D::~Texture2D()
+	{
+		glDeleteTextures(1, &m_RendererID);
+	}
+
+	void Texture2D::SetData(uint32_t x, uint32_t y, uint32_t width, uint32_t height, const void* data)
+	{
+		//Partial alpha anywhere keeps the texture blended from then on, even if the texels are overwritten later.
+		const uint8_t* pixels = static_cast<const uint8_t*>(data);
+		const size_t byteCount = static_cast<size_t>(width) * height * 4;
+		for (size_t alpha = 3; m_IsOpaque && alpha < byteCount; alpha += 4)
+		{
+			m_IsOpaque = pixels[alpha] == 0 || pixels[alpha] == 255;
+		}
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTextureSubImage2D(m_RendererID, 0, static_cast<GLint>(x), static_cast<GLint>(y),
+			static_cast<GLsizei>(width), static_cast<GLsizei>(height), GL_RGBA, GL_UNSIGNED_BYTE, data);
+	}
+
+	std::vector<uint8_t> Texture2D::ReadData() const
+	{
+		std::vector<uint8_t> pixels(static_cast<size_t>(m_Width) * m_Height * 4);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glGetTextureImage(m_RendererID, 0, GL_RGBA, GL_UNSIGNED_BYTE, static_cast<GLsizei>(pixels.size()), pixels.data());
+		return pixels;
+	}
+
+	void Texture2D::Bind(uint32_t slot) const
+	{
+		glBindTextureUnit(slot, m_RendererID);
+	}
+}//namespace Sengine
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Sengine
+{
+	//An RGBA8 2D texture. Non-copyable as it owns the OpenGL handle.
+	class Texture2D
+	{
+	public:
+		Texture2D(uint32_t width, uint32_t height, const void* data = nullptr);
+		~Texture2D();
+
+		Texture2D(const Texture2D&) = delete;
+		Texture2D& operator=(const Texture2D&) = delete;
+
+		//Uploads tightly packed RGBA8 pixels into a region of the texture.
+		void SetData(uint32_t x, uint32_t y, uint32_t width, uint32_t height, const void* data);
+		//Reads every pixel back from the GPU, rows in the order SetData takes them. Waits for the GPU to finish writing the texture.
+		[[nodiscard]] std::vector<uint8_t> ReadData() const;
+
+		void Bind(uint32_t slot = 0) const;
+
+		[[nodiscard]] uint32_t GetRendererID() const { return m_RendererID; }
+		[[nodiscard]] uint32_t GetWidth() const { return m_Width; }
+		[[nodiscard]] uint32_t GetHeight() const { return m_Height; }
+		//True while every texel uploaded has been either fully opaque or fully transparent, so sprites using the texture
+		//can be drawn without blending. Textures created without data start out false, as their texels are undefined.
+		[[nodiscard]] bool GetIsOpaque() const { return m_IsOpaque; }
+
+	private:
+		uint32_t m_RendererID = 0;
+		uint32_t m_Width = 0;
+		uint32_t m_Height = 0;
+		bool m_IsOpaque = false;
+	};
+}//namespace Sengine
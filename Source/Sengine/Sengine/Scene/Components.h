@@ -0,0 +1,61 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "entt/entt.hpp"
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+namespace Sengine::Renderer3D
+{
+	class Terrain;
+}
+
+namespace Sengine
+{
+	struct TagComponent
+	{
+		std::string Name;
+	};
+
+	struct TransformComponent
+	{
+		glm::vec3 Translation = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 Rotation = { 0.0f, 0.0f, 0.0f }; //Euler angles in radians
+		glm::vec3 Scale = { 1.0f, 1.0f, 1.0f };
+
+		[[nodiscard]] glm::mat4 GetTransform() const
+		{
+			glm::mat4 transform = glm::translate(glm::mat4(1.0f), Translation);
+			transform = glm::rotate(transform, Rotation.z, { 0.0f, 0.0f, 1.0f });
+			transform = glm::rotate(transform, Rotation.y, { 0.0f, 1.0f, 0.0f });
+			transform = glm::rotate(transform, Rotation.x, { 1.0f, 0.0f, 0.0f });
+			return glm::scale(transform, Scale);
+		}
+	};
+
+	struct SpriteComponent
+	{
+		glm::vec4 Colour = { 1.0f, 1.0f, 1.0f, 1.0f };
+	};
+
+	//Terrains are large and shared between the scenes that show them, so the component only references one.
+	struct TerrainComponent
+	{
+		std::shared_ptr<Renderer3D::Terrain> Terrain;
+	};
+
+	//Intrusive linked list of children, so walking a subtree never allocates.
+	struct RelationshipComponent
+	{
+		entt::entity Parent = entt::null;
+		entt::entity FirstChild = entt::null;
+		entt::entity PreviousSibling = entt::null;
+		entt::entity NextSibling = entt::null;
+		uint32_t ChildCount = 0;
+	};
+
+	//Empty tag for entities without a parent. Its storage is the packed list of roots.
+	struct RootComponent {};
+}//namespace Sengine
@@ -0,0 +1,117 @@
+#include "Scene.h"
+
+#include <iostream>
+
+namespace Sengine
+{
+	Scene::Scene()
+	{
+		//Created up front so the roots can be handed out before the first entity exists.
+		static_cast<void>(m_Registry.storage<RootComponent>());
+	}
+
+	entt::entity Scene::CreateEntity(const std::string& name, entt::entity parent)
+	{
+		const entt::entity entity = m_Registry.create();
+
+		m_Registry.emplace<TagComponent>(entity, name);
+		m_Registry.emplace<TransformComponent>(entity);
+		m_Registry.emplace<RelationshipComponent>(entity);
+		m_Registry.emplace<RootComponent>(entity);
+
+		if (parent != entt::null)
+		{
+			SetParent(entity, parent);
+		}
+
+		m_HierarchyVersion++;
+		return entity;
+	}
+
+	void Scene::DestroyEntity(entt::entity entity)
+	{
+		//Children are destroyed first, each one unlinks itself from this entity.
+		while (m_Registry.get<RelationshipComponent>(entity).FirstChild != entt::null)
+		{
+			DestroyEntity(m_Registry.get<RelationshipComponent>(entity).FirstChild);
+		}
+
+		Unlink(entity);
+		m_Registry.destroy(entity);
+
+		m_HierarchyVersion++;
+	}
+
+	bool Scene::SetParent(entt::entity entity, entt::entity parent)
+	{
+		//Parenting to itself or a descendant would make a cycle that hierarchy walks never leave.
+		for (entt::entity ancestor = parent; ancestor != entt::null; ancestor = m_Registry.get<RelationshipComponent>(ancestor).Parent)
+		{
+			if (ancestor == entity)
+			{
+				std::cout << "[Scene] Error: An entity can not be parented to itself or one of its children\n";
+				return false;
+			}
+		}
+
+		Unlink(entity);
+
+		RelationshipComponent& relationship = m_Registry.get<RelationshipComponent>(entity);
+		relationship.Parent = parent;
+
+		if (parent == entt::null)
+		{
+			m_Registry.emplace_or_replace<RootComponent>(entity);
+		}
+		else
+		{
+			m_Registry.remove<RootComponent>(entity);
+
+			//Push to the front of the parent's children, which keeps re-parenting O(1).
+			RelationshipComponent& parentRelationship = m_Registry.get<RelationshipComponent>(parent);
+			relationship.NextSibling = parentRelationship.FirstChild;
+			if (parentRelationship.FirstChild != entt::null)
+			{
+				m_Registry.get<RelationshipComponent>(parentRelationship.FirstChild).PreviousSibling = entity;
+			}
+			parentRelationship.FirstChild = entity;
+			parentRelationship.ChildCount++;
+		}
+
+		m_HierarchyVersion++;
+		return true;
+	}
+
+	void Scene::SetName(entt::entity entity, const std::string& name)
+	{
+		//Patch rather than write through get so on_update listeners see the rename.
+		m_Registry.patch<TagComponent>(entity, [&name](TagComponent& tag) { tag.Name = name; });
+	}
+
+	void Scene::Unlink(entt::entity entity)
+	{
+		RelationshipComponent& relationship = m_Registry.get<RelationshipComponent>(entity);
+		if (relationship.Parent == entt::null) return;
+
+		RelationshipComponent& parentRelationship = m_Registry.get<RelationshipComponent>(relationship.Parent);
+		if (parentRelationship.FirstChild == entity)
+		{
+			parentRelationship.FirstChild = relationship.NextSibling;
+		}
+		if (relationship.PreviousSibling != entt::null)
+		{
+			m_Registry.get<RelationshipComponent>(relationship.PreviousSibling).NextSibling = relationship.NextSibling;
+		}
+		if (relationship.NextSibling != entt::null)
+		{
+			m_Registry.get<RelationshipComponent>(relationship.NextSibling).PreviousSibling = relationship.PreviousSibling;
+		}
+		parentRelationship.ChildCount--;
+
+		relationship.Parent = entt::null;
+		relationship.PreviousSibling = entt::null;
+		relationship.NextSibling = entt::null;
+
+		m_Registry.emplace_or_replace<RootComponent>(entity);
+	}
+}//namespace Sengine
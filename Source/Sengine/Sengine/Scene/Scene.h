@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "Components.h"
+
+namespace Sengine
+{
+	class Scene
+	{
+	public:
+		Scene();
+		~Scene() = default;
+
+		Scene(const Scene&) = delete;
+		Scene& operator=(const Scene&) = delete;
+
+		entt::entity CreateEntity(const std::string& name = "Entity", entt::entity parent = entt::null);
+		//Destroys the entity and all of its children.
+		void DestroyEntity(entt::entity entity);
+
+		//Returns false, leaving the hierarchy as it was, if the parent is the entity itself or one of its descendants.
+		bool SetParent(entt::entity entity, entt::entity parent);
+		void SetName(entt::entity entity, const std::string& name);
+
+		[[nodiscard]] entt::registry& GetRegistry() { return m_Registry; }
+		[[nodiscard]] const entt::registry& GetRegistry() const { return m_Registry; }
+
+		//Packed storage of all root entities, can be indexed directly.
+		[[nodiscard]] const entt::registry::storage_for_type<RootComponent>& GetRoots() const { return *m_Registry.storage<RootComponent>(); }
+
+		//Incremented whenever entities are created, destroyed or re-parented.
+		[[nodiscard]] uint64_t GetHierarchyVersion() const { return m_HierarchyVersion; }
+
+	private:
+		void Unlink(entt::entity entity);
+
+	private:
+		entt::registry m_Registry;
+		uint64_t m_HierarchyVersion = 0;
+	};
+}//namespace Sengine
@@ -0,0 +1,221 @@
+#include "DistanceField.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace Sengine
+{
+	namespace
+	{
+		constexpr uint32_t MaxSphereCastSteps = 256;
+	}
+
+	bool DistanceField::Load(const std::filesystem::path& path)
+	{
+		Unload();
+
+		if (!m_File.Open(path)) return false;
+
+		const uint8_t* data = m_File.GetData();
+		const auto* header = reinterpret_cast<const DistanceFieldHeader*>(data);
+		if (m_File.GetSize() < sizeof(DistanceFieldHeader)
+			|| std::memcmp(header->FileMagic, DistanceFieldHeader::Magic, sizeof(DistanceFieldHeader::Magic)) != 0
+			|| header->Version != DistanceFieldHeader::CurrentVersion)
+		{
+			std::cout << "[Distance Field] Error: " << path.string() << " is not a distance field or is out of date\n";
+			m_File.Close();
+			return false;
+		}
+
+		//Bounded by the file size one axis at a time, so a corrupt header cannot overflow the cell count.
+		const size_t maxCellCount = m_File.GetSize() / (sizeof(float) + sizeof(uint32_t));
+		size_t cellCount = 1;
+		for (glm::length_t axis = 0; axis < 3; axis++)
+		{
+			const uint32_t count = header->CellCount[axis];
+			cellCount = count == 0 || cellCount > maxCellCount / count ? 0 : cellCount * count;
+		}
+		if (cellCount == 0 || !(header->VoxelSize > 0.0f) || !std::isfinite(header->VoxelSize))
+		{
+			std::cout << "[Distance Field] Error: " << path.string() << " has an invalid grid\n";
+			m_File.Close();
+			return false;
+		}
+
+		const size_t expectedSize = sizeof(DistanceFieldHeader) + cellCount * (sizeof(float) + sizeof(uint32_t))
+			+ static_cast<size_t>(header->BrickCount) * DistanceFieldHeader::SamplesPerBrick;
+		if (m_File.GetSize() < expectedSize)
+		{
+			std::cout << "[Distance Field] Error: " << path.string() << " is truncated\n";
+			m_File.Close();
+			return false;
+		}
+
+		const float* coarseDistances = reinterpret_cast<const float*>(data + sizeof(DistanceFieldHeader));
+		const uint32_t* brickIndices = reinterpret_cast<const uint32_t*>(coarseDistances + cellCount);
+		//Queries index the bricks without checking, so a corrupt index would read past the end of the file.
+		for (size_t cell = 0; cell < cellCount; cell++)
+		{
+			if (brickIndices[cell] != DistanceFieldHeader::EmptyCell && brickIndices[cell] >= header->BrickCount)
+			{
+				std::cout << "[Distance Field] Error: " << path.string() << " references brick " << brickIndices[cell] << " of " << header->BrickCount << "\n";
+				m_File.Close();
+				return false;
+			}
+		}
+
+		m_Header = header;
+		m_CoarseDistances = coarseDistances;
+		m_BrickIndices = brickIndices;
+		m_Bricks = reinterpret_cast<const int8_t*>(m_BrickIndices + cellCount);
+		m_CellSize = header->VoxelSize * static_cast<float>(DistanceFieldHeader::BrickSize);
+		return true;
+	}
+
+	void DistanceField::Unload()
+	{
+		m_File.Close();
+
+		m_Header = nullptr;
+		m_CoarseDistances = nullptr;
+		m_BrickIndices = nullptr;
+		m_Bricks = nullptr;
+	}
+
+	float DistanceField::GetDistance(const glm::vec3& position) const
+	{
+		if (!m_Header) return (std::numeric_limits<float>::max)();
+
+		const glm::vec3 local = (position - m_Header->Origin) / m_CellSize;
+		const glm::vec3 gridSize = glm::vec3(m_Header->CellCount);
+
+		//The grid is padded by a cell around the geometry, so outside of it the surface is at least that much further.
+		const glm::vec3 clamped = glm::clamp(local, glm::vec3(0.0f), gridSize);
+		if (clamped != local)
+		{
+			return glm::length(local - clamped) * m_CellSize + m_CellSize;
+		}
+
+		const glm::uvec3 cell = glm::min(glm::uvec3(local), m_Header->CellCount - 1u);
+		const size_t index = cell.x + static_cast<size_t>(m_Header->CellCount.x) * (cell.y + static_cast<size_t>(m_Header->CellCount.y) * cell.z);
+
+		const uint32_t brick = m_BrickIndices[index];
+		if (brick == DistanceFieldHeader::EmptyCell)
+		{
+			return m_CoarseDistances[index];
+		}
+
+		return SampleBrick(brick, (local - glm::vec3(cell)) * static_cast<float>(DistanceFieldHeader::BrickSize));
+	}
+
+	glm::vec3 DistanceField::GetNormal(const glm::vec3& position) const
+	{
+		if (!m_Header) return glm::vec3(0.0f, 1.0f, 0.0f);
+
+		const float offset = m_Header->VoxelSize * 0.5f;
+		const glm::vec3 gradient =
+		{
+			GetDistance(position + glm::vec3(offset, 0.0f, 0.0f)) - GetDistance(position - glm::vec3(offset, 0.0f, 0.0f)),
+			GetDistance(position + glm::vec3(0.0f, offset, 0.0f)) - GetDistance(position - glm::vec3(0.0f, offset, 0.0f)),
+			GetDistance(position + glm::vec3(0.0f, 0.0f, offset)) - GetDistance(position - glm::vec3(0.0f, 0.0f, offset)),
+		};
+
+		const float length = glm::length(gradient);
+		return length > 0.0f ? gradient / length : glm::vec3(0.0f, 1.0f, 0.0f);
+	}
+
+	bool DistanceField::SphereCast(const glm::vec3& origin, const glm::vec3& direction, float radius, float maxDistance, SphereCastHit& hit) const
+	{
+		if (!m_Header) return false;
+
+		const glm::vec3 normalizedDirection = glm::normalize(direction);
+		const float minStep = m_Header->VoxelSize * 0.1f;
+		const float contactDistance = m_Header->VoxelSize * 0.05f;
+
+		//Sphere tracing: the distance is a safe step, as nothing can be closer than it.
+		float travelled = 0.0f;
+		for (uint32_t step = 0; step < MaxSphereCastSteps && travelled <= maxDistance; step++)
+		{
+			const glm::vec3 centre = origin + normalizedDirection * travelled;
+			const float distance = GetDistance(centre) - radius;
+			if (distance < contactDistance)
+			{
+				hit.Position = centre;
+				hit.Normal = GetNormal(centre);
+				hit.Distance = travelled;
+				return true;
+			}
+
+			travelled += std::max(distance, minStep);
+		}
+
+		return false;
+	}
+
+	bool DistanceField::GetClosestPoint(const glm::vec3& position, float maxDistance, glm::vec3& closestPoint) const
+	{
+		if (!m_Header) return false;
+
+		if (std::abs(GetDistance(position)) > maxDistance) return false;
+
+		//Coarse distances undershoot, so the point is projected along the gradient until it settles on the surface.
+		closestPoint = position;
+		for (uint32_t iteration = 0; iteration < 4; iteration++)
+		{
+			const float distance = GetDistance(closestPoint);
+			if (std::abs(distance) < m_Header->VoxelSize * 0.05f) break;
+
+			closestPoint -= GetNormal(closestPoint) * distance;
+		}
+
+		return true;
+	}
+
+	float DistanceField::GetAmbientOcclusion(const glm::vec3& position, const glm::vec3& normal, uint32_t sampleCount) const
+	{
+		if (!m_Header) return 1.0f;
+
+		const float stepSize = m_Header->VoxelSize * 2.0f;
+
+		//Each sample along the normal should be as far from the surface as it is from the start, closer means occluded.
+		float occlusion = 0.0f;
+		float totalWeight = 0.0f;
+		float weight = 1.0f;
+		for (uint32_t sample = 1; sample <= sampleCount; sample++)
+		{
+			const float height = stepSize * static_cast<float>(sample);
+			const float distance = GetDistance(position + normal * height);
+
+			occlusion += weight * std::clamp((height - distance) / height, 0.0f, 1.0f);
+			totalWeight += weight;
+			weight *= 0.5f;
+		}
+
+		return totalWeight > 0.0f ? 1.0f - occlusion / totalWeight : 1.0f;
+	}
+
+	float DistanceField::SampleBrick(uint32_t brick, const glm::vec3& local) const
+	{
+		constexpr uint32_t axis = DistanceFieldHeader::SamplesPerAxis;
+		const int8_t* samples = m_Bricks + static_cast<size_t>(brick) * DistanceFieldHeader::SamplesPerBrick;
+
+		const glm::uvec3 base = glm::min(glm::uvec3(local), glm::uvec3(DistanceFieldHeader::BrickSize - 1));
+		const glm::vec3 t = glm::clamp(local - glm::vec3(base), 0.0f, 1.0f);
+
+		const auto at = [&](uint32_t x, uint32_t y, uint32_t z)
+			{
+				return static_cast<float>(samples[(base.x + x) + axis * ((base.y + y) + axis * (base.z + z))]);
+			};
+
+		const float x00 = glm::mix(at(0, 0, 0), at(1, 0, 0), t.x);
+		const float x10 = glm::mix(at(0, 1, 0), at(1, 1, 0), t.x);
+		const float x01 = glm::mix(at(0, 0, 1), at(1, 0, 1), t.x);
+		const float x11 = glm::mix(at(0, 1, 1), at(1, 1, 1), t.x);
+		const float quantized = glm::mix(glm::mix(x00, x10, t.y), glm::mix(x01, x11, t.y), t.z);
+
+		return quantized * (m_Header->Band / 127.0f);
+	}
+}//namespace Sengine
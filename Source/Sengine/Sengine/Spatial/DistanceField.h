@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+#include "glm/glm.hpp"
+
+#include "../Core/MappedFile.h"
+
+namespace Sengine
+{
+	//Layout of a cooked distance field file. The header is followed by one coarse distance and one brick index
+	//per cell of the top level grid, then the bricks. Only cells the surface passes through have a brick.
+	struct DistanceFieldHeader
+	{
+		static constexpr char Magic[4] = { 'S', 'E', 'S', 'D' };
+		static constexpr uint32_t CurrentVersion = 1;
+
+		//Voxels along each edge of a brick. A brick stores one more sample than that per axis, so it can be
+		//interpolated without touching its neighbours.
+		static constexpr uint32_t BrickSize = 8;
+		static constexpr uint32_t SamplesPerAxis = BrickSize + 1;
+		static constexpr uint32_t SamplesPerBrick = SamplesPerAxis * SamplesPerAxis * SamplesPerAxis;
+		static constexpr uint32_t EmptyCell = UINT32_MAX;
+
+		char FileMagic[4] = {};
+		uint32_t Version = 0;
+
+		glm::vec3 Origin = glm::vec3(0.0f);
+		float VoxelSize = 0.0f;
+		glm::uvec3 CellCount = glm::uvec3(0);
+		uint32_t BrickCount = 0;
+
+		//Brick samples are stored as signed bytes covering [-Band, Band].
+		float Band = 0.0f;
+		uint32_t Reserved = 0;
+	};
+	static_assert(sizeof(DistanceFieldHeader) == 48, "The distance field header is written to disk as is");
+
+	struct SphereCastHit
+	{
+		glm::vec3 Position = glm::vec3(0.0f);
+		glm::vec3 Normal = glm::vec3(0.0f);
+		float Distance = 0.0f;
+	};
+
+	//A sparse signed distance field of static geometry, negative inside. Queries run against the mapped file directly:
+	//cells without a surface answer from their coarse distance, which bounds the distance for the whole cell,
+	//and cells with one interpolate their brick. Until a field is loaded there is no surface: distances are the largest
+	//float and casts miss.
+	class DistanceField
+	{
+	public:
+		[[nodiscard]] bool Load(const std::filesystem::path& path);
+		void Unload();
+
+		//Signed distance to the nearest surface. Away from the surface it is a lower bound, which is what sphere tracing needs.
+		[[nodiscard]] float GetDistance(const glm::vec3& position) const;
+		[[nodiscard]] glm::vec3 GetNormal(const glm::vec3& position) const;
+
+		//Moves a sphere along the direction until it touches the surface.
+		[[nodiscard]] bool SphereCast(const glm::vec3& origin, const glm::vec3& direction, float radius, float maxDistance, SphereCastHit& hit) const;
+		[[nodiscard]] bool OverlapsSphere(const glm::vec3& centre, float radius) const { return GetDistance(centre) < radius; }
+		//Returns false if there is no surface within the max distance.
+		[[nodiscard]] bool GetClosestPoint(const glm::vec3& position, float maxDistance, glm::vec3& closestPoint) const;
+
+		//1 when open, falling towards 0 as nearby geometry closes in along the normal.
+		[[nodiscard]] float GetAmbientOcclusion(const glm::vec3& position, const glm::vec3& normal, uint32_t sampleCount = 5) const;
+
+		[[nodiscard]] bool GetIsLoaded() const { return m_Header != nullptr; }
+		[[nodiscard]] const DistanceFieldHeader* GetHeader() const { return m_Header; }
+
+	private:
+		[[nodiscard]] float SampleBrick(uint32_t brick, const glm::vec3& local) const;
+
+	private:
+		MappedFile m_File;
+
+		const DistanceFieldHeader* m_Header = nullptr;
+		const float* m_CoarseDistances = nullptr;
+		const uint32_t* m_BrickIndices = nullptr;
+		const int8_t* m_Bricks = nullptr;
+
+		float m_CellSize = 0.0f;
+	};
+}//namespace Sengine
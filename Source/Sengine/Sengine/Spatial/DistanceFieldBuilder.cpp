@@ -0,0 +1,437 @@
+#include "DistanceFieldBuilder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+#include "fastgltf/core.hpp"
+#include "fastgltf/glm_element_traits.hpp"
+#include "fastgltf/tools.hpp"
+#include "glm/gtc/type_ptr.hpp"
+
+#include "DistanceField.h"
+
+namespace Sengine
+{
+	namespace
+	{
+		constexpr uint32_t MaxTrianglesPerLeaf = 4;
+
+		//Slightly off axis, so parity rays do not run exactly along the edges of axis aligned geometry.
+		const glm::vec3 ParityDirections[3] =
+		{
+			glm::normalize(glm::vec3(1.0f, 0.0013f, 0.0029f)),
+			glm::normalize(glm::vec3(0.0017f, 1.0f, 0.0023f)),
+			glm::normalize(glm::vec3(0.0031f, 0.0019f, 1.0f)),
+		};
+
+		//From Real-Time Collision Detection by Christer Ericson, 5.1.5.
+		glm::vec3 GetClosestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+		{
+			const glm::vec3 ab = b - a;
+			const glm::vec3 ac = c - a;
+			const glm::vec3 ap = p - a;
+			const float d1 = glm::dot(ab, ap);
+			const float d2 = glm::dot(ac, ap);
+			if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+			const glm::vec3 bp = p - b;
+			const float d3 = glm::dot(ab, bp);
+			const float d4 = glm::dot(ac, bp);
+			if (d3 >= 0.0f && d4 <= d3) return b;
+
+			const float vc = d1 * d4 - d3 * d2;
+			if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return a + ab * (d1 / (d1 - d3));
+
+			const glm::vec3 cp = p - c;
+			const float d5 = glm::dot(ab, cp);
+			const float d6 = glm::dot(ac, cp);
+			if (d6 >= 0.0f && d5 <= d6) return c;
+
+			const float vb = d5 * d2 - d1 * d6;
+			if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return a + ac * (d2 / (d2 - d6));
+
+			const float va = d3 * d6 - d5 * d4;
+			if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+			const float denominator = 1.0f / (va + vb + vc);
+			return a + ab * (vb * denominator) + ac * (vc * denominator);
+		}
+
+		float GetBoxDistanceSquared(const glm::vec3& p, const glm::vec3& min, const glm::vec3& max)
+		{
+			const glm::vec3 outside = glm::max(glm::max(min - p, p - max), glm::vec3(0.0f));
+			return glm::dot(outside, outside);
+		}
+
+		bool RayIntersectsBox(const glm::vec3& origin, const glm::vec3& inverseDirection, const glm::vec3& min, const glm::vec3& max)
+		{
+			const glm::vec3 t0 = (min - origin) * inverseDirection;
+			const glm::vec3 t1 = (max - origin) * inverseDirection;
+			const glm::vec3 near = glm::min(t0, t1);
+			const glm::vec3 far = glm::max(t0, t1);
+
+			const float enter = std::max(std::max(near.x, near.y), near.z);
+			const float exit = std::min(std::min(far.x, far.y), far.z);
+			return exit >= std::max(enter, 0.0f);
+		}
+
+		//Moller-Trumbore, counting hits in front of the origin from either side.
+		bool RayIntersectsTriangle(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+		{
+			const glm::vec3 ab = b - a;
+			const glm::vec3 ac = c - a;
+			const glm::vec3 p = glm::cross(direction, ac);
+			const float determinant = glm::dot(ab, p);
+			if (std::abs(determinant) < 1e-12f) return false;
+
+			const float inverseDeterminant = 1.0f / determinant;
+			const glm::vec3 s = origin - a;
+			const float u = glm::dot(s, p) * inverseDeterminant;
+			if (u < 0.0f || u > 1.0f) return false;
+
+			const glm::vec3 q = glm::cross(s, ab);
+			const float v = glm::dot(direction, q) * inverseDeterminant;
+			if (v < 0.0f || u + v > 1.0f) return false;
+
+			return glm::dot(ac, q) * inverseDeterminant > 0.0f;
+		}
+
+		int8_t Quantize(float distance, float band)
+		{
+			return static_cast<int8_t>(std::clamp(std::round(distance / band * 127.0f), -127.0f, 127.0f));
+		}
+	}
+
+	bool DistanceFieldBuilder::AddTriangles(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices, const glm::mat4& transform)
+	{
+		const auto outOfRange = std::find_if(indices.begin(), indices.end(), [&](uint32_t index) { return index >= positions.size(); });
+		if (outOfRange != indices.end())
+		{
+			std::cout << "[Distance Field Builder] Error: Index " << *outOfRange << " is out of range of " << positions.size() << " positions\n";
+			return false;
+		}
+
+		m_Triangles.reserve(m_Triangles.size() + indices.size() / 3);
+		for (size_t index = 0; index + 2 < indices.size(); index += 3)
+		{
+			m_Triangles.push_back(
+				{
+					glm::vec3(transform * glm::vec4(positions[indices[index + 0]], 1.0f)),
+					glm::vec3(transform * glm::vec4(positions[indices[index + 1]], 1.0f)),
+					glm::vec3(transform * glm::vec4(positions[indices[index + 2]], 1.0f)),
+				});
+		}
+		return true;
+	}
+
+	bool DistanceFieldBuilder::AddGltf(const std::filesystem::path& path)
+	{
+		auto data = fastgltf::GltfDataBuffer::FromPath(path);
+		if (data.error() != fastgltf::Error::None)
+		{
+			std::cout << "[Distance Field Builder] Error: Could not read " << path.string() << "\n";
+			return false;
+		}
+
+		fastgltf::Parser parser;
+		auto asset = parser.loadGltf(data.get(), path.parent_path(), fastgltf::Options::LoadExternalBuffers);
+		if (asset.error() != fastgltf::Error::None)
+		{
+			std::cout << "[Distance Field Builder] Error: Could not parse " << path.string() << ": " << fastgltf::getErrorMessage(asset.error()) << "\n";
+			return false;
+		}
+
+		if (asset->scenes.empty()) return true;
+
+		std::vector<glm::vec3> positions;
+		std::vector<uint32_t> indices;
+		bool isValid = true;
+		fastgltf::iterateSceneNodes(asset.get(), asset->defaultScene.value_or(0), fastgltf::math::fmat4x4(),
+			[&](fastgltf::Node& node, const fastgltf::math::fmat4x4& matrix)
+			{
+				if (!node.meshIndex.has_value()) return;
+
+				const glm::mat4 transform = glm::make_mat4(matrix.data());
+
+				for (const fastgltf::Primitive& primitive : asset->meshes[*node.meshIndex].primitives)
+				{
+					const auto position = primitive.findAttribute("POSITION");
+					if (primitive.type != fastgltf::PrimitiveType::Triangles || position == primitive.attributes.end()) continue;
+
+					const fastgltf::Accessor& positionAccessor = asset->accessors[position->accessorIndex];
+					positions.resize(positionAccessor.count);
+					fastgltf::iterateAccessorWithIndex<glm::vec3>(asset.get(), positionAccessor, [&](glm::vec3 value, size_t index)
+						{
+							positions[index] = value;
+						});
+
+					if (primitive.indicesAccessor.has_value())
+					{
+						const fastgltf::Accessor& indexAccessor = asset->accessors[*primitive.indicesAccessor];
+						indices.resize(indexAccessor.count);
+						fastgltf::copyFromAccessor<uint32_t>(asset.get(), indexAccessor, indices.data());
+					}
+					else
+					{
+						indices.resize(positions.size());
+						for (uint32_t index = 0; index < indices.size(); index++) indices[index] = index;
+					}
+
+					if (!AddTriangles(positions, indices, transform)) isValid = false;
+				}
+			});
+
+		if (!isValid)
+		{
+			std::cout << "[Distance Field Builder] Error: Skipped invalid meshes in " << path.string() << "\n";
+		}
+		return isValid;
+	}
+
+	bool DistanceFieldBuilder::Build(float voxelSize, const std::filesystem::path& outputPath, uint32_t threadCount)
+	{
+		if (m_Triangles.empty() || voxelSize <= 0.0f)
+		{
+			std::cout << "[Distance Field Builder] Error: Nothing to build\n";
+			return false;
+		}
+
+		BuildHierarchy();
+
+		//One empty cell of padding on every side keeps the surface away from the edge of the grid.
+		const float cellSize = voxelSize * static_cast<float>(DistanceFieldHeader::BrickSize);
+		const glm::vec3 extent = m_Nodes.front().Max - m_Nodes.front().Min;
+
+		DistanceFieldHeader header;
+		std::memcpy(header.FileMagic, DistanceFieldHeader::Magic, sizeof(header.FileMagic));
+		header.Version = DistanceFieldHeader::CurrentVersion;
+		header.Origin = m_Nodes.front().Min - glm::vec3(cellSize);
+		header.VoxelSize = voxelSize;
+		header.CellCount = glm::uvec3(glm::ceil(extent / cellSize)) + 2u;
+
+		//A cell the surface passes through has its centre within half a diagonal of it, so no sample is further than a diagonal.
+		const float halfDiagonal = cellSize * 0.5f * std::sqrt(3.0f);
+		header.Band = halfDiagonal * 2.0f;
+
+		const uint32_t cellCount = header.CellCount.x * header.CellCount.y * header.CellCount.z;
+		std::vector<float> coarseDistances(cellCount, 0.0f);
+		std::vector<std::vector<int8_t>> cellBricks(cellCount);
+
+		const auto buildCell = [&](uint32_t cellIndex)
+			{
+				const glm::uvec3 cell = { cellIndex % header.CellCount.x, (cellIndex / header.CellCount.x) % header.CellCount.y, cellIndex / (header.CellCount.x * header.CellCount.y) };
+				const glm::vec3 cellOrigin = header.Origin + glm::vec3(cell) * cellSize;
+
+				const float centreDistance = GetSignedDistance(cellOrigin + glm::vec3(cellSize * 0.5f));
+				if (std::abs(centreDistance) > halfDiagonal)
+				{
+					//Nothing in the cell is closer to the surface than its centre, less half a diagonal.
+					coarseDistances[cellIndex] = std::copysign(std::abs(centreDistance) - halfDiagonal, centreDistance);
+					return;
+				}
+
+				std::vector<int8_t>& brick = cellBricks[cellIndex];
+				brick.resize(DistanceFieldHeader::SamplesPerBrick);
+
+				constexpr uint32_t axis = DistanceFieldHeader::SamplesPerAxis;
+				for (uint32_t z = 0; z < axis; z++)
+				{
+					for (uint32_t y = 0; y < axis; y++)
+					{
+						for (uint32_t x = 0; x < axis; x++)
+						{
+							const glm::vec3 position = cellOrigin + glm::vec3(x, y, z) * voxelSize;
+							brick[x + axis * (y + axis * z)] = Quantize(GetSignedDistance(position), header.Band);
+						}
+					}
+				}
+			};
+
+		if (threadCount == 0)
+		{
+			threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+		}
+
+		std::atomic<uint32_t> nextCell = 0;
+		std::vector<std::thread> workers;
+		for (uint32_t thread = 0; thread < threadCount; thread++)
+		{
+			workers.emplace_back([&]()
+				{
+					for (uint32_t cellIndex = nextCell++; cellIndex < cellCount; cellIndex = nextCell++)
+					{
+						buildCell(cellIndex);
+					}
+				});
+		}
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+
+		std::vector<uint32_t> brickIndices(cellCount, DistanceFieldHeader::EmptyCell);
+		for (uint32_t cellIndex = 0; cellIndex < cellCount; cellIndex++)
+		{
+			if (!cellBricks[cellIndex].empty())
+			{
+				brickIndices[cellIndex] = header.BrickCount++;
+			}
+		}
+
+		std::ofstream file(outputPath, std::ios::binary);
+		if (!file)
+		{
+			std::cout << "[Distance Field Builder] Error: Could not write " << outputPath.string() << "\n";
+			return false;
+		}
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(coarseDistances.data()), static_cast<std::streamsize>(coarseDistances.size() * sizeof(float)));
+		file.write(reinterpret_cast<const char*>(brickIndices.data()), static_cast<std::streamsize>(brickIndices.size() * sizeof(uint32_t)));
+		for (const std::vector<int8_t>& brick : cellBricks)
+		{
+			file.write(reinterpret_cast<const char*>(brick.data()), static_cast<std::streamsize>(brick.size()));
+		}
+
+		return static_cast<bool>(file);
+	}
+
+	void DistanceFieldBuilder::BuildHierarchy()
+	{
+		m_Nodes.clear();
+		m_Nodes.reserve(m_Triangles.size() * 2);
+		m_Nodes.push_back({});
+
+		Subdivide(0, 0, static_cast<uint32_t>(m_Triangles.size()));
+	}
+
+	void DistanceFieldBuilder::Subdivide(uint32_t nodeIndex, uint32_t first, uint32_t count)
+	{
+		glm::vec3 min(std::numeric_limits<float>::max());
+		glm::vec3 max(std::numeric_limits<float>::lowest());
+		glm::vec3 centroidMin = min;
+		glm::vec3 centroidMax = max;
+		for (uint32_t index = first; index < first + count; index++)
+		{
+			const Triangle& triangle = m_Triangles[index];
+			min = glm::min(min, glm::min(triangle.A, glm::min(triangle.B, triangle.C)));
+			max = glm::max(max, glm::max(triangle.A, glm::max(triangle.B, triangle.C)));
+
+			const glm::vec3 centroid = (triangle.A + triangle.B + triangle.C) / 3.0f;
+			centroidMin = glm::min(centroidMin, centroid);
+			centroidMax = glm::max(centroidMax, centroid);
+		}
+
+		m_Nodes[nodeIndex].Min = min;
+		m_Nodes[nodeIndex].Max = max;
+
+		if (count <= MaxTrianglesPerLeaf)
+		{
+			m_Nodes[nodeIndex].FirstOrLeft = first;
+			m_Nodes[nodeIndex].Count = count;
+			return;
+		}
+
+		//Median split along the longest axis of the centroids keeps the tree balanced.
+		const glm::vec3 centroidExtent = centroidMax - centroidMin;
+		const int axis = centroidExtent.x > centroidExtent.y ? (centroidExtent.x > centroidExtent.z ? 0 : 2) : (centroidExtent.y > centroidExtent.z ? 1 : 2);
+		const uint32_t half = count / 2;
+		std::nth_element(m_Triangles.begin() + first, m_Triangles.begin() + first + half, m_Triangles.begin() + first + count,
+			[axis](const Triangle& a, const Triangle& b)
+			{
+				return a.A[axis] + a.B[axis] + a.C[axis] < b.A[axis] + b.B[axis] + b.C[axis];
+			});
+
+		const uint32_t left = static_cast<uint32_t>(m_Nodes.size());
+		m_Nodes.push_back({});
+		m_Nodes.push_back({});
+		m_Nodes[nodeIndex].FirstOrLeft = left;
+		m_Nodes[nodeIndex].Count = 0;
+
+		Subdivide(left, first, half);
+		Subdivide(left + 1, first + half, count - half);
+	}
+
+	float DistanceFieldBuilder::GetSignedDistance(const glm::vec3& position) const
+	{
+		//A point inside a closed mesh crosses it an odd number of times in any direction, the majority of three rides over grazing hits.
+		uint32_t insideVotes = 0;
+		for (const glm::vec3& direction : ParityDirections)
+		{
+			insideVotes += CountCrossings(position, direction) & 1u;
+		}
+
+		const float distance = std::sqrt(GetDistanceSquared(position));
+		return insideVotes >= 2 ? -distance : distance;
+	}
+
+	float DistanceFieldBuilder::GetDistanceSquared(const glm::vec3& position) const
+	{
+		float best = std::numeric_limits<float>::max();
+
+		uint32_t stack[64];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = 0;
+		while (stackSize > 0)
+		{
+			const BvhNode& node = m_Nodes[stack[--stackSize]];
+			if (GetBoxDistanceSquared(position, node.Min, node.Max) >= best) continue;
+
+			if (node.Count > 0)
+			{
+				for (uint32_t index = node.FirstOrLeft; index < node.FirstOrLeft + node.Count; index++)
+				{
+					const Triangle& triangle = m_Triangles[index];
+					const glm::vec3 offset = position - GetClosestPointOnTriangle(position, triangle.A, triangle.B, triangle.C);
+					best = std::min(best, glm::dot(offset, offset));
+				}
+				continue;
+			}
+
+			//The nearer child goes on top so it is searched first and tightens the bound for the other.
+			const uint32_t left = node.FirstOrLeft;
+			const uint32_t right = node.FirstOrLeft + 1;
+			const bool isLeftNearer = GetBoxDistanceSquared(position, m_Nodes[left].Min, m_Nodes[left].Max)
+				< GetBoxDistanceSquared(position, m_Nodes[right].Min, m_Nodes[right].Max);
+			stack[stackSize++] = isLeftNearer ? right : left;
+			stack[stackSize++] = isLeftNearer ? left : right;
+		}
+
+		return best;
+	}
+
+	uint32_t DistanceFieldBuilder::CountCrossings(const glm::vec3& origin, const glm::vec3& direction) const
+	{
+		const glm::vec3 inverseDirection = 1.0f / direction;
+		uint32_t crossings = 0;
+
+		uint32_t stack[64];
+		uint32_t stackSize = 0;
+		stack[stackSize++] = 0;
+		while (stackSize > 0)
+		{
+			const BvhNode& node = m_Nodes[stack[--stackSize]];
+			if (!RayIntersectsBox(origin, inverseDirection, node.Min, node.Max)) continue;
+
+			if (node.Count > 0)
+			{
+				for (uint32_t index = node.FirstOrLeft; index < node.FirstOrLeft + node.Count; index++)
+				{
+					const Triangle& triangle = m_Triangles[index];
+					crossings += RayIntersectsTriangle(origin, direction, triangle.A, triangle.B, triangle.C) ? 1 : 0;
+				}
+				continue;
+			}
+
+			stack[stackSize++] = node.FirstOrLeft;
+			stack[stackSize++] = node.FirstOrLeft + 1;
+		}
+
+		return crossings;
+	}
+}//namespace Sengine
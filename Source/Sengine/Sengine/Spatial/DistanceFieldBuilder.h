@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+namespace Sengine
+{
+	//Cooks a DistanceField from static triangle geometry. Distances come from a bounding volume hierarchy over the
+	//triangles, and the inside is found by ray parity, so meshes should be closed for the sign to be right.
+	class DistanceFieldBuilder
+	{
+	public:
+		//Returns false, adding nothing, if an index is out of range of the positions.
+		[[nodiscard]] bool AddTriangles(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices, const glm::mat4& transform = glm::mat4(1.0f));
+		//Adds every triangle mesh of the default scene, in world space. Returns false if any mesh was invalid, the others are still added.
+		[[nodiscard]] bool AddGltf(const std::filesystem::path& path);
+
+		//Builds the field with the given voxel size and writes it to disk, spreading the bricks over the threads.
+		[[nodiscard]] bool Build(float voxelSize, const std::filesystem::path& outputPath, uint32_t threadCount = 0);
+
+		[[nodiscard]] size_t GetTriangleCount() const { return m_Triangles.size(); }
+
+	private:
+		struct Triangle
+		{
+			glm::vec3 A;
+			glm::vec3 B;
+			glm::vec3 C;
+		};
+
+		struct BvhNode
+		{
+			glm::vec3 Min;
+			uint32_t FirstOrLeft; //First triangle of a leaf, or the left child
+			glm::vec3 Max;
+			uint32_t Count; //Triangles in a leaf, zero for an inner node whose right child follows the left one
+		};
+
+		void BuildHierarchy();
+		void Subdivide(uint32_t nodeIndex, uint32_t first, uint32_t count);
+
+		[[nodiscard]] float GetSignedDistance(const glm::vec3& position) const;
+		[[nodiscard]] float GetDistanceSquared(const glm::vec3& position) const;
+		[[nodiscard]] uint32_t CountCrossings(const glm::vec3& origin, const glm::vec3& direction) const;
+
+	private:
+		std::vector<Triangle> m_Triangles;
+		std::vector<BvhNode> m_Nodes;
+	};
+}//namespace Sengine
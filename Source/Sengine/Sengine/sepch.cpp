@@ -0,0 +1 @@
+#include "sepch.h"
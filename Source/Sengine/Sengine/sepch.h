@@ -0,0 +1,27 @@
+#pragma once
+
+//Precompiled header, force included into every engine source file by the build. Only stable headers that most
+//of the engine uses belong here, anything that changes often would rebuild everything.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+//Glad has to come before any other OpenGL header, which being first in every file guarantees.
+#include "glad/glad.h"
+#include "glm/glm.hpp"
@@ -7,8 +7,9 @@ project "Sengine"
     targetdir ("../../bin/" .. outputdir .. "/%{prj.name}")
 	objdir ("../../bin-int/" .. outputdir .. "/%{prj.name}")
 
-    --pchheader "frpch.h"
-    --pchsource "src/frpch.cpp"
+    pchheader "sepch.h"
+    pchsource "Sengine/sepch.cpp"
+    forceincludes { "sepch.h" }
 
     files
     {
@@ -16,10 +17,19 @@ project "Sengine"
         "Sengine/**.cpp",
     }
 
+    --ImGuiLayer defines Swindow's ImGui implementation macro before including it, so it cannot share a file.
+    unitybuild("Sengine", { "Sengine/**.cpp" }, { "sepch.cpp", "ImGuiLayer.cpp" }, 8)
+
     includedirs
     {
         "Sengine",
         "%{IncludeDir.THIRDPARTY}",
+        "%{IncludeDir.GLAD}",
+        "%{IncludeDir.IMGUI}",
+        "%{IncludeDir.ENTT}",
+        "%{IncludeDir.GLM}",
+        "%{IncludeDir.FASTGLTF}",
+        "%{IncludeDir.BOX2D}",
     }
 
     links
@@ -29,6 +39,7 @@ project "Sengine"
         "GLM",
         "IMGUI",
         "FASTGLTF",
+        "BOX2D",
         "SWINDOW",
     }
 
@@ -40,6 +51,13 @@ project "Sengine"
             "SE_PLATFORM_WINDOWS",
         }
 
+    --HeadlessContext gets its contexts from EGL, Mesa picks llvmpipe when there is no GPU driver.
+    filter "system:linux"
+        links
+        {
+            "EGL",
+        }
+
     filter "configurations:Debug"
         defines
         {
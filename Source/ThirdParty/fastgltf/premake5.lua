@@ -13,6 +13,10 @@ files
 	"**.hpp",
 	"**.cpp"
 }
+
+--All of fastgltf goes through one file, so simdjson.h is only parsed once.
+unitybuild("FASTGLTF", { "**.cpp" }, {}, 4)
+
 includedirs
 {
 	"include",
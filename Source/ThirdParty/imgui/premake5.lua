@@ -15,6 +15,9 @@ files
     "imgui/Nodes/**.h",
 }
 
+--binary_to_compressed_c is a command line tool with its own main.
+unitybuild("IMGUI", { "imgui/**.cpp" }, { "binary_to_compressed_c.cpp" }, 16)
+
 includedirs
 {
     "imgui/**.cpp",
@@ -19,10 +19,9 @@
 #pragma comment (lib, "opengl32.lib")
 #endif
 
-#ifdef __LINUX__
-#include <X11/Xlib.h>
-#include <X11/Xutil.h>
-#include <X11/Xos.h>
+#ifdef __linux__
+//Only the display handle is needed so far. Xlib's headers define macros such as None and Bool, which would leak into every includer.
+typedef struct _XDisplay Display;
 #endif	
 
 namespace Swindow
@@ -135,14 +134,14 @@ namespace Swindow
 	struct WindowCallbacks
 	{
 		//Basic Window Callbacks
-		WindowResizeCallback WindowResizeCallback;
-		WindowCloseCallback WindowCloseCallback;
+		Swindow::WindowResizeCallback WindowResizeCallback;
+		Swindow::WindowCloseCallback WindowCloseCallback;
 
 		//Input Callbacks
-		WindowKeyCallback WindowKeyCallback;
-		WindowMouseCallback WindowMouseCallback;
-		WindowMouseMoveCallback WindowMouseMoveCallback;
-		WindowCharacterCallback WindowCharacterCallback;
+		Swindow::WindowKeyCallback WindowKeyCallback;
+		Swindow::WindowMouseCallback WindowMouseCallback;
+		Swindow::WindowMouseMoveCallback WindowMouseMoveCallback;
+		Swindow::WindowCharacterCallback WindowCharacterCallback;
 	};
 
 	class Window
@@ -499,6 +498,11 @@ namespace Swindow
 		window->m_WindowDescription = description;
 
 		window->m_NativeWindow = Internal::NativeWindow::Create(window);
+		if (!window->m_NativeWindow)
+		{
+			Internal::Logger::Log("No window backend for this platform");
+			return nullptr;
+		}
 
 		window->m_IsRunning = true;
 
@@ -597,6 +601,10 @@ namespace Swindow
 		{
 #ifdef _WIN32
 			return std::make_shared<Win32NativeWindow>(window);
+#else
+			//The X11 backend is not implemented yet.
+			(void)window;
+			return nullptr;
 #endif
 		}
 
@@ -0,0 +1,38 @@
+#!/usr/bin/env bash
+# Generates and builds the workspace on Linux.
+#   ./build.sh [debug|release|profile] [gmake2|ninja] [extra premake options, e.g. --glm-simd]
+# The ninja action needs a premake5 with the premake-ninja module installed.
+set -e
+
+config="${1:-release}"
+action="${2:-gmake2}"
+shift $(( $# > 2 ? 2 : $# ))
+
+cd "$(dirname "$0")"
+
+premake="premake5"
+if [ -x "Source/ThirdParty/premake/premake5" ]; then
+    premake="Source/ThirdParty/premake/premake5"
+fi
+
+if ! command -v "$premake" > /dev/null; then
+    echo "premake5 was not found, put it on the PATH or in Source/ThirdParty/premake"
+    exit 1
+fi
+
+"$premake" "$action" "$@"
+
+case "$action" in
+    gmake2)
+        make config="$config" -j"$(nproc)"
+        ;;
+    ninja)
+        # premake-ninja names the per configuration targets after the configuration.
+        config="$(tr '[:lower:]' '[:upper:]' <<< "${config:0:1}")${config:1}"
+        ninja "$config"
+        ;;
+    *)
+        echo "Unknown action $action, use gmake2 or ninja"
+        exit 1
+        ;;
+esac
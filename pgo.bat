@@ -0,0 +1,29 @@
+@echo off
+setlocal
+
+rem Profile guided Release build. Builds an instrumented binary, runs the headless benchmarks to record
+rem where the time goes, then rebuilds with those profiles. Run from a Developer Command Prompt so msbuild is found.
+
+if exist bin-pgo rmdir /s /q bin-pgo
+mkdir bin-pgo
+
+call Source\ThirdParty\premake\premake5.exe vs2022 --pgo=generate
+if %errorlevel% neq 0 goto Error
+msbuild Sengine.sln /m /p:Configuration=Release /p:Platform=x64
+if %errorlevel% neq 0 goto Error
+
+bin\Release-windows-x86_64\Benchmarks\Benchmarks.exe
+if %errorlevel% neq 0 goto Error
+
+call Source\ThirdParty\premake\premake5.exe vs2022 --pgo=use
+if %errorlevel% neq 0 goto Error
+msbuild Sengine.sln /m /t:Rebuild /p:Configuration=Release /p:Platform=x64
+if %errorlevel% neq 0 goto Error
+
+endlocal
+exit /b 0
+
+:Error
+echo The profile guided build failed in %CD%
+endlocal
+exit /b 1
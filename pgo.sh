@@ -0,0 +1,18 @@
+#!/usr/bin/env bash
+# Profile guided Release build. Builds an instrumented binary, runs the headless benchmarks to record
+# where the time goes, then rebuilds with those profiles. Both builds use link time optimisation.
+#   ./pgo.sh [gmake2|ninja]
+set -e
+
+action="${1:-gmake2}"
+
+cd "$(dirname "$0")"
+
+rm -rf bin-pgo
+./build.sh release "$action" --pgo=generate
+
+bin/Release-linux-x86_64/Benchmarks/Benchmarks
+
+# Flags changed but the sources did not, so the objects have to be thrown away for the second build.
+rm -rf bin-int/Release-linux-x86_64 Source/ThirdParty/*/bin-int/Release-linux-x86_64
+./build.sh release "$action" --pgo=use
@@ -1,5 +1,5 @@
 workspace("Sengine")
-	configurations { "Debug", "Release" }
+	configurations { "Debug", "Release", "Profile" }
 	architecture("x64")
 
   flags
@@ -12,14 +12,189 @@ workspace("Sengine")
   IncludeDir = {}
   IncludeDir["SENGINE"] =     "../Sengine/"
   IncludeDir["THIRDPARTY"] =     "../ThirdParty/"
+  IncludeDir["GLAD"] =     "../ThirdParty/glad/include"
+  IncludeDir["IMGUI"] =     "../ThirdParty/imgui"
+  IncludeDir["ENTT"] =     "../ThirdParty/entt/include"
+  IncludeDir["GLM"] =     "../ThirdParty/glm"
+  IncludeDir["FASTGLTF"] =     "../ThirdParty/fastgltf/include"
+  IncludeDir["BOX2D"] =     "../ThirdParty/box2D/include"
+
+  newoption
+  {
+    trigger = "glm-simd",
+    description = "Build GLM with SSE/AVX2 intrinsics and aligned types for the engine's SIMD maths"
+  }
+
+  newoption
+  {
+    trigger = "lto",
+    description = "Link time optimisation across the engine and its static libraries in Release and Profile"
+  }
+
+  newoption
+  {
+    trigger = "pgo",
+    value = "PHASE",
+    description = "Profile guided optimisation of Release, see pgo.sh and pgo.bat for the whole workflow",
+    allowed =
+    {
+      { "generate", "Instrument the build to record profiles when run" },
+      { "use", "Optimise with the profiles recorded by the generate build" },
+    }
+  }
+
+  newoption
+  {
+    trigger = "unity",
+    description = "Compile the engine, ImGui and fastgltf as a few large files each for faster full rebuilds"
+  }
+
+  newoption
+  {
+    trigger = "deterministic-fp",
+    description = "Strict floating point without FMA contraction, so determinism mode state hashes match across compilers and machines"
+  }
+
+  --Replaces the project's sources with generated files that each include a batch of them when --unity is given.
+  --Sources that have to be compiled on their own, like ones that define an implementation macro before an
+  --include, are excluded by file name.
+  function unitybuild(projectName, patterns, exclude, batchSize)
+    if not _OPTIONS["unity"] then
+      return
+    end
+
+    local sources = {}
+    for _, pattern in ipairs(patterns) do
+      for _, file in ipairs(os.matchfiles(path.join(_SCRIPT_DIR, pattern))) do
+        if not table.contains(exclude, path.getname(file)) then
+          table.insert(sources, file)
+        end
+      end
+    end
+    table.sort(sources)
+
+    local directory = path.join(_MAIN_SCRIPT_DIR, "bin-int/Unity/" .. projectName)
+    os.mkdir(directory)
+
+    local unityFiles = {}
+    for first = 1, #sources, batchSize do
+      local lines = {}
+      for index = first, math.min(first + batchSize - 1, #sources) do
+        table.insert(lines, '#include "' .. sources[index] .. '"')
+      end
+
+      --Writing an unchanged file again would rebuild its whole batch.
+      local unityFile = path.join(directory, "Unity" .. #unityFiles .. ".cpp")
+      os.writefile_ifnotequal(table.concat(lines, "\n") .. "\n", unityFile)
+      table.insert(unityFiles, unityFile)
+    end
+
+    removefiles(sources)
+    files(unityFiles)
+  end
+
+  --Profiles of every project land in one place, so the instrumented run and the optimised build agree on it.
+  pgodir = path.getabsolute("bin-pgo")
+
+  --Optimised like Release but keeps symbols and frame pointers so profilers see real call stacks, and turns on the
+  --SE_PROFILE_ macros. Set here so every project, third party ones included, gets it without its own block.
+  filter "configurations:Profile"
+    defines
+    {
+      "SE_PROFILE",
+    }
+    runtime "Release"
+    optimize "On"
+    symbols "On"
+    omitframepointer "Off"
+
+  filter "system:linux"
+    defines
+    {
+      "SE_PLATFORM_LINUX",
+    }
+    pic "On"
+
+  --Windows.h otherwise defines min and max as macros, which breaks std::min, std::max and numeric_limits in every
+  --file that comes after it, unity batches included.
+  filter "system:windows"
+    defines
+    {
+      "NOMINMAX",
+      "WIN32_LEAN_AND_MEAN",
+    }
+
+  --Inlining across projects needs every static library compiled for it too, not just the executables.
+  filter { "configurations:Release or Profile", "options:lto or pgo=generate or pgo=use" }
+    flags
+    {
+      "LinkTimeOptimization",
+    }
+
+  --Only executables are instrumented and optimised by the linker, libraries come along through LTO.
+  filter { "configurations:Release", "options:pgo=generate", "system:windows", "kind:ConsoleApp or WindowedApp" }
+    linkoptions
+    {
+      "/GENPROFILE:PGD=" .. pgodir .. "/%{prj.name}.pgd",
+    }
+
+  filter { "configurations:Release", "options:pgo=use", "system:windows", "kind:ConsoleApp or WindowedApp" }
+    linkoptions
+    {
+      "/USEPROFILE:PGD=" .. pgodir .. "/%{prj.name}.pgd",
+    }
+
+  filter { "configurations:Release", "options:pgo=generate", "system:linux" }
+    buildoptions
+    {
+      "-fprofile-generate=" .. pgodir,
+    }
+    linkoptions
+    {
+      "-fprofile-generate=" .. pgodir,
+    }
+
+  --Code the benchmarks never reach keeps its normal optimisation instead of being treated as cold.
+  filter { "configurations:Release", "options:pgo=use", "system:linux" }
+    buildoptions
+    {
+      "-fprofile-use=" .. pgodir,
+      "-fprofile-partial-training",
+      "-Wno-missing-profile",
+    }
+    linkoptions
+    {
+      "-fprofile-use=" .. pgodir,
+    }
+
+  --Fused multiply adds round once instead of twice, whether an expression gets one depends on the compiler and target.
+  filter "options:deterministic-fp"
+    floatingpoint "Strict"
+
+  filter { "options:deterministic-fp", "system:linux" }
+    buildoptions
+    {
+      "-ffp-contract=off",
+    }
+
+  --Has to match across every project, glm types are shared between the engine and what links it.
+  --Only the aligned_* types are aligned, the default ones keep their size so vertex and buffer layouts stay put.
+  filter "options:glm-simd"
+    defines
+    {
+      "GLM_FORCE_INTRINSICS",
+      "GLM_FORCE_ALIGNED_GENTYPES",
+    }
+    vectorextensions "AVX2"
+  filter {}
 
   group "Dependencies"
-    include "Source/ThirdParty/box2d"
+    include "Source/ThirdParty/box2D"
     include "Source/ThirdParty/entt"
     include "Source/ThirdParty/fastgltf"
 	  include "Source/ThirdParty/glad"
     include "Source/ThirdParty/glm"
-    include "Source/ThirdParty/ImGui"
+    include "Source/ThirdParty/imgui"
 	  include "Source/ThirdParty/sol2"
     include "Source/ThirdParty/stb_image"
     include "Source/ThirdParty/swindow"
@@ -31,6 +206,10 @@ workspace("Sengine")
 
   group "Tools"
     include "Source/Editor"
+    include "Source/DistanceFieldCooker"
+    include "Source/Benchmarks"
+    include "Source/RenderRegression"
+    include "Source/FrameReplay"
   group ""
 	
 	filter "Debug"